@@ -34,6 +34,7 @@
 #include <thread>
 #include <vector>
 #include <string>
+#include <limits>
 #include <numeric>
 #include <algorithm>
 
@@ -46,6 +47,7 @@
 #include "alFilter.h"
 #include "alEffect.h"
 #include "alAuxEffectSlot.h"
+#include "alSubmixBus.h"
 #include "alError.h"
 #include "mastering.h"
 #include "bformatdec.h"
@@ -181,7 +183,7 @@ BackendInfo CaptureBackend;
  * Functions, enums, and errors
  ************************************************/
 #define DECL(x) { #x, (ALCvoid*)(x) }
-constexpr struct {
+const struct {
     const ALCchar *funcName;
     ALCvoid *address;
 } alcFunctions[] = {
@@ -221,6 +223,12 @@ constexpr struct {
 
     DECL(alcGetInteger64vSOFT),
 
+    DECL(alcReloadConfigSOFT),
+
+    DECL(alcReopenDeviceSOFT),
+
+    DECL(alcRenderListenerSamplesSOFT),
+
     DECL(alEnable),
     DECL(alDisable),
     DECL(alIsEnabled),
@@ -356,6 +364,24 @@ constexpr struct {
     DECL(alEventCallbackSOFT),
     DECL(alGetPointerSOFT),
     DECL(alGetPointervSOFT),
+
+    DECL(alGenSubmixBusesSOFT),
+    DECL(alDeleteSubmixBusesSOFT),
+    DECL(alIsSubmixBusSOFT),
+    DECL(alSubmixBusiSOFT),
+    DECL(alSubmixBusivSOFT),
+    DECL(alSubmixBusfSOFT),
+    DECL(alSubmixBusfvSOFT),
+    DECL(alGetSubmixBusiSOFT),
+    DECL(alGetSubmixBusivSOFT),
+    DECL(alGetSubmixBusfSOFT),
+    DECL(alGetSubmixBusfvSOFT),
+
+    DECL(alSelectListenerSOFT),
+
+    DECL(alBufferFileSOFT),
+
+    DECL(alGetSourceStatusvSOFT),
 };
 #undef DECL
 
@@ -433,6 +459,10 @@ constexpr struct {
 
     DECL(ALC_OUTPUT_LIMITER_SOFT),
 
+    DECL(ALC_DEVICE_MEMORY_SOFT),
+    DECL(ALC_CONTEXTS_MEMORY_SOFT),
+    DECL(ALC_EFFECT_SLOTS_MEMORY_SOFT),
+
     DECL(ALC_NO_ERROR),
     DECL(ALC_INVALID_DEVICE),
     DECL(ALC_INVALID_CONTEXT),
@@ -542,6 +572,19 @@ constexpr struct {
     DECL(AL_FORMAT_BFORMAT3D_FLOAT32),
     DECL(AL_FORMAT_BFORMAT3D_MULAW),
 
+    DECL(AL_FORMAT_MONO_HALF_SOFT),
+    DECL(AL_FORMAT_STEREO_HALF_SOFT),
+    DECL(AL_FORMAT_51CHN_HALF_SOFT),
+    DECL(AL_FORMAT_71CHN_HALF_SOFT),
+    DECL(AL_FORMAT_BFORMAT2D_HALF_SOFT),
+    DECL(AL_FORMAT_BFORMAT3D_HALF_SOFT),
+    DECL(AL_FORMAT_MONO24_SOFT),
+    DECL(AL_FORMAT_STEREO24_SOFT),
+    DECL(AL_FORMAT_51CHN24_SOFT),
+    DECL(AL_FORMAT_71CHN24_SOFT),
+    DECL(AL_FORMAT_BFORMAT2D_24_SOFT),
+    DECL(AL_FORMAT_BFORMAT3D_24_SOFT),
+
     DECL(AL_FREQUENCY),
     DECL(AL_BITS),
     DECL(AL_CHANNELS),
@@ -784,19 +827,25 @@ constexpr ALchar alExtList[] =
     "AL_EXT_STEREO_ANGLES "
     "AL_LOKI_quadriphonic "
     "AL_SOFT_block_alignment "
+    "AL_SOFTX_buffer_residency "
     "AL_SOFT_deferred_updates "
     "AL_SOFT_direct_channels "
     "AL_SOFTX_effect_chain "
     "AL_SOFTX_events "
     "AL_SOFTX_filter_gain_ex "
     "AL_SOFT_gain_clamp_ex "
+    "AL_SOFTX_half_packed24_formats "
     "AL_SOFT_loop_points "
     "AL_SOFTX_map_buffer "
     "AL_SOFT_MSADPCM "
+    "AL_SOFTX_multi_listener "
     "AL_SOFT_source_latency "
     "AL_SOFT_source_length "
     "AL_SOFT_source_resampler "
-    "AL_SOFT_source_spatialize";
+    "AL_SOFT_source_spatialize "
+    "AL_SOFTX_source_status "
+    "AL_SOFTX_submix_bus "
+    "AL_SOFTX_voice_clusters";
 
 std::atomic<ALCenum> LastNullDeviceError{ALC_NO_ERROR};
 
@@ -848,12 +897,13 @@ bool SuspendDefers{true};
  ************************************************/
 constexpr ALCchar alcNoDeviceExtList[] =
     "ALC_ENUMERATE_ALL_EXT ALC_ENUMERATION_EXT ALC_EXT_CAPTURE "
-    "ALC_EXT_thread_local_context ALC_SOFT_loopback";
+    "ALC_EXT_thread_local_context ALC_SOFT_loopback ALC_SOFT_reload_config";
 constexpr ALCchar alcExtensionList[] =
     "ALC_ENUMERATE_ALL_EXT ALC_ENUMERATION_EXT ALC_EXT_CAPTURE "
     "ALC_EXT_DEDICATED ALC_EXT_disconnect ALC_EXT_EFX "
     "ALC_EXT_thread_local_context ALC_SOFT_device_clock ALC_SOFT_HRTF "
-    "ALC_SOFT_loopback ALC_SOFT_output_limiter ALC_SOFT_pause_device";
+    "ALC_SOFT_loopback ALC_SOFT_memory_usage ALC_SOFT_output_limiter "
+    "ALC_SOFT_pause_device ALC_SOFT_reload_config ALC_SOFT_reopen_device";
 constexpr ALCint alcMajorVersion = 1;
 constexpr ALCint alcMinorVersion = 1;
 
@@ -901,6 +951,8 @@ BOOL APIENTRY DllMain(HINSTANCE module, DWORD reason, LPVOID /*reserved*/)
 }
 #endif
 
+static void ConfigChanged(void*);
+
 static void alc_initconfig(void)
 {
     const char *devs, *str;
@@ -943,6 +995,7 @@ static void alc_initconfig(void)
         TRACE("Supported backends: %s\n", names.c_str());
     }
     ReadALConfig();
+    AddConfigChangedCallback(ConfigChanged, nullptr);
 
     str = getenv("__ALSOFT_SUSPEND_CONTEXT");
     if(str && *str)
@@ -1012,6 +1065,14 @@ static void alc_initconfig(void)
 #endif
     ConfigValueInt(nullptr, nullptr, "rt-prio", &RTPrioLevel);
 
+    unsigned int allocflags{0u};
+    if(GetConfigValueBool(nullptr, nullptr, "huge-pages", 0))
+        allocflags |= AL_LARGE_ALLOC_HUGEPAGES;
+    if(GetConfigValueBool(nullptr, nullptr, "lock-memory", 0))
+        allocflags |= AL_LARGE_ALLOC_LOCKED;
+    TRACE("Large allocation flags: 0x%x\n", allocflags);
+    al_set_large_alloc_flags(allocflags);
+
     aluInit();
     aluInitMixer();
 
@@ -1512,9 +1573,9 @@ void ALCcontext_ProcessUpdates(ALCcontext *context)
 
         if(!context->PropsClean.test_and_set(std::memory_order_acq_rel))
             UpdateContextProps(context);
-        if(!context->Listener.PropsClean.test_and_set(std::memory_order_acq_rel))
-            UpdateListenerProps(context);
+        UpdateAllListenerProps(context);
         UpdateAllEffectSlotProps(context);
+        UpdateAllSubmixBusProps(context);
         UpdateAllSourceProps(context);
 
         /* Now with all updates declared, let the mixer continue applying them
@@ -1577,25 +1638,438 @@ static inline void UpdateClockBase(ALCdevice *device)
     IncrementRef(&device->MixCount);
 }
 
+/* UpdateDitherAndLimiter
+ *
+ * Sets up the device's dithering and output limiter from the config and the
+ * requested limiter state. Called when the device is reset, and when the
+ * config is reloaded (with the backend lock held, so the mixer picks up the
+ * changes on its next update).
+ */
+static void UpdateDitherAndLimiter(ALCdevice *device)
+{
+    device->DitherDepth = 0.0f;
+    if(GetConfigValueBool(device->DeviceName.c_str(), nullptr, "dither", 1))
+    {
+        ALint depth = 0;
+        ConfigValueInt(device->DeviceName.c_str(), nullptr, "dither-depth", &depth);
+        if(depth <= 0)
+        {
+            switch(device->FmtType)
+            {
+                case DevFmtByte:
+                case DevFmtUByte:
+                    depth = 8;
+                    break;
+                case DevFmtShort:
+                case DevFmtUShort:
+                    depth = 16;
+                    break;
+                case DevFmtInt:
+                case DevFmtUInt:
+                case DevFmtFloat:
+                    break;
+            }
+        }
+
+        if(depth > 0)
+        {
+            depth = clampi(depth, 2, 24);
+            device->DitherDepth = std::pow(2.0f, static_cast<ALfloat>(depth-1));
+        }
+    }
+    if(!(device->DitherDepth > 0.0f))
+        TRACE("Dithering disabled\n");
+    else
+        TRACE("Dithering enabled (%d-bit, %g)\n", float2int(std::log2(device->DitherDepth)+0.5f)+1,
+              device->DitherDepth);
+
+    ALCenum gainLimiter{device->LimiterState};
+    int val;
+    if(ConfigValueBool(device->DeviceName.c_str(), nullptr, "output-limiter", &val))
+        gainLimiter = val ? ALC_TRUE : ALC_FALSE;
+
+    /* Valid values for gainLimiter are ALC_DONT_CARE_SOFT, ALC_TRUE, and
+     * ALC_FALSE. For ALC_DONT_CARE_SOFT, use the limiter for integer-based
+     * output (where samples must be clamped), and don't for floating-point
+     * (which can take unclamped samples).
+     */
+    if(gainLimiter == ALC_DONT_CARE_SOFT)
+    {
+        switch(device->FmtType)
+        {
+            case DevFmtByte:
+            case DevFmtUByte:
+            case DevFmtShort:
+            case DevFmtUShort:
+            case DevFmtInt:
+            case DevFmtUInt:
+                gainLimiter = ALC_TRUE;
+                break;
+            case DevFmtFloat:
+                gainLimiter = ALC_FALSE;
+                break;
+        }
+    }
+    std::unique_ptr<Compressor> limiter;
+    if(gainLimiter != ALC_FALSE)
+    {
+        ALfloat thrshld = 1.0f;
+        switch(device->FmtType)
+        {
+            case DevFmtByte:
+            case DevFmtUByte:
+                thrshld = 127.0f / 128.0f;
+                break;
+            case DevFmtShort:
+            case DevFmtUShort:
+                thrshld = 32767.0f / 32768.0f;
+                break;
+            case DevFmtInt:
+            case DevFmtUInt:
+            case DevFmtFloat:
+                break;
+        }
+        if(device->DitherDepth > 0.0f)
+            thrshld -= 1.0f / device->DitherDepth;
+
+        limiter = CreateDeviceLimiter(device, std::log10(thrshld) * 20.0f);
+    }
+
+    /* Convert the lookahead from samples to nanosamples to nanoseconds. */
+    auto lookahead_latency = [device](const Compressor *comp) -> std::chrono::nanoseconds
+    {
+        if(!comp) return std::chrono::nanoseconds::zero();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::seconds(comp->getLookAhead())) / device->Frequency;
+    };
+    device->FixedLatency -= lookahead_latency(device->Limiter.get());
+    device->FixedLatency += lookahead_latency(limiter.get());
+    device->Limiter = std::move(limiter);
+    TRACE("Output limiter %s\n", device->Limiter ? "enabled" : "disabled");
+}
+
+/* ConfigChanged
+ *
+ * Applies settings that can change without a device reset after the config is
+ * reloaded. Settings affecting the device format or buffer layout still need
+ * the device to be reset.
+ */
+static void ConfigChanged(void*)
+{
+    aluInitResampler();
+    const Resampler resampler{ResamplerDefault.load()};
+
+    std::lock_guard<std::recursive_mutex> _{ListLock};
+    ALCdevice *device{DeviceList.load()};
+    while(device)
+    {
+        if(device->Type != Capture)
+        {
+            std::lock_guard<std::mutex> ___{device->StateLock};
+            if(device->RealOut.Buffer)
+            {
+                BackendLockGuard __{*device->Backend};
+                UpdateDitherAndLimiter(device);
+            }
+        }
+
+        /* Sources that never had a resampler set follow the new default. Any
+         * that are playing get it with their next property update.
+         */
+        ALCcontext *context{device->ContextList.load()};
+        while(context)
+        {
+            std::lock_guard<std::mutex> __{context->PropLock};
+            std::lock_guard<std::mutex> ___{context->SourceLock};
+            for(auto &sublist : context->SourceList)
+            {
+                uint64_t usemask{~sublist.FreeMask};
+                while(usemask)
+                {
+                    ALsizei idx{CTZ64(usemask)};
+                    ALsource *source{sublist.Sources + idx};
+                    usemask &= ~(1_u64 << idx);
+
+                    if(source->mResamplerSet || source->mResampler == resampler)
+                        continue;
+                    source->mResampler = resampler;
+                    source->PropsClean.clear(std::memory_order_release);
+                }
+            }
+            if(!context->DeferUpdates.load(std::memory_order_acquire))
+                UpdateAllSourceProps(context);
+            context = context->next.load(std::memory_order_relaxed);
+        }
+        device = device->next.load(std::memory_order_relaxed);
+    }
+}
+
+/* Device settings requested by an attribute list. Settings the list doesn't
+ * specify keep the device's current values.
+ */
+struct DeviceAttribs {
+    ALCenum schans{AL_NONE};
+    ALCenum stype{AL_NONE};
+    ALCuint freq{0u};
+    ALCenum alayout{AL_NONE};
+    ALCenum ascale{AL_NONE};
+    ALCsizei aorder{0};
+    ALsizei numMono;
+    ALsizei numStereo;
+    ALsizei numSends;
+    HrtfRequestMode hrtf_appreq{Hrtf_Default};
+    ALCsizei hrtf_id{-1};
+    ALCenum gainLimiter;
+
+    DeviceAttribs(const ALCdevice *device)
+      : numMono{static_cast<ALsizei>(device->NumMonoSources)},
+        numStereo{static_cast<ALsizei>(device->NumStereoSources)},
+        numSends{device->NumAuxSends}, gainLimiter{device->LimiterState}
+    { }
+};
+
+static void ParseDeviceAttribs(DeviceAttribs &attrs, const ALCint *attrList)
+{
+    ALCsizei attrIdx{0};
+#define TRACE_ATTR(a, v) TRACE("%s = %d\n", #a, v)
+    while(attrList[attrIdx])
+    {
+        switch(attrList[attrIdx])
+        {
+        case ALC_FORMAT_CHANNELS_SOFT:
+            attrs.schans = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_FORMAT_CHANNELS_SOFT, attrs.schans);
+            break;
+
+        case ALC_FORMAT_TYPE_SOFT:
+            attrs.stype = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_FORMAT_TYPE_SOFT, attrs.stype);
+            break;
+
+        case ALC_FREQUENCY:
+            attrs.freq = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_FREQUENCY, attrs.freq);
+            break;
+
+        case ALC_AMBISONIC_LAYOUT_SOFT:
+            attrs.alayout = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_AMBISONIC_LAYOUT_SOFT, attrs.alayout);
+            break;
+
+        case ALC_AMBISONIC_SCALING_SOFT:
+            attrs.ascale = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_AMBISONIC_SCALING_SOFT, attrs.ascale);
+            break;
+
+        case ALC_AMBISONIC_ORDER_SOFT:
+            attrs.aorder = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_AMBISONIC_ORDER_SOFT, attrs.aorder);
+            break;
+
+        case ALC_MONO_SOURCES:
+            attrs.numMono = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_MONO_SOURCES, attrs.numMono);
+            attrs.numMono = maxi(attrs.numMono, 0);
+            break;
+
+        case ALC_STEREO_SOURCES:
+            attrs.numStereo = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_STEREO_SOURCES, attrs.numStereo);
+            attrs.numStereo = maxi(attrs.numStereo, 0);
+            break;
+
+        case ALC_MAX_AUXILIARY_SENDS:
+            attrs.numSends = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_MAX_AUXILIARY_SENDS, attrs.numSends);
+            attrs.numSends = clampi(attrs.numSends, 0, MAX_SENDS);
+            break;
+
+        case ALC_HRTF_SOFT:
+            TRACE_ATTR(ALC_HRTF_SOFT, attrList[attrIdx + 1]);
+            if(attrList[attrIdx + 1] == ALC_FALSE)
+                attrs.hrtf_appreq = Hrtf_Disable;
+            else if(attrList[attrIdx + 1] == ALC_TRUE)
+                attrs.hrtf_appreq = Hrtf_Enable;
+            else
+                attrs.hrtf_appreq = Hrtf_Default;
+            break;
+
+        case ALC_HRTF_ID_SOFT:
+            attrs.hrtf_id = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_HRTF_ID_SOFT, attrs.hrtf_id);
+            break;
+
+        case ALC_OUTPUT_LIMITER_SOFT:
+            attrs.gainLimiter = attrList[attrIdx + 1];
+            TRACE_ATTR(ALC_OUTPUT_LIMITER_SOFT, attrs.gainLimiter);
+            break;
+
+        default:
+            TRACE("0x%04X = %d (0x%x)\n", attrList[attrIdx],
+                attrList[attrIdx + 1], attrList[attrIdx + 1]);
+            break;
+        }
+
+        attrIdx += 2;
+    }
+#undef TRACE_ATTR
+}
+
+/* SetSourceLimits
+ *
+ * Sets the device's source limits from the requested mono and stereo source
+ * counts, which the config may override.
+ */
+static void SetSourceLimits(ALCdevice *device, const char *devname, ALsizei numMono,
+    ALsizei numStereo)
+{
+    if(numMono > INT_MAX-numStereo)
+        numMono = INT_MAX-numStereo;
+    numMono += numStereo;
+    if(ConfigValueInt(devname, nullptr, "sources", &numMono))
+    {
+        if(numMono <= 0)
+            numMono = 256;
+    }
+    else
+        numMono = maxi(numMono, 256);
+    numStereo = mini(numStereo, numMono);
+    numMono -= numStereo;
+    device->SourcesMax = numMono + numStereo;
+
+    device->NumMonoSources = numMono;
+    device->NumStereoSources = numStereo;
+}
+
+/* GetAuxSendCount
+ *
+ * Returns the number of auxiliary sends to use given the requested count,
+ * which the config may lower.
+ */
+static ALsizei GetAuxSendCount(const char *devname, ALsizei numSends)
+{
+    ALsizei new_sends;
+    if(ConfigValueInt(devname, nullptr, "sends", &new_sends))
+        return mini(numSends, clampi(new_sends, 0, MAX_SENDS));
+    return numSends;
+}
+
+/* RequestHrtfFormat
+ *
+ * Loads the HRTF if the config or app requests it, and updates the device
+ * format request to match it.
+ */
+static void RequestHrtfFormat(ALCdevice *device, HrtfRequestMode &hrtf_userreq,
+    HrtfRequestMode &hrtf_appreq, ALCsizei hrtf_id)
+{
+    device->HrtfStatus = ALC_HRTF_DISABLED_SOFT;
+    if(device->Type == Loopback)
+        return;
+
+    const char *hrtf;
+    if(ConfigValueStr(device->DeviceName.c_str(), nullptr, "hrtf", &hrtf))
+    {
+        if(strcasecmp(hrtf, "true") == 0)
+            hrtf_userreq = Hrtf_Enable;
+        else if(strcasecmp(hrtf, "false") == 0)
+            hrtf_userreq = Hrtf_Disable;
+        else if(strcasecmp(hrtf, "auto") != 0)
+            ERR("Unexpected hrtf value: %s\n", hrtf);
+    }
+
+    if(hrtf_userreq == Hrtf_Enable || (hrtf_userreq != Hrtf_Disable && hrtf_appreq == Hrtf_Enable))
+    {
+        HrtfEntry *hrtf{nullptr};
+        if(device->HrtfList.empty())
+            device->HrtfList = EnumerateHrtf(device->DeviceName.c_str());
+        if(!device->HrtfList.empty())
+        {
+            if(hrtf_id >= 0 && static_cast<size_t>(hrtf_id) < device->HrtfList.size())
+                hrtf = GetLoadedHrtf(device->HrtfList[hrtf_id].hrtf);
+            else
+                hrtf = GetLoadedHrtf(device->HrtfList.front().hrtf);
+        }
+
+        if(hrtf)
+        {
+            device->FmtChans = DevFmtStereo;
+            device->Frequency = hrtf->sampleRate;
+            device->Flags |= DEVICE_CHANNELS_REQUEST | DEVICE_FREQUENCY_REQUEST;
+            if(HrtfEntry *oldhrtf{device->mHrtf})
+                oldhrtf->DecRef();
+            device->mHrtf = hrtf;
+        }
+        else
+        {
+            hrtf_userreq = Hrtf_Default;
+            hrtf_appreq = Hrtf_Disable;
+            device->HrtfStatus = ALC_HRTF_UNSUPPORTED_FORMAT_SOFT;
+        }
+    }
+}
+
+/* InitDeviceRenderer
+ *
+ * Sets up the renderer for the device's output format, and allocates the
+ * mixing buffers it needs.
+ */
+static void InitDeviceRenderer(ALCdevice *device, ALCsizei hrtf_id, HrtfRequestMode hrtf_appreq,
+    HrtfRequestMode hrtf_userreq)
+{
+    aluInitRenderer(device, hrtf_id, hrtf_appreq, hrtf_userreq);
+    TRACE("Channel config, Dry: %d, FOA: %d, Real: %d\n", device->Dry.NumChannels,
+          device->FOAOut.NumChannels, device->RealOut.NumChannels);
+
+    /* Allocate extra channels for any post-filter output. */
+    ALsizei num_chans{device->Dry.NumChannels + device->FOAOut.NumChannels +
+                      device->RealOut.NumChannels};
+
+    TRACE("Allocating %d channels, " SZFMT " bytes\n", num_chans,
+          num_chans*sizeof(device->MixBuffer[0]));
+    device->MixBuffer.resize(num_chans);
+
+    device->Dry.Buffer = &reinterpret_cast<ALfloat(&)[BUFFERSIZE]>(device->MixBuffer[0]);
+    if(device->RealOut.NumChannels != 0)
+        device->RealOut.Buffer = device->Dry.Buffer + device->Dry.NumChannels +
+                                 device->FOAOut.NumChannels;
+    else
+    {
+        device->RealOut.Buffer = device->Dry.Buffer;
+        device->RealOut.NumChannels = device->Dry.NumChannels;
+    }
+
+    if(device->FOAOut.NumChannels != 0)
+        device->FOAOut.Buffer = device->Dry.Buffer + device->Dry.NumChannels;
+    else
+    {
+        device->FOAOut.Buffer = device->Dry.Buffer;
+        device->FOAOut.NumChannels = device->Dry.NumChannels;
+    }
+
+    /* The additional listeners' outputs follow the new renderer. */
+    for(auto &output : device->ListenerOuts)
+        aluInitListenerOutput(device, output.get());
+}
+
 /* UpdateDeviceParams
  *
  * Updates device parameters according to the attribute list (caller is
- * responsible for holding the list lock).
+ * responsible for holding the list lock). If resetBackend is false, the caller
+ * has already reset the backend, and the renderer is rebuilt for the format it
+ * got.
  */
-static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
+static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList,
+    bool resetBackend=true)
 {
     HrtfRequestMode hrtf_userreq = Hrtf_Default;
-    HrtfRequestMode hrtf_appreq = Hrtf_Default;
-    ALCenum gainLimiter = device->LimiterState;
+    DeviceAttribs attrs{device};
     const ALsizei old_sends = device->NumAuxSends;
     ALsizei new_sends = device->NumAuxSends;
     DevFmtChannels oldChans;
     DevFmtType oldType;
     ALboolean update_failed;
-    ALCsizei hrtf_id = -1;
     ALCcontext *context;
     ALCuint oldFreq;
-    int val;
 
     if((!attrList || !attrList[0]) && device->Type == Loopback)
     {
@@ -1606,14 +2080,6 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
     // Check for attributes
     if(attrList && attrList[0])
     {
-        ALCenum alayout = AL_NONE;
-        ALCenum ascale = AL_NONE;
-        ALCenum schans = AL_NONE;
-        ALCenum stype = AL_NONE;
-        ALCsizei attrIdx = 0;
-        ALCsizei aorder = 0;
-        ALCuint freq = 0;
-
         const char *devname{nullptr};
         const bool loopback{device->Type == Loopback};
         if(!loopback)
@@ -1627,114 +2093,31 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
             device->Flags &= ~DEVICE_RUNNING;
         }
 
-        auto numMono = static_cast<ALsizei>(device->NumMonoSources);
-        auto numStereo = static_cast<ALsizei>(device->NumStereoSources);
-        auto numSends = ALsizei{old_sends};
-
-#define TRACE_ATTR(a, v) TRACE("%s = %d\n", #a, v)
-        while(attrList[attrIdx])
-        {
-            switch(attrList[attrIdx])
-            {
-            case ALC_FORMAT_CHANNELS_SOFT:
-                schans = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_FORMAT_CHANNELS_SOFT, schans);
-                break;
-
-            case ALC_FORMAT_TYPE_SOFT:
-                stype = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_FORMAT_TYPE_SOFT, stype);
-                break;
-
-            case ALC_FREQUENCY:
-                freq = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_FREQUENCY, freq);
-                break;
-
-            case ALC_AMBISONIC_LAYOUT_SOFT:
-                alayout = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_AMBISONIC_LAYOUT_SOFT, alayout);
-                break;
-
-            case ALC_AMBISONIC_SCALING_SOFT:
-                ascale = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_AMBISONIC_SCALING_SOFT, ascale);
-                break;
-
-            case ALC_AMBISONIC_ORDER_SOFT:
-                aorder = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_AMBISONIC_ORDER_SOFT, aorder);
-                break;
-
-            case ALC_MONO_SOURCES:
-                numMono = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_MONO_SOURCES, numMono);
-                numMono = maxi(numMono, 0);
-                break;
-
-            case ALC_STEREO_SOURCES:
-                numStereo = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_STEREO_SOURCES, numStereo);
-                numStereo = maxi(numStereo, 0);
-                break;
-
-            case ALC_MAX_AUXILIARY_SENDS:
-                numSends = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_MAX_AUXILIARY_SENDS, numSends);
-                numSends = clampi(numSends, 0, MAX_SENDS);
-                break;
-
-            case ALC_HRTF_SOFT:
-                TRACE_ATTR(ALC_HRTF_SOFT, attrList[attrIdx + 1]);
-                if(attrList[attrIdx + 1] == ALC_FALSE)
-                    hrtf_appreq = Hrtf_Disable;
-                else if(attrList[attrIdx + 1] == ALC_TRUE)
-                    hrtf_appreq = Hrtf_Enable;
-                else
-                    hrtf_appreq = Hrtf_Default;
-                break;
-
-            case ALC_HRTF_ID_SOFT:
-                hrtf_id = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_HRTF_ID_SOFT, hrtf_id);
-                break;
-
-            case ALC_OUTPUT_LIMITER_SOFT:
-                gainLimiter = attrList[attrIdx + 1];
-                TRACE_ATTR(ALC_OUTPUT_LIMITER_SOFT, gainLimiter);
-                break;
-
-            default:
-                TRACE("0x%04X = %d (0x%x)\n", attrList[attrIdx],
-                    attrList[attrIdx + 1], attrList[attrIdx + 1]);
-                break;
-            }
-
-            attrIdx += 2;
-        }
-#undef TRACE_ATTR
+        ParseDeviceAttribs(attrs, attrList);
 
         if(loopback)
         {
-            if(!schans || !stype || !freq)
+            if(!attrs.schans || !attrs.stype || !attrs.freq)
             {
                 WARN("Missing format for loopback device\n");
                 return ALC_INVALID_VALUE;
             }
-            if(!IsValidALCChannels(schans) || !IsValidALCType(stype) || freq < MIN_OUTPUT_RATE)
+            if(!IsValidALCChannels(attrs.schans) || !IsValidALCType(attrs.stype) ||
+               attrs.freq < MIN_OUTPUT_RATE)
                 return ALC_INVALID_VALUE;
-            if(schans == ALC_BFORMAT3D_SOFT)
+            if(attrs.schans == ALC_BFORMAT3D_SOFT)
             {
-                if(!alayout || !ascale || !aorder)
+                if(!attrs.alayout || !attrs.ascale || !attrs.aorder)
                 {
                     WARN("Missing ambisonic info for loopback device\n");
                     return ALC_INVALID_VALUE;
                 }
-                if(!IsValidAmbiLayout(alayout) || !IsValidAmbiScaling(ascale))
+                if(!IsValidAmbiLayout(attrs.alayout) || !IsValidAmbiScaling(attrs.ascale))
                     return ALC_INVALID_VALUE;
-                if(aorder < 1 || aorder > MAX_AMBI_ORDER)
+                if(attrs.aorder < 1 || attrs.aorder > MAX_AMBI_ORDER)
                     return ALC_INVALID_VALUE;
-                if((alayout == ALC_FUMA_SOFT || ascale == ALC_FUMA_SOFT) && aorder > 3)
+                if((attrs.alayout == ALC_FUMA_SOFT || attrs.ascale == ALC_FUMA_SOFT) &&
+                   attrs.aorder > 3)
                     return ALC_INVALID_VALUE;
             }
         }
@@ -1751,6 +2134,7 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
             device->UpdateSize = DEFAULT_UPDATE_SIZE;
             device->Frequency = DEFAULT_OUTPUT_RATE;
 
+            ALCuint freq{attrs.freq};
             ConfigValueUInt(devname, nullptr, "frequency", &freq);
             if(freq < 1)
                 device->Flags &= ~DEVICE_FREQUENCY_REQUEST;
@@ -1776,38 +2160,19 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
         }
         else
         {
-            device->Frequency = freq;
-            device->FmtChans = static_cast<DevFmtChannels>(schans);
-            device->FmtType = static_cast<DevFmtType>(stype);
-            if(schans == ALC_BFORMAT3D_SOFT)
+            device->Frequency = attrs.freq;
+            device->FmtChans = static_cast<DevFmtChannels>(attrs.schans);
+            device->FmtType = static_cast<DevFmtType>(attrs.stype);
+            if(attrs.schans == ALC_BFORMAT3D_SOFT)
             {
-                device->mAmbiOrder = aorder;
-                device->mAmbiLayout = static_cast<AmbiLayout>(alayout);
-                device->mAmbiScale = static_cast<AmbiNorm>(ascale);
+                device->mAmbiOrder = attrs.aorder;
+                device->mAmbiLayout = static_cast<AmbiLayout>(attrs.alayout);
+                device->mAmbiScale = static_cast<AmbiNorm>(attrs.ascale);
             }
         }
 
-        if(numMono > INT_MAX-numStereo)
-            numMono = INT_MAX-numStereo;
-        numMono += numStereo;
-        if(ConfigValueInt(devname, nullptr, "sources", &numMono))
-        {
-            if(numMono <= 0)
-                numMono = 256;
-        }
-        else
-            numMono = maxi(numMono, 256);
-        numStereo = mini(numStereo, numMono);
-        numMono -= numStereo;
-        device->SourcesMax = numMono + numStereo;
-
-        device->NumMonoSources = numMono;
-        device->NumStereoSources = numStereo;
-
-        if(ConfigValueInt(devname, nullptr, "sends", &new_sends))
-            new_sends = mini(numSends, clampi(new_sends, 0, MAX_SENDS));
-        else
-            new_sends = numSends;
+        SetSourceLimits(device, devname, attrs.numMono, attrs.numStereo);
+        new_sends = GetAuxSendCount(devname, attrs.numSends);
     }
 
     if((device->Flags&DEVICE_RUNNING))
@@ -1837,49 +2202,13 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
     /*************************************************************************
      * Update device format request if HRTF is requested
      */
-    device->HrtfStatus = ALC_HRTF_DISABLED_SOFT;
-    if(device->Type != Loopback)
+    const ALCuint resetFreq{device->Frequency};
+    const DevFmtChannels resetChans{device->FmtChans};
+    RequestHrtfFormat(device, hrtf_userreq, attrs.hrtf_appreq, attrs.hrtf_id);
+    if(!resetBackend)
     {
-        const char *hrtf;
-        if(ConfigValueStr(device->DeviceName.c_str(), nullptr, "hrtf", &hrtf))
-        {
-            if(strcasecmp(hrtf, "true") == 0)
-                hrtf_userreq = Hrtf_Enable;
-            else if(strcasecmp(hrtf, "false") == 0)
-                hrtf_userreq = Hrtf_Disable;
-            else if(strcasecmp(hrtf, "auto") != 0)
-                ERR("Unexpected hrtf value: %s\n", hrtf);
-        }
-
-        if(hrtf_userreq == Hrtf_Enable || (hrtf_userreq != Hrtf_Disable && hrtf_appreq == Hrtf_Enable))
-        {
-            HrtfEntry *hrtf{nullptr};
-            if(device->HrtfList.empty())
-                device->HrtfList = EnumerateHrtf(device->DeviceName.c_str());
-            if(!device->HrtfList.empty())
-            {
-                if(hrtf_id >= 0 && static_cast<size_t>(hrtf_id) < device->HrtfList.size())
-                    hrtf = GetLoadedHrtf(device->HrtfList[hrtf_id].hrtf);
-                else
-                    hrtf = GetLoadedHrtf(device->HrtfList.front().hrtf);
-            }
-
-            if(hrtf)
-            {
-                device->FmtChans = DevFmtStereo;
-                device->Frequency = hrtf->sampleRate;
-                device->Flags |= DEVICE_CHANNELS_REQUEST | DEVICE_FREQUENCY_REQUEST;
-                if(HrtfEntry *oldhrtf{device->mHrtf})
-                    oldhrtf->DecRef();
-                device->mHrtf = hrtf;
-            }
-            else
-            {
-                hrtf_userreq = Hrtf_Default;
-                hrtf_appreq = Hrtf_Disable;
-                device->HrtfStatus = ALC_HRTF_UNSUPPORTED_FORMAT_SOFT;
-            }
-        }
+        device->Frequency = resetFreq;
+        device->FmtChans = resetChans;
     }
 
     oldFreq  = device->Frequency;
@@ -1893,7 +2222,7 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
         device->UpdateSize, device->NumUpdates
     );
 
-    if(device->Backend->reset() == ALC_FALSE)
+    if(resetBackend && device->Backend->reset() == ALC_FALSE)
         return ALC_INVALID_DEVICE;
 
     if(device->FmtChans != oldChans && (device->Flags&DEVICE_CHANNELS_REQUEST))
@@ -1904,154 +2233,38 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
     }
     if(device->FmtType != oldType && (device->Flags&DEVICE_SAMPLE_TYPE_REQUEST))
     {
-        ERR("Failed to set %s, got %s instead\n", DevFmtTypeString(oldType),
-            DevFmtTypeString(device->FmtType));
-        device->Flags &= ~DEVICE_SAMPLE_TYPE_REQUEST;
-    }
-    if(device->Frequency != oldFreq && (device->Flags&DEVICE_FREQUENCY_REQUEST))
-    {
-        ERR("Failed to set %uhz, got %uhz instead\n", oldFreq, device->Frequency);
-        device->Flags &= ~DEVICE_FREQUENCY_REQUEST;
-    }
-
-    if((device->UpdateSize&3) != 0)
-    {
-        if((CPUCapFlags&CPU_CAP_SSE))
-            WARN("SSE performs best with multiple of 4 update sizes (%u)\n", device->UpdateSize);
-        if((CPUCapFlags&CPU_CAP_NEON))
-            WARN("NEON performs best with multiple of 4 update sizes (%u)\n", device->UpdateSize);
-    }
-
-    TRACE("Post-reset: %s, %s, %uhz, %u update size x%d\n",
-        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
-        device->Frequency, device->UpdateSize, device->NumUpdates
-    );
-
-    aluInitRenderer(device, hrtf_id, hrtf_appreq, hrtf_userreq);
-    TRACE("Channel config, Dry: %d, FOA: %d, Real: %d\n", device->Dry.NumChannels,
-          device->FOAOut.NumChannels, device->RealOut.NumChannels);
-
-    /* Allocate extra channels for any post-filter output. */
-    ALsizei num_chans{device->Dry.NumChannels + device->FOAOut.NumChannels +
-                      device->RealOut.NumChannels};
-
-    TRACE("Allocating %d channels, " SZFMT " bytes\n", num_chans,
-          num_chans*sizeof(device->MixBuffer[0]));
-    device->MixBuffer.resize(num_chans);
-
-    device->Dry.Buffer = &reinterpret_cast<ALfloat(&)[BUFFERSIZE]>(device->MixBuffer[0]);
-    if(device->RealOut.NumChannels != 0)
-        device->RealOut.Buffer = device->Dry.Buffer + device->Dry.NumChannels +
-                                 device->FOAOut.NumChannels;
-    else
-    {
-        device->RealOut.Buffer = device->Dry.Buffer;
-        device->RealOut.NumChannels = device->Dry.NumChannels;
-    }
-
-    if(device->FOAOut.NumChannels != 0)
-        device->FOAOut.Buffer = device->Dry.Buffer + device->Dry.NumChannels;
-    else
-    {
-        device->FOAOut.Buffer = device->Dry.Buffer;
-        device->FOAOut.NumChannels = device->Dry.NumChannels;
-    }
-
-    device->NumAuxSends = new_sends;
-    TRACE("Max sources: %d (%d + %d), effect slots: %d, sends: %d\n",
-          device->SourcesMax, device->NumMonoSources, device->NumStereoSources,
-          device->AuxiliaryEffectSlotMax, device->NumAuxSends);
-
-    device->DitherDepth = 0.0f;
-    if(GetConfigValueBool(device->DeviceName.c_str(), nullptr, "dither", 1))
-    {
-        ALint depth = 0;
-        ConfigValueInt(device->DeviceName.c_str(), nullptr, "dither-depth", &depth);
-        if(depth <= 0)
-        {
-            switch(device->FmtType)
-            {
-                case DevFmtByte:
-                case DevFmtUByte:
-                    depth = 8;
-                    break;
-                case DevFmtShort:
-                case DevFmtUShort:
-                    depth = 16;
-                    break;
-                case DevFmtInt:
-                case DevFmtUInt:
-                case DevFmtFloat:
-                    break;
-            }
-        }
-
-        if(depth > 0)
-        {
-            depth = clampi(depth, 2, 24);
-            device->DitherDepth = std::pow(2.0f, static_cast<ALfloat>(depth-1));
-        }
-    }
-    if(!(device->DitherDepth > 0.0f))
-        TRACE("Dithering disabled\n");
-    else
-        TRACE("Dithering enabled (%d-bit, %g)\n", float2int(std::log2(device->DitherDepth)+0.5f)+1,
-              device->DitherDepth);
-
-    device->LimiterState = gainLimiter;
-    if(ConfigValueBool(device->DeviceName.c_str(), nullptr, "output-limiter", &val))
-        gainLimiter = val ? ALC_TRUE : ALC_FALSE;
-
-    /* Valid values for gainLimiter are ALC_DONT_CARE_SOFT, ALC_TRUE, and
-     * ALC_FALSE. For ALC_DONT_CARE_SOFT, use the limiter for integer-based
-     * output (where samples must be clamped), and don't for floating-point
-     * (which can take unclamped samples).
-     */
-    if(gainLimiter == ALC_DONT_CARE_SOFT)
-    {
-        switch(device->FmtType)
-        {
-            case DevFmtByte:
-            case DevFmtUByte:
-            case DevFmtShort:
-            case DevFmtUShort:
-            case DevFmtInt:
-            case DevFmtUInt:
-                gainLimiter = ALC_TRUE;
-                break;
-            case DevFmtFloat:
-                gainLimiter = ALC_FALSE;
-                break;
-        }
+        ERR("Failed to set %s, got %s instead\n", DevFmtTypeString(oldType),
+            DevFmtTypeString(device->FmtType));
+        device->Flags &= ~DEVICE_SAMPLE_TYPE_REQUEST;
     }
-    if(gainLimiter != ALC_FALSE)
+    if(device->Frequency != oldFreq && (device->Flags&DEVICE_FREQUENCY_REQUEST))
     {
-        ALfloat thrshld = 1.0f;
-        switch(device->FmtType)
-        {
-            case DevFmtByte:
-            case DevFmtUByte:
-                thrshld = 127.0f / 128.0f;
-                break;
-            case DevFmtShort:
-            case DevFmtUShort:
-                thrshld = 32767.0f / 32768.0f;
-                break;
-            case DevFmtInt:
-            case DevFmtUInt:
-            case DevFmtFloat:
-                break;
-        }
-        if(device->DitherDepth > 0.0f)
-            thrshld -= 1.0f / device->DitherDepth;
+        ERR("Failed to set %uhz, got %uhz instead\n", oldFreq, device->Frequency);
+        device->Flags &= ~DEVICE_FREQUENCY_REQUEST;
+    }
 
-        auto limiter = CreateDeviceLimiter(device, std::log10(thrshld) * 20.0f);
-        /* Convert the lookahead from samples to nanosamples to nanoseconds. */
-        device->FixedLatency += std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::seconds(limiter->getLookAhead())) / device->Frequency;
-        device->Limiter = std::move(limiter);
+    if((device->UpdateSize&3) != 0)
+    {
+        if((CPUCapFlags&CPU_CAP_SSE))
+            WARN("SSE performs best with multiple of 4 update sizes (%u)\n", device->UpdateSize);
+        if((CPUCapFlags&CPU_CAP_NEON))
+            WARN("NEON performs best with multiple of 4 update sizes (%u)\n", device->UpdateSize);
     }
-    TRACE("Output limiter %s\n", device->Limiter ? "enabled" : "disabled");
+
+    TRACE("Post-reset: %s, %s, %uhz, %u update size x%d\n",
+        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
+        device->Frequency, device->UpdateSize, device->NumUpdates
+    );
+
+    InitDeviceRenderer(device, attrs.hrtf_id, attrs.hrtf_appreq, hrtf_userreq);
+
+    device->NumAuxSends = new_sends;
+    TRACE("Max sources: %d (%d + %d), effect slots: %d, sends: %d\n",
+          device->SourcesMax, device->NumMonoSources, device->NumStereoSources,
+          device->AuxiliaryEffectSlotMax, device->NumAuxSends);
+
+    device->LimiterState = attrs.gainLimiter;
+    UpdateDitherAndLimiter(device);
 
     aluSelectPostProcess(device);
 
@@ -2093,6 +2306,24 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
         }
         slotlock.unlock();
 
+        /* Buses restart their output mix and filters like the voices. */
+        std::unique_lock<std::mutex> buslock{context->SubmixBusLock};
+        for(auto &bus : context->SubmixBusList)
+        {
+            if(!bus) continue;
+            for(ALsizei c{0};c < MAX_EFFECT_CHANNELS;c++)
+            {
+                bus->Params.LowPass[c].clear();
+                bus->Params.HighPass[c].clear();
+                std::fill(std::begin(bus->Params.Gains[c].Current),
+                    std::end(bus->Params.Gains[c].Current), 0.0f);
+                std::fill(std::begin(bus->Params.SendGains[c].Current),
+                    std::end(bus->Params.SendGains[c].Current), 0.0f);
+            }
+            UpdateSubmixBusProps(bus.get(), context);
+        }
+        buslock.unlock();
+
         std::unique_lock<std::mutex> srclock{context->SourceLock};
         for(auto &sublist : context->SourceList)
         {
@@ -2145,7 +2376,7 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
         AllocateVoices(context, context->MaxVoices, old_sends);
         auto voices_end = context->Voices + context->VoiceCount.load(std::memory_order_relaxed);
         std::for_each(context->Voices, voices_end,
-            [device](ALvoice *voice) -> void
+            [device,context](ALvoice *voice) -> void
             {
                 delete voice->Update.exchange(nullptr, std::memory_order_acq_rel);
 
@@ -2157,19 +2388,31 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
                     /* Reinitialize the NFC filters for new parameters. */
                     ALfloat w1 = SPEEDOFSOUNDMETRESPERSEC /
                                  (device->AvgSpeakerDist * device->Frequency);
+                    auto init_nfc = [w1](DirectParams &params) noexcept -> void
+                    { params.NFCtrlFilter.init(w1); };
                     std::for_each(voice->Direct.Params, voice->Direct.Params+voice->NumChannels,
-                        [w1](DirectParams &params) noexcept -> void
-                        { params.NFCtrlFilter.init(w1); }
-                    );
+                        init_nfc);
+                    for(ALsizei i{1};i < context->NumListeners;i++)
+                    {
+                        ALvoice::DirectData &direct = voice->Listeners[i-1].Direct;
+                        std::for_each(direct.Params, direct.Params+voice->NumChannels, init_nfc);
+                    }
                 }
             }
         );
         srclock.unlock();
 
+        for(VoiceCluster &cluster : context->VoiceClusters)
+            cluster.Active = false;
+
         context->PropsClean.test_and_set(std::memory_order_release);
         UpdateContextProps(context);
-        context->Listener.PropsClean.test_and_set(std::memory_order_release);
-        UpdateListenerProps(context);
+        for(ALsizei i{0};i < context->NumListeners;i++)
+        {
+            ALlistener &listener = context->getListener(i);
+            listener.PropsClean.test_and_set(std::memory_order_release);
+            UpdateListenerProps(&listener, context);
+        }
         UpdateAllSourceProps(context);
 
         context = context->next.load(std::memory_order_relaxed);
@@ -2189,10 +2432,58 @@ static ALCenum UpdateDeviceParams(ALCdevice *device, const ALCint *attrList)
 }
 
 
+/* ResetDeviceOutput
+ *
+ * Resets a newly opened backend using the device's current format. If the
+ * backend keeps the format, channel order, and headphone state, the renderer
+ * and everything built for it is kept as-is. Otherwise the renderer is rebuilt
+ * for the new format, without resetting the backend again.
+ */
+static ALCenum ResetDeviceOutput(ALCdevice *device)
+{
+    const ALuint oldFreq{device->Frequency};
+    const DevFmtChannels oldChans{device->FmtChans};
+    const DevFmtType oldType{device->FmtType};
+    const ALboolean oldHeadphones{device->IsHeadphones};
+    Channel oldChanNames[MAX_OUTPUT_CHANNELS];
+    std::copy(std::begin(device->RealOut.ChannelName), std::end(device->RealOut.ChannelName),
+        std::begin(oldChanNames));
+
+    UpdateClockBase(device);
+    if(device->Backend->reset() == ALC_FALSE)
+        return ALC_INVALID_DEVICE;
+
+    if(device->Frequency != oldFreq || device->FmtChans != oldChans ||
+       device->FmtType != oldType || device->IsHeadphones != oldHeadphones ||
+       !std::equal(std::begin(oldChanNames), std::end(oldChanNames),
+            std::begin(device->RealOut.ChannelName)))
+    {
+        TRACE("Output format changed, resetting device\n");
+        return UpdateDeviceParams(device, nullptr, false);
+    }
+
+    TRACE("Keeping renderer for %s, %s, %uhz, %u update size x%d\n",
+        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
+        device->Frequency, device->UpdateSize, device->NumUpdates
+    );
+
+    if(!(device->Flags&DEVICE_PAUSED) && device->ContextList.load() != nullptr)
+    {
+        if(device->Backend->start() == ALC_FALSE)
+            return ALC_INVALID_DEVICE;
+        device->Flags |= DEVICE_RUNNING;
+    }
+    return ALC_NO_ERROR;
+}
+
 ALCdevice::ALCdevice(DeviceType type) : Type{type}
 {
 }
 
+ListenerOutput::ListenerOutput() = default;
+ListenerOutput::~ListenerOutput() = default;
+
+
 /* ALCdevice::~ALCdevice
  *
  * Frees the device structure, and destroys any objects the app failed to
@@ -2321,7 +2612,6 @@ ALCcontext::ALCcontext(ALCdevice *device) : Device{device}
  */
 static ALvoid InitContext(ALCcontext *Context)
 {
-    ALlistener &listener = Context->Listener;
     ALeffectslotArray *auxslots;
 
     //Validate Context
@@ -2333,6 +2623,7 @@ static ALvoid InitContext(ALCcontext *Context)
         (*auxslots)[0] = Context->DefaultSlot.get();
     }
     Context->ActiveAuxSlots.store(auxslots, std::memory_order_relaxed);
+    Context->ActiveSubmixBuses.store(ALsubmixbus::CreatePtrArray(0), std::memory_order_relaxed);
 
     //Set globals
     Context->mDistanceModel = DistanceModel::Default;
@@ -2345,20 +2636,27 @@ static ALvoid InitContext(ALCcontext *Context)
     Context->ExtensionList = alExtList;
 
 
-    listener.Params.Matrix = alu::Matrix::Identity();
-    listener.Params.Velocity = alu::Vector{};
-    listener.Params.Gain = listener.Gain;
-    listener.Params.MetersPerUnit = Context->MetersPerUnit;
-    listener.Params.DopplerFactor = Context->DopplerFactor;
-    listener.Params.SpeedOfSound = Context->SpeedOfSound * Context->DopplerVelocity;
-    listener.Params.ReverbSpeedOfSound = listener.Params.SpeedOfSound *
-                                         listener.Params.MetersPerUnit;
-    listener.Params.SourceDistanceModel = Context->SourceDistanceModel;
-    listener.Params.mDistanceModel = Context->mDistanceModel;
+    for(ALsizei i{0};i < Context->NumListeners;i++)
+    {
+        ALlistener &listener = Context->getListener(i);
+        listener.Params.Matrix = alu::Matrix::Identity();
+        listener.Params.Velocity = alu::Vector{};
+        listener.Params.Gain = listener.Gain;
+        listener.Params.MetersPerUnit = Context->MetersPerUnit;
+        listener.Params.DopplerFactor = Context->DopplerFactor;
+        listener.Params.SpeedOfSound = Context->SpeedOfSound * Context->DopplerVelocity;
+        listener.Params.ReverbSpeedOfSound = listener.Params.SpeedOfSound *
+                                             listener.Params.MetersPerUnit;
+        listener.Params.SourceDistanceModel = Context->SourceDistanceModel;
+        listener.Params.mDistanceModel = Context->mDistanceModel;
+    }
 
 
-    Context->AsyncEvents = CreateRingBuffer(511, sizeof(AsyncEvent), false);
-    StartEventThrd(Context);
+    /* The event thread is otherwise started when the app enables events or
+     * creates an effect slot, since nothing else can send it events.
+     */
+    if(Context->DefaultSlot)
+        StartEventThrd(Context);
 }
 
 
@@ -2397,6 +2695,27 @@ ALCcontext::~ALCcontext()
     SourceList.clear();
     NumSources = 0;
 
+    /* Buses hold references on effect slots, so delete them first. */
+    count = 0;
+    ALsubmixbusProps *bprops{FreeSubmixBusProps.exchange(nullptr, std::memory_order_acquire)};
+    while(bprops)
+    {
+        ALsubmixbusProps *next{bprops->next.load(std::memory_order_relaxed)};
+        al_free(bprops);
+        bprops = next;
+        ++count;
+    }
+    TRACE("Freed " SZFMT " submix bus property object%s\n", count, (count==1)?"":"s");
+
+    delete ActiveSubmixBuses.exchange(nullptr, std::memory_order_relaxed);
+
+    count = std::count_if(SubmixBusList.cbegin(), SubmixBusList.cend(),
+        [](const ALsubmixbusPtr &bus) noexcept -> bool { return bus != nullptr; }
+    );
+    if(count > 0)
+        WARN(SZFMT " submix bus%s not deleted\n", count, (count==1)?"":"es");
+    SubmixBusList.clear();
+
     count = 0;
     ALeffectslotProps *eprops{FreeEffectslotProps.exchange(nullptr, std::memory_order_acquire)};
     while(eprops)
@@ -2436,14 +2755,19 @@ ALCcontext::~ALCcontext()
     VoiceCount.store(0, std::memory_order_relaxed);
     MaxVoices = 0;
 
-    ALlistenerProps *lprops{Listener.Update.exchange(nullptr, std::memory_order_relaxed)};
-    if(lprops)
+    for(ALsizei i{0};i < NumListeners;i++)
     {
-        TRACE("Freed unapplied listener update %p\n", lprops);
-        al_free(lprops);
+        ALlistenerProps *lprops{getListener(i).Update.exchange(nullptr,
+            std::memory_order_relaxed)};
+        if(lprops)
+        {
+            TRACE("Freed unapplied listener update %p\n", lprops);
+            al_free(lprops);
+        }
     }
+    ExtraListeners = nullptr;
     count = 0;
-    lprops = FreeListenerProps.exchange(nullptr, std::memory_order_acquire);
+    ALlistenerProps *lprops{FreeListenerProps.exchange(nullptr, std::memory_order_acquire)};
     while(lprops)
     {
         ALlistenerProps *next{lprops->next.load(std::memory_order_relaxed)};
@@ -2586,6 +2910,15 @@ ContextRef GetContextRef(void)
 }
 
 
+/* Returns the storage size of each voice, which includes its sends and the
+ * direct paths to any additional listeners.
+ */
+static size_t VoiceStorageSize(ALsizei num_sends, ALsizei num_listeners)
+{
+    return RoundUp(ALvoice::Sizeof(num_sends), 16) +
+        RoundUp(sizeof(ALvoice::ListenerData)*(num_listeners-1), 16);
+}
+
 void AllocateVoices(ALCcontext *context, ALsizei num_voices, ALsizei old_sends)
 {
     ALCdevice *device{context->Device};
@@ -2595,10 +2928,12 @@ void AllocateVoices(ALCcontext *context, ALsizei num_voices, ALsizei old_sends)
         return;
 
     /* Allocate the voice pointers, voices, and the voices' stored source
-     * property set (including the dynamically-sized Send[] array) in one
-     * chunk.
+     * property set (including the dynamically-sized Send[] array and the
+     * additional listener paths) in one chunk.
      */
-    const size_t sizeof_voice{RoundUp(ALvoice::Sizeof(num_sends), 16)};
+    const ALsizei num_listeners{context->NumListeners};
+    const size_t listeners_offset{RoundUp(ALvoice::Sizeof(num_sends), 16)};
+    const size_t sizeof_voice{VoiceStorageSize(num_sends, num_listeners)};
     const size_t size{sizeof(ALvoice*) + sizeof_voice};
 
     auto voices = static_cast<ALvoice**>(al_calloc(16, RoundUp(size*num_voices, 16)));
@@ -2612,9 +2947,16 @@ void AllocateVoices(ALCcontext *context, ALsizei num_voices, ALsizei old_sends)
         const ALsizei s_count = mini(old_sends, num_sends);
 
         /* Copy the old voice data to the new storage. */
-        auto copy_voice = [&voice,num_sends,sizeof_voice,s_count](ALvoice *old_voice) -> ALvoice*
+        auto copy_voice = [&voice,num_sends,num_listeners,listeners_offset,sizeof_voice,s_count](ALvoice *old_voice) -> ALvoice*
         {
             voice = new (voice) ALvoice{static_cast<size_t>(num_sends)};
+            if(num_listeners > 1)
+            {
+                voice->Listeners = reinterpret_cast<ALvoice::ListenerData*>(
+                    reinterpret_cast<char*>(voice) + listeners_offset);
+                std::uninitialized_copy_n(old_voice->Listeners, num_listeners-1,
+                    voice->Listeners);
+            }
 
             /* Make sure the old voice's Update (if any) is cleared so it
              * doesn't get deleted on deinit.
@@ -2648,11 +2990,17 @@ void AllocateVoices(ALCcontext *context, ALsizei num_voices, ALsizei old_sends)
 
             voice->Step = old_voice->Step;
             voice->Resampler = old_voice->Resampler;
+            voice->ResamplerMulti = old_voice->ResamplerMulti;
 
             voice->Flags = old_voice->Flags;
 
             voice->Offset = old_voice->Offset;
 
+            voice->ClusterIdx = old_voice->ClusterIdx;
+            voice->ClusterDir = old_voice->ClusterDir;
+            voice->PrevClusterIdx = old_voice->PrevClusterIdx;
+            voice->PrevClusterGain = old_voice->PrevClusterGain;
+
             std::copy(std::begin(old_voice->PrevSamples), std::end(old_voice->PrevSamples),
                       std::begin(voice->PrevSamples));
 
@@ -2674,9 +3022,16 @@ void AllocateVoices(ALCcontext *context, ALsizei num_voices, ALsizei old_sends)
         std::for_each(context->Voices, voices_end, DeinitVoice);
     }
     /* Finish setting the voices and references. */
-    auto init_voice = [&voice,num_sends,sizeof_voice]() -> ALvoice*
+    auto init_voice = [&voice,num_sends,num_listeners,listeners_offset,sizeof_voice]() -> ALvoice*
     {
         ALvoice *ret = new (voice) ALvoice{static_cast<size_t>(num_sends)};
+        if(num_listeners > 1)
+        {
+            ret->Listeners = reinterpret_cast<ALvoice::ListenerData*>(
+                reinterpret_cast<char*>(ret) + listeners_offset);
+            for(ALsizei i{1};i < num_listeners;i++)
+                new (&ret->Listeners[i-1]) ALvoice::ListenerData{};
+        }
         voice = reinterpret_cast<ALvoice*>(reinterpret_cast<char*>(voice) + sizeof_voice);
         return ret;
     };
@@ -2858,6 +3213,90 @@ static inline ALCsizei NumAttrsForDevice(ALCdevice *device)
     return 29;
 }
 
+/* Memory held by a playback device's mixing state, in bytes. Buffers, effects,
+ * and filters are sized by the app, so only the device's own storage, its
+ * contexts (including their sources, voices, and event queue), and their
+ * effect slots are counted.
+ */
+struct DeviceMemoryUsage {
+    ALCint64SOFT Device{0};
+    ALCint64SOFT Contexts{0};
+    ALCint64SOFT EffectSlots{0};
+};
+
+static DeviceMemoryUsage GetMemoryUsage(ALCdevice *device)
+{
+    DeviceMemoryUsage usage;
+
+    usage.Device += sizeof(ALCdevice);
+    usage.Device += device->MixBuffer.capacity() * sizeof(device->MixBuffer[0]);
+    if(device->mHrtfState)
+        usage.Device += DirectHrtfState::Sizeof(device->mHrtfState->Chan.size());
+    if(device->Uhj_Encoder) usage.Device += sizeof(Uhj2Encoder);
+    if(device->AmbiDecoder) usage.Device += sizeof(BFormatDec);
+    if(device->Bs2b) usage.Device += sizeof(bs2b);
+    if(device->AmbiUp) usage.Device += sizeof(AmbiUpsampler);
+    if(device->Stablizer) usage.Device += sizeof(FrontStablizer);
+    if(device->Limiter) usage.Device += sizeof(Compressor);
+    for(const auto &output : device->ListenerOuts)
+    {
+        usage.Device += sizeof(ListenerOutput);
+        usage.Device += output->MixBuffer.capacity() * sizeof(output->MixBuffer[0]);
+        if(output->mHrtfState)
+            usage.Device += DirectHrtfState::Sizeof(output->mHrtfState->Chan.size());
+        if(output->Uhj_Encoder) usage.Device += sizeof(Uhj2Encoder);
+        if(output->AmbiDecoder) usage.Device += sizeof(BFormatDec);
+        if(output->Bs2b) usage.Device += sizeof(bs2b);
+        if(output->AmbiUp) usage.Device += sizeof(AmbiUpsampler);
+    }
+
+    ALCcontext *context{device->ContextList.load(std::memory_order_acquire)};
+    for(;context;context = context->next.load(std::memory_order_relaxed))
+    {
+        usage.Contexts += sizeof(ALCcontext);
+        { std::lock_guard<std::mutex> _{context->SourceLock};
+            usage.Contexts += context->SourceList.capacity() * sizeof(SourceSubList);
+            for(const SourceSubList &sublist : context->SourceList)
+            {
+                if(sublist.Sources)
+                    usage.Contexts += 64 * sizeof(ALsource);
+            }
+            const size_t sizeof_voice{VoiceStorageSize(device->NumAuxSends,
+                context->NumListeners)};
+            usage.Contexts += context->MaxVoices * (sizeof(ALvoice*) + sizeof_voice);
+            if(context->ExtraListeners)
+                usage.Contexts += ALCcontext::ALlistenerArray::Sizeof(
+                    context->ExtraListeners->size());
+        }
+        usage.Contexts += context->VoiceClusters.capacity() * sizeof(VoiceCluster);
+        { std::lock_guard<std::mutex> _{context->SubmixBusLock};
+            usage.Contexts += context->SubmixBusList.capacity() * sizeof(ALsubmixbusPtr);
+            for(const ALsubmixbusPtr &bus : context->SubmixBusList)
+            {
+                if(bus)
+                    usage.Contexts += sizeof(ALsubmixbus);
+            }
+        }
+        { std::lock_guard<std::mutex> _{context->EventThrdLock};
+            if(RingBuffer *ring{context->AsyncEvents.get()})
+                usage.Contexts += sizeof(RingBuffer) + (ring->mSizeMask+1)*ring->mElemSize;
+        }
+
+        if(context->DefaultSlot)
+            usage.EffectSlots += sizeof(ALeffectslot);
+        { std::lock_guard<std::mutex> _{context->EffectSlotLock};
+            usage.EffectSlots += context->EffectSlotList.capacity() * sizeof(ALeffectslotPtr);
+            for(const ALeffectslotPtr &slot : context->EffectSlotList)
+            {
+                if(slot)
+                    usage.EffectSlots += sizeof(ALeffectslot);
+            }
+        }
+    }
+
+    return usage;
+}
+
 static ALCsizei GetIntegerv(ALCdevice *device, ALCenum param, ALCsizei size, ALCint *values)
 {
     ALCsizei i;
@@ -2893,6 +3332,9 @@ static ALCsizei GetIntegerv(ALCdevice *device, ALCenum param, ALCsizei size, ALC
             case ALC_AMBISONIC_SCALING_SOFT:
             case ALC_AMBISONIC_ORDER_SOFT:
             case ALC_MAX_AMBISONIC_ORDER_SOFT:
+            case ALC_DEVICE_MEMORY_SOFT:
+            case ALC_CONTEXTS_MEMORY_SOFT:
+            case ALC_EFFECT_SLOTS_MEMORY_SOFT:
                 alcSetError(nullptr, ALC_INVALID_DEVICE);
                 return 0;
 
@@ -3162,6 +3604,17 @@ static ALCsizei GetIntegerv(ALCdevice *device, ALCenum param, ALCsizei size, ALC
             values[0] = MAX_AMBI_ORDER;
             return 1;
 
+        case ALC_DEVICE_MEMORY_SOFT:
+        case ALC_CONTEXTS_MEMORY_SOFT:
+        case ALC_EFFECT_SLOTS_MEMORY_SOFT:
+            { std::lock_guard<std::mutex> _{device->StateLock};
+                const DeviceMemoryUsage usage{GetMemoryUsage(device)};
+                const ALCint64SOFT bytes{(param == ALC_DEVICE_MEMORY_SOFT) ? usage.Device :
+                    (param == ALC_CONTEXTS_MEMORY_SOFT) ? usage.Contexts : usage.EffectSlots};
+                values[0] = static_cast<ALCint>(mini64(bytes, std::numeric_limits<ALCint>::max()));
+            }
+            return 1;
+
         default:
             alcSetError(device, ALC_INVALID_ENUM);
             return 0;
@@ -3296,6 +3749,16 @@ ALC_API void ALC_APIENTRY alcGetInteger64vSOFT(ALCdevice *device, ALCenum pname,
                 }
                 break;
 
+            case ALC_DEVICE_MEMORY_SOFT:
+            case ALC_CONTEXTS_MEMORY_SOFT:
+            case ALC_EFFECT_SLOTS_MEMORY_SOFT:
+                { std::lock_guard<std::mutex> _{dev->StateLock};
+                    const DeviceMemoryUsage usage{GetMemoryUsage(dev.get())};
+                    *values = (pname == ALC_DEVICE_MEMORY_SOFT) ? usage.Device :
+                        (pname == ALC_CONTEXTS_MEMORY_SOFT) ? usage.Contexts : usage.EffectSlots;
+                }
+                break;
+
             case ALC_DEVICE_CLOCK_LATENCY_SOFT:
                 if(size < 2)
                     alcSetError(dev.get(), ALC_INVALID_VALUE);
@@ -3415,6 +3878,25 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
         alcSetError(dev.get(), ALC_INVALID_DEVICE);
         return nullptr;
     }
+
+    /* Additional listeners need their own direct path in each voice, so the
+     * number is fixed when creating the context. Each renders to its own
+     * output, which the app can only read from a loopback device.
+     */
+    ALsizei num_listeners{1};
+    for(ALCsizei attrIdx{0};attrList && attrList[attrIdx];attrIdx += 2)
+    {
+        if(attrList[attrIdx] == ALC_MAX_LISTENERS_SOFT)
+            num_listeners = clampi(attrList[attrIdx+1], 1, MAX_LISTENERS);
+    }
+    if(num_listeners > 1 && dev->Type != Loopback)
+    {
+        listlock.unlock();
+        WARN("Additional listeners require a loopback device\n");
+        alcSetError(dev.get(), ALC_INVALID_VALUE);
+        return nullptr;
+    }
+
     std::unique_lock<std::mutex> statelock{dev->StateLock};
     listlock.unlock();
 
@@ -3433,7 +3915,6 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
 
         return nullptr;
     }
-    AllocateVoices(ALContext.get(), 256, dev->NumAuxSends);
 
     if(DefaultEffect.type != AL_EFFECT_NULL && dev->Type == Playback)
     {
@@ -3447,6 +3928,26 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
         }
     }
 
+    ALContext->NumListeners = num_listeners;
+    if(ALContext->NumListeners > 1)
+    {
+        const size_t count{static_cast<size_t>(ALContext->NumListeners - 1)};
+        void *ptr{al_calloc(alignof(ALCcontext::ALlistenerArray),
+            ALCcontext::ALlistenerArray::Sizeof(count))};
+        ALContext->ExtraListeners.reset(new (ptr) ALCcontext::ALlistenerArray{count});
+
+        if(dev->ListenerOuts.size() < count)
+        {
+            BackendLockGuard _{*dev->Backend};
+            while(dev->ListenerOuts.size() < count)
+            {
+                dev->ListenerOuts.emplace_back(al::make_unique<ListenerOutput>());
+                aluInitListenerOutput(dev.get(), dev->ListenerOuts.back().get());
+            }
+        }
+        TRACE("Created context with %d listeners\n", ALContext->NumListeners);
+    }
+
     InitContext(ALContext.get());
 
     ALfloat valf{};
@@ -3463,7 +3964,24 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
             TRACE("volume-adjust gain: %f\n", ALContext->GainBoost);
         }
     }
-    UpdateListenerProps(ALContext.get());
+
+    ALint sectors{0};
+    if(ConfigValueInt(dev->DeviceName.c_str(), nullptr, "voice-cluster-sectors", &sectors) &&
+       sectors > 0)
+    {
+        ALContext->ClusterSectors = mini(sectors, 64);
+        ALContext->VoiceClusters.resize(3 * ALContext->ClusterSectors);
+
+        ALContext->ClusterDistance = 50.0f;
+        if(ConfigValueFloat(dev->DeviceName.c_str(), nullptr, "voice-cluster-distance", &valf))
+            ALContext->ClusterDistance = valf;
+        if(ConfigValueFloat(dev->DeviceName.c_str(), nullptr, "voice-cluster-gain", &valf))
+            ALContext->ClusterGain = clampf(valf, 0.0f, 1.0f);
+        TRACE("Voice clustering: %d sectors, distance %f, gain %f\n", ALContext->ClusterSectors,
+            ALContext->ClusterDistance, ALContext->ClusterGain);
+    }
+    for(ALsizei i{0};i < ALContext->NumListeners;i++)
+        UpdateListenerProps(&ALContext->getListener(i), ALContext.get());
 
     {
         ALCcontext *head = dev->ContextList.load();
@@ -4134,6 +4652,26 @@ FORCE_ALIGN ALC_API void ALC_APIENTRY alcRenderSamplesSOFT(ALCdevice *device, AL
     }
 }
 
+/* alcRenderListenerSamplesSOFT
+ *
+ * Renders some samples like alcRenderSamplesSOFT, writing the output of each
+ * of the contexts' listeners to its own buffer. The first buffer gets the
+ * main listener's output, and buffers may be null to discard the output.
+ */
+FORCE_ALIGN ALC_API void ALC_APIENTRY alcRenderListenerSamplesSOFT(ALCdevice *device, ALCsizei numbuffers, ALCvoid **buffers, ALCsizei samples)
+{
+    DeviceRef dev{VerifyDevice(device)};
+    if(!dev || dev->Type != Loopback)
+        alcSetError(dev.get(), ALC_INVALID_DEVICE);
+    else if(numbuffers < 1 || numbuffers > MAX_LISTENERS || !buffers || samples < 0)
+        alcSetError(dev.get(), ALC_INVALID_VALUE);
+    else
+    {
+        BackendLockGuard _{*device->Backend};
+        aluMixListenerData(dev.get(), buffers, numbuffers, samples);
+    }
+}
+
 
 /************************************************
  * ALC DSP pause/resume functions
@@ -4217,6 +4755,144 @@ ALC_API const ALCchar* ALC_APIENTRY alcGetStringiSOFT(ALCdevice *device, ALCenum
     return nullptr;
 }
 
+/* alcReloadConfigSOFT
+ *
+ * Re-reads the config files, applying what can be changed on the fly to
+ * existing devices.
+ */
+ALC_API ALCboolean ALC_APIENTRY alcReloadConfigSOFT(void)
+{
+    DO_INITCONFIG();
+    ReloadALConfig();
+    return ALC_TRUE;
+}
+
+/* ReconfigureRunningDevice
+ *
+ * Tries to apply the attribute list to a running playback device without
+ * stopping it. The new renderer and its mixing buffers are set up on a staging
+ * device while the current one keeps mixing. The mixer then fades out the
+ * current output, the renderers are swapped between updates, and the mixer
+ * fades in the new output after recalculating the voice and effect targets
+ * for it. Any updates mixed between the fade out and the swap are silent, but
+ * hold the voices and effects in place so no audio is skipped.
+ *
+ * Returns false, leaving the device untouched, if the settings need the
+ * backend to be reset (a different sample rate or channel configuration, or a
+ * different number of auxiliary sends).
+ */
+static bool ReconfigureRunningDevice(ALCdevice *device, const ALCint *attrList)
+{
+    const char *devname{device->DeviceName.c_str()};
+
+    DeviceAttribs attrs{device};
+    if(attrList && attrList[0])
+        ParseDeviceAttribs(attrs, attrList);
+
+    ALCuint freq{attrs.freq};
+    ConfigValueUInt(devname, nullptr, "frequency", &freq);
+    if(freq > 0)
+    {
+        freq = maxi(freq, MIN_OUTPUT_RATE);
+        if(freq != device->Frequency)
+            return false;
+    }
+    if(GetAuxSendCount(devname, attrs.numSends) != device->NumAuxSends)
+        return false;
+
+    DeviceRef staging{new ALCdevice{Playback}};
+    staging->Frequency = device->Frequency;
+    staging->UpdateSize = device->UpdateSize;
+    staging->NumUpdates = device->NumUpdates;
+    staging->FmtChans = device->FmtChans;
+    staging->FmtType = device->FmtType;
+    staging->IsHeadphones = device->IsHeadphones;
+    staging->mAmbiOrder = device->mAmbiOrder;
+    staging->mAmbiLayout = device->mAmbiLayout;
+    staging->mAmbiScale = device->mAmbiScale;
+    staging->DeviceName = device->DeviceName;
+    staging->HrtfList = device->HrtfList;
+    std::copy(std::begin(device->RealOut.ChannelName), std::end(device->RealOut.ChannelName),
+        std::begin(staging->RealOut.ChannelName));
+
+    HrtfRequestMode hrtf_userreq{Hrtf_Default};
+    RequestHrtfFormat(staging.get(), hrtf_userreq, attrs.hrtf_appreq, attrs.hrtf_id);
+    if(staging->FmtChans != device->FmtChans || staging->Frequency != device->Frequency)
+        return false;
+
+    TRACE("Reconfiguring running device: %s, %s, %uhz, %u update size x%d\n",
+        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
+        device->Frequency, device->UpdateSize, device->NumUpdates
+    );
+
+    InitDeviceRenderer(staging.get(), attrs.hrtf_id, attrs.hrtf_appreq, hrtf_userreq);
+
+    staging->LimiterState = attrs.gainLimiter;
+    UpdateDitherAndLimiter(staging.get());
+
+    aluSelectPostProcess(staging.get());
+
+    /* Have the mixer fade out the current output. Give it a few updates'
+     * worth of time, after which the renderers are swapped regardless.
+     */
+    const auto update_time = std::chrono::nanoseconds{std::chrono::seconds{device->UpdateSize}} /
+        device->Frequency;
+    const auto fade_timeout = std::chrono::steady_clock::now() +
+        update_time*(device->NumUpdates*2);
+    device->mRenderFade.store(RenderFade::FadeOut, std::memory_order_release);
+    while(device->mRenderFade.load(std::memory_order_acquire) == RenderFade::FadeOut &&
+          std::chrono::steady_clock::now() < fade_timeout)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+    {
+        BackendLockGuard _{*device->Backend};
+        std::swap(device->MixBuffer, staging->MixBuffer);
+        std::swap(device->Dry, staging->Dry);
+        std::swap(device->NumChannelsPerOrder, staging->NumChannelsPerOrder);
+        std::swap(device->FOAOut, staging->FOAOut);
+        std::swap(device->RealOut, staging->RealOut);
+
+        std::swap(device->mHrtfState, staging->mHrtfState);
+        std::swap(device->mHrtf, staging->mHrtf);
+        std::swap(device->HrtfName, staging->HrtfName);
+        std::swap(device->HrtfList, staging->HrtfList);
+        device->HrtfStatus = staging->HrtfStatus;
+        device->mHrtfLod = staging->mHrtfLod;
+        device->mHrtfInterp = staging->mHrtfInterp;
+        device->mRenderMode = staging->mRenderMode;
+        device->AvgSpeakerDist = staging->AvgSpeakerDist;
+
+        std::swap(device->Uhj_Encoder, staging->Uhj_Encoder);
+        std::swap(device->AmbiDecoder, staging->AmbiDecoder);
+        std::swap(device->Bs2b, staging->Bs2b);
+        std::swap(device->AmbiUp, staging->AmbiUp);
+        device->PostProcess = staging->PostProcess;
+        std::swap(device->Stablizer, staging->Stablizer);
+        std::swap(device->Limiter, staging->Limiter);
+        std::swap(device->ChannelDelay, staging->ChannelDelay);
+
+        device->LimiterState = staging->LimiterState;
+        device->DitherDepth = staging->DitherDepth;
+        device->FixedLatency = staging->FixedLatency;
+
+        for(auto &output : device->ListenerOuts)
+            aluInitListenerOutput(device, output.get());
+
+        /* The next update recalculates everything targeting the new output. */
+        device->mRenderFade.store(RenderFade::FadeIn, std::memory_order_release);
+    }
+    device->Flags |= staging->Flags&(DEVICE_CHANNELS_REQUEST|DEVICE_FREQUENCY_REQUEST);
+
+    SetSourceLimits(device, devname, attrs.numMono, attrs.numStereo);
+    TRACE("Max sources: %d (%d + %d), effect slots: %d, sends: %d\n",
+          device->SourcesMax, device->NumMonoSources, device->NumStereoSources,
+          device->AuxiliaryEffectSlotMax, device->NumAuxSends);
+    TRACE("Fixed device latency: %ldns\n", (long)device->FixedLatency.count());
+
+    /* The staging device now holds the old renderer, which is freed here. */
+    return true;
+}
+
 /* alcResetDeviceSOFT
  *
  * Resets the given device output, using the specified attribute list.
@@ -4234,8 +4910,18 @@ ALC_API ALCboolean ALC_APIENTRY alcResetDeviceSOFT(ALCdevice *device, const ALCi
     std::lock_guard<std::mutex> _{dev->StateLock};
     listlock.unlock();
 
-    /* Force the backend to stop mixing first since we're resetting. Also reset
-     * the connected state so lost devices can attempt recover.
+    /* If the device is running, try to apply the new settings without stopping
+     * it, to avoid a gap in the output.
+     */
+    if(dev->Type == Playback && (dev->Flags&DEVICE_RUNNING) &&
+       dev->Connected.load(std::memory_order_acquire))
+    {
+        if(ReconfigureRunningDevice(dev.get(), attribs))
+            return ALC_TRUE;
+    }
+
+    /* Otherwise, force the backend to stop mixing first since we're resetting.
+     * Also reset the connected state so lost devices can attempt recover.
      */
     if((dev->Flags&DEVICE_RUNNING))
         dev->Backend->stop();
@@ -4250,3 +4936,99 @@ ALC_API ALCboolean ALC_APIENTRY alcResetDeviceSOFT(ALCdevice *device, const ALCi
         aluHandleDisconnect(dev.get(), "Device start failure");
     return ALC_FALSE;
 }
+
+/* alcReopenDeviceSOFT
+ *
+ * Moves the given playback device's output to the named device (or the
+ * default device if null), keeping its contexts and all of their objects. The
+ * attribute list is applied as with alcResetDeviceSOFT. Without attributes,
+ * the renderer is only rebuilt if the new output needs a different format.
+ */
+ALC_API ALCboolean ALC_APIENTRY alcReopenDeviceSOFT(ALCdevice *device,
+    const ALCchar *deviceName, const ALCint *attribs)
+{
+    if(deviceName && (!deviceName[0] || strcasecmp(deviceName, alcDefaultName) == 0 ||
+        strcasecmp(deviceName, "openal-soft") == 0))
+        deviceName = nullptr;
+
+    std::unique_lock<std::recursive_mutex> listlock{ListLock};
+    DeviceRef dev{VerifyDevice(device)};
+    if(!dev || dev->Type != Playback)
+    {
+        listlock.unlock();
+        alcSetError(dev.get(), ALC_INVALID_DEVICE);
+        return ALC_FALSE;
+    }
+    std::lock_guard<std::mutex> _{dev->StateLock};
+    /* Hold off source calls that lock the backend until it's replaced. */
+    std::unique_lock<std::mutex> swaplock{dev->BackendSwapLock};
+
+    /* Close the current output before opening the new one, since some
+     * backends can't have the same device open twice. A backend that doesn't
+     * output anything stands in meanwhile, so the device always has one. If
+     * the new output fails to open, the old one is opened again so playback
+     * can continue.
+     */
+    const bool wasRunning{(dev->Flags&DEVICE_RUNNING) != 0};
+    if(wasRunning)
+        dev->Backend->stop();
+    dev->Flags &= ~DEVICE_RUNNING;
+
+    const std::string oldName{dev->DeviceName};
+    BackendPtr placeholder{LoopbackBackendFactory::getFactory().createBackend(dev.get(),
+        BackendType::Playback)};
+    placeholder->open(oldName.c_str());
+    dev->Backend = std::move(placeholder);
+
+    BackendFactory &factory = PlaybackBackend.getFactory();
+    BackendPtr newbackend{factory.createBackend(dev.get(), BackendType::Playback)};
+    ALCenum err{newbackend ? newbackend->open(deviceName) : ALC_OUT_OF_MEMORY};
+    if(err != ALC_NO_ERROR)
+    {
+        WARN("Failed to reopen device %p on \"%s\"\n", dev.get(),
+            deviceName ? deviceName : "(default)");
+        alcSetError(dev.get(), err);
+
+        newbackend = factory.createBackend(dev.get(), BackendType::Playback);
+        if(!newbackend || newbackend->open(oldName.c_str()) != ALC_NO_ERROR)
+        {
+            /* The old output is gone too. Leave the device disconnected on
+             * the stand-in until it's reopened successfully.
+             */
+            ERR("Failed to restore device %p on \"%s\"\n", dev.get(), oldName.c_str());
+            dev->DeviceName = oldName;
+            swaplock.unlock();
+            listlock.unlock();
+            aluHandleDisconnect(dev.get(), "Failed to reopen device");
+            return ALC_FALSE;
+        }
+        dev->Backend = std::move(newbackend);
+        swaplock.unlock();
+        listlock.unlock();
+
+        if(dev->RealOut.Buffer && ResetDeviceOutput(dev.get()) != ALC_NO_ERROR)
+            aluHandleDisconnect(dev.get(), "Device start failure");
+        return ALC_FALSE;
+    }
+    listlock.unlock();
+
+    dev->Backend = std::move(newbackend);
+    swaplock.unlock();
+    dev->Connected.store(true);
+    TRACE("Reopened device %p, \"%s\"\n", dev.get(), dev->DeviceName.c_str());
+
+    /* A device without a renderer gets set up when its first context is
+     * created.
+     */
+    if(!dev->RealOut.Buffer)
+        return ALC_TRUE;
+
+    err = (attribs && attribs[0]) ? UpdateDeviceParams(dev.get(), attribs) :
+        ResetDeviceOutput(dev.get());
+    if(LIKELY(err == ALC_NO_ERROR)) return ALC_TRUE;
+
+    alcSetError(dev.get(), err);
+    if(err == ALC_INVALID_DEVICE)
+        aluHandleDisconnect(dev.get(), "Device start failure");
+    return ALC_FALSE;
+}
@@ -41,7 +41,11 @@
 
 #include <vector>
 #include <string>
+#include <mutex>
+#include <utility>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "alMain.h"
 #include "alconfig.h"
@@ -51,16 +55,23 @@
 
 namespace {
 
-struct ConfigEntry {
-    std::string key;
-    std::string value;
+using ConfigMap = std::unordered_map<std::string,std::string>;
 
-    template<typename T0, typename T1>
-    ConfigEntry(T0&& key_, T1&& val_)
-      : key{std::forward<T0>(key_)}, value{std::forward<T1>(val_)}
-    { }
+/* Guards the current options and the change callbacks. */
+std::mutex ConfigLock;
+/* Values returned by GetConfigValue may still be in use after a reload, so
+ * option values are kept in a pool that's never shrunk. Elements of an
+ * unordered_set don't move when it grows, and reloading the same (or a
+ * previously seen) value reuses the existing string.
+ */
+std::unordered_set<std::string> ConfValues;
+std::unordered_map<std::string,const char*> ConfOpts;
+
+struct ConfigCallback {
+    ConfigChangedFunc func;
+    void *userptr;
 };
-al::vector<ConfigEntry> ConfOpts;
+al::vector<ConfigCallback> ConfigCallbacks;
 
 
 std::string &lstrip(std::string &line)
@@ -135,7 +146,7 @@ std:: string expdup(const char *str)
     return output;
 }
 
-void LoadConfigFromFile(std::istream &f)
+void LoadConfigFromFile(ConfigMap &opts, std::istream &f)
 {
     std::string curSection;
     std::string buffer;
@@ -263,30 +274,22 @@ void LoadConfigFromFile(std::istream &f)
         while(!fullKey.empty() && std::isspace(fullKey.back()))
             fullKey.pop_back();
 
-        /* Check if we already have this option set */
-        auto ent = std::find_if(ConfOpts.begin(), ConfOpts.end(),
-            [&fullKey](const ConfigEntry &entry) -> bool
-            { return entry.key == fullKey; }
-        );
-        if(ent != ConfOpts.end())
-            ent->value = expdup(value);
-        else
-        {
-            ConfOpts.emplace_back(std::move(fullKey), expdup(value));
-            ent = ConfOpts.end()-1;
-        }
+        /* Later files override options already set. */
+        auto &ent = opts[fullKey];
+        ent = expdup(value);
 
-        TRACE("found '%s' = '%s'\n", ent->key.c_str(), ent->value.c_str());
+        TRACE("found '%s' = '%s'\n", fullKey.c_str(), ent.c_str());
     }
-    ConfOpts.shrink_to_fit();
 }
 
 } // namespace
 
 
 #ifdef _WIN32
-void ReadALConfig(void) noexcept
+static ConfigMap LoadConfigFiles()
 {
+    ConfigMap opts;
+
     WCHAR buffer[MAX_PATH];
     if(SHGetSpecialFolderPathW(nullptr, buffer, CSIDL_APPDATA, FALSE) != FALSE)
     {
@@ -296,7 +299,7 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", filepath.c_str());
         al::ifstream f{filepath};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
 
     std::string ppath{GetProcBinary().path};
@@ -306,7 +309,7 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", ppath.c_str());
         al::ifstream f{ppath};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
 
     const WCHAR *str{_wgetenv(L"ALSOFT_CONF")};
@@ -317,18 +320,22 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", filepath.c_str());
         al::ifstream f{filepath};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
+
+    return opts;
 }
 #else
-void ReadALConfig(void) noexcept
+static ConfigMap LoadConfigFiles()
 {
+    ConfigMap opts;
+
     const char *str{"/etc/openal/alsoft.conf"};
 
     TRACE("Loading config %s...\n", str);
     al::ifstream f{str};
     if(f.is_open())
-        LoadConfigFromFile(f);
+        LoadConfigFromFile(opts, f);
     f.close();
 
     if(!(str=getenv("XDG_CONFIG_DIRS")) || str[0] == 0)
@@ -364,7 +371,7 @@ void ReadALConfig(void) noexcept
             TRACE("Loading config %s...\n", fname.c_str());
             al::ifstream f{fname};
             if(f.is_open())
-                LoadConfigFromFile(f);
+                LoadConfigFromFile(opts, f);
         }
         fname.clear();
     }
@@ -381,7 +388,7 @@ void ReadALConfig(void) noexcept
         {
             al::ifstream f{reinterpret_cast<char*>(fileName)};
             if(f.is_open())
-                LoadConfigFromFile(f);
+                LoadConfigFromFile(opts, f);
         }
     }
 #endif
@@ -395,7 +402,7 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", fname.c_str());
         al::ifstream f{fname};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
 
     if((str=getenv("XDG_CONFIG_HOME")) != nullptr && str[0] != 0)
@@ -419,7 +426,7 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", fname.c_str());
         al::ifstream f{fname};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
 
     std::string ppath{GetProcBinary().path};
@@ -431,7 +438,7 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", ppath.c_str());
         al::ifstream f{ppath};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
 
     if((str=getenv("ALSOFT_CONF")) != nullptr && *str)
@@ -439,56 +446,96 @@ void ReadALConfig(void) noexcept
         TRACE("Loading config %s...\n", str);
         al::ifstream f{str};
         if(f.is_open())
-            LoadConfigFromFile(f);
+            LoadConfigFromFile(opts, f);
     }
+
+    return opts;
 }
 #endif
 
+void ReadALConfig(void) noexcept
+{
+    ConfigMap opts{LoadConfigFiles()};
+
+    std::lock_guard<std::mutex> _{ConfigLock};
+    ConfOpts.clear();
+    for(auto &opt : opts)
+    {
+        auto value = ConfValues.emplace(std::move(opt.second)).first;
+        ConfOpts.emplace(opt.first, value->c_str());
+    }
+}
+
+void ReloadALConfig(void) noexcept
+{
+    TRACE("Reloading config\n");
+    ReadALConfig();
+
+    /* Copy the callbacks so they can be called without holding the lock,
+     * letting them read the new options.
+     */
+    al::vector<ConfigCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> _{ConfigLock};
+        callbacks = ConfigCallbacks;
+    }
+    for(const ConfigCallback &callback : callbacks)
+        callback.func(callback.userptr);
+}
+
+void AddConfigChangedCallback(ConfigChangedFunc func, void *userptr)
+{
+    std::lock_guard<std::mutex> _{ConfigLock};
+    ConfigCallbacks.emplace_back(ConfigCallback{func, userptr});
+}
+
 const char *GetConfigValue(const char *devName, const char *blockName, const char *keyName, const char *def)
 {
     if(!keyName)
         return def;
 
-    std::string key;
-    if(blockName && strcasecmp(blockName, "general") != 0)
+    std::lock_guard<std::mutex> _{ConfigLock};
+    while(1)
     {
-        key = blockName;
-        if(devName)
+        std::string key;
+        if(blockName && strcasecmp(blockName, "general") != 0)
         {
+            key = blockName;
+            if(devName)
+            {
+                key += '/';
+                key += devName;
+            }
             key += '/';
-            key += devName;
+            key += keyName;
         }
-        key += '/';
-        key += keyName;
-    }
-    else
-    {
-        if(devName)
+        else
         {
-            key = devName;
-            key += '/';
+            if(devName)
+            {
+                key = devName;
+                key += '/';
+            }
+            key += keyName;
         }
-        key += keyName;
-    }
 
-    auto iter = std::find_if(ConfOpts.cbegin(), ConfOpts.cend(),
-        [&key](const ConfigEntry &entry) -> bool
-        { return entry.key == key; }
-    );
-    if(iter != ConfOpts.cend())
-    {
-        TRACE("Found %s = \"%s\"\n", key.c_str(), iter->value.c_str());
-        if(!iter->value.empty())
-            return iter->value.c_str();
-        return def;
-    }
+        auto iter = ConfOpts.find(key);
+        if(iter != ConfOpts.cend())
+        {
+            TRACE("Found %s = \"%s\"\n", key.c_str(), iter->second);
+            if(iter->second[0])
+                return iter->second;
+            return def;
+        }
 
-    if(!devName)
-    {
-        TRACE("Key %s not found\n", key.c_str());
-        return def;
+        if(!devName)
+        {
+            TRACE("Key %s not found\n", key.c_str());
+            return def;
+        }
+        /* Fall back to the option without the device name. */
+        devName = nullptr;
     }
-    return GetConfigValue(nullptr, blockName, keyName, def);
 }
 
 int ConfigValueExists(const char *devName, const char *blockName, const char *keyName)
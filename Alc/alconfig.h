@@ -9,6 +9,14 @@ extern "C" {
 #endif
 
 void ReadALConfig(void) NOEXCEPT;
+/* Reads the config files again, replacing the current options, and calls the
+ * registered change callbacks. Pointers previously returned for option values
+ * remain valid.
+ */
+void ReloadALConfig(void) NOEXCEPT;
+
+typedef void (*ConfigChangedFunc)(void *userptr);
+void AddConfigChangedCallback(ConfigChangedFunc func, void *userptr);
 
 int ConfigValueExists(const char *devName, const char *blockName, const char *keyName);
 const char *GetConfigValue(const char *devName, const char *blockName, const char *keyName, const char *def);
@@ -18,6 +18,8 @@
 #include "alnumeric.h"
 
 #include "alListener.h"
+#include "alu.h"
+#include "filters/biquad.h"
 
 
 struct ALsource;
@@ -26,6 +28,8 @@ struct ALcontextProps;
 struct ALlistenerProps;
 struct ALvoiceProps;
 struct ALeffectslotProps;
+struct ALsubmixbus;
+struct ALsubmixbusProps;
 struct ALvoice;
 struct RingBuffer;
 
@@ -60,6 +64,7 @@ struct SourceSubList {
  * or two (let alone 64), so hold them individually.
  */
 using ALeffectslotPtr = std::unique_ptr<ALeffectslot>;
+using ALsubmixbusPtr = std::unique_ptr<ALsubmixbus>;
 
 struct ALCcontext {
     RefCount ref{1u};
@@ -71,6 +76,9 @@ struct ALCcontext {
     al::vector<ALeffectslotPtr> EffectSlotList;
     std::mutex EffectSlotLock;
 
+    al::vector<ALsubmixbusPtr> SubmixBusList;
+    std::mutex SubmixBusLock;
+
     std::atomic<ALenum> LastError{AL_NO_ERROR};
 
     DistanceModel mDistanceModel{DistanceModel::Default};
@@ -103,14 +111,35 @@ struct ALCcontext {
     std::atomic<ALlistenerProps*> FreeListenerProps{nullptr};
     std::atomic<ALvoiceProps*> FreeVoiceProps{nullptr};
     std::atomic<ALeffectslotProps*> FreeEffectslotProps{nullptr};
+    std::atomic<ALsubmixbusProps*> FreeSubmixBusProps{nullptr};
 
     ALvoice **Voices{nullptr};
     std::atomic<ALsizei> VoiceCount{0};
     ALsizei MaxVoices{0};
 
+    /* Direction clusters for distant voices, with voice-cluster-sectors
+     * azimuth sectors in each of three elevation bands. Empty when clustering
+     * is disabled.
+     */
+    al::vector<VoiceCluster,16> VoiceClusters;
+    ALsizei ClusterSectors{0};
+    /* Voices at least this far away (in meters), or quieter than this gain,
+     * are clustered.
+     */
+    ALfloat ClusterDistance{0.0f};
+    ALfloat ClusterGain{0.0f};
+    /* The number of active clusters and clustered voices from the last mix. */
+    std::atomic<ALuint> ActiveClusters{0u};
+    std::atomic<ALuint> ClusteredVoices{0u};
+
     using ALeffectslotArray = al::FlexArray<ALeffectslot*>;
     std::atomic<ALeffectslotArray*> ActiveAuxSlots{nullptr};
 
+    using ALsubmixbusArray = al::FlexArray<ALsubmixbus*>;
+    std::atomic<ALsubmixbusArray*> ActiveSubmixBuses{nullptr};
+
+    /* The event thread and queue are started on demand (see StartEventThrd). */
+    std::mutex EventThrdLock;
     std::thread EventThread;
     al::semaphore EventSem;
     std::unique_ptr<RingBuffer> AsyncEvents;
@@ -129,12 +158,32 @@ struct ALCcontext {
 
     ALlistener Listener{};
 
+    /* Any additional listeners requested with ALC_MAX_LISTENERS_SOFT. These
+     * hear the same voices as the main listener from their own viewpoint,
+     * sharing the loaded and resampled samples, and mix to the device's
+     * matching ListenerOuts. The main listener alone determines the effect
+     * sends and doppler shift.
+     */
+    using ALlistenerArray = al::FlexArray<ALlistener>;
+    std::unique_ptr<ALlistenerArray> ExtraListeners;
+    ALsizei NumListeners{1};
+    /* The listener the alListener* functions apply to. */
+    ALsizei SelectedListener{0};
+
+    /* Filter coefficients shared by the context's voices. Only used by the
+     * mixer when updating voices.
+     */
+    BiquadCache FilterCache;
+
 
     ALCcontext(ALCdevice *device);
     ALCcontext(const ALCcontext&) = delete;
     ALCcontext& operator=(const ALCcontext&) = delete;
     ~ALCcontext();
 
+    ALlistener &getListener(ALsizei idx) noexcept
+    { return (idx == 0) ? Listener : (*ExtraListeners)[idx-1]; }
+
     static constexpr inline const char *CurrentPrefix() noexcept { return "ALCcontext::"; }
     DEF_NEWDEL(ALCcontext)
 };
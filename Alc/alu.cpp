@@ -38,6 +38,7 @@
 #include "alBuffer.h"
 #include "alListener.h"
 #include "alAuxEffectSlot.h"
+#include "alSubmixBus.h"
 #include "alu.h"
 #include "bs2b.h"
 #include "hrtf.h"
@@ -50,7 +51,7 @@
 #include "mixer/defs.h"
 #include "fpu_modes.h"
 #include "cpu_caps.h"
-#include "bsinc_inc.h"
+#include "bsinc_tables.h"
 
 
 namespace {
@@ -182,6 +183,55 @@ void ProcessBs2b(ALCdevice *device, const ALsizei SamplesToDo)
                     device->RealOut.Buffer[ridx], SamplesToDo);
 }
 
+
+/* Gets an additional listener's buffer for the given device mixing buffer,
+ * which has the same channels in the listener's copy.
+ */
+ALfloat (*GetListenerBuffer(const ALCdevice *device, ListenerOutput *output,
+    const ALfloat (*buffer)[BUFFERSIZE]) noexcept)[BUFFERSIZE]
+{
+    const ALfloat (*base)[BUFFERSIZE]{&reinterpret_cast<const ALfloat(&)[BUFFERSIZE]>(
+        device->MixBuffer[0])};
+    return &reinterpret_cast<ALfloat(&)[BUFFERSIZE]>(output->MixBuffer[0]) + (buffer-base);
+}
+
+/* Applies the device's post-process to an additional listener's output, using
+ * the listener's copy of the state.
+ */
+void ProcessListenerOutput(const ALCdevice *device, ListenerOutput *output,
+    const ALsizei SamplesToDo)
+{
+    ALfloat (*DryBuffer)[BUFFERSIZE]{GetListenerBuffer(device, output, device->Dry.Buffer)};
+    ALfloat (*FOABuffer)[BUFFERSIZE]{GetListenerBuffer(device, output, device->FOAOut.Buffer)};
+    ALfloat (*RealBuffer)[BUFFERSIZE]{GetListenerBuffer(device, output, device->RealOut.Buffer)};
+    const int lidx{(device->RealOut.ChannelName[0]==FrontLeft) ? 0 : 1};
+    const int ridx{(device->RealOut.ChannelName[0]==FrontLeft) ? 1 : 0};
+
+    if(DirectHrtfState *state{output->mHrtfState.get()})
+    {
+        if(AmbiUpsampler *ambiup{output->AmbiUp.get()})
+            ambiup->process(DryBuffer, device->Dry.NumChannels, FOABuffer,
+                device->FOAOut.NumChannels, SamplesToDo);
+        MixDirectHrtf(RealBuffer[lidx], RealBuffer[ridx], DryBuffer, state,
+            device->Dry.NumChannels, SamplesToDo);
+        state->Offset += SamplesToDo;
+    }
+    else if(BFormatDec *ambidec{output->AmbiDecoder.get()})
+    {
+        if(DryBuffer != FOABuffer)
+            ambidec->upSample(DryBuffer, device->Dry.NumChannels, FOABuffer,
+                device->FOAOut.NumChannels, SamplesToDo);
+        ambidec->process(RealBuffer, device->RealOut.NumChannels, DryBuffer, SamplesToDo);
+    }
+    else if(AmbiUpsampler *ambiup{output->AmbiUp.get()})
+        ambiup->process(RealBuffer, device->RealOut.NumChannels, FOABuffer,
+            device->FOAOut.NumChannels, SamplesToDo);
+    else if(Uhj2Encoder *uhj2enc{output->Uhj_Encoder.get()})
+        uhj2enc->encode(RealBuffer[lidx], RealBuffer[ridx], DryBuffer, SamplesToDo);
+    else if(bs2b *crossfeed{output->Bs2b.get()})
+        bs2b_cross_feed(crossfeed, RealBuffer[lidx], RealBuffer[ridx], SamplesToDo);
+}
+
 } // namespace
 
 void aluInit(void)
@@ -243,6 +293,22 @@ void BsincPrepare(const ALuint increment, BsincState *state, const BSincTable *t
     state->filter = table->Tab + table->filterOffset[si];
 }
 
+const BSincTable *GetBSincTable(Resampler resampler)
+{
+    switch(resampler)
+    {
+        case BSinc8Resampler: return &bsinc8;
+        case BSinc12Resampler: return &bsinc12;
+        case BSinc24Resampler: return &bsinc24;
+        case BSinc48Resampler: return &bsinc48;
+        case PointResampler:
+        case LinearResampler:
+        case FIR4Resampler:
+            break;
+    }
+    return nullptr;
+}
+
 
 namespace {
 
@@ -307,26 +373,27 @@ bool CalcContextParams(ALCcontext *Context)
     ALcontextProps *props{Context->Update.exchange(nullptr, std::memory_order_acq_rel)};
     if(!props) return false;
 
-    ALlistener &Listener = Context->Listener;
-    Listener.Params.MetersPerUnit = props->MetersPerUnit;
+    for(ALsizei i{0};i < Context->NumListeners;i++)
+    {
+        ALlistener &Listener = Context->getListener(i);
+        Listener.Params.MetersPerUnit = props->MetersPerUnit;
 
-    Listener.Params.DopplerFactor = props->DopplerFactor;
-    Listener.Params.SpeedOfSound = props->SpeedOfSound * props->DopplerVelocity;
-    if(!OverrideReverbSpeedOfSound)
-        Listener.Params.ReverbSpeedOfSound = Listener.Params.SpeedOfSound *
-                                             Listener.Params.MetersPerUnit;
+        Listener.Params.DopplerFactor = props->DopplerFactor;
+        Listener.Params.SpeedOfSound = props->SpeedOfSound * props->DopplerVelocity;
+        if(!OverrideReverbSpeedOfSound)
+            Listener.Params.ReverbSpeedOfSound = Listener.Params.SpeedOfSound *
+                                                 Listener.Params.MetersPerUnit;
 
-    Listener.Params.SourceDistanceModel = props->SourceDistanceModel;
-    Listener.Params.mDistanceModel = props->mDistanceModel;
+        Listener.Params.SourceDistanceModel = props->SourceDistanceModel;
+        Listener.Params.mDistanceModel = props->mDistanceModel;
+    }
 
     AtomicReplaceHead(Context->FreeContextProps, props);
     return true;
 }
 
-bool CalcListenerParams(ALCcontext *Context)
+bool CalcListenerParams(ALlistener &Listener, ALCcontext *Context)
 {
-    ALlistener &Listener = Context->Listener;
-
     ALlistenerProps *props{Listener.Update.exchange(nullptr, std::memory_order_acq_rel)};
     if(!props) return false;
 
@@ -439,6 +506,9 @@ bool CalcEffectSlotParams(ALeffectslot *slot, ALCcontext *context, bool force)
         AtomicReplaceHead(context->FreeEffectslotProps, props);
     }
 
+    slot->Params.DirectOutChannel = -1;
+    slot->Params.DirectOutGain = 0.0f;
+
     MixParams params;
     EffectTarget output;
     if(ALeffectslot *target{slot->Params.Target})
@@ -455,11 +525,110 @@ bool CalcEffectSlotParams(ALeffectslot *slot, ALCcontext *context, bool force)
     {
         ALCdevice *device{context->Device};
         output = EffectTarget{&device->Dry, &device->FOAOut, &device->RealOut};
+
+        /* The dedicated effects simply apply a gain to the mono input for a
+         * single output channel, which voices can do themselves.
+         */
+        int idx{-1};
+        if(slot->Params.EffectType == AL_EFFECT_DEDICATED_LOW_FREQUENCY_EFFECT)
+            idx = GetChannelIdxByName(device->RealOut, LFE);
+        else if(slot->Params.EffectType == AL_EFFECT_DEDICATED_DIALOGUE)
+            idx = GetChannelIdxByName(device->RealOut, FrontCenter);
+        if(idx != -1)
+        {
+            slot->Params.DirectOutChannel = idx;
+            slot->Params.DirectOutGain = slot->Params.Gain *
+                slot->Params.EffectProps.Dedicated.Gain;
+        }
     }
     state->update(context, slot, &slot->Params.EffectProps, output);
     return true;
 }
 
+void CalcSubmixBusParams(ALsubmixbus *bus, ALCcontext *context, bool force)
+{
+    ALsubmixbusProps *props{bus->Update.exchange(nullptr, std::memory_order_acq_rel)};
+    if(!props && !force) return;
+
+    const ALCdevice *device{context->Device};
+    if(props)
+    {
+        bus->Params.Gain = props->Gain * props->Filter.Gain;
+        bus->Params.Position = props->Position;
+        bus->Params.Spatialize = props->Spatialize;
+        bus->Params.Slot = props->Slot;
+        bus->Params.SendGain = props->SendGain;
+
+        const auto Frequency = static_cast<ALfloat>(device->Frequency);
+        const ALfloat hfScale{props->Filter.HFReference / Frequency};
+        const ALfloat lfScale{props->Filter.LFReference / Frequency};
+        const ALfloat gainHF{maxf(props->Filter.GainHF, 0.001f)}; /* Limit -60dB */
+        const ALfloat gainLF{maxf(props->Filter.GainLF, 0.001f)};
+
+        bus->Params.FilterType = AF_None;
+        if(gainHF != 1.0f) bus->Params.FilterType |= AF_LowPass;
+        if(gainLF != 1.0f) bus->Params.FilterType |= AF_HighPass;
+        bus->Params.LowPass[0].setParams(BiquadType::HighShelf, gainHF, hfScale,
+            calc_rcpQ_from_slope(gainHF, 1.0f));
+        bus->Params.HighPass[0].setParams(BiquadType::LowShelf, gainLF, lfScale,
+            calc_rcpQ_from_slope(gainLF, 1.0f));
+        for(ALsizei c{1};c < MAX_EFFECT_CHANNELS;c++)
+        {
+            bus->Params.LowPass[c].copyParamsFrom(bus->Params.LowPass[0]);
+            bus->Params.HighPass[c].copyParamsFrom(bus->Params.HighPass[0]);
+        }
+
+        AtomicReplaceHead(context->FreeSubmixBusProps, props);
+    }
+
+    const ALlistener &Listener = context->Listener;
+    const ALfloat gain{minf(bus->Params.Gain * Listener.Params.Gain, GAIN_MIX_MAX)};
+    const ALfloat sendgain{gain * bus->Params.SendGain};
+    const ALeffectslot *slot{bus->Params.Slot};
+    for(ALsizei c{0};c < MAX_EFFECT_CHANNELS;c++)
+    {
+        ClearArray(bus->Params.Gains[c].Target);
+        ClearArray(bus->Params.SendGains[c].Target);
+    }
+
+    alu::Vector dir{};
+    ALfloat dist{0.0f};
+    if(bus->Params.Spatialize)
+    {
+        const std::array<ALfloat,3> &pos = bus->Params.Position;
+        dir = Listener.Params.Matrix * alu::Vector{pos[0], pos[1], pos[2], 1.0f};
+        dir[3] = 0.0f;
+        dist = dir.normalize();
+    }
+
+    if(dist > std::numeric_limits<float>::epsilon())
+    {
+        /* Pan the bus' W channel toward its position, like a B-Format source,
+         * and silence the others.
+         */
+        const ALfloat ev{std::asin(clampf(dir[1], -1.0f, 1.0f))};
+        const ALfloat az{std::atan2(dir[0], -dir[2])};
+
+        ALfloat coeffs[MAX_AMBI_CHANNELS];
+        CalcAngleCoeffs((device->mRenderMode==StereoPair) ? ScaleAzimuthFront(az, 1.5f) : az,
+                        ev, 0.0f, coeffs);
+        ComputePanGains(&device->FOAOut, coeffs, gain, bus->Params.Gains[0].Target);
+        if(slot)
+            ComputePanGains(slot, coeffs, sendgain, bus->Params.SendGains[0].Target);
+    }
+    else
+    {
+        /* Otherwise the bus' B-Format mix passes through as-is. */
+        for(ALsizei c{0};c < MAX_EFFECT_CHANNELS;c++)
+        {
+            const ALfloat *coeffs{alu::Matrix::Identity()[c].data()};
+            ComputePanGains(&device->FOAOut, coeffs, gain, bus->Params.Gains[c].Target);
+            if(slot)
+                ComputePanGains(slot, coeffs, sendgain, bus->Params.SendGains[c].Target);
+        }
+    }
+}
+
 
 constexpr ChanMap MonoMap[1]{
     { FrontCenter, 0.0f, 0.0f }
@@ -497,15 +666,35 @@ constexpr ChanMap MonoMap[1]{
     { SideRight,   Deg2Rad(  90.0f), Deg2Rad(0.0f) }
 };
 
-void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev,
+/* Selects the HRTF level of detail for a voice given its dry gain. Quieter
+ * voices, whether from distance attenuation or a low source gain, get shorter
+ * IRs where the truncated tail would be masked by louder voices.
+ */
+ALsizei CalcHrtfLod(const ALCdevice *Device, const ALfloat gain)
+{
+    if(!Device->mHrtfLod)
+        return 0;
+    if(gain > 0.0625f) /* -24dB */
+        return 0;
+    if(gain > 0.0078125f) /* -42dB */
+        return 1;
+    return 2;
+}
+
+void CalcPanningAndFilters(ALvoice *voice, ALvoice::ListenerData *path, const ALfloat Azi, const ALfloat Elev,
                            const ALfloat Distance, const ALfloat Spread,
                            const ALfloat DryGain, const ALfloat DryGainHF,
                            const ALfloat DryGainLF, const ALfloat *WetGain,
                            const ALfloat *WetGainLF, const ALfloat *WetGainHF,
                            ALeffectslot **SendSlots, const ALbuffer *Buffer,
                            const ALvoicePropsBase *props, const ALlistener &Listener,
-                           const ALCdevice *Device)
+                           const ALCdevice *Device, const bool Clustered,
+                           BiquadCache &FilterCache)
 {
+    /* Additional listeners only have a direct path. */
+    ALvoice::DirectData &Direct = path ? path->Direct : voice->Direct;
+    ALuint &Flags = path ? path->Flags : voice->Flags;
+
     ChanMap StereoMap[2]{
         { FrontLeft,  Deg2Rad(-30.0f), Deg2Rad(0.0f) },
         { FrontRight, Deg2Rad( 30.0f), Deg2Rad(0.0f) }
@@ -582,16 +771,16 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
     }
     ASSUME(num_channels > 0);
 
-    std::for_each(std::begin(voice->Direct.Params), std::begin(voice->Direct.Params)+num_channels,
+    std::for_each(std::begin(Direct.Params), std::begin(Direct.Params)+num_channels,
         [](DirectParams &params) -> void
         {
             params.Hrtf.Target = HrtfParams{};
             ClearArray(params.Gains.Target);
         }
     );
-    const ALsizei NumSends{Device->NumAuxSends};
+    const ALsizei NumSends{path ? 0 : Device->NumAuxSends};
     ASSUME(NumSends >= 0);
-    std::for_each(voice->Send.begin(), voice->Send.end(),
+    std::for_each(voice->Send.begin(), voice->Send.begin()+NumSends,
         [num_channels](ALvoice::SendData &send) -> void
         {
             std::for_each(std::begin(send.Params), std::begin(send.Params)+num_channels,
@@ -600,8 +789,42 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
         }
     );
 
-    voice->Flags &= ~(VOICE_HAS_HRTF | VOICE_HAS_NFC);
-    if(isbformat)
+    const bool WasClustered{(Flags&VOICE_IS_CLUSTERED) != 0};
+    const bool WasBussed{(Flags&VOICE_IS_BUSSED) != 0};
+    Flags &= ~(VOICE_HAS_HRTF | VOICE_HAS_NFC | VOICE_IS_CLUSTERED | VOICE_IS_BUSSED);
+    if(props->Bus)
+    {
+        /* Sources on a submix bus play each channel from its nominal position
+         * in the bus' B-Format mix, with just the source gain (the caller sets
+         * the buffer). The bus applies the filtering and spatialization once
+         * for all of its sources.
+         */
+        const MixParams &busmix = props->Bus->Mix;
+        if(isbformat)
+        {
+            /* FuMa W, X, Y, and Z map to ACN 0, 3, 1, and 2. */
+            static constexpr ALsizei acn[4]{0, 3, 1, 2};
+            for(ALsizei c{0};c < num_channels;c++)
+                Direct.Params[c].Gains.Target[acn[c]] = DryGain *
+                    AmbiScale::FromFuMa[acn[c]];
+        }
+        else
+        {
+            for(ALsizei c{0};c < num_channels;c++)
+            {
+                /* Skip LFE */
+                if(chans[c].channel == LFE)
+                    continue;
+
+                ALfloat coeffs[MAX_AMBI_CHANNELS];
+                CalcAngleCoeffs(chans[c].angle, chans[c].elevation, 0.0f, coeffs);
+                ComputePanGains(&busmix, coeffs, DryGain, Direct.Params[c].Gains.Target);
+            }
+        }
+
+        Flags |= VOICE_IS_BUSSED;
+    }
+    else if(isbformat)
     {
         /* Special handling for B-Format sources. */
 
@@ -622,19 +845,19 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                     (mdist * static_cast<ALfloat>(Device->Frequency))};
 
                 /* Only need to adjust the first channel of a B-Format source. */
-                voice->Direct.Params[0].NFCtrlFilter.adjust(w0);
+                Direct.Params[0].NFCtrlFilter.adjust(w0);
 
                 std::copy(std::begin(Device->NumChannelsPerOrder),
                           std::end(Device->NumChannelsPerOrder),
-                          std::begin(voice->Direct.ChannelsPerOrder));
-                voice->Flags |= VOICE_HAS_NFC;
+                          std::begin(Direct.ChannelsPerOrder));
+                Flags |= VOICE_HAS_NFC;
             }
 
             /* Always render B-Format sources to the FOA output, to ensure
              * smooth changes if it switches between panned and unpanned.
              */
-            voice->Direct.Buffer = Device->FOAOut.Buffer;
-            voice->Direct.Channels = Device->FOAOut.NumChannels;
+            Direct.Buffer = Device->FOAOut.Buffer;
+            Direct.Channels = Device->FOAOut.NumChannels;
 
             /* A scalar of 1.5 for plain stereo results in +/-60 degrees being
              * moved to +/-90 degrees for direct right and left speaker
@@ -647,7 +870,7 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
             /* NOTE: W needs to be scaled due to FuMa normalization. */
             const ALfloat &scale0 = AmbiScale::FromFuMa[0];
             ComputePanGains(&Device->FOAOut, coeffs, DryGain*scale0,
-                voice->Direct.Params[0].Gains.Target);
+                Direct.Params[0].Gains.Target);
             for(ALsizei i{0};i < NumSends;i++)
             {
                 if(const ALeffectslot *Slot{SendSlots[i]})
@@ -663,13 +886,13 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                  * is what we want for FOA input. The first channel may have
                  * been previously re-adjusted if panned, so reset it.
                  */
-                voice->Direct.Params[0].NFCtrlFilter.adjust(0.0f);
+                Direct.Params[0].NFCtrlFilter.adjust(0.0f);
 
-                voice->Direct.ChannelsPerOrder[0] = 1;
-                voice->Direct.ChannelsPerOrder[1] = mini(voice->Direct.Channels-1, 3);
-                std::fill(std::begin(voice->Direct.ChannelsPerOrder)+2,
-                          std::end(voice->Direct.ChannelsPerOrder), 0);
-                voice->Flags |= VOICE_HAS_NFC;
+                Direct.ChannelsPerOrder[0] = 1;
+                Direct.ChannelsPerOrder[1] = mini(Direct.Channels-1, 3);
+                std::fill(std::begin(Direct.ChannelsPerOrder)+2,
+                          std::end(Direct.ChannelsPerOrder), 0);
+                Flags |= VOICE_HAS_NFC;
             }
 
             /* Local B-Format sources have their XYZ channels rotated according
@@ -705,11 +928,11 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                   0.0f, -V[0]*zscale,  V[1]*zscale, -V[2]*zscale  // FuMa Z
             };
 
-            voice->Direct.Buffer = Device->FOAOut.Buffer;
-            voice->Direct.Channels = Device->FOAOut.NumChannels;
+            Direct.Buffer = Device->FOAOut.Buffer;
+            Direct.Channels = Device->FOAOut.NumChannels;
             for(ALsizei c{0};c < num_channels;c++)
                 ComputePanGains(&Device->FOAOut, matrix[c].data(), DryGain,
-                                voice->Direct.Params[c].Gains.Target);
+                                Direct.Params[c].Gains.Target);
             for(ALsizei i{0};i < NumSends;i++)
             {
                 if(const ALeffectslot *Slot{SendSlots[i]})
@@ -720,18 +943,38 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
             }
         }
     }
+    else if(Clustered)
+    {
+        /* Clustered sources only apply their gain to the cluster's mono input
+         * (the caller sets the buffer). The cluster is panned as a whole after
+         * its voices are mixed.
+         */
+        Direct.Channels = 1;
+        Direct.Params[0].Gains.Target[0] = DryGain;
+
+        ALfloat coeffs[MAX_AMBI_CHANNELS];
+        CalcAngleCoeffs(Azi, Elev, Spread, coeffs);
+        for(ALsizei i{0};i < NumSends;i++)
+        {
+            if(const ALeffectslot *Slot{SendSlots[i]})
+                ComputePanningGainsBF(Slot->ChanMap, Slot->NumChannels, coeffs, WetGain[i],
+                    voice->Send[i].Params[0].Gains.Target);
+        }
+
+        Flags |= VOICE_IS_CLUSTERED;
+    }
     else if(DirectChannels)
     {
         /* Direct source channels always play local. Skip the virtual channels
          * and write inputs to the matching real outputs.
          */
-        voice->Direct.Buffer = Device->RealOut.Buffer;
-        voice->Direct.Channels = Device->RealOut.NumChannels;
+        Direct.Buffer = Device->RealOut.Buffer;
+        Direct.Channels = Device->RealOut.NumChannels;
 
         for(ALsizei c{0};c < num_channels;c++)
         {
             int idx{GetChannelIdxByName(Device->RealOut, chans[c].channel)};
-            if(idx != -1) voice->Direct.Params[c].Gains.Target[idx] = DryGain;
+            if(idx != -1) Direct.Params[c].Gains.Target[idx] = DryGain;
         }
 
         /* Auxiliary sends still use normal channel panning since they mix to
@@ -756,25 +999,25 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
         /* Full HRTF rendering. Skip the virtual channels and render to the
          * real outputs.
          */
-        voice->Direct.Buffer = Device->RealOut.Buffer;
-        voice->Direct.Channels = Device->RealOut.NumChannels;
+        Direct.Buffer = Device->RealOut.Buffer;
+        Direct.Channels = Device->RealOut.NumChannels;
 
         if(Distance > std::numeric_limits<float>::epsilon())
         {
             /* Get the HRIR coefficients and delays just once, for the given
              * source direction.
              */
-            GetHrtfCoeffs(Device->mHrtf, Elev, Azi, Distance, Spread,
-                          voice->Direct.Params[0].Hrtf.Target.Coeffs,
-                          voice->Direct.Params[0].Hrtf.Target.Delay);
-            voice->Direct.Params[0].Hrtf.Target.Gain = DryGain * downmix_gain;
+            Direct.Params[0].Hrtf.Target.IrSize = GetHrtfCoeffs(Device->mHrtf, Elev, Azi,
+                Distance, Spread, CalcHrtfLod(Device, DryGain*downmix_gain),
+                Direct.Params[0].Hrtf.Target.Coeffs, Direct.Params[0].Hrtf.Target.Delay);
+            Direct.Params[0].Hrtf.Target.Gain = DryGain * downmix_gain;
 
             /* Remaining channels use the same results as the first. */
             for(ALsizei c{1};c < num_channels;c++)
             {
                 /* Skip LFE */
                 if(chans[c].channel != LFE)
-                    voice->Direct.Params[c].Hrtf.Target = voice->Direct.Params[0].Hrtf.Target;
+                    Direct.Params[c].Hrtf.Target = Direct.Params[0].Hrtf.Target;
             }
 
             /* Calculate the directional coefficients once, which apply to all
@@ -811,11 +1054,11 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                 /* Get the HRIR coefficients and delays for this channel
                  * position.
                  */
-                GetHrtfCoeffs(Device->mHrtf, chans[c].elevation, chans[c].angle,
-                    std::numeric_limits<float>::infinity(), Spread,
-                    voice->Direct.Params[c].Hrtf.Target.Coeffs,
-                    voice->Direct.Params[c].Hrtf.Target.Delay);
-                voice->Direct.Params[c].Hrtf.Target.Gain = DryGain;
+                Direct.Params[c].Hrtf.Target.IrSize = GetHrtfCoeffs(Device->mHrtf,
+                    chans[c].elevation, chans[c].angle, std::numeric_limits<float>::infinity(),
+                    Spread, CalcHrtfLod(Device, DryGain), Direct.Params[c].Hrtf.Target.Coeffs,
+                    Direct.Params[c].Hrtf.Target.Delay);
+                Direct.Params[c].Hrtf.Target.Gain = DryGain;
 
                 /* Normal panning for auxiliary sends. */
                 ALfloat coeffs[MAX_AMBI_CHANNELS];
@@ -831,7 +1074,7 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
             }
         }
 
-        voice->Flags |= VOICE_HAS_HRTF;
+        Flags |= VOICE_HAS_HRTF;
     }
     else
     {
@@ -851,12 +1094,12 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
 
                 /* Adjust NFC filters. */
                 for(ALsizei c{0};c < num_channels;c++)
-                    voice->Direct.Params[c].NFCtrlFilter.adjust(w0);
+                    Direct.Params[c].NFCtrlFilter.adjust(w0);
 
                 std::copy(std::begin(Device->NumChannelsPerOrder),
                     std::end(Device->NumChannelsPerOrder),
-                    std::begin(voice->Direct.ChannelsPerOrder));
-                voice->Flags |= VOICE_HAS_NFC;
+                    std::begin(Direct.ChannelsPerOrder));
+                Flags |= VOICE_HAS_NFC;
             }
 
             /* Calculate the directional coefficients once, which apply to all
@@ -874,13 +1117,13 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                     if(Device->Dry.Buffer == Device->RealOut.Buffer)
                     {
                         int idx = GetChannelIdxByName(Device->RealOut, chans[c].channel);
-                        if(idx != -1) voice->Direct.Params[c].Gains.Target[idx] = DryGain;
+                        if(idx != -1) Direct.Params[c].Gains.Target[idx] = DryGain;
                     }
                     continue;
                 }
 
                 ComputePanGains(&Device->Dry, coeffs, DryGain * downmix_gain,
-                                voice->Direct.Params[c].Gains.Target);
+                                Direct.Params[c].Gains.Target);
             }
 
             for(ALsizei i{0};i < NumSends;i++)
@@ -909,12 +1152,12 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                     (Device->AvgSpeakerDist * static_cast<ALfloat>(Device->Frequency))};
 
                 for(ALsizei c{0};c < num_channels;c++)
-                    voice->Direct.Params[c].NFCtrlFilter.adjust(w0);
+                    Direct.Params[c].NFCtrlFilter.adjust(w0);
 
                 std::copy(std::begin(Device->NumChannelsPerOrder),
                     std::end(Device->NumChannelsPerOrder),
-                    std::begin(voice->Direct.ChannelsPerOrder));
-                voice->Flags |= VOICE_HAS_NFC;
+                    std::begin(Direct.ChannelsPerOrder));
+                Flags |= VOICE_HAS_NFC;
             }
 
             for(ALsizei c{0};c < num_channels;c++)
@@ -925,7 +1168,7 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                     if(Device->Dry.Buffer == Device->RealOut.Buffer)
                     {
                         int idx = GetChannelIdxByName(Device->RealOut, chans[c].channel);
-                        if(idx != -1) voice->Direct.Params[c].Gains.Target[idx] = DryGain;
+                        if(idx != -1) Direct.Params[c].Gains.Target[idx] = DryGain;
                     }
                     continue;
                 }
@@ -938,7 +1181,7 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
                 );
 
                 ComputePanGains(&Device->Dry, coeffs, DryGain,
-                    voice->Direct.Params[c].Gains.Target);
+                    Direct.Params[c].Gains.Target);
                 for(ALsizei i{0};i < NumSends;i++)
                 {
                     if(const ALeffectslot *Slot{SendSlots[i]})
@@ -950,6 +1193,42 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
         }
     }
 
+    if(Clustered != WasClustered || (props->Bus != nullptr) != WasBussed)
+    {
+        /* The direct path moved into or out of a cluster or bus, so its
+         * current gains and HRTF state are for another output. Fade it in from
+         * silence.
+         */
+        std::for_each(std::begin(Direct.Params),
+            std::begin(Direct.Params)+num_channels,
+            [](DirectParams &params) -> void
+            {
+                ClearArray(params.Gains.Current);
+                params.Hrtf.Old.Gain = 0.0f;
+                params.Hrtf.State = HrtfState{};
+            }
+        );
+    }
+
+    /* Sends to a slot with direct output mix straight to the slot's output
+     * channel, using the gain the wet buffer's mono input would get along with
+     * the slot's own gain.
+     */
+    for(ALsizei i{0};i < NumSends;i++)
+    {
+        const ALeffectslot *Slot{SendSlots[i]};
+        if(!Slot || !Slot->DirectOut)
+            continue;
+
+        for(ALsizei c{0};c < num_channels;c++)
+        {
+            ALfloat (&gains)[MAX_OUTPUT_CHANNELS] = voice->Send[i].Params[c].Gains.Target;
+            const ALfloat gain{gains[0] * Slot->Params.DirectOutGain};
+            std::fill(std::begin(gains), std::end(gains), 0.0f);
+            gains[Slot->Params.DirectOutChannel] = gain;
+        }
+    }
+
     const auto Frequency = static_cast<ALfloat>(Device->Frequency);
     {
         const ALfloat hfScale{props->Direct.HFReference / Frequency};
@@ -957,19 +1236,17 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
         const ALfloat gainHF{maxf(DryGainHF, 0.001f)}; /* Limit -60dB */
         const ALfloat gainLF{maxf(DryGainLF, 0.001f)};
 
-        voice->Direct.FilterType = AF_None;
-        if(gainHF != 1.0f) voice->Direct.FilterType |= AF_LowPass;
-        if(gainLF != 1.0f) voice->Direct.FilterType |= AF_HighPass;
-        voice->Direct.Params[0].LowPass.setParams(BiquadType::HighShelf,
-            gainHF, hfScale, calc_rcpQ_from_slope(gainHF, 1.0f)
-        );
-        voice->Direct.Params[0].HighPass.setParams(BiquadType::LowShelf,
-            gainLF, lfScale, calc_rcpQ_from_slope(gainLF, 1.0f)
-        );
-        for(ALsizei c{1};c < num_channels;c++)
+        Direct.FilterType = AF_None;
+        if(gainHF != 1.0f) Direct.FilterType |= AF_LowPass;
+        if(gainLF != 1.0f) Direct.FilterType |= AF_HighPass;
+        const BiquadFilter &lowpass = FilterCache.get(BiquadType::HighShelf,
+            gainHF, hfScale, calc_rcpQ_from_slope(gainHF, 1.0f));
+        const BiquadFilter &highpass = FilterCache.get(BiquadType::LowShelf,
+            gainLF, lfScale, calc_rcpQ_from_slope(gainLF, 1.0f));
+        for(ALsizei c{0};c < num_channels;c++)
         {
-            voice->Direct.Params[c].LowPass.copyParamsFrom(voice->Direct.Params[0].LowPass);
-            voice->Direct.Params[c].HighPass.copyParamsFrom(voice->Direct.Params[0].HighPass);
+            Direct.Params[c].LowPass.copyParamsFrom(lowpass);
+            Direct.Params[c].HighPass.copyParamsFrom(highpass);
         }
     }
     for(ALsizei i{0};i < NumSends;i++)
@@ -982,28 +1259,48 @@ void CalcPanningAndFilters(ALvoice *voice, const ALfloat Azi, const ALfloat Elev
         voice->Send[i].FilterType = AF_None;
         if(gainHF != 1.0f) voice->Send[i].FilterType |= AF_LowPass;
         if(gainLF != 1.0f) voice->Send[i].FilterType |= AF_HighPass;
-        voice->Send[i].Params[0].LowPass.setParams(BiquadType::HighShelf,
-            gainHF, hfScale, calc_rcpQ_from_slope(gainHF, 1.0f)
-        );
-        voice->Send[i].Params[0].HighPass.setParams(BiquadType::LowShelf,
-            gainLF, lfScale, calc_rcpQ_from_slope(gainLF, 1.0f)
-        );
-        for(ALsizei c{1};c < num_channels;c++)
+        const BiquadFilter &lowpass = FilterCache.get(BiquadType::HighShelf,
+            gainHF, hfScale, calc_rcpQ_from_slope(gainHF, 1.0f));
+        const BiquadFilter &highpass = FilterCache.get(BiquadType::LowShelf,
+            gainLF, lfScale, calc_rcpQ_from_slope(gainLF, 1.0f));
+        for(ALsizei c{0};c < num_channels;c++)
         {
-            voice->Send[i].Params[c].LowPass.copyParamsFrom(voice->Send[i].Params[0].LowPass);
-            voice->Send[i].Params[c].HighPass.copyParamsFrom(voice->Send[i].Params[0].HighPass);
+            voice->Send[i].Params[c].LowPass.copyParamsFrom(lowpass);
+            voice->Send[i].Params[c].HighPass.copyParamsFrom(highpass);
         }
     }
 }
 
-void CalcNonAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const ALbuffer *ALBuffer, const ALCcontext *ALContext)
+/* Sets the buffer a voice's send mixes to. The send's current gains apply to
+ * the channels of the buffer it last mixed to, so when that changes (e.g. the
+ * slot switches to or from direct output) they're cleared to fade in on the
+ * new buffer instead of ramping from the wrong channels.
+ */
+void SetSendOutput(ALvoice::SendData &send, ALfloat (*buffer)[BUFFERSIZE], ALsizei channels)
+{
+    if(send.Buffer != buffer)
+    {
+        std::for_each(std::begin(send.Params), std::end(send.Params),
+            [](SendParams &params) -> void { ClearArray(params.Gains.Current); }
+        );
+    }
+    send.Buffer = buffer;
+    send.Channels = channels;
+}
+
+void CalcNonAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const ALbuffer *ALBuffer, ALCcontext *ALContext, const ALlistener &Listener, ALvoice::ListenerData *path)
 {
     const ALCdevice *Device{ALContext->Device};
+    /* As with spatialized sources, additional listeners only get their own
+     * direct path.
+     */
+    const ALsizei NumSends{path ? 0 : Device->NumAuxSends};
+    ALvoice::DirectData &Direct = path ? path->Direct : voice->Direct;
     ALeffectslot *SendSlots[MAX_SENDS];
 
-    voice->Direct.Buffer = Device->Dry.Buffer;
-    voice->Direct.Channels = Device->Dry.NumChannels;
-    for(ALsizei i{0};i < Device->NumAuxSends;i++)
+    Direct.Buffer = Device->Dry.Buffer;
+    Direct.Channels = Device->Dry.NumChannels;
+    for(ALsizei i{0};i < NumSends;i++)
     {
         SendSlots[i] = props->Send[i].Slot;
         if(!SendSlots[i] && i == 0)
@@ -1014,35 +1311,35 @@ void CalcNonAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, cons
             voice->Send[i].Buffer = nullptr;
             voice->Send[i].Channels = 0;
         }
+        else if(SendSlots[i]->DirectOut)
+            SetSendOutput(voice->Send[i], Device->RealOut.Buffer, Device->RealOut.NumChannels);
         else
-        {
-            voice->Send[i].Buffer = SendSlots[i]->WetBuffer;
-            voice->Send[i].Channels = SendSlots[i]->NumChannels;
-        }
+            SetSendOutput(voice->Send[i], SendSlots[i]->WetBuffer, SendSlots[i]->NumChannels);
     }
 
     /* Calculate the stepping value */
-    const auto Pitch = static_cast<ALfloat>(ALBuffer->Frequency) /
-        static_cast<ALfloat>(Device->Frequency) * props->Pitch;
-    if(Pitch > static_cast<ALfloat>(MAX_PITCH))
-        voice->Step = MAX_PITCH<<FRACTIONBITS;
-    else
-        voice->Step = maxi(fastf2i(Pitch * FRACTIONONE), 1);
-    if(props->mResampler == BSinc24Resampler)
-        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, &bsinc24);
-    else if(props->mResampler == BSinc12Resampler)
-        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, &bsinc12);
-    voice->Resampler = SelectResampler(props->mResampler);
+    if(!path)
+    {
+        const auto Pitch = static_cast<ALfloat>(ALBuffer->Frequency) /
+            static_cast<ALfloat>(Device->Frequency) * props->Pitch;
+        if(Pitch > static_cast<ALfloat>(MAX_PITCH))
+            voice->Step = MAX_PITCH<<FRACTIONBITS;
+        else
+            voice->Step = maxi(fastf2i(Pitch * FRACTIONONE), 1);
+        if(const BSincTable *table{GetBSincTable(props->mResampler)})
+            BsincPrepare(voice->Step, &voice->ResampleState.bsinc, table);
+        voice->Resampler = SelectResampler(props->mResampler);
+        voice->ResamplerMulti = SelectResamplerMulti(props->mResampler);
+    }
 
     /* Calculate gains */
-    const ALlistener &Listener = ALContext->Listener;
     ALfloat DryGain{clampf(props->Gain, props->MinGain, props->MaxGain)};
     DryGain *= props->Direct.Gain * Listener.Params.Gain;
     DryGain  = minf(DryGain, GAIN_MIX_MAX);
     ALfloat DryGainHF{props->Direct.GainHF};
     ALfloat DryGainLF{props->Direct.GainLF};
     ALfloat WetGain[MAX_SENDS], WetGainHF[MAX_SENDS], WetGainLF[MAX_SENDS];
-    for(ALsizei i{0};i < Device->NumAuxSends;i++)
+    for(ALsizei i{0};i < NumSends;i++)
     {
         WetGain[i]  = clampf(props->Gain, props->MinGain, props->MaxGain);
         WetGain[i] *= props->Send[i].Gain * Listener.Params.Gain;
@@ -1051,19 +1348,23 @@ void CalcNonAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, cons
         WetGainLF[i] = props->Send[i].GainLF;
     }
 
-    CalcPanningAndFilters(voice, 0.0f, 0.0f, 0.0f, 0.0f, DryGain, DryGainHF, DryGainLF, WetGain,
-                          WetGainLF, WetGainHF, SendSlots, ALBuffer, props, Listener, Device);
+    CalcPanningAndFilters(voice, path, 0.0f, 0.0f, 0.0f, 0.0f, DryGain, DryGainHF, DryGainLF, WetGain,
+                          WetGainLF, WetGainHF, path ? nullptr : SendSlots, ALBuffer, props,
+                          Listener, Device, false, ALContext->FilterCache);
 }
 
-void CalcAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const ALbuffer *ALBuffer, const ALCcontext *ALContext)
+void CalcAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const ALbuffer *ALBuffer, ALCcontext *ALContext, const ALlistener &Listener, ALvoice::ListenerData *path)
 {
     const ALCdevice *Device{ALContext->Device};
-    const ALsizei NumSends{Device->NumAuxSends};
-    const ALlistener &Listener = ALContext->Listener;
+    /* The sends, pitch, and clustering are only handled for the main
+     * listener. Additional listeners just get their own direct path.
+     */
+    const ALsizei NumSends{path ? 0 : Device->NumAuxSends};
+    ALvoice::DirectData &Direct = path ? path->Direct : voice->Direct;
 
     /* Set mixing buffers and get send parameters. */
-    voice->Direct.Buffer = Device->Dry.Buffer;
-    voice->Direct.Channels = Device->Dry.NumChannels;
+    Direct.Buffer = Device->Dry.Buffer;
+    Direct.Channels = Device->Dry.NumChannels;
     ALeffectslot *SendSlots[MAX_SENDS];
     ALfloat RoomRolloff[MAX_SENDS];
     ALfloat DecayDistance[MAX_SENDS];
@@ -1122,11 +1423,10 @@ void CalcAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const A
             voice->Send[i].Buffer = nullptr;
             voice->Send[i].Channels = 0;
         }
+        else if(SendSlots[i]->DirectOut)
+            SetSendOutput(voice->Send[i], Device->RealOut.Buffer, Device->RealOut.NumChannels);
         else
-        {
-            voice->Send[i].Buffer = SendSlots[i]->WetBuffer;
-            voice->Send[i].Channels = SendSlots[i]->NumChannels;
-        }
+            SetSendOutput(voice->Send[i], SendSlots[i]->WetBuffer, SendSlots[i]->NumChannels);
     }
 
     /* Transform source to listener space (convert to head relative) */
@@ -1323,6 +1623,35 @@ void CalcAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const A
     }
 
 
+    ALfloat ev{0.0f}, az{0.0f};
+    if(Distance > 0.0f)
+    {
+        /* Clamp Y, in case rounding errors caused it to end up outside of
+         * -1...+1.
+         */
+        ev = std::asin(clampf(-SourceToListener[1], -1.0f, 1.0f));
+        /* Double negation on Z cancels out; negate once for changing source-
+         * to-listener to listener-to-source, and again for right-handed coords
+         * with -Z in front.
+         */
+        az = std::atan2(-SourceToListener[0], SourceToListener[2]*ZScale);
+    }
+
+    ALfloat spread{0.0f};
+    if(props->Radius > Distance)
+        spread = al::MathDefs<float>::Tau() - Distance/props->Radius*al::MathDefs<float>::Pi();
+    else if(Distance > 0.0f)
+        spread = std::asin(props->Radius/Distance) * 2.0f;
+
+    const ALfloat meters{Distance * Listener.Params.MetersPerUnit};
+    if(path)
+    {
+        CalcPanningAndFilters(voice, path, az, ev, meters, spread, DryGain, DryGainHF, DryGainLF,
+            WetGain, WetGainLF, WetGainHF, nullptr, ALBuffer, props, Listener, Device, false,
+            ALContext->FilterCache);
+        return;
+    }
+
     /* Initial source pitch */
     ALfloat Pitch{props->Pitch};
 
@@ -1366,35 +1695,92 @@ void CalcAttnSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const A
         voice->Step = MAX_PITCH<<FRACTIONBITS;
     else
         voice->Step = maxi(fastf2i(Pitch * FRACTIONONE), 1);
-    if(props->mResampler == BSinc24Resampler)
-        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, &bsinc24);
-    else if(props->mResampler == BSinc12Resampler)
-        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, &bsinc12);
+    if(const BSincTable *table{GetBSincTable(props->mResampler)})
+        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, table);
     voice->Resampler = SelectResampler(props->mResampler);
+    voice->ResamplerMulti = SelectResamplerMulti(props->mResampler);
 
-    ALfloat ev{0.0f}, az{0.0f};
-    if(Distance > 0.0f)
+    /* Distant or quiet mono sources may be premixed with others from around
+     * the same direction. Sources already clustered get some leeway on the
+     * thresholds, so ones hovering around them don't keep switching.
+     */
+    bool clustered{false};
+    if(ALContext->ClusterSectors > 0 && ALBuffer->mFmtChannels == FmtMono && Distance > 0.0f)
     {
-        /* Clamp Y, in case rounding errors caused it to end up outside of
-         * -1...+1.
-         */
-        ev = std::asin(clampf(-SourceToListener[1], -1.0f, 1.0f));
-        /* Double negation on Z cancels out; negate once for changing source-
-         * to-listener to listener-to-source, and again for right-handed coords
-         * with -Z in front.
+        const ALfloat leeway{(voice->Flags&VOICE_IS_CLUSTERED) ? 0.1f : 0.0f};
+        clustered = (ALContext->ClusterDistance > 0.0f &&
+                     meters >= ALContext->ClusterDistance*(1.0f-leeway)) ||
+                    DryGain < ALContext->ClusterGain*(1.0f+leeway);
+    }
+
+    const ALsizei oldcluster{(voice->Flags&VOICE_IS_CLUSTERED) ? voice->ClusterIdx : -1};
+    const ALfloat oldclustergain{voice->Direct.Params[0].Gains.Current[0]};
+
+    CalcPanningAndFilters(voice, nullptr, az, ev, meters, spread, DryGain, DryGainHF, DryGainLF, WetGain,
+        WetGainLF, WetGainHF, SendSlots, ALBuffer, props, Listener, Device, clustered,
+        ALContext->FilterCache);
+
+    if(clustered)
+    {
+        /* Clusters cover a number of azimuth sectors in each of three
+         * elevation bands, split at +/-30 degrees.
          */
-        az = std::atan2(-SourceToListener[0], SourceToListener[2]*ZScale);
+        const ALfloat cosev{std::cos(ev)};
+        voice->ClusterDir = {{std::sin(az)*cosev, std::sin(ev), std::cos(az)*cosev}};
+
+        const ALsizei sectors{ALContext->ClusterSectors};
+        const ALsizei band{(ev < Deg2Rad(-30.0f)) ? 0 : (ev > Deg2Rad(30.0f)) ? 2 : 1};
+        const ALsizei sector{clampi(static_cast<ALsizei>((az+al::MathDefs<float>::Pi()) /
+            al::MathDefs<float>::Tau() * static_cast<ALfloat>(sectors)), 0, sectors-1)};
+        voice->ClusterIdx = band*sectors + sector;
+        voice->Direct.Buffer = ALContext->VoiceClusters[voice->ClusterIdx].Buffer;
     }
 
-    ALfloat spread{0.0f};
-    if(props->Radius > Distance)
-        spread = al::MathDefs<float>::Tau() - Distance/props->Radius*al::MathDefs<float>::Pi();
-    else if(Distance > 0.0f)
-        spread = std::asin(props->Radius/Distance) * 2.0f;
+    if(oldcluster >= 0 && (!clustered || voice->ClusterIdx != oldcluster))
+    {
+        /* Cross-fade from the cluster the voice left to its new output. */
+        voice->PrevClusterIdx = oldcluster;
+        voice->PrevClusterGain = oldclustergain;
+        voice->Direct.Params[0].Gains.Current[0] = 0.0f;
+    }
+}
 
-    CalcPanningAndFilters(voice, az, ev, Distance*Listener.Params.MetersPerUnit, spread, DryGain,
-        DryGainHF, DryGainLF, WetGain, WetGainLF, WetGainHF, SendSlots, ALBuffer, props, Listener,
-        Device);
+void CalcBusSourceParams(ALvoice *voice, const ALvoicePropsBase *props, const ALbuffer *ALBuffer, ALCcontext *ALContext)
+{
+    const ALCdevice *Device{ALContext->Device};
+
+    /* Sends are left to the bus. */
+    ALeffectslot *SendSlots[MAX_SENDS]{};
+    voice->Direct.Buffer = props->Bus->Mix.Buffer;
+    voice->Direct.Channels = props->Bus->Mix.NumChannels;
+    for(ALsizei i{0};i < Device->NumAuxSends;i++)
+    {
+        voice->Send[i].Buffer = nullptr;
+        voice->Send[i].Channels = 0;
+    }
+
+    /* Calculate the stepping value */
+    const auto Pitch = static_cast<ALfloat>(ALBuffer->Frequency) /
+        static_cast<ALfloat>(Device->Frequency) * props->Pitch;
+    if(Pitch > static_cast<ALfloat>(MAX_PITCH))
+        voice->Step = MAX_PITCH<<FRACTIONBITS;
+    else
+        voice->Step = maxi(fastf2i(Pitch * FRACTIONONE), 1);
+    if(const BSincTable *table{GetBSincTable(props->mResampler)})
+        BsincPrepare(voice->Step, &voice->ResampleState.bsinc, table);
+    voice->Resampler = SelectResampler(props->mResampler);
+    voice->ResamplerMulti = SelectResamplerMulti(props->mResampler);
+
+    /* Calculate gains. The listener gain applies to the bus as a whole. */
+    const ALlistener &Listener = ALContext->Listener;
+    ALfloat DryGain{clampf(props->Gain, props->MinGain, props->MaxGain)};
+    DryGain = minf(DryGain, GAIN_MIX_MAX);
+    ALfloat WetGain[MAX_SENDS]{}, WetGainHF[MAX_SENDS], WetGainLF[MAX_SENDS];
+    std::fill(std::begin(WetGainHF), std::end(WetGainHF), 1.0f);
+    std::fill(std::begin(WetGainLF), std::end(WetGainLF), 1.0f);
+
+    CalcPanningAndFilters(voice, nullptr, 0.0f, 0.0f, 0.0f, 0.0f, DryGain, 1.0f, 1.0f, WetGain, WetGainLF,
+        WetGainHF, SendSlots, ALBuffer, props, Listener, Device, false, ALContext->FilterCache);
 }
 
 void CalcSourceParams(ALvoice *voice, ALCcontext *context, bool force)
@@ -1417,11 +1803,52 @@ void CalcSourceParams(ALvoice *voice, ALCcontext *context, bool force)
             std::bind(std::not_equal_to<const ALbuffer*>{}, _1, nullptr));
         if(LIKELY(buffer != buffers_end))
         {
-            if(voice->Props.mSpatializeMode==SpatializeOn ||
-               (voice->Props.mSpatializeMode==SpatializeAuto && (*buffer)->mFmtChannels==FmtMono))
-                CalcAttnSourceParams(voice, &voice->Props, *buffer, context);
+            const bool spatialized{!voice->Props.Bus &&
+                (voice->Props.mSpatializeMode==SpatializeOn ||
+                 (voice->Props.mSpatializeMode==SpatializeAuto &&
+                  (*buffer)->mFmtChannels==FmtMono))};
+            if(voice->Props.Bus)
+                CalcBusSourceParams(voice, &voice->Props, *buffer, context);
+            else if(spatialized)
+                CalcAttnSourceParams(voice, &voice->Props, *buffer, context, context->Listener,
+                    nullptr);
             else
-                CalcNonAttnSourceParams(voice, &voice->Props, *buffer, context);
+                CalcNonAttnSourceParams(voice, &voice->Props, *buffer, context,
+                    context->Listener, nullptr);
+
+            /* The additional listeners each hear the source through their own
+             * output. Sources on a submix bus are only heard by the main
+             * listener, since the bus mixes to the device output.
+             */
+            const ALCdevice *device{context->Device};
+            for(ALsizei i{1};i < context->NumListeners;i++)
+            {
+                ALvoice::ListenerData &path = voice->Listeners[i-1];
+                if(!voice->Props.Bus)
+                {
+                    if(spatialized)
+                        CalcAttnSourceParams(voice, &voice->Props, *buffer, context,
+                            context->getListener(i), &path);
+                    else
+                        CalcNonAttnSourceParams(voice, &voice->Props, *buffer, context,
+                            context->getListener(i), &path);
+                    path.Direct.Buffer = GetListenerBuffer(device,
+                        device->ListenerOuts[static_cast<size_t>(i-1)].get(), path.Direct.Buffer);
+                }
+                else if(path.Direct.Buffer)
+                {
+                    path.Direct.Buffer = nullptr;
+                    std::for_each(std::begin(path.Direct.Params),
+                        std::begin(path.Direct.Params)+voice->NumChannels,
+                        [](DirectParams &params) -> void
+                        {
+                            ClearArray(params.Gains.Current);
+                            params.Hrtf.Old.Gain = 0.0f;
+                            params.Hrtf.State = HrtfState{};
+                        }
+                    );
+                }
+            }
             break;
         }
         BufferListItem = BufferListItem->next.load(std::memory_order_acquire);
@@ -1429,18 +1856,116 @@ void CalcSourceParams(ALvoice *voice, ALCcontext *context, bool force)
 }
 
 
-void ProcessParamUpdates(ALCcontext *ctx, const ALeffectslotArray *slots)
+/* Resets the voices' direct path mixing state after the device output is
+ * replaced, since the old state was for a different channel layout. The
+ * output fades in afterward, so the voices can jump straight to their new
+ * target gains.
+ */
+void ResetVoiceOutput(ALCcontext *ctx)
+{
+    const ALCdevice *device{ctx->Device};
+    const ALsizei num_listeners{ctx->NumListeners};
+    std::for_each(ctx->Voices, ctx->Voices+ctx->VoiceCount.load(std::memory_order_acquire),
+        [device,num_listeners](ALvoice *voice) -> void
+        {
+            if(voice->SourceID.load(std::memory_order_acquire) == 0u)
+                return;
+
+            voice->Flags &= ~VOICE_IS_FADING;
+            auto reset_direct = [device,voice](ALvoice::DirectData &direct) -> void
+            {
+                std::for_each(direct.Params, direct.Params+voice->NumChannels,
+                    [](DirectParams &params) noexcept -> void
+                    {
+                        params.Hrtf.Old = HrtfParams{};
+                        params.Hrtf.State = HrtfState{};
+                    }
+                );
+                if(device->AvgSpeakerDist > 0.0f)
+                {
+                    /* Reinitialize the NFC filters for new parameters. */
+                    ALfloat w1 = SPEEDOFSOUNDMETRESPERSEC /
+                                 (device->AvgSpeakerDist * device->Frequency);
+                    std::for_each(direct.Params, direct.Params+voice->NumChannels,
+                        [w1](DirectParams &params) noexcept -> void
+                        { params.NFCtrlFilter.init(w1); }
+                    );
+                }
+            };
+            reset_direct(voice->Direct);
+            for(ALsizei i{1};i < num_listeners;i++)
+                reset_direct(voice->Listeners[i-1].Direct);
+        }
+    );
+    /* Clusters restart with their new panning, like the voices. */
+    for(VoiceCluster &cluster : ctx->VoiceClusters)
+        cluster.Active = false;
+
+    /* As do the buses, which also restart their filters. */
+    const ALsubmixbusArray *buses{ctx->ActiveSubmixBuses.load(std::memory_order_acquire)};
+    for(ALsubmixbus *bus : *buses)
+    {
+        for(ALsizei c{0};c < MAX_EFFECT_CHANNELS;c++)
+        {
+            bus->Params.LowPass[c].clear();
+            bus->Params.HighPass[c].clear();
+            ClearArray(bus->Params.Gains[c].Current);
+            ClearArray(bus->Params.SendGains[c].Current);
+        }
+    }
+}
+
+void ProcessParamUpdates(ALCcontext *ctx, const ALeffectslotArray *slots,
+    const ALsubmixbusArray *buses, const bool outputChanged)
 {
     IncrementRef(&ctx->UpdateCount);
-    if(LIKELY(!ctx->HoldUpdates.load(std::memory_order_acquire)))
+    /* Voices and effects still reference the old buffers after the output is
+     * replaced, so their targets are recalculated even if updates are being
+     * held. This may apply held updates early, but it can't wait.
+     */
+    if(UNLIKELY(outputChanged))
+        ResetVoiceOutput(ctx);
+    if(LIKELY(!ctx->HoldUpdates.load(std::memory_order_acquire)) || UNLIKELY(outputChanged))
     {
-        bool cforce{CalcContextParams(ctx)};
-        bool force{CalcListenerParams(ctx) || cforce};
+        bool cforce{CalcContextParams(ctx) || outputChanged};
+        bool force{cforce};
+        for(ALsizei i{0};i < ctx->NumListeners;i++)
+            force = CalcListenerParams(ctx->getListener(i), ctx) || force;
         force = std::accumulate(slots->begin(), slots->end(), force,
             [ctx,cforce](bool force, ALeffectslot *slot) -> bool
             { return CalcEffectSlotParams(slot, ctx, cforce) | force; }
         );
 
+        /* Buses are panned relative to the listener. */
+        std::for_each(buses->begin(), buses->end(),
+            [ctx,force](ALsubmixbus *bus) -> void
+            { CalcSubmixBusParams(bus, ctx, force); }
+        );
+
+        /* A slot can only have voices mix directly to its output if no other
+         * slot or bus outputs to it. Voices need to update whenever this
+         * changes.
+         */
+        auto is_target = [slots,buses](const ALeffectslot *slot) noexcept -> bool
+        {
+            return std::any_of(slots->begin(), slots->end(),
+                [slot](const ALeffectslot *other) noexcept -> bool
+                { return other->Params.Target == slot; }
+            ) || std::any_of(buses->begin(), buses->end(),
+                [slot](const ALsubmixbus *bus) noexcept -> bool
+                { return bus->Params.Slot == slot; }
+            );
+        };
+        force = std::accumulate(slots->begin(), slots->end(), force,
+            [&is_target](bool force, ALeffectslot *slot) -> bool
+            {
+                const bool directout{slot->Params.DirectOutChannel != -1 && !is_target(slot)};
+                if(directout == slot->DirectOut) return force;
+                slot->DirectOut = directout;
+                return true;
+            }
+        );
+
         std::for_each(ctx->Voices, ctx->Voices+ctx->VoiceCount.load(std::memory_order_acquire),
             [ctx,force](ALvoice *voice) -> void
             {
@@ -1452,19 +1977,119 @@ void ProcessParamUpdates(ALCcontext *ctx, const ALeffectslotArray *slots)
     IncrementRef(&ctx->UpdateCount);
 }
 
-void ProcessContext(ALCcontext *ctx, const ALsizei SamplesToDo)
+/* Collects the playing clustered voices into their clusters for this update,
+ * and clears the input of each cluster that will be mixed.
+ */
+void GatherVoiceClusters(ALCcontext *ctx, const ALsizei SamplesToDo)
+{
+    for(VoiceCluster &cluster : ctx->VoiceClusters)
+    {
+        cluster.Dir.fill(0.0f);
+        cluster.NumVoices = 0;
+    }
+
+    std::for_each(ctx->Voices, ctx->Voices+ctx->VoiceCount.load(std::memory_order_acquire),
+        [ctx](const ALvoice *voice) -> void
+        {
+            if(!(voice->Flags&VOICE_IS_CLUSTERED)) return;
+            if(!voice->Playing.load(std::memory_order_acquire)) return;
+            if(!voice->SourceID.load(std::memory_order_relaxed) || voice->Step < 1) return;
+
+            /* Louder members pull the cluster's direction toward them. */
+            VoiceCluster &cluster = ctx->VoiceClusters[voice->ClusterIdx];
+            const ALfloat weight{maxf(voice->Direct.Params[0].Gains.Target[0],
+                GAIN_SILENCE_THRESHOLD)};
+            std::transform(voice->ClusterDir.begin(), voice->ClusterDir.end(),
+                cluster.Dir.begin(), cluster.Dir.begin(),
+                [weight](const ALfloat dir, const ALfloat sum) noexcept -> ALfloat
+                { return sum + dir*weight; }
+            );
+            ++cluster.NumVoices;
+        }
+    );
+
+    for(VoiceCluster &cluster : ctx->VoiceClusters)
+    {
+        if(cluster.NumVoices > 0 || cluster.Active)
+            std::fill_n(cluster.Buffer[0], SamplesToDo, 0.0f);
+    }
+}
+
+/* Pans each active cluster toward its members' average direction, then mixes
+ * it to the output.
+ */
+void MixVoiceClusters(ALCcontext *ctx, const ALsizei SamplesToDo)
+{
+    ALCdevice *device{ctx->Device};
+
+    ALuint active{0u}, clustered{0u};
+    for(VoiceCluster &cluster : ctx->VoiceClusters)
+    {
+        if(cluster.NumVoices > 0)
+        {
+            const bool starting{!cluster.Active};
+            if(starting)
+            {
+                cluster.Offset = 0;
+                cluster.Hrtf.Old = HrtfParams{};
+                cluster.Hrtf.State = HrtfState{};
+            }
+
+            alu::Vector dir{cluster.Dir[0], cluster.Dir[1], cluster.Dir[2], 0.0f};
+            if(!(dir.normalize() > std::numeric_limits<float>::epsilon()))
+                dir = alu::Vector{0.0f, 0.0f, 1.0f, 0.0f};
+            const ALfloat ev{std::asin(clampf(dir[1], -1.0f, 1.0f))};
+            const ALfloat az{std::atan2(dir[0], dir[2])};
+
+            if(device->mRenderMode == HrtfRender)
+            {
+                /* Clusters sum many voices, so always use the full IRs. */
+                cluster.Hrtf.Target.IrSize = GetHrtfCoeffs(device->mHrtf, ev, az,
+                    std::numeric_limits<float>::infinity(), 0.0f, 0, cluster.Hrtf.Target.Coeffs,
+                    cluster.Hrtf.Target.Delay);
+                cluster.Hrtf.Target.Gain = 1.0f;
+                cluster.Moved = true;
+            }
+            else
+            {
+                ALfloat coeffs[MAX_AMBI_CHANNELS];
+                CalcAngleCoeffs((device->mRenderMode==StereoPair) ? ScaleAzimuthFront(az, 1.5f)
+                    : az, ev, 0.0f, coeffs);
+                ComputePanGains(&device->Dry, coeffs, 1.0f, cluster.Gains.Target);
+                if(starting)
+                    std::copy(std::begin(cluster.Gains.Target), std::end(cluster.Gains.Target),
+                        std::begin(cluster.Gains.Current));
+            }
+
+            ++active;
+            clustered += static_cast<ALuint>(cluster.NumVoices);
+        }
+        else if(!cluster.Active)
+            continue;
+
+        MixVoiceCluster(&cluster, device, SamplesToDo);
+        cluster.Active = (cluster.NumVoices > 0);
+    }
+
+    ctx->ActiveClusters.store(active, std::memory_order_relaxed);
+    ctx->ClusteredVoices.store(clustered, std::memory_order_relaxed);
+}
+
+void ProcessContext(ALCcontext *ctx, const ALsizei SamplesToDo, const bool outputChanged)
 {
     ASSUME(SamplesToDo > 0);
 
     const ALeffectslotArray *auxslots{ctx->ActiveAuxSlots.load(std::memory_order_acquire)};
+    const ALsubmixbusArray *buses{ctx->ActiveSubmixBuses.load(std::memory_order_acquire)};
 
     /* Process pending propery updates for objects on the context. */
-    ProcessParamUpdates(ctx, auxslots);
+    ProcessParamUpdates(ctx, auxslots, buses, outputChanged);
 
     /* Clear auxiliary effect slot mixing buffers. */
     std::for_each(auxslots->begin(), auxslots->end(),
         [SamplesToDo](ALeffectslot *slot) -> void
         {
+            if(slot->DirectOut) return;
             std::for_each(slot->WetBuffer, slot->WetBuffer+slot->NumChannels,
                 [SamplesToDo](ALfloat *buffer) -> void
                 { std::fill_n(buffer, SamplesToDo, 0.0f); }
@@ -1472,6 +2097,20 @@ void ProcessContext(ALCcontext *ctx, const ALsizei SamplesToDo)
         }
     );
 
+    /* Clear submix bus mixing buffers. */
+    std::for_each(buses->begin(), buses->end(),
+        [SamplesToDo](ALsubmixbus *bus) -> void
+        {
+            std::for_each(bus->Buffer, bus->Buffer+bus->Mix.NumChannels,
+                [SamplesToDo](ALfloat *buffer) -> void
+                { std::fill_n(buffer, SamplesToDo, 0.0f); }
+            );
+        }
+    );
+
+    if(!ctx->VoiceClusters.empty())
+        GatherVoiceClusters(ctx, SamplesToDo);
+
     /* Process voices that have a playing source. */
     std::for_each(ctx->Voices, ctx->Voices+ctx->VoiceCount.load(std::memory_order_acquire),
         [SamplesToDo,ctx](ALvoice *voice) -> void
@@ -1489,6 +2128,15 @@ void ProcessContext(ALCcontext *ctx, const ALsizei SamplesToDo)
         }
     );
 
+    if(!ctx->VoiceClusters.empty())
+        MixVoiceClusters(ctx, SamplesToDo);
+
+    /* Mix the buses to the output, and to their effect slots. */
+    std::for_each(buses->begin(), buses->end(),
+        [ctx,SamplesToDo](ALsubmixbus *bus) -> void
+        { MixSubmixBus(bus, ctx->Device, SamplesToDo); }
+    );
+
     /* Process effects. */
     if(auxslots->size() < 1) return;
     auto slots = auxslots->data();
@@ -1528,6 +2176,7 @@ void ProcessContext(ALCcontext *ctx, const ALsizei SamplesToDo)
     std::for_each(sorted_slots, sorted_slots_end,
         [SamplesToDo](const ALeffectslot *slot) -> void
         {
+            if(slot->DirectOut) return;
             EffectState *state{slot->Params.mEffectState};
             state->process(SamplesToDo, slot->WetBuffer, state->mOutBuffer,
                            state->mOutChannels);
@@ -1615,6 +2264,27 @@ void ApplyDistanceComp(ALfloat (*Samples)[BUFFERSIZE], const DistanceComp &distc
     }
 }
 
+void ApplyRenderFade(ALfloat (*Samples)[BUFFERSIZE], const bool fadein,
+                     const ALsizei SamplesToDo, const ALsizei numchans)
+{
+    ASSUME(numchans > 0);
+
+    /* Linearly fade the output in from silence, or out to silence, over the
+     * update.
+     */
+    const ALfloat step{1.0f / static_cast<ALfloat>(SamplesToDo)};
+    auto fade_channel = [fadein,step,SamplesToDo](ALfloat *buffer) -> void
+    {
+        ASSUME(SamplesToDo > 0);
+        for(ALsizei i{0};i < SamplesToDo;i++)
+        {
+            const ALfloat gain{static_cast<ALfloat>(i+1) * step};
+            buffer[i] *= fadein ? gain : (1.0f-gain);
+        }
+    };
+    std::for_each(Samples, Samples+numchans, fade_channel);
+}
+
 void ApplyDither(ALfloat (*Samples)[BUFFERSIZE], ALuint *dither_seed, const ALfloat quant_scale,
                  const ALsizei SamplesToDo, const ALsizei numchans)
 {
@@ -1698,31 +2368,67 @@ void Write(const ALfloat (*InBuffer)[BUFFERSIZE], ALvoid *OutBuffer, ALsizei Off
     std::for_each(InBuffer, InBuffer+numchans, conv_channel);
 }
 
+/* Interleaves and converts samples, writing to an output buffer in the
+ * device's sample type.
+ */
+void WriteSamples(const ALCdevice *device, const ALfloat (*Buffer)[BUFFERSIZE],
+    ALvoid *OutBuffer, ALsizei Offset, ALsizei SamplesToDo, ALsizei Channels)
+{
+    switch(device->FmtType)
+    {
+#define HANDLE_WRITE(T) case T:                                            \
+    Write<T>(Buffer, OutBuffer, Offset, SamplesToDo, Channels); break;
+        HANDLE_WRITE(DevFmtByte)
+        HANDLE_WRITE(DevFmtUByte)
+        HANDLE_WRITE(DevFmtShort)
+        HANDLE_WRITE(DevFmtUShort)
+        HANDLE_WRITE(DevFmtInt)
+        HANDLE_WRITE(DevFmtUInt)
+        HANDLE_WRITE(DevFmtFloat)
+#undef HANDLE_WRITE
+    }
+}
+
 } // namespace
 
 void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
+{
+    aluMixListenerData(device, &OutBuffer, 1, NumSamples);
+}
+
+void aluMixListenerData(ALCdevice *device, ALvoid *const *OutBuffers, ALsizei NumBuffers,
+    ALsizei NumSamples)
 {
     FPUCtl mixer_mode{};
     for(ALsizei SamplesDone{0};SamplesDone < NumSamples;)
     {
         const ALsizei SamplesToDo{mini(NumSamples-SamplesDone, BUFFERSIZE)};
 
-        /* Clear main mixing buffers. */
-        std::for_each(device->MixBuffer.begin(), device->MixBuffer.end(),
-            [SamplesToDo](std::array<ALfloat,BUFFERSIZE> &buffer) -> void
-            { std::fill_n(buffer.begin(), SamplesToDo, 0.0f); }
-        );
+        /* Check if the output is fading around a renderer swap. When fading
+         * in, the output was just replaced.
+         */
+        const RenderFade fade{device->mRenderFade.load(std::memory_order_acquire)};
+
+        /* Clear main mixing buffers, and those of any additional listeners. */
+        auto clear_buffer = [SamplesToDo](std::array<ALfloat,BUFFERSIZE> &buffer) -> void
+        { std::fill_n(buffer.begin(), SamplesToDo, 0.0f); };
+        std::for_each(device->MixBuffer.begin(), device->MixBuffer.end(), clear_buffer);
+        for(auto &output : device->ListenerOuts)
+            std::for_each(output->MixBuffer.begin(), output->MixBuffer.end(), clear_buffer);
 
         /* Increment the mix count at the start (lsb should now be 1). */
         IncrementRef(&device->MixCount);
 
         /* For each context on this device, process and mix its sources and
-         * effects.
+         * effects. While the output is silent waiting for a renderer swap,
+         * nothing is processed so the sources and effects hold their place
+         * instead of advancing unheard.
          */
-        ALCcontext *ctx{device->ContextList.load(std::memory_order_acquire)};
+        ALCcontext *ctx{(fade == RenderFade::Silent) ? nullptr :
+            device->ContextList.load(std::memory_order_acquire)};
         while(ctx)
         {
-            ProcessContext(ctx, SamplesToDo);
+            ProcessContext(ctx, SamplesToDo, fade == RenderFade::FadeIn);
 
             ctx = ctx->next.load(std::memory_order_relaxed);
         }
@@ -1765,6 +2471,26 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
         ApplyDistanceComp(device->RealOut.Buffer, device->ChannelDelay, SamplesToDo,
             device->RealOut.NumChannels);
 
+        /* Fade the output out or in around a renderer swap. */
+        if(UNLIKELY(fade != RenderFade::None))
+        {
+            if(fade == RenderFade::Silent)
+                std::for_each(device->RealOut.Buffer,
+                    device->RealOut.Buffer+device->RealOut.NumChannels,
+                    [SamplesToDo](ALfloat *buffer) -> void
+                    { std::fill_n(buffer, SamplesToDo, 0.0f); }
+                );
+            else
+            {
+                ApplyRenderFade(device->RealOut.Buffer, fade == RenderFade::FadeIn,
+                    SamplesToDo, device->RealOut.NumChannels);
+                RenderFade oldfade{fade};
+                device->mRenderFade.compare_exchange_strong(oldfade,
+                    (fade == RenderFade::FadeOut) ? RenderFade::Silent : RenderFade::None,
+                    std::memory_order_acq_rel);
+            }
+        }
+
         /* Apply dithering. The compressor should have left enough headroom for
          * the dither noise to not saturate.
          */
@@ -1772,27 +2498,35 @@ void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples)
             ApplyDither(device->RealOut.Buffer, &device->DitherSeed, device->DitherDepth,
                 SamplesToDo, device->RealOut.NumChannels);
 
-        if(LIKELY(OutBuffer))
+        /* Finally, interleave and convert samples, writing to the device's
+         * output buffer.
+         */
+        if(LIKELY(OutBuffers[0]))
+            WriteSamples(device, device->RealOut.Buffer, OutBuffers[0], SamplesDone, SamplesToDo,
+                device->RealOut.NumChannels);
+
+        /* Finish the additional listeners' output the same way, writing each
+         * to its own buffer.
+         */
+        for(size_t i{0};i < device->ListenerOuts.size();i++)
         {
-            ALfloat (*Buffer)[BUFFERSIZE]{device->RealOut.Buffer};
-            ALsizei Channels{device->RealOut.NumChannels};
+            ListenerOutput *output{device->ListenerOuts[i].get()};
+            ALfloat (*RealBuffer)[BUFFERSIZE]{GetListenerBuffer(device, output,
+                device->RealOut.Buffer)};
+
+            ProcessListenerOutput(device, output, SamplesToDo);
+            if(UNLIKELY(fade == RenderFade::Silent))
+                std::for_each(RealBuffer, RealBuffer+device->RealOut.NumChannels,
+                    [SamplesToDo](ALfloat *buffer) -> void
+                    { std::fill_n(buffer, SamplesToDo, 0.0f); }
+                );
+            else if(UNLIKELY(fade != RenderFade::None))
+                ApplyRenderFade(RealBuffer, fade == RenderFade::FadeIn, SamplesToDo,
+                    device->RealOut.NumChannels);
 
-            /* Finally, interleave and convert samples, writing to the device's
-             * output buffer.
-             */
-            switch(device->FmtType)
-            {
-#define HANDLE_WRITE(T) case T:                                            \
-    Write<T>(Buffer, OutBuffer, SamplesDone, SamplesToDo, Channels); break;
-                HANDLE_WRITE(DevFmtByte)
-                HANDLE_WRITE(DevFmtUByte)
-                HANDLE_WRITE(DevFmtShort)
-                HANDLE_WRITE(DevFmtUShort)
-                HANDLE_WRITE(DevFmtInt)
-                HANDLE_WRITE(DevFmtUInt)
-                HANDLE_WRITE(DevFmtFloat)
-#undef HANDLE_WRITE
-            }
+            if(static_cast<ALsizei>(i+1) < NumBuffers && OutBuffers[i+1])
+                WriteSamples(device, RealBuffer, OutBuffers[i+1], SamplesDone, SamplesToDo,
+                    device->RealOut.NumChannels);
         }
 
         SamplesDone += SamplesToDo;
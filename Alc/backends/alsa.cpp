@@ -38,6 +38,7 @@
 #include "alconfig.h"
 #include "ringbuffer.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #include <alsa/asoundlib.h>
 
@@ -460,6 +461,7 @@ int AlsaPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     snd_pcm_uframes_t update_size{mDevice->UpdateSize};
     snd_pcm_uframes_t num_updates{mDevice->NumUpdates};
@@ -543,6 +545,7 @@ int AlsaPlayback::mixerNoMMapProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     snd_pcm_uframes_t update_size{mDevice->UpdateSize};
     snd_pcm_uframes_t num_updates{mDevice->NumUpdates};
@@ -55,6 +55,25 @@ using BackendPtr = std::unique_ptr<BackendBase>;
 using BackendUniqueLock = std::unique_lock<BackendBase>;
 using BackendLockGuard = std::lock_guard<BackendBase>;
 
+/* Locks a device's backend without holding the device's StateLock. Holds off
+ * alcReopenDeviceSOFT from replacing the backend while it's locked.
+ */
+class DeviceBackendLock {
+    std::unique_lock<std::mutex> mSwapLock;
+    BackendUniqueLock mBackendLock;
+
+public:
+    explicit DeviceBackendLock(ALCdevice *device)
+      : mSwapLock{device->BackendSwapLock}, mBackendLock{*device->Backend}
+    { }
+
+    void unlock()
+    {
+        mBackendLock.unlock();
+        mSwapLock.unlock();
+    }
+};
+
 enum class BackendType {
     Playback,
     Capture
@@ -44,6 +44,7 @@
 #include "alu.h"
 #include "ringbuffer.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 /* MinGW-w64 needs this for some unknown reason now. */
 using LPCWAVEFORMATEX = const WAVEFORMATEX*;
@@ -234,6 +235,7 @@ FORCE_ALIGN int DSoundPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     DSBCAPS DSBCaps{};
     DSBCaps.dwSize = sizeof(DSBCaps);
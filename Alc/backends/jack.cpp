@@ -35,6 +35,7 @@
 #include "ringbuffer.h"
 #include "threads.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #include <jack/jack.h>
 #include <jack/ringbuffer.h>
@@ -299,6 +300,7 @@ int JackPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     lock();
     while(!mKillNow.load(std::memory_order_acquire) &&
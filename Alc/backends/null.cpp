@@ -34,6 +34,7 @@
 #include "alMain.h"
 #include "alu.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 
 namespace {
@@ -68,6 +69,7 @@ int NullBackend::mixerProc()
 
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     int64_t done{0};
     auto start = std::chrono::steady_clock::now();
@@ -35,6 +35,7 @@
 #include "ringbuffer.h"
 #include "threads.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #include <SLES/OpenSLES.h>
 #include <SLES/OpenSLES_Android.h>
@@ -217,6 +218,7 @@ int OpenSLPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     SLPlayItf player;
     SLAndroidSimpleBufferQueueItf bufferQueue;
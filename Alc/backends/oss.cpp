@@ -48,6 +48,7 @@
 #include "alconfig.h"
 #include "ringbuffer.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #include <sys/soundcard.h>
 
@@ -276,6 +277,7 @@ int OSSPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     const int frame_size{mDevice->frameSizeFromFmt()};
 
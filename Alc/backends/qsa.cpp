@@ -36,6 +36,7 @@
 #include "alMain.h"
 #include "alu.h"
 #include "threads.h"
+#include "fpu_modes.h"
 
 #include <sys/asoundlib.h>
 #include <sys/neutrino.h>
@@ -199,6 +200,7 @@ FORCE_ALIGN static int qsa_proc_playback(void *ptr)
 
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     /* Increase default 10 priority to 11 to avoid jerky sound */
     SchedGet(0, 0, &param);
@@ -34,6 +34,7 @@
 #include "threads.h"
 #include "vector.h"
 #include "ringbuffer.h"
+#include "fpu_modes.h"
 
 #include <sndio.h>
 
@@ -76,6 +77,7 @@ int SndioPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     const ALsizei frameSize{mDevice->frameSizeFromFmt()};
 
@@ -44,6 +44,7 @@
 #include "threads.h"
 #include "vector.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #include <sys/audioio.h>
 
@@ -88,6 +89,7 @@ int SolarisBackend::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     const int frame_size{mDevice->frameSizeFromFmt()};
 
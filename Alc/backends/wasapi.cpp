@@ -52,6 +52,7 @@
 #include "ringbuffer.h"
 #include "compat.h"
 #include "converter.h"
+#include "fpu_modes.h"
 
 
 /* Some headers seem to define these as macros for __uuidof, which is annoying
@@ -566,6 +567,7 @@ FORCE_ALIGN int WasapiPlayback::mixerProc()
 
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     const ALuint update_size{mDevice->UpdateSize};
     const UINT32 buffer_len{update_size * mDevice->NumUpdates};
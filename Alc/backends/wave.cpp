@@ -36,6 +36,7 @@
 #include "alu.h"
 #include "alconfig.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 
 namespace {
@@ -114,6 +115,7 @@ int WaveBackend::mixerProc()
     const milliseconds restTime{mDevice->UpdateSize*1000/mDevice->Frequency / 2};
 
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     const ALsizei frameSize{mDevice->frameSizeFromFmt()};
 
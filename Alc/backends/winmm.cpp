@@ -42,6 +42,7 @@
 #include "ringbuffer.h"
 #include "threads.h"
 #include "compat.h"
+#include "fpu_modes.h"
 
 #ifndef WAVE_FORMAT_IEEE_FLOAT
 #define WAVE_FORMAT_IEEE_FLOAT  0x0003
@@ -182,6 +183,7 @@ FORCE_ALIGN int WinMMPlayback::mixerProc()
 {
     SetRTPriority();
     althrd_setname(MIXER_THREAD_NAME);
+    FPUCtl::setThreadMode();
 
     lock();
     while(!mKillNow.load(std::memory_order_acquire) &&
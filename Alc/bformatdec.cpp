@@ -183,6 +183,34 @@ void BFormatDec::reset(const ALsizei inchans, const ALfloat xover_norm, const AL
 }
 
 
+void BFormatDec::reset(const BFormatDec &rhs)
+{
+    mEnabled = rhs.mEnabled;
+    mMatrix = rhs.mMatrix;
+    mNumChannels = rhs.mNumChannels;
+    mDualBand = rhs.mDualBand;
+
+    mSamples.clear();
+    mSamples.resize(rhs.mSamples.size());
+    mSamplesHF = nullptr;
+    mSamplesLF = nullptr;
+    if(mDualBand)
+    {
+        mSamplesHF = mSamples.data();
+        mSamplesLF = mSamplesHF + mNumChannels;
+    }
+
+    std::copy(std::begin(rhs.mXOver), std::end(rhs.mXOver), std::begin(mXOver));
+    std::for_each(std::begin(mXOver), std::end(mXOver), std::mem_fn(&BandSplitter::clear));
+    std::copy(std::begin(rhs.mUpAllpass), std::end(rhs.mUpAllpass), std::begin(mUpAllpass));
+    std::for_each(std::begin(mUpAllpass), std::end(mUpAllpass),
+        std::mem_fn(&SplitterAllpass::clear));
+    std::copy(std::begin(rhs.mUpsampler), std::end(rhs.mUpsampler), std::begin(mUpsampler));
+    for(auto &upsampler : mUpsampler)
+        upsampler.Splitter.clear();
+}
+
+
 void BFormatDec::process(ALfloat (*OutBuffer)[BUFFERSIZE], const ALsizei OutChannels, const ALfloat (*InSamples)[BUFFERSIZE], const ALsizei SamplesToDo)
 {
     ASSUME(OutChannels > 0);
@@ -287,6 +315,15 @@ void AmbiUpsampler::reset(const ALsizei out_order, const ALfloat xover_norm)
     std::fill(std::begin(mAllpass)+1, std::end(mAllpass), mAllpass[0]);
 }
 
+void AmbiUpsampler::reset(const AmbiUpsampler &rhs)
+{
+    std::copy(std::begin(rhs.mAllpass), std::end(rhs.mAllpass), std::begin(mAllpass));
+    std::for_each(std::begin(mAllpass), std::end(mAllpass), std::mem_fn(&SplitterAllpass::clear));
+    std::copy(std::begin(rhs.mInput), std::end(rhs.mInput), std::begin(mInput));
+    for(auto &input : mInput)
+        input.Splitter.clear();
+}
+
 void AmbiUpsampler::process(ALfloat (*OutBuffer)[BUFFERSIZE], const ALsizei OutChannels, const ALfloat (*InSamples)[BUFFERSIZE], const ALsizei InChannels, const ALsizei SamplesToDo)
 {
     ASSUME(InChannels > 0);
@@ -46,6 +46,9 @@ public:
 
     void reset(const ALsizei inchans, const ALfloat xover_norm, const ALsizei chancount, const ChannelDec (&chancoeffs)[MAX_OUTPUT_CHANNELS], const ALsizei (&chanmap)[MAX_OUTPUT_CHANNELS]);
 
+    /* Copies another decoder's configuration, with cleared filter history. */
+    void reset(const BFormatDec &rhs);
+
     /* Decodes the ambisonic input to the given output channels. */
     void process(ALfloat (*OutBuffer)[BUFFERSIZE], const ALsizei OutChannels, const ALfloat (*InSamples)[BUFFERSIZE], const ALsizei SamplesToDo);
 
@@ -73,6 +76,7 @@ class AmbiUpsampler {
 
 public:
     void reset(const ALsizei out_order, const ALfloat xover_norm);
+    void reset(const AmbiUpsampler &rhs);
     void process(ALfloat (*OutBuffer)[BUFFERSIZE], const ALsizei OutChannels, const ALfloat (*InSamples)[BUFFERSIZE], const ALsizei InChannels, const ALsizei SamplesToDo);
 
     static std::array<ALfloat,MAX_AMBI_ORDER+1> GetHFOrderScales(const ALsizei in_order, const ALsizei out_order) noexcept;
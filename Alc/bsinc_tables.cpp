@@ -0,0 +1,320 @@
+/*
+ * Sinc interpolator coefficient and delta generator for the OpenAL Soft
+ * cross platform audio library.
+ *
+ * Copyright (C) 2015 by Christopher Fitzgerald.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+ *
+ * Or visit:  http://www.gnu.org/licenses/old-licenses/lgpl-2.0.html
+ *
+ * --------------------------------------------------------------------------
+ *
+ * This is a modified version of the bandlimited windowed sinc interpolator
+ * algorithm presented here:
+ *
+ *   Smith, J.O. "Windowed Sinc Interpolation", in
+ *   Physical Audio Signal Processing,
+ *   https://ccrma.stanford.edu/~jos/pasp/Windowed_Sinc_Interpolation.html,
+ *   online book,
+ *   accessed October 2012.
+ */
+
+#include "config.h"
+
+#include "bsinc_tables.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "math_defs.h"
+#include "vector.h"
+
+
+namespace {
+
+/* The number of coefficients for each scale is padded to a multiple of the
+ * widest SIMD vector used by the resamplers (4 floats for SSE and NEON).
+ */
+constexpr ALsizei BSincPointsAlign{4};
+
+
+/* NOTE: This is the normalized (instead of just sin(x)/x) cardinal sine
+ *       function.
+ *       2 f_t sinc(2 f_t x)
+ *       f_t -- normalized transition frequency (0.5 is nyquist)
+ *       x   -- sample index (-N to N)
+ */
+double Sinc(const double x)
+{
+    if(std::fabs(x) < 1e-15)
+        return 1.0;
+    return std::sin(al::MathDefs<double>::Pi()*x) / (al::MathDefs<double>::Pi()*x);
+}
+
+double BesselI_0(const double x)
+{
+    double term{1.0}, sum{1.0}, last_sum;
+    const double x2{x / 2.0};
+    int i{1};
+    do {
+        const double y{x2 / i};
+        i++;
+        last_sum = sum;
+        term *= y * y;
+        sum += term;
+    } while(sum != last_sum);
+    return sum;
+}
+
+/* NOTE: k is assumed normalized (-1 to 1)
+ *       beta is equivalent to 2 alpha
+ */
+double Kaiser(const double b, const double k)
+{
+    if(!(k >= -1.0 && k <= 1.0))
+        return 0.0;
+    return BesselI_0(b * std::sqrt(1.0 - k*k)) / BesselI_0(b);
+}
+
+/* Calculates the (normalized frequency) transition width of the Kaiser window.
+ * Rejection is in dB.
+ */
+double CalcKaiserWidth(const double rejection, const int order)
+{
+    const double w_t{2.0 * al::MathDefs<double>::Pi()};
+
+    if(rejection > 21.0)
+       return (rejection - 7.95) / (order * 2.285 * w_t);
+    /* This enforces a minimum rejection of just above 21.18dB */
+    return 5.79 / (order * w_t);
+}
+
+double CalcKaiserBeta(const double rejection)
+{
+    if(rejection > 50.0)
+       return 0.1102 * (rejection - 8.7);
+    else if(rejection >= 21.0)
+       return (0.5842 * std::pow(rejection - 21.0, 0.4)) +
+              (0.07886 * (rejection - 21.0));
+    return 0.0;
+}
+
+
+/* Windowing parameters and the per-scale filter sizes for a table. The width
+ * describes the transition band, but it may vary due to the linear
+ * interpolation between scales of the filter.
+ */
+struct BSincHeader {
+    double width;
+    double beta;
+    double scaleBase;
+    double scaleRange;
+
+    int num_points_min;
+    double a[BSINC_SCALE_COUNT];
+    ALsizei m[BSINC_SCALE_COUNT];
+    ALsizei total_size;
+
+    BSincHeader(const double rejection, const int order)
+    {
+        width = CalcKaiserWidth(rejection, order);
+        beta = CalcKaiserBeta(rejection);
+        scaleBase = width / 2.0;
+        scaleRange = 1.0 - scaleBase;
+
+        num_points_min = order + 1;
+        total_size = 0;
+        for(ALsizei si{0};si < BSINC_SCALE_COUNT;si++)
+        {
+            const double scale{scaleBase + (scaleRange * si / (BSINC_SCALE_COUNT - 1))};
+            a[si] = std::min(std::floor(num_points_min / (2.0 * scale)),
+                static_cast<double>(num_points_min));
+            m[si] = 2 * static_cast<ALsizei>(a[si]);
+            total_size += 4 * BSINC_PHASE_COUNT *
+                ((m[si]+BSincPointsAlign-1) & ~(BSincPointsAlign-1));
+        }
+    }
+};
+
+/* 7th order filter with a -30dB drop at nyquist. */
+const BSincHeader bsinc8_hdr{30.0, 7};
+/* 11th order filter with a -40dB drop at nyquist. */
+const BSincHeader bsinc12_hdr{40.0, 11};
+/* 23rd order filter with a -60dB drop at nyquist. */
+const BSincHeader bsinc24_hdr{60.0, 23};
+/* 47th order filter with a -80dB drop at nyquist. */
+const BSincHeader bsinc48_hdr{80.0, 47};
+
+
+/* Generates the coefficient and delta tables required by the bsinc resampler.
+ * For each scale and phase, the filter coefficients are followed by the scale,
+ * phase, and scale-phase deltas.
+ */
+al::vector<ALfloat,16> GenerateBSincCoeffs(const BSincHeader &hdr)
+{
+    /* Filters are centered within the widest (2*num_points_min) span, so
+     * different scales line up for calculating the scale deltas. Extra space
+     * is left on both sides for padding the rows.
+     */
+    const ALsizei points_max{hdr.num_points_min*2 + BSincPointsAlign};
+    auto make_table = [points_max](const ALsizei phases) -> al::vector<double>
+    { return al::vector<double>(BSINC_SCALE_COUNT * phases * points_max, 0.0); };
+    al::vector<double> filter{make_table(BSINC_PHASE_COUNT+1)};
+    al::vector<double> phDeltas{make_table(BSINC_PHASE_COUNT+1)};
+    al::vector<double> scDeltas{make_table(BSINC_PHASE_COUNT)};
+    al::vector<double> spDeltas{make_table(BSINC_PHASE_COUNT)};
+    auto at = [points_max](al::vector<double> &tab, const ALsizei phases, const ALsizei si,
+        const ALsizei pi) -> double*
+    { return &tab[(si*phases + pi)*points_max + BSincPointsAlign/2]; };
+
+    /* Calculate the Kaiser-windowed Sinc filter coefficients for each scale
+     * and phase.
+     */
+    for(ALsizei si{0};si < BSINC_SCALE_COUNT;si++)
+    {
+        const ALsizei m{hdr.m[si]};
+        const ALsizei o{hdr.num_points_min - (m / 2)};
+        const ALsizei l{(m / 2) - 1};
+        const double a{hdr.a[si]};
+        const double scale{hdr.scaleBase + (hdr.scaleRange * si / (BSINC_SCALE_COUNT - 1))};
+        const double cutoff{(0.5 * scale) - (hdr.scaleBase * std::max(0.5, scale))};
+
+        for(ALsizei pi{0};pi <= BSINC_PHASE_COUNT;pi++)
+        {
+            const double phase{l + (static_cast<double>(pi) / BSINC_PHASE_COUNT)};
+            double *fil{at(filter, BSINC_PHASE_COUNT+1, si, pi)};
+            for(ALsizei i{0};i < m;i++)
+            {
+                const double x{i - phase};
+                fil[o+i] = Kaiser(hdr.beta, x / a) * 2.0 * cutoff * Sinc(2.0 * cutoff * x);
+            }
+        }
+    }
+
+    /* Linear interpolation between scales is simplified by pre-calculating
+     * the delta (b - a) in: x = a + f (b - a)
+     *
+     * Given a difference in points between scales, the destination points
+     * will be 0, thus: x = a + f (-a)
+     */
+    for(ALsizei si{0};si < (BSINC_SCALE_COUNT - 1);si++)
+    {
+        const ALsizei m{hdr.m[si]};
+        const ALsizei o{hdr.num_points_min - (m / 2)};
+
+        for(ALsizei pi{0};pi < BSINC_PHASE_COUNT;pi++)
+        {
+            const double *fil0{at(filter, BSINC_PHASE_COUNT+1, si, pi)};
+            const double *fil1{at(filter, BSINC_PHASE_COUNT+1, si+1, pi)};
+            double *scd{at(scDeltas, BSINC_PHASE_COUNT, si, pi)};
+            for(ALsizei i{0};i < m;i++)
+                scd[o+i] = fil1[o+i] - fil0[o+i];
+        }
+    }
+
+    /* Linear interpolation between phases is also simplified. */
+    for(ALsizei si{0};si < BSINC_SCALE_COUNT;si++)
+    {
+        const ALsizei m{hdr.m[si]};
+        const ALsizei o{hdr.num_points_min - (m / 2)};
+
+        for(ALsizei pi{0};pi < BSINC_PHASE_COUNT;pi++)
+        {
+            const double *fil0{at(filter, BSINC_PHASE_COUNT+1, si, pi)};
+            const double *fil1{at(filter, BSINC_PHASE_COUNT+1, si, pi+1)};
+            double *phd{at(phDeltas, BSINC_PHASE_COUNT+1, si, pi)};
+            for(ALsizei i{0};i < m;i++)
+                phd[o+i] = fil1[o+i] - fil0[o+i];
+        }
+    }
+
+    /* This last simplification is done to complete the bilinear equation for
+     * the combination of scale and phase.
+     */
+    for(ALsizei si{0};si < (BSINC_SCALE_COUNT - 1);si++)
+    {
+        const ALsizei m{hdr.m[si]};
+        const ALsizei o{hdr.num_points_min - (m / 2)};
+
+        for(ALsizei pi{0};pi < BSINC_PHASE_COUNT;pi++)
+        {
+            const double *phd0{at(phDeltas, BSINC_PHASE_COUNT+1, si, pi)};
+            const double *phd1{at(phDeltas, BSINC_PHASE_COUNT+1, si+1, pi)};
+            double *spd{at(spDeltas, BSINC_PHASE_COUNT, si, pi)};
+            for(ALsizei i{0};i < m;i++)
+                spd[o+i] = phd1[o+i] - phd0[o+i];
+        }
+    }
+
+    /* Write out the rows, padded with zeros. The padded rows stay centered,
+     * matching the left offset BsincPrepare calculates from the padded size.
+     */
+    al::vector<ALfloat,16> ret(hdr.total_size, 0.0f);
+    auto dst = ret.begin();
+    for(ALsizei si{0};si < BSINC_SCALE_COUNT;si++)
+    {
+        const ALsizei m{(hdr.m[si]+BSincPointsAlign-1) & ~(BSincPointsAlign-1)};
+        const ALsizei o{hdr.num_points_min - (m / 2)};
+        auto copy_row = [&dst,m,o](const double *row) -> void
+        {
+            dst = std::transform(row+o, row+o+m, dst,
+                [](const double val) noexcept -> ALfloat { return static_cast<ALfloat>(val); });
+        };
+
+        for(ALsizei pi{0};pi < BSINC_PHASE_COUNT;pi++)
+        {
+            copy_row(at(filter, BSINC_PHASE_COUNT+1, si, pi));
+            copy_row(at(scDeltas, BSINC_PHASE_COUNT, si, pi));
+            copy_row(at(phDeltas, BSINC_PHASE_COUNT+1, si, pi));
+            copy_row(at(spDeltas, BSINC_PHASE_COUNT, si, pi));
+        }
+    }
+    return ret;
+}
+
+/* The scaleBase is calculated from the Kaiser window transition width. It
+ * represents the absolute limit to the filter before it fully cuts the
+ * signal. The limit in octaves can be calculated by taking the base-2
+ * logarithm of its inverse: log_2(1 / scaleBase)
+ */
+BSincTable GenerateBSincTable(const BSincHeader &hdr, const ALfloat *tab)
+{
+    BSincTable ret{};
+    ret.scaleBase = static_cast<ALfloat>(hdr.scaleBase);
+    ret.scaleRange = static_cast<ALfloat>(1.0 / hdr.scaleRange);
+    ALsizei offset{0};
+    for(ALsizei si{0};si < BSINC_SCALE_COUNT;si++)
+    {
+        ret.m[si] = (hdr.m[si]+BSincPointsAlign-1) & ~(BSincPointsAlign-1);
+        ret.filterOffset[si] = offset;
+        offset += 4 * BSINC_PHASE_COUNT * ret.m[si];
+    }
+    ret.Tab = tab;
+    return ret;
+}
+
+const al::vector<ALfloat,16> bsinc8_tab{GenerateBSincCoeffs(bsinc8_hdr)};
+const al::vector<ALfloat,16> bsinc12_tab{GenerateBSincCoeffs(bsinc12_hdr)};
+const al::vector<ALfloat,16> bsinc24_tab{GenerateBSincCoeffs(bsinc24_hdr)};
+const al::vector<ALfloat,16> bsinc48_tab{GenerateBSincCoeffs(bsinc48_hdr)};
+
+} // namespace
+
+const BSincTable bsinc8{GenerateBSincTable(bsinc8_hdr, bsinc8_tab.data())};
+const BSincTable bsinc12{GenerateBSincTable(bsinc12_hdr, bsinc12_tab.data())};
+const BSincTable bsinc24{GenerateBSincTable(bsinc24_hdr, bsinc24_tab.data())};
+const BSincTable bsinc48{GenerateBSincTable(bsinc48_hdr, bsinc48_tab.data())};
@@ -0,0 +1,25 @@
+#ifndef BSINC_TABLES_H
+#define BSINC_TABLES_H
+
+#include "AL/al.h"
+
+#include "alu.h"
+
+
+struct BSincTable {
+    ALfloat scaleBase, scaleRange;
+    ALsizei m[BSINC_SCALE_COUNT];
+    ALsizei filterOffset[BSINC_SCALE_COUNT];
+    const ALfloat *Tab;
+};
+
+/* Band-limited sinc filter tables of increasing quality and cost. The number
+ * is the filter length in samples, which doubles when downsampling by up to
+ * an octave.
+ */
+extern const BSincTable bsinc8;
+extern const BSincTable bsinc12;
+extern const BSincTable bsinc24;
+extern const BSincTable bsinc48;
+
+#endif /* BSINC_TABLES_H */
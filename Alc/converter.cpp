@@ -160,10 +160,8 @@ SampleConverterPtr CreateSampleConverter(DevFmtType srcType, DevFmtType dstType,
         converter->mResample = Resample_<CopyTag,CTag>;
     else
     {
-        if(resampler == BSinc24Resampler)
-            BsincPrepare(converter->mIncrement, &converter->mState.bsinc, &bsinc24);
-        else if(resampler == BSinc12Resampler)
-            BsincPrepare(converter->mIncrement, &converter->mState.bsinc, &bsinc12);
+        if(const BSincTable *table{GetBSincTable(resampler)})
+            BsincPrepare(converter->mIncrement, &converter->mState.bsinc, table);
         converter->mResample = SelectResampler(resampler);
     }
 
@@ -23,6 +23,7 @@
 #include <cmath>
 #include <cstdlib>
 
+#include <array>
 #include <algorithm>
 
 #include "alMain.h"
@@ -37,6 +38,29 @@
 #define MAX_FREQ 2500.0f
 #define Q_FACTOR 5.0f
 
+namespace {
+
+/* The swept filter's sine and cosine components are looked up from a table
+ * covering one period, with linear interpolation between entries. This keeps
+ * the error below 5e-6, which is plenty for a continuously modulated filter.
+ */
+#define SINTABLE_BITS 10
+#define SINTABLE_SIZE (1<<SINTABLE_BITS)
+#define SINTABLE_MASK (SINTABLE_SIZE-1)
+
+std::array<ALfloat,SINTABLE_SIZE+1> InitSinTable()
+{
+    std::array<ALfloat,SINTABLE_SIZE+1> ret;
+    for(ALsizei i{0};i < SINTABLE_SIZE;i++)
+        ret[i] = static_cast<ALfloat>(std::sin(al::MathDefs<double>::Tau() * i /
+            double{SINTABLE_SIZE}));
+    ret[SINTABLE_SIZE] = ret[0];
+    return ret;
+}
+const std::array<ALfloat,SINTABLE_SIZE+1> SinTable = InitSinTable();
+
+} // namespace
+
 struct ALautowahState final : public EffectState {
     /* Effect parameters */
     ALfloat mAttackRate;
@@ -47,25 +71,29 @@ struct ALautowahState final : public EffectState {
     ALfloat mBandwidthNorm;
     ALfloat mEnvDelay;
 
-    /* Filter components derived from the envelope. */
+    /* Normalized filter frequency derived from the envelope, and the
+     * resulting filter coefficients (a1 is the same as b1 for a peaking
+     * filter).
+     */
+    alignas(16) ALfloat mEnvFreq[BUFFERSIZE];
     struct {
-        ALfloat cos_w0;
-        ALfloat alpha;
+        ALfloat b0, b1, b2, a2;
     } mEnv[BUFFERSIZE];
 
-    struct {
-        /* Effect filters' history. */
-        struct {
-            ALfloat z1, z2;
-        } Filter;
+    /* Effect filters' history, for each channel. These are processed in
+     * lockstep since every channel uses the same coefficients.
+     */
+    alignas(16) ALfloat mZ1[MAX_EFFECT_CHANNELS];
+    alignas(16) ALfloat mZ2[MAX_EFFECT_CHANNELS];
 
+    struct {
         /* Effect gains for each output channel */
         ALfloat CurrentGains[MAX_OUTPUT_CHANNELS];
         ALfloat TargetGains[MAX_OUTPUT_CHANNELS];
     } mChans[MAX_EFFECT_CHANNELS];
 
     /* Effects buffers */
-    alignas(16) ALfloat mBufferOut[BUFFERSIZE];
+    alignas(16) ALfloat mBufferOut[MAX_EFFECT_CHANNELS][BUFFERSIZE];
 
 
     ALboolean deviceUpdate(const ALCdevice *device) override;
@@ -87,18 +115,10 @@ ALboolean ALautowahState::deviceUpdate(const ALCdevice *UNUSED(device))
     mBandwidthNorm = 0.05f;
     mEnvDelay      = 0.0f;
 
-    for(auto &e : mEnv)
-    {
-        e.cos_w0 = 0.0f;
-        e.alpha = 0.0f;
-    }
-
+    std::fill(std::begin(mZ1), std::end(mZ1), 0.0f);
+    std::fill(std::begin(mZ2), std::end(mZ2), 0.0f);
     for(auto &chan : mChans)
-    {
         std::fill(std::begin(chan.CurrentGains), std::end(chan.CurrentGains), 0.0f);
-        chan.Filter.z1 = 0.0f;
-        chan.Filter.z2 = 0.0f;
-    }
 
     return AL_TRUE;
 }
@@ -140,7 +160,7 @@ void ALautowahState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT Sampl
     env_delay = mEnvDelay;
     for(i = 0;i < SamplesToDo;i++)
     {
-        ALfloat w0, sample, a;
+        ALfloat sample, a;
 
         /* Envelope follower described on the book: Audio Effects, Theory,
          * Implementation and Application.
@@ -149,51 +169,62 @@ void ALautowahState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT Sampl
         a = (sample > env_delay) ? attack_rate : release_rate;
         env_delay = lerp(sample, env_delay, a);
 
-        /* Calculate the cos and alpha components for this sample's filter. */
-        w0 = minf((bandwidth*env_delay + freq_min), 0.46f) * al::MathDefs<float>::Tau();
-        mEnv[i].cos_w0 = cosf(w0);
-        mEnv[i].alpha = sinf(w0)/(2.0f * Q_FACTOR);
+        mEnvFreq[i] = minf((bandwidth*env_delay + freq_min), 0.46f);
     }
     mEnvDelay = env_delay;
 
-    for(c = 0;c < MAX_EFFECT_CHANNELS; c++)
+    /* Calculate this sample's filter coefficients from the envelope. This
+     * effectively inlines BiquadFilter_setParams for a peaking filter, with
+     * the sine and cosine of the frequency taken from the lookup table.
+     */
+    const ALfloat rcp_res_gain{1.0f / res_gain};
+    for(i = 0;i < SamplesToDo;i++)
     {
-        /* This effectively inlines BiquadFilter_setParams for a peaking
-         * filter and BiquadFilter_processC. The alpha and cosine components
-         * for the filter coefficients were previously calculated with the
-         * envelope. Because the filter changes for each sample, the
-         * coefficients are transient and don't need to be held.
-         */
-        ALfloat z1 = mChans[c].Filter.z1;
-        ALfloat z2 = mChans[c].Filter.z2;
+        const ALfloat pos{mEnvFreq[i] * ALfloat{SINTABLE_SIZE}};
+        const ALsizei idx{float2int(pos)};
+        const ALfloat frac{pos - static_cast<ALfloat>(idx)};
+        const ALsizei cidx{(idx + SINTABLE_SIZE/4) & SINTABLE_MASK};
+        const ALfloat sin_w0{lerp(SinTable[idx], SinTable[idx+1], frac)};
+        const ALfloat cos_w0{lerp(SinTable[cidx], SinTable[cidx+1], frac)};
+        const ALfloat alpha{sin_w0 * (0.5f/Q_FACTOR)};
+
+        const ALfloat a0_rcp{1.0f / (1.0f + alpha*rcp_res_gain)};
+        mEnv[i].b0 = (1.0f + alpha*res_gain) * a0_rcp;
+        mEnv[i].b1 = -2.0f * cos_w0 * a0_rcp;
+        mEnv[i].b2 = (1.0f - alpha*res_gain) * a0_rcp;
+        mEnv[i].a2 = (1.0f - alpha*rcp_res_gain) * a0_rcp;
+    }
 
-        for(i = 0;i < SamplesToDo;i++)
+    /* Because the filter changes for each sample, the coefficients are
+     * transient and don't need to be held. All channels use the same
+     * coefficients, so they're filtered together.
+     */
+    alignas(16) ALfloat z1[MAX_EFFECT_CHANNELS];
+    alignas(16) ALfloat z2[MAX_EFFECT_CHANNELS];
+    std::copy(std::begin(mZ1), std::end(mZ1), std::begin(z1));
+    std::copy(std::begin(mZ2), std::end(mZ2), std::begin(z2));
+    for(i = 0;i < SamplesToDo;i++)
+    {
+        const ALfloat b0{mEnv[i].b0};
+        const ALfloat b1{mEnv[i].b1};
+        const ALfloat b2{mEnv[i].b2};
+        const ALfloat a2{mEnv[i].a2};
+        for(c = 0;c < MAX_EFFECT_CHANNELS;c++)
         {
-            const ALfloat alpha = mEnv[i].alpha;
-            const ALfloat cos_w0 = mEnv[i].cos_w0;
-            ALfloat input, output;
-            ALfloat a[3], b[3];
-
-            b[0] =  1.0f + alpha*res_gain;
-            b[1] = -2.0f * cos_w0;
-            b[2] =  1.0f - alpha*res_gain;
-            a[0] =  1.0f + alpha/res_gain;
-            a[1] = -2.0f * cos_w0;
-            a[2] =  1.0f - alpha/res_gain;
-
-            input = SamplesIn[c][i];
-            output = input*(b[0]/a[0]) + z1;
-            z1 = input*(b[1]/a[0]) - output*(a[1]/a[0]) + z2;
-            z2 = input*(b[2]/a[0]) - output*(a[2]/a[0]);
-            mBufferOut[i] = output;
+            const ALfloat input{SamplesIn[c][i]};
+            const ALfloat output{input*b0 + z1[c]};
+            z1[c] = (input - output)*b1 + z2[c];
+            z2[c] = input*b2 - output*a2;
+            mBufferOut[c][i] = output;
         }
-        mChans[c].Filter.z1 = z1;
-        mChans[c].Filter.z2 = z2;
+    }
+    std::copy(std::begin(z1), std::end(z1), std::begin(mZ1));
+    std::copy(std::begin(z2), std::end(z2), std::begin(mZ2));
 
-        /* Now, mix the processed sound data to the output. */
-        MixSamples(mBufferOut, NumChannels, SamplesOut, mChans[c].CurrentGains,
+    /* Now, mix the processed sound data to the output. */
+    for(c = 0;c < MAX_EFFECT_CHANNELS;c++)
+        MixSamples(mBufferOut[c], NumChannels, SamplesOut, mChans[c].CurrentGains,
                    mChans[c].TargetGains, SamplesToDo, 0, SamplesToDo);
-    }
 }
 
 struct AutowahStateFactory final : public EffectStateFactory {
@@ -69,7 +69,7 @@ void GetSinusoidDelays(ALint *delays, ALsizei offset, ALsizei lfo_range, ALfloat
 }
 
 struct ChorusState final : public EffectState {
-    al::vector<ALfloat,16> mSampleBuffer;
+    al::large_vector<ALfloat,16> mSampleBuffer;
     ALsizei mOffset{0};
 
     ALsizei mLfoOffset{0};
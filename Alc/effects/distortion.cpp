@@ -23,7 +23,7 @@
 #include <cmath>
 #include <cstdlib>
 
-#include <cmath>
+#include <algorithm>
 
 #include "alMain.h"
 #include "alcontext.h"
@@ -31,6 +31,7 @@
 #include "alError.h"
 #include "alu.h"
 #include "filters/biquad.h"
+#include "filters/polyphase.h"
 
 
 struct ALdistortionState final : public EffectState {
@@ -43,7 +44,11 @@ struct ALdistortionState final : public EffectState {
     ALfloat mAttenuation{};
     ALfloat mEdgeCoeff{};
 
-    ALfloat mBuffer[2][BUFFERSIZE]{};
+    PolyphaseUpsampler mUpsampler;
+    PolyphaseDownsampler mDownsampler;
+
+    alignas(16) ALfloat mBuffer[BUFFERSIZE]{};
+    alignas(16) ALfloat mBaseBuffer[POLYPHASE_MAX_SAMPLES]{};
 
 
     ALboolean deviceUpdate(const ALCdevice *device) override;
@@ -57,6 +62,8 @@ ALboolean ALdistortionState::deviceUpdate(const ALCdevice *UNUSED(device))
 {
     mLowpass.clear();
     mBandpass.clear();
+    mUpsampler.clear();
+    mDownsampler.clear();
     return AL_TRUE;
 }
 
@@ -69,22 +76,25 @@ void ALdistortionState::update(const ALCcontext *context, const ALeffectslot *sl
         minf(std::sin(al::MathDefs<float>::Pi()*0.5f * props->Distortion.Edge), 0.99f)};
     mEdgeCoeff = 2.0f * edge / (1.0f-edge);
 
+    /* The filters run at the base sample rate, with the polyphase resamplers
+     * handling the oversampling around the waveshaper. The filter Q is still
+     * calculated for the oversampled rate, where the bandwidth approximation
+     * holds for the whole frequency range, and the frequency is kept just
+     * below Nyquist.
+     */
+    auto frequency = static_cast<ALfloat>(device->Frequency);
     ALfloat cutoff{props->Distortion.LowpassCutoff};
     /* Bandwidth value is constant in octaves. */
     ALfloat bandwidth{(cutoff / 2.0f) / (cutoff * 0.67f)};
-    /* Multiply sampling frequency by the amount of oversampling done during
-     * processing.
-     */
-    auto frequency = static_cast<ALfloat>(device->Frequency);
-    mLowpass.setParams(BiquadType::LowPass, 1.0f, cutoff / (frequency*4.0f),
-        calc_rcpQ_from_bandwidth(cutoff / (frequency*4.0f), bandwidth)
+    mLowpass.setParams(BiquadType::LowPass, 1.0f, minf(cutoff / frequency, 0.49f),
+        calc_rcpQ_from_bandwidth(cutoff / (frequency*POLYPHASE_FACTOR), bandwidth)
     );
 
     cutoff = props->Distortion.EQCenter;
     /* Convert bandwidth in Hz to octaves. */
     bandwidth = props->Distortion.EQBandwidth / (cutoff * 0.67f);
-    mBandpass.setParams(BiquadType::BandPass, 1.0f, cutoff / (frequency*4.0f),
-        calc_rcpQ_from_bandwidth(cutoff / (frequency*4.0f), bandwidth)
+    mBandpass.setParams(BiquadType::BandPass, 1.0f, minf(cutoff / frequency, 0.49f),
+        calc_rcpQ_from_bandwidth(cutoff / (frequency*POLYPHASE_FACTOR), bandwidth)
     );
 
     ALfloat coeffs[MAX_AMBI_CHANNELS];
@@ -97,64 +107,54 @@ void ALdistortionState::update(const ALCcontext *context, const ALeffectslot *sl
 
 void ALdistortionState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT SamplesIn)[BUFFERSIZE], ALfloat (*RESTRICT SamplesOut)[BUFFERSIZE], ALsizei NumChannels)
 {
-    ALfloat (*RESTRICT buffer)[BUFFERSIZE] = mBuffer;
-    const ALfloat fc = mEdgeCoeff;
-    ALsizei base;
-    ALsizei i, k;
+    ALfloat *RESTRICT buffer{mBuffer};
+    ALfloat *RESTRICT basebuf{mBaseBuffer};
+    const ALfloat fc{mEdgeCoeff};
 
-    for(base = 0;base < SamplesToDo;)
+    for(ALsizei base{0};base < SamplesToDo;)
     {
-        /* Perform 4x oversampling to avoid aliasing. Oversampling greatly
-         * improves distortion quality and allows to implement lowpass and
-         * bandpass filters using high frequencies, at which classic IIR
-         * filters became unstable.
-         */
-        ALsizei todo = mini(BUFFERSIZE, (SamplesToDo-base) * 4);
+        const ALsizei todo{mini(POLYPHASE_MAX_SAMPLES, SamplesToDo-base)};
 
-        /* Fill oversample buffer using zero stuffing. Multiply the sample by
-         * the amount of oversampling to maintain the signal's power.
-         */
-        for(i = 0;i < todo;i++)
-            buffer[0][i] = !(i&3) ? SamplesIn[0][(i>>2)+base] * 4.0f : 0.0f;
+        /* First step, do lowpass filtering of original signal. */
+        mLowpass.process(basebuf, &SamplesIn[0][base], todo);
 
-        /* First step, do lowpass filtering of original signal. Additionally
-         * perform buffer interpolation and lowpass cutoff for oversampling
-         * (which is fortunately first step of distortion). So combine three
-         * operations into the one.
+        /* Perform 4x oversampling to avoid aliasing. Oversampling greatly
+         * improves distortion quality, as the waveshaper generates harmonics
+         * well beyond the input's bandwidth.
          */
-        mLowpass.process(buffer[1], buffer[0], todo);
+        mUpsampler.process(buffer, basebuf, todo);
 
         /* Second step, do distortion using waveshaper function to emulate
          * signal processing during tube overdriving. Three steps of
          * waveshaping are intended to modify waveform without boost/clipping/
          * attenuation process.
          */
-        for(i = 0;i < todo;i++)
+        auto proc_sample = [fc](ALfloat smp) -> ALfloat
         {
-            ALfloat smp = buffer[1][i];
-
-            smp = (1.0f + fc) * smp/(1.0f + fc*fabsf(smp));
-            smp = (1.0f + fc) * smp/(1.0f + fc*fabsf(smp)) * -1.0f;
-            smp = (1.0f + fc) * smp/(1.0f + fc*fabsf(smp));
-
-            buffer[0][i] = smp;
-        }
+            smp = (1.0f + fc) * smp/(1.0f + fc*std::abs(smp));
+            smp = (1.0f + fc) * smp/(1.0f + fc*std::abs(smp)) * -1.0f;
+            smp = (1.0f + fc) * smp/(1.0f + fc*std::abs(smp));
+            return smp;
+        };
+        std::transform(buffer, buffer+todo*POLYPHASE_FACTOR, buffer, proc_sample);
+
+        /* Decimate back to the base rate, removing the harmonics that would
+         * otherwise alias. Only the retained samples are computed.
+         */
+        mDownsampler.process(basebuf, buffer, todo);
 
         /* Third step, do bandpass filtering of distorted signal. */
-        mBandpass.process(buffer[1], buffer[0], todo);
+        mBandpass.process(basebuf, basebuf, todo);
 
-        todo >>= 2;
-        for(k = 0;k < NumChannels;k++)
+        for(ALsizei k{0};k < NumChannels;k++)
         {
-            /* Fourth step, final, do attenuation and perform decimation,
-             * storing only one sample out of four.
-             */
-            ALfloat gain = mGain[k];
-            if(!(fabsf(gain) > GAIN_SILENCE_THRESHOLD))
+            /* Fourth step, final, do attenuation and mix to the output. */
+            const ALfloat gain{mGain[k]};
+            if(!(std::fabs(gain) > GAIN_SILENCE_THRESHOLD))
                 continue;
 
-            for(i = 0;i < todo;i++)
-                SamplesOut[k][base+i] += gain * buffer[1][i*4];
+            for(ALsizei i{0};i < todo;i++)
+                SamplesOut[k][base+i] += gain * basebuf[i];
         }
 
         base += todo;
@@ -36,7 +36,7 @@
 
 
 struct ALechoState final : public EffectState {
-    al::vector<ALfloat,16> mSampleBuffer;
+    al::large_vector<ALfloat,16> mSampleBuffer;
 
     // The echo is two tap. The delay is the number of samples from before the
     // current offset
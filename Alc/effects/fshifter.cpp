@@ -22,8 +22,6 @@
 
 #include <cmath>
 #include <cstdlib>
-#include <array>
-#include <complex>
 #include <algorithm>
 
 #include "alMain.h"
@@ -31,49 +29,21 @@
 #include "alAuxEffectSlot.h"
 #include "alError.h"
 #include "alu.h"
-
-#include "alcomplex.h"
+#include "filters/modulation.h"
 
 namespace {
 
-using complex_d = std::complex<double>;
-
-#define HIL_SIZE 1024
-#define OVERSAMP (1<<2)
-
-#define HIL_STEP     (HIL_SIZE / OVERSAMP)
-#define FIFO_LATENCY (HIL_STEP * (OVERSAMP-1))
-
-/* Define a Hann window, used to filter the HIL input and output. */
-/* Making this constexpr seems to require C++14. */
-std::array<ALdouble,HIL_SIZE> InitHannWindow()
-{
-    std::array<ALdouble,HIL_SIZE> ret;
-    /* Create lookup table of the Hann window for the desired size, i.e. HIL_SIZE */
-    for(ALsizei i{0};i < HIL_SIZE>>1;i++)
-    {
-        ALdouble val = std::sin(al::MathDefs<double>::Pi() * i / ALdouble{HIL_SIZE-1});
-        ret[i] = ret[HIL_SIZE-1-i] = val * val;
-    }
-    return ret;
-}
-alignas(16) const std::array<ALdouble,HIL_SIZE> HannWindow = InitHannWindow();
+#define MAX_UPDATE_SAMPLES 256
 
 
 struct ALfshifterState final : public EffectState {
     /* Effect parameters */
-    ALsizei  mCount{};
-    ALsizei  mPhaseStep{};
-    ALsizei  mPhase{};
-    ALdouble mLdSign{};
-
-    /*Effects buffers*/ 
-    ALfloat   mInFIFO[HIL_SIZE]{};
-    complex_d mOutFIFO[HIL_SIZE]{};
-    complex_d mOutputAccum[HIL_SIZE]{};
-    complex_d mAnalytic[HIL_SIZE]{};
-    complex_d mOutdata[BUFFERSIZE]{};
+    ALfloat mLdSign{};
 
+    Oscillator mOscillator;
+    HilbertTransformer mHilbert;
+
+    /* Effects buffers */
     alignas(16) ALfloat mBufferOut[BUFFERSIZE]{};
 
     /* Effect gains for each output channel */
@@ -91,15 +61,11 @@ struct ALfshifterState final : public EffectState {
 ALboolean ALfshifterState::deviceUpdate(const ALCdevice *UNUSED(device))
 {
     /* (Re-)initializing parameters and clear the buffers. */
-    mCount     = FIFO_LATENCY;
-    mPhaseStep = 0;
-    mPhase     = 0;
-    mLdSign    = 1.0;
+    mLdSign = 1.0f;
 
-    std::fill(std::begin(mInFIFO),      std::end(mInFIFO),      0.0f);
-    std::fill(std::begin(mOutFIFO),     std::end(mOutFIFO),     complex_d{});
-    std::fill(std::begin(mOutputAccum), std::end(mOutputAccum), complex_d{});
-    std::fill(std::begin(mAnalytic),    std::end(mAnalytic),    complex_d{});
+    mOscillator.setFrequency(0.0f);
+    mOscillator.reset();
+    mHilbert.clear();
 
     std::fill(std::begin(mCurrentGains), std::end(mCurrentGains), 0.0f);
     std::fill(std::begin(mTargetGains),  std::end(mTargetGains),  0.0f);
@@ -112,21 +78,21 @@ void ALfshifterState::update(const ALCcontext *context, const ALeffectslot *slot
     const ALCdevice *device{context->Device};
 
     ALfloat step{props->Fshifter.Frequency / static_cast<ALfloat>(device->Frequency)};
-    mPhaseStep = fastf2i(minf(step, 0.5f) * FRACTIONONE);
+    mOscillator.setFrequency(minf(step, 0.5f));
 
     switch(props->Fshifter.LeftDirection)
     {
         case AL_FREQUENCY_SHIFTER_DIRECTION_DOWN:
-            mLdSign = -1.0;
+            mLdSign = -1.0f;
             break;
 
         case AL_FREQUENCY_SHIFTER_DIRECTION_UP:
-            mLdSign = 1.0;
+            mLdSign = 1.0f;
             break;
 
         case AL_FREQUENCY_SHIFTER_DIRECTION_OFF:
-            mPhase = 0;
-            mPhaseStep = 0;
+            mOscillator.setFrequency(0.0f);
+            mOscillator.reset();
             break;
     }
 
@@ -140,61 +106,24 @@ void ALfshifterState::update(const ALCcontext *context, const ALeffectslot *slot
 
 void ALfshifterState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT SamplesIn)[BUFFERSIZE], ALfloat (*RESTRICT SamplesOut)[BUFFERSIZE], ALsizei NumChannels)
 {
-    static constexpr complex_d complex_zero{0.0, 0.0};
     ALfloat *RESTRICT BufferOut = mBufferOut;
-    ALsizei j, k, base;
+    const ALfloat sign{mLdSign};
 
-    for(base = 0;base < SamplesToDo;)
+    for(ALsizei base{0};base < SamplesToDo;)
     {
-        const ALsizei todo{mini(HIL_SIZE-mCount, SamplesToDo-base)};
-
-        ASSUME(todo > 0);
-
-        /* Fill FIFO buffer with samples data */
-        k = mCount;
-        for(j = 0;j < todo;j++,k++)
-        {
-            mInFIFO[k] = SamplesIn[0][base+j];
-            mOutdata[base+j]  = mOutFIFO[k-FIFO_LATENCY];
-        }
-        mCount += todo;
-        base += todo;
-
-        /* Check whether FIFO buffer is filled */
-        if(mCount < HIL_SIZE) continue;
-        mCount = FIFO_LATENCY;
-
-        /* Real signal windowing and store in Analytic buffer */
-        for(k = 0;k < HIL_SIZE;k++)
-        {
-            mAnalytic[k].real(mInFIFO[k] * HannWindow[k]);
-            mAnalytic[k].imag(0.0);
-        }
-
-        /* Processing signal by Discrete Hilbert Transform (analytical signal). */
-        complex_hilbert(mAnalytic, HIL_SIZE);
-
-        /* Windowing and add to output accumulator */
-        for(k = 0;k < HIL_SIZE;k++)
-            mOutputAccum[k] += 2.0/OVERSAMP*HannWindow[k]*mAnalytic[k];
-
-        /* Shift accumulator, input & output FIFO */
-        for(k = 0;k < HIL_STEP;k++) mOutFIFO[k] = mOutputAccum[k];
-        for(j = 0;k < HIL_SIZE;k++,j++) mOutputAccum[j] = mOutputAccum[k];
-        for(;j < HIL_SIZE;j++) mOutputAccum[j] = complex_zero;
-        for(k = 0;k < FIFO_LATENCY;k++)
-            mInFIFO[k] = mInFIFO[k+HIL_STEP];
-    }
+        alignas(16) ALfloat real[MAX_UPDATE_SAMPLES], imag[MAX_UPDATE_SAMPLES];
+        alignas(16) ALfloat cosines[MAX_UPDATE_SAMPLES], sines[MAX_UPDATE_SAMPLES];
+        const ALsizei todo{mini(MAX_UPDATE_SAMPLES, SamplesToDo-base)};
+
+        /* Get the analytic signal of the input with the IIR Hilbert
+         * transform, and shift it by the oscillator's frequency.
+         */
+        mHilbert.process(real, imag, &SamplesIn[0][base], todo);
+        mOscillator.processQuadrature(cosines, sines, todo);
+        for(ALsizei k{0};k < todo;k++)
+            BufferOut[base+k] = real[k]*cosines[k] + imag[k]*sines[k]*sign;
 
-    /* Process frequency shifter using the analytic signal obtained. */
-    for(k = 0;k < SamplesToDo;k++)
-    {
-        double phase = mPhase * ((1.0/FRACTIONONE) * al::MathDefs<double>::Tau());
-        BufferOut[k] = static_cast<float>(mOutdata[k].real()*std::cos(phase) +
-                               mOutdata[k].imag()*std::sin(phase)*mLdSign);
-
-        mPhase += mPhaseStep;
-        mPhase &= FRACTIONMASK;
+        base += todo;
     }
 
     /* Now, mix the processed sound data to the output. */
@@ -23,7 +23,6 @@
 #include <cmath>
 #include <cstdlib>
 
-#include <cmath>
 #include <algorithm>
 
 #include "alMain.h"
@@ -32,53 +31,17 @@
 #include "alError.h"
 #include "alu.h"
 #include "filters/biquad.h"
+#include "filters/modulation.h"
 #include "vecmat.h"
 
 
 #define MAX_UPDATE_SAMPLES 128
 
-#define WAVEFORM_FRACBITS  24
-#define WAVEFORM_FRACONE   (1<<WAVEFORM_FRACBITS)
-#define WAVEFORM_FRACMASK  (WAVEFORM_FRACONE-1)
-
-static inline ALfloat Sin(ALsizei index)
-{
-    return std::sin(static_cast<ALfloat>(index) * (al::MathDefs<float>::Tau() / static_cast<ALfloat>WAVEFORM_FRACONE));
-}
-
-static inline ALfloat Saw(ALsizei index)
-{
-    return static_cast<ALfloat>(index)*(2.0f/WAVEFORM_FRACONE) - 1.0f;
-}
-
-static inline ALfloat Square(ALsizei index)
-{
-    return static_cast<ALfloat>(((index>>(WAVEFORM_FRACBITS-2))&2) - 1);
-}
-
-static inline ALfloat One(ALsizei UNUSED(index))
-{
-    return 1.0f;
-}
-
-template<ALfloat func(ALsizei)>
-static void Modulate(ALfloat *RESTRICT dst, ALsizei index, const ALsizei step, ALsizei todo)
-{
-    ALsizei i;
-    for(i = 0;i < todo;i++)
-    {
-        index += step;
-        index &= WAVEFORM_FRACMASK;
-        dst[i] = func(index);
-    }
-}
-
 
 struct ALmodulatorState final : public EffectState {
-    void (*mGetSamples)(ALfloat*RESTRICT, ALsizei, const ALsizei, ALsizei){};
+    void (Oscillator::*mGetSamples)(ALfloat*RESTRICT, const ALsizei) noexcept{};
 
-    ALsizei mIndex{0};
-    ALsizei mStep{1};
+    Oscillator mOscillator;
 
     struct {
         BiquadFilter Filter;
@@ -111,17 +74,15 @@ void ALmodulatorState::update(const ALCcontext *context, const ALeffectslot *slo
     ALfloat f0norm;
     ALsizei i;
 
-    mStep = fastf2i(props->Modulator.Frequency / static_cast<ALfloat>(device->Frequency) * WAVEFORM_FRACONE);
-    mStep = clampi(mStep, 0, WAVEFORM_FRACONE-1);
-
-    if(mStep == 0)
-        mGetSamples = Modulate<One>;
+    if(!mOscillator.setFrequency(props->Modulator.Frequency /
+        static_cast<ALfloat>(device->Frequency)))
+        mGetSamples = nullptr;
     else if(props->Modulator.Waveform == AL_RING_MODULATOR_SINUSOID)
-        mGetSamples = Modulate<Sin>;
+        mGetSamples = &Oscillator::processSine;
     else if(props->Modulator.Waveform == AL_RING_MODULATOR_SAWTOOTH)
-        mGetSamples = Modulate<Saw>;
+        mGetSamples = &Oscillator::processSawtooth;
     else /*if(Slot->Params.EffectProps.Modulator.Waveform == AL_RING_MODULATOR_SQUARE)*/
-        mGetSamples = Modulate<Square>;
+        mGetSamples = &Oscillator::processSquare;
 
     f0norm = props->Modulator.HighPassCutoff / static_cast<ALfloat>(device->Frequency);
     f0norm = clampf(f0norm, 1.0f/512.0f, 0.49f);
@@ -140,7 +101,6 @@ void ALmodulatorState::update(const ALCcontext *context, const ALeffectslot *slo
 
 void ALmodulatorState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT SamplesIn)[BUFFERSIZE], ALfloat (*RESTRICT SamplesOut)[BUFFERSIZE], ALsizei NumChannels)
 {
-    const ALsizei step = mStep;
     ALsizei base;
 
     for(base = 0;base < SamplesToDo;)
@@ -149,9 +109,10 @@ void ALmodulatorState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT Sam
         ALsizei td = mini(MAX_UPDATE_SAMPLES, SamplesToDo-base);
         ALsizei c, i;
 
-        mGetSamples(modsamples, mIndex, step, td);
-        mIndex += (step*td) & WAVEFORM_FRACMASK;
-        mIndex &= WAVEFORM_FRACMASK;
+        if(mGetSamples)
+            (mOscillator.*mGetSamples)(modsamples, td);
+        else
+            std::fill_n(modsamples, td, 1.0f);
 
         for(c = 0;c < MAX_EFFECT_CHANNELS;c++)
         {
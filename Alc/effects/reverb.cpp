@@ -34,14 +34,23 @@
 #include "alListener.h"
 #include "alError.h"
 #include "filters/biquad.h"
+#include "mixer/defs.h"
 #include "vector.h"
 #include "vecmat.h"
+#include "reverb.h"
 
 /* This is a user config option for modifying the overall output of the reverb
  * effect.
  */
 ALfloat ReverbBoost = 1.0f;
 
+ReverbDelayMixFunc ReverbDelayMix = ReverbDelayMix_<CTag>;
+ReverbFadedDelayMixFunc ReverbFadedDelayMix = ReverbFadedDelayMix_<CTag>;
+ReverbAllpassFunc ReverbAllpass = ReverbAllpass_<CTag>;
+ReverbFadedAllpassFunc ReverbFadedAllpass = ReverbFadedAllpass_<CTag>;
+ReverbScatterRevDelayInFunc ReverbScatterRevDelayIn = ReverbScatterRevDelayIn_<CTag>;
+ReverbT60FilterFunc ReverbT60Filter = ReverbT60Filter_<CTag>;
+
 namespace {
 
 /* This is the maximum number of samples processed for each inner loop
@@ -56,12 +65,11 @@ namespace {
  */
 #define FADE_SAMPLES  128
 
-/* The number of spatialized lines or channels to process. Four channels allows
- * for a 3D A-Format response. NOTE: This can't be changed without taking care
- * of the conversion matrices, and a few places where the length arrays are
- * assumed to have 4 elements.
+/* NOTE: The number of lines can't be changed without taking care of the
+ * conversion matrices, and a few places where the length arrays are assumed to
+ * have 4 elements.
  */
-#define NUM_LINES 4
+#define NUM_LINES REVERB_LINES
 
 
 /* The B-Format to A-Format conversion matrix. The arrangement of rows is
@@ -217,28 +225,12 @@ constexpr ALfloat LATE_LINE_LENGTHS[NUM_LINES]{
 };
 
 
-struct DelayLineI {
-    /* The delay lines use interleaved samples, with the lengths being powers
-     * of 2 to allow the use of bit-masking instead of a modulus for wrapping.
-     */
-    ALsizei  Mask{0};
-    ALfloat (*Line)[NUM_LINES]{nullptr};
-};
-
 struct VecAllpass {
     DelayLineI Delay;
     ALfloat Coeff{0.0f};
     ALsizei Offset[NUM_LINES][2]{};
 };
 
-struct T60Filter {
-    /* Two filters are used to adjust the signal. One to control the low
-     * frequencies, and one to control the high frequencies.
-     */
-    ALfloat MidGain[2]{0.0f, 0.0f};
-    BiquadFilter HFFilter, LFFilter;
-};
-
 struct EarlyReflections {
     /* A Gerzon vector all-pass filter is used to simulate initial diffusion.
      * The spread from this filter also helps smooth out the reverb tail.
@@ -267,8 +259,13 @@ struct LateReverb {
      */
     ALfloat DensityGain[2]{0.0f, 0.0f};
 
-    /* T60 decay filters are used to simulate absorption. */
-    T60Filter T60[NUM_LINES];
+    /* T60 decay filters are used to simulate absorption. Two filters are used
+     * to adjust the signal, one to control the low frequencies and one to
+     * control the high frequencies, while the mid-band gain is applied when
+     * reading the delay lines.
+     */
+    ALfloat MidGain[NUM_LINES][2]{};
+    T60FilterLanes T60;
 
     /* A Gerzon vector all-pass filter is used to simulate diffusion. */
     VecAllpass VecAp;
@@ -282,7 +279,7 @@ struct ReverbState final : public EffectState {
     /* All delay lines are allocated as a single buffer to reduce memory
      * fragmentation and management code.
      */
-    al::vector<ALfloat,16> mSampleBuffer;
+    al::large_vector<ALfloat,16> mSampleBuffer;
 
     struct {
         /* Calculated parameters which indicate if cross-fading is needed after
@@ -334,6 +331,9 @@ struct ReverbState final : public EffectState {
     /* Temporary storage used when processing. */
     alignas(16) ALfloat mTempSamples[NUM_LINES][MAX_UPDATE_SAMPLES]{};
     alignas(16) ALfloat mMixBuffer[NUM_LINES][MAX_UPDATE_SAMPLES]{};
+    /* Interleaved line samples for the early and late processing. */
+    alignas(16) ALfloat mTempLines[MAX_UPDATE_SAMPLES][NUM_LINES]{};
+    alignas(16) ALfloat mOutLines[MAX_UPDATE_SAMPLES][NUM_LINES]{};
 
 
     ALboolean deviceUpdate(const ALCdevice *device) override;
@@ -483,13 +483,10 @@ ALboolean ReverbState::deviceUpdate(const ALCdevice *Device)
 
     mLate.DensityGain[0] = 0.0f;
     mLate.DensityGain[1] = 0.0f;
-    for(auto &t60 : mLate.T60)
-    {
-        t60.MidGain[0] = 0.0f;
-        t60.MidGain[1] = 0.0f;
-        t60.HFFilter.clear();
-        t60.LFFilter.clear();
-    }
+    for(auto &gain : mLate.MidGain)
+        std::fill(std::begin(gain), std::end(gain), 0.0f);
+    mLate.T60.HFFilter.clear();
+    mLate.T60.LFFilter.clear();
 
     for(auto &gains : mEarly.CurrentGain)
         std::fill(std::begin(gains), std::end(gains), 0.0f);
@@ -577,6 +574,17 @@ ALfloat CalcLimitedHfRatio(const ALfloat hfRatio, const ALfloat airAbsorptionGai
 }
 
 
+/* Sets the coefficients of one lane of a set of parallel filters. */
+void SetBiquadLane(BiquadLanes *lanes, const ALsizei lane, const BiquadFilter &filter)
+{
+    const std::array<ALfloat,5> coeffs{filter.getCoeffs()};
+    lanes->b0[lane] = coeffs[0];
+    lanes->b1[lane] = coeffs[1];
+    lanes->b2[lane] = coeffs[2];
+    lanes->a1[lane] = coeffs[3];
+    lanes->a2[lane] = coeffs[4];
+}
+
 /* Calculates the 3-band T60 damping coefficients for a particular delay line
  * of specified length, using a combination of two shelf filter sections given
  * decay times for each band split at two reference frequencies.
@@ -584,17 +592,21 @@ ALfloat CalcLimitedHfRatio(const ALfloat hfRatio, const ALfloat airAbsorptionGai
 void CalcT60DampingCoeffs(const ALfloat length, const ALfloat lfDecayTime,
                           const ALfloat mfDecayTime, const ALfloat hfDecayTime,
                           const ALfloat lf0norm, const ALfloat hf0norm,
-                          T60Filter *filter)
+                          const ALsizei line, LateReverb *Late)
 {
     ALfloat lfGain{CalcDecayCoeff(length, lfDecayTime)};
     ALfloat mfGain{CalcDecayCoeff(length, mfDecayTime)};
     ALfloat hfGain{CalcDecayCoeff(length, hfDecayTime)};
 
-    filter->MidGain[1] = mfGain;
-    filter->LFFilter.setParams(BiquadType::LowShelf, lfGain/mfGain, lf0norm,
+    Late->MidGain[line][1] = mfGain;
+
+    BiquadFilter filter;
+    filter.setParams(BiquadType::LowShelf, lfGain/mfGain, lf0norm,
         calc_rcpQ_from_slope(lfGain/mfGain, 1.0f));
-    filter->HFFilter.setParams(BiquadType::HighShelf, hfGain/mfGain, hf0norm,
+    SetBiquadLane(&Late->T60.LFFilter, line, filter);
+    filter.setParams(BiquadType::HighShelf, hfGain/mfGain, hf0norm,
         calc_rcpQ_from_slope(hfGain/mfGain, 1.0f));
+    SetBiquadLane(&Late->T60.HFFilter, line, filter);
 }
 
 /* Update the offsets for the main effect delay line. */
@@ -716,7 +728,7 @@ ALvoid UpdateLateLines(const ALfloat density, const ALfloat diffusion, const ALf
 
         /* Calculate the T60 damping coefficients for each line. */
         CalcT60DampingCoeffs(length, lfDecayTime, mfDecayTime, hfDecayTime,
-                             lf0norm, hf0norm, &Late->T60[i]);
+                             lf0norm, hf0norm, i, Late);
     }
 }
 
@@ -889,35 +901,46 @@ void ReverbState::update(const ALCcontext *Context, const ALeffectslot *Slot, co
  *  Effect Processing                 *
  **************************************/
 
-/* Basic delay line input/output routines. */
-inline ALfloat DelayLineOut(const DelayLineI *Delay, const ALsizei offset, const ALsizei c)
-{ return Delay->Line[offset&Delay->Mask][c]; }
-
-/* Cross-faded delay line output routine.  Instead of interpolating the
- * offsets, this interpolates (cross-fades) the outputs at each offset.
- */
-inline ALfloat FadedDelayLineOut(const DelayLineI *Delay, const ALsizei off0, const ALsizei off1,
-                                 const ALsizei c, const ALfloat sc0, const ALfloat sc1)
+/* Basic delay line input routines. */
+inline void DelayLineIn(const DelayLineI *Delay, ALsizei offset, const ALsizei c,
+                        const ALfloat *RESTRICT in, ALsizei count)
 {
-    return Delay->Line[off0&Delay->Mask][c]*sc0 +
-           Delay->Line[off1&Delay->Mask][c]*sc1;
+    ASSUME(count > 0);
+    for(ALsizei i{0};i < count;i++)
+        Delay->Line[(offset++)&Delay->Mask][c] = *(in++);
 }
 
+/* Writes interleaved line samples to the delay line, reversing the lines. */
+inline void DelayLineRevIn(const DelayLineI *Delay, ALsizei offset,
+                           const ALfloat (*RESTRICT in)[NUM_LINES], const ALsizei count)
+{
+    ASSUME(count > 0);
+    for(ALsizei i{0};i < count;i++)
+        std::reverse_copy(std::begin(in[i]), std::end(in[i]),
+            Delay->Line[(offset++)&Delay->Mask]);
+}
 
-inline void DelayLineIn(const DelayLineI *Delay, ALsizei offset, const ALsizei c,
-                        const ALfloat *RESTRICT in, ALsizei count)
+/* Splits interleaved line samples into separate buffers for mixing. */
+inline void DeinterleaveLines(ALfloat (*RESTRICT out)[MAX_UPDATE_SAMPLES],
+                              const ALfloat (*RESTRICT in)[NUM_LINES], const ALsizei count)
 {
     ASSUME(count > 0);
     for(ALsizei i{0};i < count;i++)
-        Delay->Line[(offset++)&Delay->Mask][c] = *(in++);
+    {
+        for(ALsizei j{0};j < NUM_LINES;j++)
+            out[j][i] = in[i][j];
+    }
 }
 
-/* Applies a scattering matrix to the 4-line (vector) input.  This is used
- * for both the below vector all-pass model and to perform modal feed-back
- * delay network (FDN) mixing.
+/* The early and late stages process all four lines together, one sample frame
+ * at a time, using the ReverbDelayMix, ReverbAllpass, ReverbScatterRevDelayIn,
+ * and ReverbT60Filter kernels (which have SIMD versions treating the lines as
+ * vector lanes).
  *
- * The matrix is derived from a skew-symmetric matrix to form a 4D rotation
- * matrix with a single unitary rotational parameter:
+ * The scattering matrix used for the vector all-pass model and to perform
+ * modal feed-back delay network (FDN) mixing is derived from a skew-symmetric
+ * matrix to form a 4D rotation matrix with a single unitary rotational
+ * parameter:
  *
  *     [  d,  a,  b,  c ]          1 = a^2 + b^2 + c^2 + d^2
  *     [ -a,  d,  c, -b ]
@@ -949,111 +972,11 @@ inline void DelayLineIn(const DelayLineI *Delay, ALsizei offset, const ALsizei c
  *
  * Where D is a diagonal matrix (of x), and S is a triangular matrix (of y)
  * whose combination of signs are being iterated.
- */
-inline void VectorPartialScatter(ALfloat *RESTRICT out, const ALfloat *RESTRICT in,
-                                 const ALfloat xCoeff, const ALfloat yCoeff)
-{
-    out[0] = xCoeff*in[0] + yCoeff*(          in[1] + -in[2] + in[3]);
-    out[1] = xCoeff*in[1] + yCoeff*(-in[0]          +  in[2] + in[3]);
-    out[2] = xCoeff*in[2] + yCoeff*( in[0] + -in[1]          + in[3]);
-    out[3] = xCoeff*in[3] + yCoeff*(-in[0] + -in[1] + -in[2]        );
-}
-#define VectorScatterDelayIn(delay, o, in, xcoeff, ycoeff) \
-    VectorPartialScatter((delay)->Line[(o)&(delay)->Mask], in, xcoeff, ycoeff)
-
-/* Utilizes the above, but reverses the input channels. */
-inline void VectorScatterRevDelayIn(const DelayLineI *Delay, ALint offset,
-                                    const ALfloat xCoeff, const ALfloat yCoeff,
-                                    const ALfloat (*RESTRICT in)[MAX_UPDATE_SAMPLES],
-                                    const ALsizei count)
-{
-    const DelayLineI delay{*Delay};
-    for(ALsizei i{0};i < count;++i)
-    {
-        ALfloat f[NUM_LINES];
-        for(ALsizei j{0};j < NUM_LINES;j++)
-            f[NUM_LINES-1-j] = in[j][i];
-
-        VectorScatterDelayIn(&delay, offset++, f, xCoeff, yCoeff);
-    }
-}
-
-/* This applies a Gerzon multiple-in/multiple-out (MIMO) vector all-pass
- * filter to the 4-line input.
- *
- * It works by vectorizing a regular all-pass filter and replacing the delay
- * element with a scattering matrix (like the one above) and a diagonal
- * matrix of delay elements.
  *
- * Two static specializations are used for transitional (cross-faded) delay
- * line processing and non-transitional processing.
+ * The Gerzon multiple-in/multiple-out (MIMO) vector all-pass filter works by
+ * vectorizing a regular all-pass filter and replacing the delay element with
+ * the scattering matrix and a diagonal matrix of delay elements.
  */
-void VectorAllpass_Unfaded(ALfloat (*RESTRICT samples)[MAX_UPDATE_SAMPLES], ALsizei offset,
-                           const ALfloat xCoeff, const ALfloat yCoeff, ALsizei todo,
-                           VecAllpass *Vap)
-{
-    const DelayLineI delay{Vap->Delay};
-    const ALfloat feedCoeff{Vap->Coeff};
-
-    ASSUME(todo > 0);
-
-    ALsizei vap_offset[NUM_LINES];
-    for(ALsizei j{0};j < NUM_LINES;j++)
-        vap_offset[j] = offset - Vap->Offset[j][0];
-    for(ALsizei i{0};i < todo;i++)
-    {
-        ALfloat f[NUM_LINES];
-
-        for(ALsizei j{0};j < NUM_LINES;j++)
-        {
-            ALfloat input = samples[j][i];
-            ALfloat out = DelayLineOut(&delay, vap_offset[j]++, j) - feedCoeff*input;
-            f[j] = input + feedCoeff*out;
-
-            samples[j][i] = out;
-        }
-
-        VectorScatterDelayIn(&delay, offset, f, xCoeff, yCoeff);
-        ++offset;
-    }
-}
-void VectorAllpass_Faded(ALfloat (*RESTRICT samples)[MAX_UPDATE_SAMPLES], ALsizei offset,
-                         const ALfloat xCoeff, const ALfloat yCoeff, ALfloat fade,
-                         ALsizei todo, VecAllpass *Vap)
-{
-    const DelayLineI delay{Vap->Delay};
-    const ALfloat feedCoeff{Vap->Coeff};
-
-    ASSUME(todo > 0);
-
-    fade *= 1.0f/FADE_SAMPLES;
-    ALsizei vap_offset[NUM_LINES][2];
-    for(ALsizei j{0};j < NUM_LINES;j++)
-    {
-        vap_offset[j][0] = offset - Vap->Offset[j][0];
-        vap_offset[j][1] = offset - Vap->Offset[j][1];
-    }
-    for(ALsizei i{0};i < todo;i++)
-    {
-        ALfloat f[NUM_LINES];
-
-        for(ALsizei j{0};j < NUM_LINES;j++)
-        {
-            ALfloat input = samples[j][i];
-            ALfloat out =
-                FadedDelayLineOut(&delay, vap_offset[j][0]++, vap_offset[j][1]++, j,
-                    1.0f-fade, fade
-                ) - feedCoeff*input;
-            f[j] = input + feedCoeff*out;
-
-            samples[j][i] = out;
-        }
-        fade += FadeStep;
-
-        VectorScatterDelayIn(&delay, offset, f, xCoeff, yCoeff);
-        ++offset;
-    }
-}
 
 /* This generates early reflections.
  *
@@ -1077,11 +1000,14 @@ void VectorAllpass_Faded(ALfloat (*RESTRICT samples)[MAX_UPDATE_SAMPLES], ALsize
 void EarlyReflection_Unfaded(ReverbState *State, ALsizei offset, const ALsizei todo,
                              ALfloat (*RESTRICT out)[MAX_UPDATE_SAMPLES])
 {
-    ALfloat (*RESTRICT temps)[MAX_UPDATE_SAMPLES]{State->mTempSamples};
-    const DelayLineI early_delay{State->mEarly.Delay};
-    const DelayLineI main_delay{State->mDelay};
+    ALfloat (*RESTRICT temps)[NUM_LINES]{State->mTempLines};
+    ALfloat (*RESTRICT lines)[NUM_LINES]{State->mOutLines};
+    const DelayLineI &early_delay = State->mEarly.Delay;
+    const DelayLineI &main_delay = State->mDelay;
     const ALfloat mixX{State->mMixX};
     const ALfloat mixY{State->mMixY};
+    ALsizei taps[NUM_LINES];
+    ALfloat gains[NUM_LINES];
 
     ASSUME(todo > 0);
 
@@ -1090,103 +1016,91 @@ void EarlyReflection_Unfaded(ReverbState *State, ALsizei offset, const ALsizei t
      */
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        ALsizei early_delay_tap{offset - State->mEarlyDelayTap[j][0]};
-        const ALfloat coeff{State->mEarlyDelayCoeff[j][0]};
-        for(ALsizei i{0};i < todo;i++)
-            temps[j][i] = DelayLineOut(&main_delay, early_delay_tap++, j) * coeff;
+        taps[j] = offset - State->mEarlyDelayTap[j][0];
+        gains[j] = State->mEarlyDelayCoeff[j][0];
     }
+    std::fill_n(temps[0], todo*NUM_LINES, 0.0f);
+    ReverbDelayMix(temps, main_delay, taps, gains, todo);
 
     /* Apply a vector all-pass, to help color the initial reflections based on
      * the diffusion strength.
      */
-    VectorAllpass_Unfaded(temps, offset, mixX, mixY, todo, &State->mEarly.VecAp);
+    for(ALsizei j{0};j < NUM_LINES;j++)
+        taps[j] = offset - State->mEarly.VecAp.Offset[j][0];
+    ReverbAllpass(temps, State->mEarly.VecAp.Delay, offset, taps, State->mEarly.VecAp.Coeff,
+        mixX, mixY, todo);
 
     /* Apply a delay and bounce to generate secondary reflections, combine with
      * the primary reflections and write out the result for mixing.
      */
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        ALint early_feedb_tap{offset - State->mEarly.Offset[j][0]};
-        const ALfloat early_feedb_coeff{State->mEarly.Coeff[j][0]};
-
-        for(ALsizei i{0};i < todo;i++)
-            out[j][i] = DelayLineOut(&early_delay, early_feedb_tap++, j)*early_feedb_coeff +
-                        temps[j][i];
+        taps[j] = offset - State->mEarly.Offset[j][0];
+        gains[j] = State->mEarly.Coeff[j][0];
     }
-    for(ALsizei j{0};j < NUM_LINES;j++)
-        DelayLineIn(&early_delay, offset, NUM_LINES-1-j, temps[j], todo);
+    std::copy_n(temps[0], todo*NUM_LINES, lines[0]);
+    ReverbDelayMix(lines, early_delay, taps, gains, todo);
+    DelayLineRevIn(&early_delay, offset, temps, todo);
 
     /* Also write the result back to the main delay line for the late reverb
      * stage to pick up at the appropriate time, appplying a scatter and
      * bounce to improve the initial diffusion in the late reverb.
      */
     const ALsizei late_feed_tap{offset - State->mLateFeedTap};
-    VectorScatterRevDelayIn(&main_delay, late_feed_tap, mixX, mixY, out, todo);
+    ReverbScatterRevDelayIn(main_delay, late_feed_tap, mixX, mixY, lines, todo);
+
+    DeinterleaveLines(out, lines, todo);
 }
 void EarlyReflection_Faded(ReverbState *State, ALsizei offset, const ALsizei todo,
                            const ALfloat fade, ALfloat (*RESTRICT out)[MAX_UPDATE_SAMPLES])
 {
-    ALfloat (*RESTRICT temps)[MAX_UPDATE_SAMPLES]{State->mTempSamples};
-    const DelayLineI early_delay{State->mEarly.Delay};
-    const DelayLineI main_delay{State->mDelay};
+    ALfloat (*RESTRICT temps)[NUM_LINES]{State->mTempLines};
+    ALfloat (*RESTRICT lines)[NUM_LINES]{State->mOutLines};
+    const DelayLineI &early_delay = State->mEarly.Delay;
+    const DelayLineI &main_delay = State->mDelay;
     const ALfloat mixX{State->mMixX};
     const ALfloat mixY{State->mMixY};
+    const ALfloat fadeStart{fade * FadeStep};
+    ALsizei taps0[NUM_LINES], taps1[NUM_LINES];
+    ALfloat gains0[NUM_LINES], gains1[NUM_LINES];
 
     ASSUME(todo > 0);
 
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        ALsizei early_delay_tap0 = offset - State->mEarlyDelayTap[j][0];
-        ALsizei early_delay_tap1 = offset - State->mEarlyDelayTap[j][1];
-        ALfloat oldCoeff = State->mEarlyDelayCoeff[j][0];
-        ALfloat oldCoeffStep = -oldCoeff / FADE_SAMPLES;
-        ALfloat newCoeffStep = State->mEarlyDelayCoeff[j][1] / FADE_SAMPLES;
-        ALfloat fadeCount = fade;
-
-        for(ALsizei i{0};i < todo;i++)
-        {
-            const ALfloat fade0 = oldCoeff + oldCoeffStep*fadeCount;
-            const ALfloat fade1 = newCoeffStep*fadeCount;
-            temps[j][i] = FadedDelayLineOut(&main_delay,
-                early_delay_tap0++, early_delay_tap1++, j, fade0, fade1
-            );
-            fadeCount += 1.0f;
-        }
+        taps0[j] = offset - State->mEarlyDelayTap[j][0];
+        taps1[j] = offset - State->mEarlyDelayTap[j][1];
+        gains0[j] = State->mEarlyDelayCoeff[j][0];
+        gains1[j] = State->mEarlyDelayCoeff[j][1];
     }
-
-    VectorAllpass_Faded(temps, offset, mixX, mixY, fade, todo, &State->mEarly.VecAp);
+    std::fill_n(temps[0], todo*NUM_LINES, 0.0f);
+    ReverbFadedDelayMix(temps, main_delay, taps0, taps1, gains0, gains1, fadeStart, FadeStep,
+        todo);
 
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        ALint feedb_tap0{offset - State->mEarly.Offset[j][0]};
-        ALint feedb_tap1{offset - State->mEarly.Offset[j][1]};
-        const ALfloat feedb_oldCoeff{State->mEarly.Coeff[j][0]};
-        const ALfloat feedb_oldCoeffStep{-feedb_oldCoeff / FADE_SAMPLES};
-        const ALfloat feedb_newCoeffStep{State->mEarly.Coeff[j][1] / FADE_SAMPLES};
-        ALfloat fadeCount{fade};
-
-        for(ALsizei i{0};i < todo;i++)
-        {
-            const ALfloat fade0{feedb_oldCoeff + feedb_oldCoeffStep*fadeCount};
-            const ALfloat fade1{feedb_newCoeffStep*fadeCount};
-            out[j][i] = FadedDelayLineOut(&early_delay,
-                feedb_tap0++, feedb_tap1++, j, fade0, fade1
-            ) + temps[j][i];
-            fadeCount += 1.0f;
-        }
+        taps0[j] = offset - State->mEarly.VecAp.Offset[j][0];
+        taps1[j] = offset - State->mEarly.VecAp.Offset[j][1];
     }
+    ReverbFadedAllpass(temps, State->mEarly.VecAp.Delay, offset, taps0, taps1,
+        State->mEarly.VecAp.Coeff, mixX, mixY, fadeStart, FadeStep, todo);
+
     for(ALsizei j{0};j < NUM_LINES;j++)
-        DelayLineIn(&early_delay, offset, NUM_LINES-1-j, temps[j], todo);
+    {
+        taps0[j] = offset - State->mEarly.Offset[j][0];
+        taps1[j] = offset - State->mEarly.Offset[j][1];
+        gains0[j] = State->mEarly.Coeff[j][0];
+        gains1[j] = State->mEarly.Coeff[j][1];
+    }
+    std::copy_n(temps[0], todo*NUM_LINES, lines[0]);
+    ReverbFadedDelayMix(lines, early_delay, taps0, taps1, gains0, gains1, fadeStart, FadeStep,
+        todo);
+    DelayLineRevIn(&early_delay, offset, temps, todo);
 
     const ALsizei late_feed_tap{offset - State->mLateFeedTap};
-    VectorScatterRevDelayIn(&main_delay, late_feed_tap, mixX, mixY, out, todo);
-}
+    ReverbScatterRevDelayIn(main_delay, late_feed_tap, mixX, mixY, lines, todo);
 
-/* Applies the two T60 damping filter sections. */
-inline void LateT60Filter(ALfloat *samples, const ALsizei todo, T60Filter *filter)
-{
-    filter->HFFilter.process(samples, samples, todo);
-    filter->LFFilter.process(samples, samples, todo);
+    DeinterleaveLines(out, lines, todo);
 }
 
 /* This generates the reverb tail using a modified feed-back delay network
@@ -1206,11 +1120,13 @@ inline void LateT60Filter(ALfloat *samples, const ALsizei todo, T60Filter *filte
 void LateReverb_Unfaded(ReverbState *State, ALsizei offset, const ALsizei todo,
                         ALfloat (*RESTRICT out)[MAX_UPDATE_SAMPLES])
 {
-    ALfloat (*RESTRICT temps)[MAX_UPDATE_SAMPLES]{State->mTempSamples};
-    const DelayLineI late_delay{State->mLate.Delay};
-    const DelayLineI main_delay{State->mDelay};
+    ALfloat (*RESTRICT temps)[NUM_LINES]{State->mTempLines};
+    const DelayLineI &late_delay = State->mLate.Delay;
+    const DelayLineI &main_delay = State->mDelay;
     const ALfloat mixX{State->mMixX};
     const ALfloat mixY{State->mMixY};
+    ALsizei taps[NUM_LINES];
+    ALfloat gains[NUM_LINES];
 
     ASSUME(todo > 0);
 
@@ -1219,76 +1135,78 @@ void LateReverb_Unfaded(ReverbState *State, ALsizei offset, const ALsizei todo,
      */
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        ALsizei late_delay_tap{offset - State->mLateDelayTap[j][0]};
-        ALsizei late_feedb_tap{offset - State->mLate.Offset[j][0]};
-        const ALfloat midGain{State->mLate.T60[j].MidGain[0]};
-        const ALfloat densityGain{State->mLate.DensityGain[0] * midGain};
-        for(ALsizei i{0};i < todo;i++)
-            temps[j][i] = DelayLineOut(&main_delay, late_delay_tap++, j)*densityGain +
-                          DelayLineOut(&late_delay, late_feedb_tap++, j)*midGain;
-        LateT60Filter(temps[j], todo, &State->mLate.T60[j]);
+        taps[j] = offset - State->mLateDelayTap[j][0];
+        gains[j] = State->mLate.DensityGain[0] * State->mLate.MidGain[j][0];
     }
+    std::fill_n(temps[0], todo*NUM_LINES, 0.0f);
+    ReverbDelayMix(temps, main_delay, taps, gains, todo);
+    for(ALsizei j{0};j < NUM_LINES;j++)
+    {
+        taps[j] = offset - State->mLate.Offset[j][0];
+        gains[j] = State->mLate.MidGain[j][0];
+    }
+    ReverbDelayMix(temps, late_delay, taps, gains, todo);
+    ReverbT60Filter(temps, &State->mLate.T60, todo);
 
     /* Apply a vector all-pass to improve micro-surface diffusion, and write
      * out the results for mixing.
      */
-    VectorAllpass_Unfaded(temps, offset, mixX, mixY, todo, &State->mLate.VecAp);
-
     for(ALsizei j{0};j < NUM_LINES;j++)
-        std::copy_n(temps[j], todo, out[j]);
+        taps[j] = offset - State->mLate.VecAp.Offset[j][0];
+    ReverbAllpass(temps, State->mLate.VecAp.Delay, offset, taps, State->mLate.VecAp.Coeff,
+        mixX, mixY, todo);
+
+    DeinterleaveLines(out, temps, todo);
 
     /* Finally, scatter and bounce the results to refeed the feedback buffer. */
-    VectorScatterRevDelayIn(&late_delay, offset, mixX, mixY, out, todo);
+    ReverbScatterRevDelayIn(late_delay, offset, mixX, mixY, temps, todo);
 }
 void LateReverb_Faded(ReverbState *State, ALsizei offset, const ALsizei todo, const ALfloat fade,
                       ALfloat (*RESTRICT out)[MAX_UPDATE_SAMPLES])
 {
-    ALfloat (*RESTRICT temps)[MAX_UPDATE_SAMPLES]{State->mTempSamples};
-    const DelayLineI late_delay{State->mLate.Delay};
-    const DelayLineI main_delay{State->mDelay};
+    ALfloat (*RESTRICT temps)[NUM_LINES]{State->mTempLines};
+    const DelayLineI &late_delay = State->mLate.Delay;
+    const DelayLineI &main_delay = State->mDelay;
     const ALfloat mixX{State->mMixX};
     const ALfloat mixY{State->mMixY};
+    const ALfloat fadeStart{fade * FadeStep};
+    ALsizei taps0[NUM_LINES], taps1[NUM_LINES];
+    ALfloat gains0[NUM_LINES], gains1[NUM_LINES];
 
     ASSUME(todo > 0);
 
     for(ALsizei j{0};j < NUM_LINES;j++)
     {
-        const ALfloat oldMidGain{State->mLate.T60[j].MidGain[0]};
-        const ALfloat midGain{State->mLate.T60[j].MidGain[1]};
-        const ALfloat oldMidStep{-oldMidGain / FADE_SAMPLES};
-        const ALfloat midStep{midGain / FADE_SAMPLES};
-        const ALfloat oldDensityGain{State->mLate.DensityGain[0] * oldMidGain};
-        const ALfloat densityGain{State->mLate.DensityGain[1] * midGain};
-        const ALfloat oldDensityStep{-oldDensityGain / FADE_SAMPLES};
-        const ALfloat densityStep{densityGain / FADE_SAMPLES};
-        ALsizei late_delay_tap0{offset - State->mLateDelayTap[j][0]};
-        ALsizei late_delay_tap1{offset - State->mLateDelayTap[j][1]};
-        ALsizei late_feedb_tap0{offset - State->mLate.Offset[j][0]};
-        ALsizei late_feedb_tap1{offset - State->mLate.Offset[j][1]};
-        ALfloat fadeCount{fade};
-
-        for(ALsizei i{0};i < todo;i++)
-        {
-            const ALfloat fade0 = oldDensityGain + oldDensityStep*fadeCount;
-            const ALfloat fade1 = densityStep*fadeCount;
-            const ALfloat gfade0 = oldMidGain + oldMidStep*fadeCount;
-            const ALfloat gfade1 = midStep*fadeCount;
-            temps[j][i] =
-                FadedDelayLineOut(&main_delay, late_delay_tap0++, late_delay_tap1++, j,
-                    fade0, fade1) +
-                FadedDelayLineOut(&late_delay, late_feedb_tap0++, late_feedb_tap1++, j,
-                    gfade0, gfade1);
-            fadeCount += 1.0f;
-        }
-        LateT60Filter(temps[j], todo, &State->mLate.T60[j]);
+        taps0[j] = offset - State->mLateDelayTap[j][0];
+        taps1[j] = offset - State->mLateDelayTap[j][1];
+        gains0[j] = State->mLate.DensityGain[0] * State->mLate.MidGain[j][0];
+        gains1[j] = State->mLate.DensityGain[1] * State->mLate.MidGain[j][1];
     }
-
-    VectorAllpass_Faded(temps, offset, mixX, mixY, fade, todo, &State->mLate.VecAp);
+    std::fill_n(temps[0], todo*NUM_LINES, 0.0f);
+    ReverbFadedDelayMix(temps, main_delay, taps0, taps1, gains0, gains1, fadeStart, FadeStep,
+        todo);
+    for(ALsizei j{0};j < NUM_LINES;j++)
+    {
+        taps0[j] = offset - State->mLate.Offset[j][0];
+        taps1[j] = offset - State->mLate.Offset[j][1];
+        gains0[j] = State->mLate.MidGain[j][0];
+        gains1[j] = State->mLate.MidGain[j][1];
+    }
+    ReverbFadedDelayMix(temps, late_delay, taps0, taps1, gains0, gains1, fadeStart, FadeStep,
+        todo);
+    ReverbT60Filter(temps, &State->mLate.T60, todo);
 
     for(ALsizei j{0};j < NUM_LINES;j++)
-        std::copy_n(temps[j], todo, out[j]);
+    {
+        taps0[j] = offset - State->mLate.VecAp.Offset[j][0];
+        taps1[j] = offset - State->mLate.VecAp.Offset[j][1];
+    }
+    ReverbFadedAllpass(temps, State->mLate.VecAp.Delay, offset, taps0, taps1,
+        State->mLate.VecAp.Coeff, mixX, mixY, fadeStart, FadeStep, todo);
+
+    DeinterleaveLines(out, temps, todo);
 
-    VectorScatterRevDelayIn(&late_delay, offset, mixX, mixY, temps, todo);
+    ReverbScatterRevDelayIn(late_delay, offset, mixX, mixY, temps, todo);
 }
 
 void ReverbState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT SamplesIn)[BUFFERSIZE], ALfloat (*RESTRICT SamplesOut)[BUFFERSIZE], ALsizei NumChannels)
@@ -1376,7 +1294,7 @@ void ReverbState::process(ALsizei SamplesToDo, const ALfloat (*RESTRICT SamplesI
                     mLateDelayTap[c][0] = mLateDelayTap[c][1];
                     mLate.VecAp.Offset[c][0] = mLate.VecAp.Offset[c][1];
                     mLate.Offset[c][0] = mLate.Offset[c][1];
-                    mLate.T60[c].MidGain[0] = mLate.T60[c].MidGain[1];
+                    mLate.MidGain[c][0] = mLate.MidGain[c][1];
                 }
                 mLate.DensityGain[0] = mLate.DensityGain[1];
                 mMaxUpdate[0] = mMaxUpdate[1];
@@ -0,0 +1,89 @@
+#ifndef EFFECTS_REVERB_H
+#define EFFECTS_REVERB_H
+
+#include <iterator>
+#include <algorithm>
+
+#include "alMain.h"
+
+
+/* The number of spatialized lines or channels to process. Four channels allows
+ * for a 3D A-Format response. Each sample frame of the lines is one 4-float
+ * vector, so the processing kernels below handle all lines at once with one
+ * line per SIMD lane.
+ */
+#define REVERB_LINES 4
+
+struct DelayLineI {
+    /* The delay lines use interleaved samples, with the lengths being powers
+     * of 2 to allow the use of bit-masking instead of a modulus for wrapping.
+     */
+    ALsizei  Mask{0};
+    ALfloat (*Line)[REVERB_LINES]{nullptr};
+};
+
+/* A set of biquad filters, one per line, with the coefficients and history
+ * arranged by lane.
+ */
+struct BiquadLanes {
+    alignas(16) ALfloat b0[REVERB_LINES]{};
+    alignas(16) ALfloat b1[REVERB_LINES]{};
+    alignas(16) ALfloat b2[REVERB_LINES]{};
+    alignas(16) ALfloat a1[REVERB_LINES]{};
+    alignas(16) ALfloat a2[REVERB_LINES]{};
+    alignas(16) ALfloat z1[REVERB_LINES]{};
+    alignas(16) ALfloat z2[REVERB_LINES]{};
+
+    void clear() noexcept
+    {
+        std::fill(std::begin(z1), std::end(z1), 0.0f);
+        std::fill(std::begin(z2), std::end(z2), 0.0f);
+    }
+};
+
+/* The high and low shelf sections of the late reverb's T60 damping filters. */
+struct T60FilterLanes {
+    BiquadLanes HFFilter, LFFilter;
+};
+
+
+/* Adds each line's delayed samples, read starting at the given offsets and
+ * scaled by the given gains, to dst.
+ */
+using ReverbDelayMixFunc = void(*)(ALfloat (*RESTRICT dst)[REVERB_LINES],
+    const DelayLineI &delay, const ALsizei *offsets, const ALfloat *gains, const ALsizei todo);
+/* Cross-fades from reading at offsets0 with gains0 to reading at offsets1 with
+ * gains1, with fade going from 0 to 1 in fadeStep increments.
+ */
+using ReverbFadedDelayMixFunc = void(*)(ALfloat (*RESTRICT dst)[REVERB_LINES],
+    const DelayLineI &delay, const ALsizei *offsets0, const ALsizei *offsets1,
+    const ALfloat *gains0, const ALfloat *gains1, ALfloat fade, const ALfloat fadeStep,
+    const ALsizei todo);
+/* Applies the vector all-pass in place, writing its scattered feedback to the
+ * delay line at offset.
+ */
+using ReverbAllpassFunc = void(*)(ALfloat (*RESTRICT samples)[REVERB_LINES],
+    const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets,
+    const ALfloat feedCoeff, const ALfloat xCoeff, const ALfloat yCoeff, const ALsizei todo);
+using ReverbFadedAllpassFunc = void(*)(ALfloat (*RESTRICT samples)[REVERB_LINES],
+    const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets0,
+    const ALsizei *vapOffsets1, const ALfloat feedCoeff, const ALfloat xCoeff,
+    const ALfloat yCoeff, ALfloat fade, const ALfloat fadeStep, const ALsizei todo);
+/* Reverses the lines of each input frame and writes them to the delay line
+ * through the scattering matrix.
+ */
+using ReverbScatterRevDelayInFunc = void(*)(const DelayLineI &delay, ALsizei offset,
+    const ALfloat xCoeff, const ALfloat yCoeff, const ALfloat (*RESTRICT in)[REVERB_LINES],
+    const ALsizei todo);
+/* Applies the two T60 damping filter sections in place. */
+using ReverbT60FilterFunc = void(*)(ALfloat (*RESTRICT samples)[REVERB_LINES],
+    T60FilterLanes *filter, const ALsizei todo);
+
+extern ReverbDelayMixFunc ReverbDelayMix;
+extern ReverbFadedDelayMixFunc ReverbFadedDelayMix;
+extern ReverbAllpassFunc ReverbAllpass;
+extern ReverbFadedAllpassFunc ReverbFadedAllpass;
+extern ReverbScatterRevDelayInFunc ReverbScatterRevDelayIn;
+extern ReverbT60FilterFunc ReverbT60Filter;
+
+#endif /* EFFECTS_REVERB_H */
@@ -2,6 +2,7 @@
 #include "config.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "AL/alc.h"
 #include "AL/al.h"
@@ -125,3 +126,31 @@ void BiquadFilterR<Real>::process(Real *dst, const Real *src, int numsamples)
 
 template class BiquadFilterR<float>;
 template class BiquadFilterR<double>;
+
+
+const BiquadFilter &BiquadCache::get(BiquadType type, float gain, float f0norm, float rcpQ)
+{
+    auto float_bits = [](const float f) noexcept -> ALuint
+    {
+        ALuint ret;
+        std::memcpy(&ret, &f, sizeof(ret));
+        return ret;
+    };
+    ALuint hash{static_cast<ALuint>(type)};
+    hash = (hash*0x9e3779b1u) ^ float_bits(gain);
+    hash = (hash*0x9e3779b1u) ^ float_bits(f0norm);
+    hash = (hash*0x9e3779b1u) ^ float_bits(rcpQ);
+    hash ^= hash >> 16;
+
+    Entry &entry = mEntries[(hash*0x9e3779b1u) >> 25];
+    static_assert(sNumEntries == 1u<<(32-25), "Cache index doesn't match the entry count");
+    if(entry.type != type || entry.gain != gain || entry.f0norm != f0norm || entry.rcpQ != rcpQ)
+    {
+        entry.type = type;
+        entry.gain = gain;
+        entry.f0norm = f0norm;
+        entry.rcpQ = rcpQ;
+        entry.filter.setParams(type, gain, f0norm, rcpQ);
+    }
+    return entry.filter;
+}
@@ -2,6 +2,7 @@
 #define FILTERS_BIQUAD_H
 
 #include <cmath>
+#include <array>
 #include <utility>
 
 #include "AL/al.h"
@@ -88,6 +89,12 @@ public:
         }
     }
 
+    /* Retrieves the coefficients as {b0, b1, b2, a1, a2}, for processors that
+     * run multiple filters in parallel.
+     */
+    std::array<Real,5> getCoeffs() const noexcept
+    { return {{b0, b1, b2, a1, a2}}; }
+
     /* Rather hacky. It's just here to support "manual" processing. */
     std::pair<Real,Real> getComponents() const noexcept
     { return {z1, z2}; }
@@ -104,6 +111,27 @@ public:
 
 using BiquadFilter = BiquadFilterR<float>;
 
+/* Direct-mapped cache of filter coefficients, so filters using the same
+ * parameters (e.g. many sources with the same occlusion filter) only need to
+ * calculate them once. Each entry is a filter holding the coefficients, which
+ * can be copied with copyParamsFrom. Not thread-safe.
+ */
+class BiquadCache {
+    struct Entry {
+        BiquadType type;
+        float gain, f0norm, rcpQ;
+        BiquadFilter filter;
+    };
+    static constexpr size_t sNumEntries{128};
+
+    /* A gain of 0 marks an unused entry, as it's not a valid filter gain. */
+    Entry mEntries[sNumEntries]{};
+
+public:
+    /** Returns a filter with the coefficients for the given parameters. */
+    const BiquadFilter &get(BiquadType type, float gain, float f0norm, float rcpQ);
+};
+
 /**
  * Calculates the rcpQ (i.e. 1/Q) coefficient for shelving filters, using the
  * reference gain and shelf slope parameter.
@@ -0,0 +1,171 @@
+
+#include "config.h"
+
+#include "modulation.h"
+
+#include <cmath>
+#include <array>
+#include <algorithm>
+
+#include "math_defs.h"
+
+
+namespace {
+
+#define SINTABLE_BITS  11
+#define SINTABLE_SIZE  (1<<SINTABLE_BITS)
+#define SINTABLE_MASK  (SINTABLE_SIZE-1)
+
+#define SINTABLE_FRACBITS (OSCILLATOR_FRACBITS-SINTABLE_BITS)
+#define SINTABLE_FRACONE  (1<<SINTABLE_FRACBITS)
+#define SINTABLE_FRACMASK (SINTABLE_FRACONE-1)
+
+/* One period of a sine wave, with the first sample repeated at the end for
+ * interpolation.
+ */
+std::array<ALfloat,SINTABLE_SIZE+1> InitSinTable()
+{
+    std::array<ALfloat,SINTABLE_SIZE+1> ret;
+    for(ALsizei i{0};i < SINTABLE_SIZE;i++)
+        ret[i] = static_cast<ALfloat>(std::sin(al::MathDefs<double>::Tau() * i /
+            double{SINTABLE_SIZE}));
+    ret[SINTABLE_SIZE] = ret[0];
+    return ret;
+}
+alignas(16) const std::array<ALfloat,SINTABLE_SIZE+1> SinTable = InitSinTable();
+
+inline ALfloat lookup_sin(const ALsizei index) noexcept
+{
+    const ALsizei idx{index >> SINTABLE_FRACBITS};
+    const ALfloat frac{(index&SINTABLE_FRACMASK) * (1.0f/SINTABLE_FRACONE)};
+    return SinTable[idx] + (SinTable[idx+1]-SinTable[idx])*frac;
+}
+
+
+/* All-pass coefficients (already squared) for the real and imaginary chains.
+ * Each section is a second-order all-pass in z^-2:
+ *   y[n] = c*(x[n] + y[n-2]) - x[n-2]
+ */
+constexpr ALfloat RealCoeffs[4]{
+    0.6923878f*0.6923878f, 0.9360654322959f*0.9360654322959f,
+    0.9882295226860f*0.9882295226860f, 0.9987488452737f*0.9987488452737f
+};
+constexpr ALfloat ImagCoeffs[4]{
+    0.4021921162426f*0.4021921162426f, 0.8561710882420f*0.8561710882420f,
+    0.9722909545651f*0.9722909545651f, 0.9952884791278f*0.9952884791278f
+};
+
+} // namespace
+
+
+bool Oscillator::setFrequency(ALfloat f0norm) noexcept
+{
+    mStep = clampi(fastf2i(f0norm * OSCILLATOR_FRACONE), 0, OSCILLATOR_FRACONE-1);
+    return mStep != 0;
+}
+
+void Oscillator::processSine(ALfloat *RESTRICT dst, const ALsizei todo) noexcept
+{
+    ASSUME(todo > 0);
+
+    ALsizei index{mIndex};
+    const ALsizei step{mStep};
+    std::generate_n(dst, todo,
+        [&index,step]() noexcept -> ALfloat
+        {
+            index = (index+step) & OSCILLATOR_FRACMASK;
+            return lookup_sin(index);
+        }
+    );
+    mIndex = index;
+}
+
+void Oscillator::processSawtooth(ALfloat *RESTRICT dst, const ALsizei todo) noexcept
+{
+    ASSUME(todo > 0);
+
+    ALsizei index{mIndex};
+    const ALsizei step{mStep};
+    std::generate_n(dst, todo,
+        [&index,step]() noexcept -> ALfloat
+        {
+            index = (index+step) & OSCILLATOR_FRACMASK;
+            return static_cast<ALfloat>(index)*(2.0f/OSCILLATOR_FRACONE) - 1.0f;
+        }
+    );
+    mIndex = index;
+}
+
+void Oscillator::processSquare(ALfloat *RESTRICT dst, const ALsizei todo) noexcept
+{
+    ASSUME(todo > 0);
+
+    ALsizei index{mIndex};
+    const ALsizei step{mStep};
+    std::generate_n(dst, todo,
+        [&index,step]() noexcept -> ALfloat
+        {
+            index = (index+step) & OSCILLATOR_FRACMASK;
+            return static_cast<ALfloat>(((index>>(OSCILLATOR_FRACBITS-2))&2) - 1);
+        }
+    );
+    mIndex = index;
+}
+
+void Oscillator::processQuadrature(ALfloat *RESTRICT cosdst, ALfloat *RESTRICT sindst,
+    const ALsizei todo) noexcept
+{
+    ASSUME(todo > 0);
+
+    ALsizei index{mIndex};
+    const ALsizei step{mStep};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        cosdst[i] = lookup_sin((index + OSCILLATOR_FRACONE/4) & OSCILLATOR_FRACMASK);
+        sindst[i] = lookup_sin(index);
+        index = (index+step) & OSCILLATOR_FRACMASK;
+    }
+    mIndex = index;
+}
+
+
+void HilbertTransformer::clear() noexcept
+{
+    std::fill(std::begin(mReal), std::end(mReal), Section{});
+    std::fill(std::begin(mImag), std::end(mImag), Section{});
+    mRealDelay = 0.0f;
+}
+
+void HilbertTransformer::process(ALfloat *RESTRICT real, ALfloat *RESTRICT imag,
+    const ALfloat *RESTRICT src, const ALsizei todo) noexcept
+{
+    ASSUME(todo > 0);
+
+    auto allpass = [](Section &sect, const ALfloat coeff, const ALfloat in) noexcept -> ALfloat
+    {
+        const ALfloat out{coeff*(in + sect.y2) - sect.x2};
+        sect.x2 = sect.x1; sect.x1 = in;
+        sect.y2 = sect.y1; sect.y1 = out;
+        return out;
+    };
+
+    Section re[NumSections], im[NumSections];
+    std::copy(std::begin(mReal), std::end(mReal), std::begin(re));
+    std::copy(std::begin(mImag), std::end(mImag), std::begin(im));
+    ALfloat delay{mRealDelay};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        ALfloat r{src[i]}, q{src[i]};
+        for(ALsizei s{0};s < NumSections;s++)
+        {
+            r = allpass(re[s], RealCoeffs[s], r);
+            q = allpass(im[s], ImagCoeffs[s], q);
+        }
+        real[i] = delay;
+        imag[i] = q;
+        delay = r;
+    }
+    std::copy(std::begin(re), std::end(re), std::begin(mReal));
+    std::copy(std::begin(im), std::end(im), std::begin(mImag));
+    mRealDelay = delay;
+}
@@ -0,0 +1,77 @@
+#ifndef FILTERS_MODULATION_H
+#define FILTERS_MODULATION_H
+
+#include "alMain.h"
+
+
+/* Fixed-point phase used by the oscillator, where OSCILLATOR_FRACONE is one
+ * full period.
+ */
+#define OSCILLATOR_FRACBITS 24
+#define OSCILLATOR_FRACONE  (1<<OSCILLATOR_FRACBITS)
+#define OSCILLATOR_FRACMASK (OSCILLATOR_FRACONE-1)
+
+/* Table-driven oscillator for the modulation effects. The sine and cosine
+ * outputs come from a shared lookup table with linear interpolation, so no
+ * transcendental functions are called while generating samples.
+ */
+class Oscillator {
+    ALsizei mIndex{0};
+    ALsizei mStep{0};
+
+public:
+    void reset() noexcept { mIndex = 0; }
+
+    /**
+     * Sets the oscillator frequency, given as a normalized frequency (freq /
+     * sample_rate). Returns false if the frequency rounds to 0 (i.e. the
+     * oscillator would output a constant value).
+     */
+    bool setFrequency(ALfloat f0norm) noexcept;
+
+    /* Each of these advances the phase for every sample before evaluating it. */
+    void processSine(ALfloat *RESTRICT dst, const ALsizei todo) noexcept;
+    void processSawtooth(ALfloat *RESTRICT dst, const ALsizei todo) noexcept;
+    void processSquare(ALfloat *RESTRICT dst, const ALsizei todo) noexcept;
+    /* Generates cosine and sine outputs for quadrature modulation. Unlike the
+     * above, each pair is evaluated at the current phase before advancing, so
+     * the first pair is at the starting phase.
+     */
+    void processQuadrature(ALfloat *RESTRICT cosdst, ALfloat *RESTRICT sindst,
+        const ALsizei todo) noexcept;
+};
+
+
+/* IIR Hilbert transformer, made from a pair of all-pass filter chains whose
+ * outputs stay 90 degrees apart over almost the whole audio band (within half
+ * a degree from ~20hz to ~20khz at 44.1khz). Unlike an FFT-based transform,
+ * this adds only a few samples of delay.
+ *
+ * Based on the polyphase design by Olli Niemitalo:
+ * http://yehar.com/blog/?p=368
+ */
+class HilbertTransformer {
+    static constexpr ALsizei NumSections{4};
+
+    struct Section {
+        ALfloat x1, x2;
+        ALfloat y1, y2;
+    };
+    Section mReal[NumSections]{};
+    Section mImag[NumSections]{};
+    /* The real chain's output is delayed by one more sample. */
+    ALfloat mRealDelay{0.0f};
+
+public:
+    void clear() noexcept;
+
+    /**
+     * Generates the in-phase (real) and quadrature (imaginary) components of
+     * the analytic signal for src. The quadrature component leads by 90
+     * degrees.
+     */
+    void process(ALfloat *RESTRICT real, ALfloat *RESTRICT imag, const ALfloat *RESTRICT src,
+        const ALsizei todo) noexcept;
+};
+
+#endif /* FILTERS_MODULATION_H */
@@ -0,0 +1,133 @@
+
+#include "config.h"
+
+#include "polyphase.h"
+
+#include <cmath>
+#include <array>
+#include <numeric>
+#include <algorithm>
+
+#include "math_defs.h"
+#include "mixer/defs.h"
+
+
+PolyphaseUpsampleFunc PolyphaseUpsampleSamples = PolyphaseUpsample_<CTag>;
+PolyphaseDownsampleFunc PolyphaseDownsampleSamples = PolyphaseDownsample_<CTag>;
+
+namespace {
+
+/* Cutoff frequency of the prototype filter, normalized to the oversampled
+ * rate, and the Kaiser window's beta parameter. This gives a flat pass-band
+ * over most of the base rate's spectrum, while attenuating images and
+ * aliases by about 58dB.
+ */
+constexpr double PrototypeCutoff{0.11};
+constexpr double PrototypeBeta{6.0};
+
+double BesselI_0(const double x)
+{
+    double term{1.0}, sum{1.0}, last_sum;
+    const double x2{x / 2.0};
+    int i{1};
+    do {
+        const double y{x2 / i};
+        i++;
+        last_sum = sum;
+        term *= y * y;
+        sum += term;
+    } while(sum != last_sum);
+    return sum;
+}
+
+std::array<double,POLYPHASE_LENGTH> InitPrototype()
+{
+    std::array<double,POLYPHASE_LENGTH> ret;
+    const double besselb{BesselI_0(PrototypeBeta)};
+    for(ALsizei i{0};i < POLYPHASE_LENGTH;i++)
+    {
+        const double x{i - (POLYPHASE_LENGTH-1)/2.0};
+        const double k{x / ((POLYPHASE_LENGTH-1)/2.0)};
+        const double window{BesselI_0(PrototypeBeta * std::sqrt(1.0 - k*k)) / besselb};
+        const double sx{al::MathDefs<double>::Pi() * 2.0*PrototypeCutoff * x};
+        ret[i] = window * ((std::fabs(sx) > 1e-9) ? std::sin(sx)/sx : 1.0);
+    }
+    /* Normalize for unity gain at DC. */
+    const double scale{1.0 / std::accumulate(ret.cbegin(), ret.cend(), 0.0)};
+    std::transform(ret.cbegin(), ret.cend(), ret.begin(),
+        [scale](const double val) noexcept -> double { return val * scale; });
+    return ret;
+}
+const std::array<double,POLYPHASE_LENGTH> Prototype = InitPrototype();
+
+/* The upsampler's coefficients are arranged by tap, each holding the
+ * coefficient for every output phase so all phases of an input sample can be
+ * computed together. They're scaled by the oversampling factor to maintain
+ * the signal's power.
+ */
+struct UpsampleCoeffs {
+    alignas(16) ALfloat Coeffs[POLYPHASE_TAPS][POLYPHASE_FACTOR];
+};
+UpsampleCoeffs InitUpsampleCoeffs()
+{
+    UpsampleCoeffs ret;
+    for(ALsizei j{0};j < POLYPHASE_TAPS;j++)
+    {
+        for(ALsizei p{0};p < POLYPHASE_FACTOR;p++)
+            ret.Coeffs[j][p] = static_cast<ALfloat>(Prototype[j*POLYPHASE_FACTOR + p] *
+                POLYPHASE_FACTOR);
+    }
+    return ret;
+}
+const UpsampleCoeffs UpsampleTable = InitUpsampleCoeffs();
+
+/* The downsampler applies the whole prototype filter to the input ending with
+ * the last sample of each group. The filter is symmetric, so the coefficients
+ * don't need to be reversed.
+ */
+struct DownsampleCoeffs {
+    alignas(16) ALfloat Coeffs[POLYPHASE_LENGTH];
+};
+DownsampleCoeffs InitDownsampleCoeffs()
+{
+    DownsampleCoeffs ret;
+    std::transform(Prototype.cbegin(), Prototype.cend(), std::begin(ret.Coeffs),
+        [](const double val) noexcept -> ALfloat { return static_cast<ALfloat>(val); });
+    return ret;
+}
+const DownsampleCoeffs DownsampleTable = InitDownsampleCoeffs();
+
+} // namespace
+
+
+void PolyphaseUpsampler::clear() noexcept
+{ std::fill(std::begin(mInput), std::end(mInput), 0.0f); }
+
+void PolyphaseUpsampler::process(ALfloat *RESTRICT dst, const ALfloat *RESTRICT src, const ALsizei count)
+{
+    ASSUME(count > 0);
+    ASSUME(count <= POLYPHASE_MAX_SAMPLES);
+
+    std::copy_n(src, count, std::begin(mInput)+(POLYPHASE_TAPS-1));
+    PolyphaseUpsampleSamples(UpsampleTable.Coeffs, &mInput[POLYPHASE_TAPS-1], dst, count);
+
+    /* Keep the last input samples for the next call. */
+    std::copy_n(std::begin(mInput)+count, POLYPHASE_TAPS-1, std::begin(mInput));
+}
+
+
+void PolyphaseDownsampler::clear() noexcept
+{ std::fill(std::begin(mInput), std::end(mInput), 0.0f); }
+
+void PolyphaseDownsampler::process(ALfloat *RESTRICT dst, const ALfloat *RESTRICT src, const ALsizei count)
+{
+    ASSUME(count > 0);
+    ASSUME(count <= POLYPHASE_MAX_SAMPLES);
+
+    const ALsizei total{count * POLYPHASE_FACTOR};
+    std::copy_n(src, total, std::begin(mInput)+(POLYPHASE_LENGTH-POLYPHASE_FACTOR));
+    PolyphaseDownsampleSamples(DownsampleTable.Coeffs, mInput, dst, count);
+
+    std::copy_n(std::begin(mInput)+total, POLYPHASE_LENGTH-POLYPHASE_FACTOR,
+        std::begin(mInput));
+}
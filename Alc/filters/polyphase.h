@@ -0,0 +1,72 @@
+#ifndef FILTERS_POLYPHASE_H
+#define FILTERS_POLYPHASE_H
+
+#include "alMain.h"
+#include "almalloc.h"
+
+
+/* Integer oversampling factor handled by the polyphase filters, and the number
+ * of filter taps used for each phase. The prototype low-pass filter is thus
+ * POLYPHASE_LENGTH taps long, with a cutoff just below the Nyquist frequency
+ * of the base (non-oversampled) rate.
+ */
+#define POLYPHASE_FACTOR 4
+#define POLYPHASE_TAPS   12
+#define POLYPHASE_LENGTH (POLYPHASE_FACTOR*POLYPHASE_TAPS)
+
+/* Maximum number of base-rate samples the filters can handle per call. */
+#define POLYPHASE_MAX_SAMPLES (BUFFERSIZE/POLYPHASE_FACTOR)
+
+static_assert(POLYPHASE_TAPS%4 == 0, "POLYPHASE_TAPS must be a multiple of 4");
+
+
+using PolyphaseUpsampleFunc = void(*)(const ALfloat (*RESTRICT coeffs)[POLYPHASE_FACTOR],
+    const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei srclen);
+using PolyphaseDownsampleFunc = void(*)(const ALfloat *RESTRICT coeffs,
+    const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei dstlen);
+
+extern PolyphaseUpsampleFunc PolyphaseUpsampleSamples;
+extern PolyphaseDownsampleFunc PolyphaseDownsampleSamples;
+
+
+/* Interpolating upsampler. Rather than filtering a zero-stuffed signal at the
+ * high rate, each output phase is computed directly from the non-zero input
+ * samples using its own subset of the prototype filter's taps.
+ */
+class PolyphaseUpsampler {
+    /* Input history needed by the filter, followed by the new input. */
+    alignas(16) ALfloat mInput[POLYPHASE_TAPS-1 + POLYPHASE_MAX_SAMPLES]{};
+
+public:
+    void clear() noexcept;
+
+    /**
+     * Upsamples count samples from src, writing count*POLYPHASE_FACTOR
+     * samples to dst. count must not exceed POLYPHASE_MAX_SAMPLES.
+     */
+    void process(ALfloat *RESTRICT dst, const ALfloat *RESTRICT src, const ALsizei count);
+
+    DEF_NEWDEL(PolyphaseUpsampler)
+};
+
+/* Decimating downsampler. Only the retained output samples are computed, with
+ * the prototype low-pass filter removing content above the base rate's
+ * Nyquist frequency to prevent aliasing.
+ */
+class PolyphaseDownsampler {
+    /* Input history needed by the filter, followed by the new input. */
+    alignas(16) ALfloat mInput[POLYPHASE_LENGTH-POLYPHASE_FACTOR + BUFFERSIZE]{};
+
+public:
+    void clear() noexcept;
+
+    /**
+     * Downsamples count*POLYPHASE_FACTOR samples from src, writing count
+     * samples to dst. count must not exceed POLYPHASE_MAX_SAMPLES.
+     */
+    void process(ALfloat *RESTRICT dst, const ALfloat *RESTRICT src, const ALsizei count);
+
+    DEF_NEWDEL(PolyphaseDownsampler)
+};
+
+#endif /* FILTERS_POLYPHASE_H */
@@ -20,6 +20,13 @@ public:
     FPUCtl& operator=(const FPUCtl&) = delete;
 
     void leave() noexcept;
+
+    /**
+     * Puts the calling thread into the mixer's FPU mode for the rest of its
+     * lifetime. For threads the library owns that exist only to mix, so each
+     * mixing call finds the mode already set and doesn't change it.
+     */
+    static void setThreadMode() noexcept;
 };
 
 #endif /* FPU_MODES_H */
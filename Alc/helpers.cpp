@@ -261,6 +261,9 @@ void FillCPUCaps(int capfilter)
 
 FPUCtl::FPUCtl() noexcept
 {
+    /* Only change the mode if the thread isn't already in it, which leaves
+     * nothing to restore later.
+     */
 #if defined(__GNUC__) && defined(HAVE_SSE)
     if((CPUCapFlags&CPU_CAP_SSE))
     {
@@ -269,17 +272,23 @@ FPUCtl::FPUCtl() noexcept
         sseState |= 0x8000; /* set flush-to-zero */
         if((CPUCapFlags&CPU_CAP_SSE2))
             sseState |= 0x0040; /* set denormals-are-zero */
+        if(sseState == this->sse_state)
+            return;
         __asm__ __volatile__("ldmxcsr %0" : : "m" (*&sseState));
     }
 
 #elif defined(HAVE___CONTROL87_2)
 
     __control87_2(0, 0, &this->state, &this->sse_state);
+    if((this->state&_MCW_DN) == _DN_FLUSH && (this->sse_state&_MCW_DN) == _DN_FLUSH)
+        return;
     _control87(_DN_FLUSH, _MCW_DN);
 
 #elif defined(HAVE__CONTROLFP)
 
     this->state = _controlfp(0, 0);
+    if((this->state&_MCW_DN) == _DN_FLUSH)
+        return;
     _controlfp(_DN_FLUSH, _MCW_DN);
 #endif
 
@@ -307,6 +316,13 @@ void FPUCtl::leave() noexcept
     this->in_mode = false;
 }
 
+void FPUCtl::setThreadMode() noexcept
+{
+    /* Enter the mode, and forget the old state so it isn't restored. */
+    FPUCtl mixer_mode{};
+    mixer_mode.in_mode = false;
+}
+
 
 #ifdef _WIN32
 
@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 
+#include <cmath>
 #include <mutex>
 #include <array>
 #include <vector>
@@ -207,8 +208,9 @@ IdxBlend CalcAzIndex(ALsizei azcount, ALfloat az)
 /* Calculates static HRIR coefficients and delays for the given polar elevation
  * and azimuth in radians. The coefficients are normalized.
  */
-void GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth, ALfloat distance,
-                   ALfloat spread, HrirArray<ALfloat> &coeffs, ALsizei *delays)
+ALsizei GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth,
+    ALfloat distance, ALfloat spread, const ALsizei lod, HrirArray<ALfloat> &coeffs,
+    ALsizei *delays)
 {
     const ALfloat dirfact{1.0f - (spread / al::MathDefs<float>::Tau())};
 
@@ -267,6 +269,7 @@ void GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth, AL
 
     const ALsizei irSize{Hrtf->irSize};
     ASSUME(irSize >= MIN_IR_SIZE);
+    ASSUME(lod >= 0 && lod <= HRTF_LOD_COUNT);
 
     /* Calculate the sample offsets for the HRIR indices. */
     idx[0] *= irSize;
@@ -274,6 +277,12 @@ void GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth, AL
     idx[2] *= irSize;
     idx[3] *= irSize;
 
+    /* Reduced levels of detail only blend the start of the IRs, leaving the
+     * rest silent.
+     */
+    const ALsizei lodSize{(lod > 0) ? Hrtf->lodSize[lod-1] : irSize};
+    ASSUME(lodSize >= MIN_IR_SIZE);
+
     /* Calculate the blended HRIR coefficients. */
     ALfloat *coeffout{al::assume_aligned<16>(&coeffs[0][0])};
     coeffout[0] = PassthruCoeff * (1.0f-dirfact);
@@ -285,9 +294,24 @@ void GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth, AL
         const ALfloat mult{blend[c]};
         auto blend_coeffs = [mult](const ALfloat src, const ALfloat coeff) noexcept -> ALfloat
         { return src*mult + coeff; };
-        std::transform<const ALfloat*RESTRICT>(srccoeffs, srccoeffs + irSize*2, coeffout,
+        std::transform<const ALfloat*RESTRICT>(srccoeffs, srccoeffs + lodSize*2, coeffout,
             coeffout, blend_coeffs);
     }
+
+    if(lod > 0)
+    {
+        /* Fade out the end of the truncated response to avoid a hard cut-off. */
+        const ALsizei fadeLen{lodSize / 4};
+        const ALfloat *fade{Hrtf->lodFade[lod-1]};
+        ALfloat *fadeout{coeffout + (lodSize-fadeLen)*2};
+        for(ALsizei i{0};i < fadeLen;i++)
+        {
+            fadeout[i*2 + 0] *= fade[i];
+            fadeout[i*2 + 1] *= fade[i];
+        }
+    }
+
+    return lodSize;
 }
 
 
@@ -538,6 +562,44 @@ std::unique_ptr<HrtfEntry> CreateHrtfStore(ALuint rate, ALsizei irSize, const AL
             delays_[i][1] = delays[i][1];
         }
 
+        /* Find the truncated IR lengths for the reduced levels of detail,
+         * keeping enough of the responses to hold all but -20dB and -13dB of
+         * the data set's total energy. These are only used for quieter voices,
+         * where the lost tail is masked by louder ones, and the windowed end
+         * avoids smearing the response with a hard cut-off.
+         */
+        static constexpr double LodResidual[HRTF_LOD_COUNT]{0.01, 0.05};
+        al::vector<double> energy(irSize, 0.0);
+        for(ALsizei i{0};i < irCount;i++)
+        {
+            for(ALsizei j{0};j < irSize;j++)
+            {
+                const ALfloat *coeff{coeffs[i*irSize + j]};
+                energy[j] += coeff[0]*coeff[0] + coeff[1]*coeff[1];
+            }
+        }
+        std::partial_sum(energy.begin(), energy.end(), energy.begin());
+
+        ALsizei lastSize{irSize};
+        for(ALsizei l{0};l < HRTF_LOD_COUNT;l++)
+        {
+            const double limit{energy.back() * (1.0-LodResidual[l])};
+            auto iter = std::lower_bound(energy.begin(), energy.end(), limit);
+            ALsizei lodSize{static_cast<ALsizei>(std::distance(energy.begin(), iter)) + 1};
+            lodSize = clampi(static_cast<ALsizei>(RoundUp(lodSize, 4)), MIN_IR_SIZE, lastSize);
+
+            const ALsizei fadeLen{lodSize / 4};
+            for(ALsizei i{0};i < fadeLen;i++)
+            {
+                const double x{static_cast<double>(i+1) / (fadeLen+1)};
+                Hrtf->lodFade[l][i] = static_cast<ALfloat>(0.5 + 0.5*std::cos(al::MathDefs<double>::Pi()*x));
+            }
+            Hrtf->lodSize[l] = lodSize;
+            lastSize = lodSize;
+        }
+        TRACE("HRTF level of detail IR lengths: %d, %d (full: %d)\n", Hrtf->lodSize[0],
+            Hrtf->lodSize[1], irSize);
+
         /* Finally, assign the storage pointers. */
         Hrtf->field = field_;
         Hrtf->azCount = azCount_;
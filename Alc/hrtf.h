@@ -20,6 +20,11 @@
 #define HRIR_LENGTH      (1<<HRIR_BITS)
 #define HRIR_MASK        (HRIR_LENGTH-1)
 
+/* The number of reduced levels of detail an HRTF voice can use, each applying
+ * a shorter IR than the last.
+ */
+#define HRTF_LOD_COUNT   (2)
+
 
 struct HrtfHandle;
 
@@ -41,6 +46,12 @@ struct HrtfEntry {
     const ALfloat (*coeffs)[2];
     const ALubyte (*delays)[2];
 
+    /* The truncated IR length for each reduced level of detail, and the
+     * window faded over the end of the truncated responses.
+     */
+    ALsizei lodSize[HRTF_LOD_COUNT];
+    ALfloat lodFade[HRTF_LOD_COUNT][HRIR_LENGTH/4];
+
     void IncRef();
     void DecRef();
 
@@ -67,6 +78,7 @@ struct HrtfParams {
     alignas(16) HrirArray<ALfloat> Coeffs;
     ALsizei Delay[2];
     ALfloat Gain;
+    ALsizei IrSize;
 };
 
 struct DirectHrtfState {
@@ -99,8 +111,14 @@ struct AngularPoint {
 al::vector<EnumeratedHrtf> EnumerateHrtf(const char *devname);
 HrtfEntry *GetLoadedHrtf(HrtfHandle *handle);
 
-void GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth, ALfloat distance,
-    ALfloat spread, HrirArray<ALfloat> &coeffs, ALsizei *delays);
+/* Calculates the HRIR coefficients and delays for the given direction. The
+ * level of detail (0 for the full response, up to HRTF_LOD_COUNT) selects a
+ * truncated IR, and the number of IR samples needing to be applied is
+ * returned.
+ */
+ALsizei GetHrtfCoeffs(const HrtfEntry *Hrtf, ALfloat elevation, ALfloat azimuth,
+    ALfloat distance, ALfloat spread, const ALsizei lod, HrirArray<ALfloat> &coeffs,
+    ALsizei *delays);
 
 /**
  * Produces HRTF filter coefficients for decoding B-Format, given a set of
@@ -85,6 +85,113 @@ AL_API void AL_APIENTRY alSourceQueueBufferLayersSOFT(ALuint src, ALsizei nb, co
 #define AL_EFFECTSLOT_TARGET_SOFT                0xf000
 #endif
 
+#ifndef AL_SOFT_voice_clusters
+#define AL_SOFT_voice_clusters 1
+#define AL_VOICE_CLUSTERS_SOFT                   0xf001
+#define AL_CLUSTERED_VOICES_SOFT                 0xf002
+#endif
+
+#ifndef AL_SOFT_submix_bus
+#define AL_SOFT_submix_bus 1
+#define AL_SUBMIX_BUS_SOFT                       0xf003
+#define AL_SUBMIX_BUS_SPATIALIZE_SOFT            0xf004
+#define AL_SUBMIX_BUS_EFFECTSLOT_SOFT            0xf005
+#define AL_SUBMIX_BUS_SEND_GAIN_SOFT             0xf006
+typedef void (AL_APIENTRY*LPALGENSUBMIXBUSESSOFT)(ALsizei n, ALuint *buses);
+typedef void (AL_APIENTRY*LPALDELETESUBMIXBUSESSOFT)(ALsizei n, const ALuint *buses);
+typedef ALboolean (AL_APIENTRY*LPALISSUBMIXBUSSOFT)(ALuint bus);
+typedef void (AL_APIENTRY*LPALSUBMIXBUSISOFT)(ALuint bus, ALenum param, ALint value);
+typedef void (AL_APIENTRY*LPALSUBMIXBUSIVSOFT)(ALuint bus, ALenum param, const ALint *values);
+typedef void (AL_APIENTRY*LPALSUBMIXBUSFSOFT)(ALuint bus, ALenum param, ALfloat value);
+typedef void (AL_APIENTRY*LPALSUBMIXBUSFVSOFT)(ALuint bus, ALenum param, const ALfloat *values);
+typedef void (AL_APIENTRY*LPALGETSUBMIXBUSISOFT)(ALuint bus, ALenum param, ALint *value);
+typedef void (AL_APIENTRY*LPALGETSUBMIXBUSIVSOFT)(ALuint bus, ALenum param, ALint *values);
+typedef void (AL_APIENTRY*LPALGETSUBMIXBUSFSOFT)(ALuint bus, ALenum param, ALfloat *value);
+typedef void (AL_APIENTRY*LPALGETSUBMIXBUSFVSOFT)(ALuint bus, ALenum param, ALfloat *values);
+#ifdef AL_ALEXT_PROTOTYPES
+AL_API void AL_APIENTRY alGenSubmixBusesSOFT(ALsizei n, ALuint *buses);
+AL_API void AL_APIENTRY alDeleteSubmixBusesSOFT(ALsizei n, const ALuint *buses);
+AL_API ALboolean AL_APIENTRY alIsSubmixBusSOFT(ALuint bus);
+AL_API void AL_APIENTRY alSubmixBusiSOFT(ALuint bus, ALenum param, ALint value);
+AL_API void AL_APIENTRY alSubmixBusivSOFT(ALuint bus, ALenum param, const ALint *values);
+AL_API void AL_APIENTRY alSubmixBusfSOFT(ALuint bus, ALenum param, ALfloat value);
+AL_API void AL_APIENTRY alSubmixBusfvSOFT(ALuint bus, ALenum param, const ALfloat *values);
+AL_API void AL_APIENTRY alGetSubmixBusiSOFT(ALuint bus, ALenum param, ALint *value);
+AL_API void AL_APIENTRY alGetSubmixBusivSOFT(ALuint bus, ALenum param, ALint *values);
+AL_API void AL_APIENTRY alGetSubmixBusfSOFT(ALuint bus, ALenum param, ALfloat *value);
+AL_API void AL_APIENTRY alGetSubmixBusfvSOFT(ALuint bus, ALenum param, ALfloat *values);
+#endif
+#endif
+
+#ifndef AL_SOFT_multi_listener
+#define AL_SOFT_multi_listener 1
+#define ALC_MAX_LISTENERS_SOFT                   0x19A3
+#define AL_NUM_LISTENERS_SOFT                    0xf007
+typedef void (AL_APIENTRY*LPALSELECTLISTENERSOFT)(ALsizei index);
+typedef void (ALC_APIENTRY*LPALCRENDERLISTENERSAMPLESSOFT)(ALCdevice *device, ALCsizei numbuffers, ALCvoid **buffers, ALCsizei samples);
+#ifdef AL_ALEXT_PROTOTYPES
+AL_API void AL_APIENTRY alSelectListenerSOFT(ALsizei index);
+ALC_API void ALC_APIENTRY alcRenderListenerSamplesSOFT(ALCdevice *device, ALCsizei numbuffers, ALCvoid **buffers, ALCsizei samples);
+#endif
+#endif
+
+#ifndef AL_SOFT_half_packed24_formats
+#define AL_SOFT_half_packed24_formats 1
+#define AL_FORMAT_MONO_HALF_SOFT                 0xf008
+#define AL_FORMAT_STEREO_HALF_SOFT               0xf009
+#define AL_FORMAT_51CHN_HALF_SOFT                0xf00a
+#define AL_FORMAT_71CHN_HALF_SOFT                0xf00b
+#define AL_FORMAT_BFORMAT2D_HALF_SOFT            0xf00c
+#define AL_FORMAT_BFORMAT3D_HALF_SOFT            0xf00d
+#define AL_FORMAT_MONO24_SOFT                    0xf00e
+#define AL_FORMAT_STEREO24_SOFT                  0xf00f
+#define AL_FORMAT_51CHN24_SOFT                   0xf010
+#define AL_FORMAT_71CHN24_SOFT                   0xf011
+#define AL_FORMAT_BFORMAT2D_24_SOFT              0xf012
+#define AL_FORMAT_BFORMAT3D_24_SOFT              0xf013
+#endif
+
+#ifndef AL_SOFT_buffer_residency
+#define AL_SOFT_buffer_residency 1
+typedef void (AL_APIENTRY*LPALBUFFERFILESOFT)(ALuint buffer, ALenum format, const ALchar *filename, ALsizei offset, ALsizei size, ALsizei freq);
+#ifdef AL_ALEXT_PROTOTYPES
+AL_API void AL_APIENTRY alBufferFileSOFT(ALuint buffer, ALenum format, const ALchar *filename, ALsizei offset, ALsizei size, ALsizei freq);
+#endif
+#endif
+
+#ifndef AL_SOFT_source_status
+#define AL_SOFT_source_status 1
+typedef void (AL_APIENTRY*LPALGETSOURCESTATUSVSOFT)(ALsizei n, const ALuint *sources, ALint *states, ALint *processed, ALint64SOFT *offsets, ALint64SOFT *latency);
+#ifdef AL_ALEXT_PROTOTYPES
+AL_API void AL_APIENTRY alGetSourceStatusvSOFT(ALsizei n, const ALuint *sources, ALint *states, ALint *processed, ALint64SOFT *offsets, ALint64SOFT *latency);
+#endif
+#endif
+
+#ifndef ALC_SOFT_reload_config
+#define ALC_SOFT_reload_config 1
+typedef ALCboolean (ALC_APIENTRY*LPALCRELOADCONFIGSOFT)(void);
+#ifdef AL_ALEXT_PROTOTYPES
+ALC_API ALCboolean ALC_APIENTRY alcReloadConfigSOFT(void);
+#endif
+#endif
+
+#ifndef ALC_SOFT_reopen_device
+#define ALC_SOFT_reopen_device 1
+typedef ALCboolean (ALC_APIENTRY*LPALCREOPENDEVICESOFT)(ALCdevice *device,
+    const ALCchar *deviceName, const ALCint *attribs);
+#ifdef AL_ALEXT_PROTOTYPES
+ALC_API ALCboolean ALC_APIENTRY alcReopenDeviceSOFT(ALCdevice *device, const ALCchar *deviceName,
+    const ALCint *attribs);
+#endif
+#endif
+
+#ifndef ALC_SOFT_memory_usage
+#define ALC_SOFT_memory_usage 1
+#define ALC_DEVICE_MEMORY_SOFT                   0x19A0
+#define ALC_CONTEXTS_MEMORY_SOFT                 0x19A1
+#define ALC_EFFECT_SLOTS_MEMORY_SOFT             0x19A2
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -1,10 +1,17 @@
 #ifndef MIXER_DEFS_H
 #define MIXER_DEFS_H
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
 #include "AL/alc.h"
 #include "AL/al.h"
 #include "alMain.h"
 #include "alu.h"
+#include "filters/polyphase.h"
+#include "effects/reverb.h"
+#include "sample_cvt.h"
 
 
 struct MixGains;
@@ -28,12 +35,22 @@ struct BSincTag { };
 
 template<typename TypeTag, typename InstTag>
 const ALfloat *Resample_(const InterpState *state, const ALfloat *RESTRICT src, ALsizei frac, ALint increment, ALfloat *RESTRICT dst, ALsizei dstlen);
+template<typename TypeTag, typename InstTag>
+void ResampleMulti_(const InterpState *state, const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans, ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen);
 
 template<typename InstTag>
 void Mix_(const ALfloat *data, const ALsizei OutChans, ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains, const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize);
 template<typename InstTag>
 void MixRow_(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*data)[BUFFERSIZE], const ALsizei InChans, const ALsizei InPos, const ALsizei BufferSize);
 
+/* Returns a mixer specialized for the given number of channels, or the
+ * generic mixer if there isn't one.
+ */
+template<typename InstTag>
+MixerFunc SelectChanMixer_(const ALsizei OutChans);
+template<typename InstTag>
+RowMixerFunc SelectChanRowMixer_(const ALsizei InChans);
+
 template<typename InstTag>
 void MixHrtf_(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut, const ALfloat *data, ALsizei Offset, const ALsizei OutPos, const ALsizei IrSize, MixHrtfParams *hrtfparams, HrtfState *hrtfstate, const ALsizei BufferSize);
 template<typename InstTag>
@@ -41,6 +58,62 @@ void MixHrtfBlend_(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut, const
 template<typename InstTag>
 void MixDirectHrtf_(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut, const ALfloat (*data)[BUFFERSIZE], DirectHrtfState *State, const ALsizei NumChans, const ALsizei BufferSize);
 
+template<typename InstTag>
+void PolyphaseUpsample_(const ALfloat (*RESTRICT coeffs)[POLYPHASE_FACTOR], const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei srclen);
+template<typename InstTag>
+void PolyphaseDownsample_(const ALfloat *RESTRICT coeffs, const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei dstlen);
+
+template<typename InstTag>
+void ReverbDelayMix_(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay, const ALsizei *offsets, const ALfloat *gains, const ALsizei todo);
+template<typename InstTag>
+void ReverbFadedDelayMix_(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay, const ALsizei *offsets0, const ALsizei *offsets1, const ALfloat *gains0, const ALfloat *gains1, ALfloat fade, const ALfloat fadeStep, const ALsizei todo);
+template<typename InstTag>
+void ReverbAllpass_(ALfloat (*RESTRICT samples)[REVERB_LINES], const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets, const ALfloat feedCoeff, const ALfloat xCoeff, const ALfloat yCoeff, const ALsizei todo);
+template<typename InstTag>
+void ReverbFadedAllpass_(ALfloat (*RESTRICT samples)[REVERB_LINES], const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets0, const ALsizei *vapOffsets1, const ALfloat feedCoeff, const ALfloat xCoeff, const ALfloat yCoeff, ALfloat fade, const ALfloat fadeStep, const ALsizei todo);
+template<typename InstTag>
+void ReverbScatterRevDelayIn_(const DelayLineI &delay, ALsizei offset, const ALfloat xCoeff, const ALfloat yCoeff, const ALfloat (*RESTRICT in)[REVERB_LINES], const ALsizei todo);
+template<typename InstTag>
+void ReverbT60Filter_(ALfloat (*RESTRICT samples)[REVERB_LINES], T60FilterLanes *filter, const ALsizei todo);
+
+template<typename InstTag>
+void DecodeIMA4Lanes_(ALshort (*RESTRICT dst)[ADPCM_LANES], const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], IMA4LaneState *RESTRICT state, const ALsizei count);
+template<typename InstTag>
+void LoadHalfs_(ALfloat *RESTRICT dst, const ALushort *RESTRICT src, const ALint srcstep, const ALsizei samples);
+template<typename InstTag>
+void DecodeMSADPCMLanes_(ALshort (*RESTRICT dst)[ADPCM_LANES], const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], MSADPCMLaneState *RESTRICT state, const ALsizei count);
+
+/* Helpers for the channel-specialized mixers, which mix all channels together
+ * when the gains allow it.
+ */
+inline bool GainsSteadyAndAudible(const ALfloat *CurrentGains, const ALfloat *TargetGains,
+    const ALsizei count)
+{
+    for(ALsizei c{0};c < count;c++)
+    {
+        if(std::fabs(TargetGains[c] - CurrentGains[c]) > std::numeric_limits<float>::epsilon())
+            return false;
+        if(!(std::fabs(CurrentGains[c]) > GAIN_SILENCE_THRESHOLD))
+            return false;
+    }
+    return true;
+}
+
+/* Stores the indices of the channels with audible gains, and returns how many
+ * there are. Silent channels are skipped just like the generic row mixer.
+ */
+inline ALsizei GetAudibleChans(const ALfloat *Gains, const ALsizei count,
+    ALsizei *RESTRICT chans)
+{
+    ALsizei total{0};
+    for(ALsizei c{0};c < count;c++)
+    {
+        if(std::fabs(Gains[c]) > GAIN_SILENCE_THRESHOLD)
+            chans[total++] = c;
+    }
+    return total;
+}
+
 /* Vectorized resampler helpers */
 inline void InitiatePositionArrays(ALsizei frac, ALint increment, ALsizei *RESTRICT frac_arr, ALsizei *RESTRICT pos_arr, ALsizei size)
 {
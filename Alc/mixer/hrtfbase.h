@@ -14,8 +14,10 @@ inline void MixHrtfBase(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut, c
     ALsizei Offset, const ALsizei OutPos, const ALsizei IrSize, MixHrtfParams *hrtfparams,
     HrtfState *hrtfstate, const ALsizei BufferSize)
 {
+    const ALsizei irSize{hrtfparams->IrSize};
     ASSUME(OutPos >= 0);
     ASSUME(IrSize >= 4);
+    ASSUME(irSize >= 4 && irSize <= IrSize);
     ASSUME(BufferSize > 0);
 
     const auto &Coeffs = *hrtfparams->Coeffs;
@@ -54,7 +56,7 @@ inline void MixHrtfBase(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut, c
             const ALfloat g{gain + gainstep*stepcount};
             const ALfloat left{hrtfstate->History[Delay[0]++] * g};
             const ALfloat right{hrtfstate->History[Delay[1]++] * g};
-            ApplyCoeffs(Offset, hrtfstate->Values, IrSize, Coeffs, left, right);
+            ApplyCoeffs(Offset, hrtfstate->Values, irSize, Coeffs, left, right);
 
             *(LeftOut++)  += hrtfstate->Values[Offset][0];
             *(RightOut++) += hrtfstate->Values[Offset][1];
@@ -83,10 +85,12 @@ inline void MixHrtfBlendBase(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightO
     const ALfloat oldGainStep{-oldGain / (ALfloat)BufferSize};
     const auto &NewCoeffs = *newparams->Coeffs;
     const ALfloat newGainStep{newparams->GainStep};
+    const ALsizei irSize{newparams->IrSize};
     ALfloat stepcount{0.0f};
 
     ASSUME(OutPos >= 0);
     ASSUME(IrSize >= 4);
+    ASSUME(irSize >= 4 && irSize <= IrSize);
     ASSUME(BufferSize > 0);
 
     ALsizei HistOffset{Offset&HRTF_HISTORY_MASK};
@@ -122,12 +126,12 @@ inline void MixHrtfBlendBase(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightO
             ALfloat g{oldGain + oldGainStep*stepcount};
             ALfloat left{hrtfstate->History[OldDelay[0]++] * g};
             ALfloat right{hrtfstate->History[OldDelay[1]++] * g};
-            ApplyCoeffs(Offset, hrtfstate->Values, IrSize, OldCoeffs, left, right);
+            ApplyCoeffs(Offset, hrtfstate->Values, irSize, OldCoeffs, left, right);
 
             g = newGainStep*stepcount;
             left = hrtfstate->History[NewDelay[0]++] * g;
             right = hrtfstate->History[NewDelay[1]++] * g;
-            ApplyCoeffs(Offset, hrtfstate->Values, IrSize, NewCoeffs, left, right);
+            ApplyCoeffs(Offset, hrtfstate->Values, irSize, NewCoeffs, left, right);
 
             *(LeftOut++)  += hrtfstate->Values[Offset][0];
             *(RightOut++) += hrtfstate->Values[Offset][1];
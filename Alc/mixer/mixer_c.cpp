@@ -101,6 +101,113 @@ const ALfloat *Resample_<BSincTag,CTag>(const InterpState *state, const ALfloat
 { return DoResample<do_bsinc>(state, src-state->bsinc.l, frac, increment, dst, dstlen); }
 
 
+/* Filter coefficient generators for the multichannel resamplers. Each writes
+ * the filter for the given fraction to coeffs and returns its length.
+ */
+static inline ALsizei point_coeffs(const InterpState&, const ALsizei, ALfloat *RESTRICT coeffs) noexcept
+{
+    coeffs[0] = 1.0f;
+    return 1;
+}
+static inline ALsizei lerp_coeffs(const InterpState&, const ALsizei frac, ALfloat *RESTRICT coeffs) noexcept
+{
+    const ALfloat mu{frac * (1.0f/FRACTIONONE)};
+    coeffs[0] = 1.0f - mu;
+    coeffs[1] = mu;
+    return 2;
+}
+static inline ALsizei cubic_coeffs(const InterpState&, const ALsizei frac, ALfloat *RESTRICT coeffs) noexcept
+{
+    const ALfloat mu{frac * (1.0f/FRACTIONONE)};
+    const ALfloat mu2{mu*mu}, mu3{mu2*mu};
+    coeffs[0] = -0.5f*mu3 +       mu2 + -0.5f*mu;
+    coeffs[1] =  1.5f*mu3 + -2.5f*mu2            + 1.0f;
+    coeffs[2] = -1.5f*mu3 +  2.0f*mu2 +  0.5f*mu;
+    coeffs[3] =  0.5f*mu3 + -0.5f*mu2;
+    return 4;
+}
+static inline ALsizei bsinc_coeffs(const InterpState &istate, const ALsizei frac, ALfloat *RESTRICT coeffs) noexcept
+{
+    ASSUME(istate.bsinc.m > 0);
+
+    // Calculate the phase index and factor.
+#define FRAC_PHASE_BITDIFF (FRACTIONBITS-BSINC_PHASE_BITS)
+    const ALsizei pi{frac >> FRAC_PHASE_BITDIFF};
+    const ALfloat pf{(frac & ((1<<FRAC_PHASE_BITDIFF)-1)) * (1.0f/(1<<FRAC_PHASE_BITDIFF))};
+#undef FRAC_PHASE_BITDIFF
+
+    const ALfloat *fil{istate.bsinc.filter + istate.bsinc.m*pi*4};
+    const ALfloat *scd{fil + istate.bsinc.m};
+    const ALfloat *phd{scd + istate.bsinc.m};
+    const ALfloat *spd{phd + istate.bsinc.m};
+
+    // Calculate the scale and phase interpolated filter.
+    for(ALsizei j_f{0};j_f < istate.bsinc.m;j_f++)
+        coeffs[j_f] = fil[j_f] + istate.bsinc.sf*scd[j_f] + pf*(phd[j_f] + istate.bsinc.sf*spd[j_f]);
+    return istate.bsinc.m;
+}
+
+template<ALsizei Coeffs(const InterpState&, const ALsizei, ALfloat*RESTRICT) noexcept>
+static void DoResampleMulti(const InterpState *state, const ALfloat (*RESTRICT src)[BUFFERSIZE],
+                            ALsizei srcpos, const ALsizei numchans, ALsizei frac,
+                            ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE],
+                            ALsizei dstlen)
+{
+    ASSUME(numchans > 0);
+    ASSUME(dstlen > 0);
+    ASSUME(increment > 0);
+    ASSUME(frac >= 0);
+
+    const InterpState istate{*state};
+    alignas(16) ALfloat coeffs[MAX_RESAMPLE_PADDING*2];
+    for(ALsizei i{0};i < dstlen;i++)
+    {
+        /* Calculate the filter once, then apply it to each channel. */
+        const ALsizei count{Coeffs(istate, frac, coeffs)};
+        ASSUME(count > 0);
+        for(ALsizei c{0};c < numchans;c++)
+        {
+            const ALfloat *RESTRICT vals{&src[c][srcpos]};
+            ALfloat r{0.0f};
+            for(ALsizei j{0};j < count;j++)
+                r += coeffs[j] * vals[j];
+            dst[c][i] = r;
+        }
+
+        frac += increment;
+        srcpos += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+}
+
+template<>
+void ResampleMulti_<PointTag,CTag>(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{ DoResampleMulti<point_coeffs>(state, src, srcpos, numchans, frac, increment, dst, dstlen); }
+
+template<>
+void ResampleMulti_<LerpTag,CTag>(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{ DoResampleMulti<lerp_coeffs>(state, src, srcpos, numchans, frac, increment, dst, dstlen); }
+
+template<>
+void ResampleMulti_<CubicTag,CTag>(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{ DoResampleMulti<cubic_coeffs>(state, src, srcpos-1, numchans, frac, increment, dst, dstlen); }
+
+template<>
+void ResampleMulti_<BSincTag,CTag>(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{
+    DoResampleMulti<bsinc_coeffs>(state, src, srcpos-state->bsinc.l, numchans, frac, increment,
+        dst, dstlen);
+}
+
+
 static inline void ApplyCoeffs(ALsizei Offset, HrirArray<ALfloat> &Values, const ALsizei IrSize,
     const HrirArray<ALfloat> &Coeffs, const ALfloat left, const ALfloat right)
 {
@@ -215,3 +322,349 @@ void MixRow_<CTag>(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*dat
             OutBuffer[i] += src[i] * gain;
     }
 }
+
+
+/* Mixers for a fixed number of channels. With the channel count known, the
+ * channel loops are fully resolved at compile time. Steady gains are applied
+ * to four output channels at a time, so each input sample is loaded once per
+ * group, and rows are summed over several samples at once to avoid a serial
+ * dependency on the output. The generic mixers are still used while gains are
+ * fading, for left over channels, and when too few channels are audible to
+ * benefit.
+ */
+template<ALsizei OutChans>
+static void MixChans(const ALfloat *data, const ALsizei UNUSED(numchans),
+    ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains,
+    const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    if(!GainsSteadyAndAudible(CurrentGains, TargetGains, OutChans))
+        return Mix_<CTag>(data, OutChans, OutBuffer, CurrentGains, TargetGains, Counter, OutPos,
+            BufferSize);
+
+    ALsizei c{0};
+    for(;OutChans-c > 3;c += 4)
+    {
+        ALfloat *RESTRICT dst0{&OutBuffer[c  ][OutPos]};
+        ALfloat *RESTRICT dst1{&OutBuffer[c+1][OutPos]};
+        ALfloat *RESTRICT dst2{&OutBuffer[c+2][OutPos]};
+        ALfloat *RESTRICT dst3{&OutBuffer[c+3][OutPos]};
+        const ALfloat gain0{CurrentGains[c  ]}, gain1{CurrentGains[c+1]};
+        const ALfloat gain2{CurrentGains[c+2]}, gain3{CurrentGains[c+3]};
+        for(ALsizei i{0};i < BufferSize;i++)
+        {
+            const ALfloat smp{data[i]};
+            dst0[i] += smp * gain0;
+            dst1[i] += smp * gain1;
+            dst2[i] += smp * gain2;
+            dst3[i] += smp * gain3;
+        }
+    }
+    if(c < OutChans)
+        Mix_<CTag>(data, OutChans-c, OutBuffer+c, CurrentGains+c, TargetGains+c, Counter,
+            OutPos, BufferSize);
+}
+
+template<ALsizei InChans>
+static void MixRowChans(ALfloat *OutBuffer, const ALfloat *Gains,
+    const ALfloat (*data)[BUFFERSIZE], const ALsizei UNUSED(inchans), const ALsizei InPos,
+    const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    ALsizei chans[InChans];
+    const ALsizei numchans{GetAudibleChans(Gains, InChans, chans)};
+    if(numchans < InChans/2)
+        return MixRow_<CTag>(OutBuffer, Gains, data, InChans, InPos, BufferSize);
+
+    ALsizei pos{0};
+    for(;BufferSize-pos > 3;pos += 4)
+    {
+        ALfloat out0{OutBuffer[pos  ]}, out1{OutBuffer[pos+1]};
+        ALfloat out2{OutBuffer[pos+2]}, out3{OutBuffer[pos+3]};
+        for(ALsizei i{0};i < numchans;i++)
+        {
+            const ALsizei c{chans[i]};
+            const ALfloat *RESTRICT src{&data[c][InPos+pos]};
+            out0 += src[0] * Gains[c];
+            out1 += src[1] * Gains[c];
+            out2 += src[2] * Gains[c];
+            out3 += src[3] * Gains[c];
+        }
+        OutBuffer[pos  ] = out0; OutBuffer[pos+1] = out1;
+        OutBuffer[pos+2] = out2; OutBuffer[pos+3] = out3;
+    }
+    for(;pos < BufferSize;pos++)
+    {
+        ALfloat out{OutBuffer[pos]};
+        for(ALsizei i{0};i < numchans;i++)
+            out += data[chans[i]][InPos+pos] * Gains[chans[i]];
+        OutBuffer[pos] = out;
+    }
+}
+
+template<>
+MixerFunc SelectChanMixer_<CTag>(const ALsizei OutChans)
+{
+    switch(OutChans)
+    {
+        case 4: return MixChans<4>;
+        case 6: return MixChans<6>;
+        case 8: return MixChans<8>;
+        case 9: return MixChans<9>;
+        case 16: return MixChans<16>;
+    }
+    return Mix_<CTag>;
+}
+
+template<>
+RowMixerFunc SelectChanRowMixer_<CTag>(const ALsizei InChans)
+{
+    switch(InChans)
+    {
+        case 2: return MixRowChans<2>;
+        case 4: return MixRowChans<4>;
+        case 9: return MixRowChans<9>;
+        case 16: return MixRowChans<16>;
+    }
+    return MixRow_<CTag>;
+}
+
+template<>
+void PolyphaseUpsample_<CTag>(const ALfloat (*RESTRICT coeffs)[POLYPHASE_FACTOR],
+    const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei srclen)
+{
+    ASSUME(srclen > 0);
+
+    for(ALsizei i{0};i < srclen;i++)
+    {
+        ALfloat r[POLYPHASE_FACTOR]{};
+        for(ALsizei j{0};j < POLYPHASE_TAPS;j++)
+        {
+            const ALfloat smp{src[i-j]};
+            for(ALsizei p{0};p < POLYPHASE_FACTOR;p++)
+                r[p] += coeffs[j][p] * smp;
+        }
+        std::copy(std::begin(r), std::end(r), dst);
+        dst += POLYPHASE_FACTOR;
+    }
+}
+
+template<>
+void PolyphaseDownsample_<CTag>(const ALfloat *RESTRICT coeffs, const ALfloat *RESTRICT src,
+    ALfloat *RESTRICT dst, const ALsizei dstlen)
+{
+    ASSUME(dstlen > 0);
+
+    for(ALsizei i{0};i < dstlen;i++)
+    {
+        ALfloat r{0.0f};
+        for(ALsizei j{0};j < POLYPHASE_LENGTH;j++)
+            r += coeffs[j] * src[j];
+        dst[i] = r;
+        src += POLYPHASE_FACTOR;
+    }
+}
+
+
+/* Applies the reverb's 4-line scattering matrix. */
+static inline void VectorPartialScatter(ALfloat *RESTRICT out, const ALfloat *RESTRICT in,
+    const ALfloat xCoeff, const ALfloat yCoeff) noexcept
+{
+    out[0] = xCoeff*in[0] + yCoeff*(          in[1] + -in[2] + in[3]);
+    out[1] = xCoeff*in[1] + yCoeff*(-in[0]          +  in[2] + in[3]);
+    out[2] = xCoeff*in[2] + yCoeff*( in[0] + -in[1]          + in[3]);
+    out[3] = xCoeff*in[3] + yCoeff*(-in[0] + -in[1] + -in[2]        );
+}
+
+template<>
+void ReverbDelayMix_<CTag>(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay,
+    const ALsizei *offsets, const ALfloat *gains, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    for(ALsizei j{0};j < REVERB_LINES;j++)
+    {
+        ALsizei offset{offsets[j]};
+        const ALfloat gain{gains[j]};
+        for(ALsizei i{0};i < todo;i++)
+            dst[i][j] += delay.Line[(offset++)&delay.Mask][j] * gain;
+    }
+}
+
+template<>
+void ReverbFadedDelayMix_<CTag>(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay,
+    const ALsizei *offsets0, const ALsizei *offsets1, const ALfloat *gains0,
+    const ALfloat *gains1, ALfloat fade, const ALfloat fadeStep, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    for(ALsizei j{0};j < REVERB_LINES;j++)
+    {
+        ALsizei offset0{offsets0[j]}, offset1{offsets1[j]};
+        const ALfloat gain0{gains0[j]}, gain1{gains1[j]};
+        ALfloat f{fade};
+        for(ALsizei i{0};i < todo;i++)
+        {
+            dst[i][j] += delay.Line[(offset0++)&delay.Mask][j]*(gain0 - gain0*f) +
+                         delay.Line[(offset1++)&delay.Mask][j]*(gain1*f);
+            f += fadeStep;
+        }
+    }
+}
+
+template<>
+void ReverbAllpass_<CTag>(ALfloat (*RESTRICT samples)[REVERB_LINES], const DelayLineI &delay,
+    ALsizei offset, const ALsizei *vapOffsets, const ALfloat feedCoeff, const ALfloat xCoeff,
+    const ALfloat yCoeff, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    ALsizei vap_offset[REVERB_LINES];
+    std::copy_n(vapOffsets, REVERB_LINES, std::begin(vap_offset));
+    for(ALsizei i{0};i < todo;i++)
+    {
+        ALfloat f[REVERB_LINES];
+        for(ALsizei j{0};j < REVERB_LINES;j++)
+        {
+            const ALfloat input{samples[i][j]};
+            const ALfloat out{delay.Line[(vap_offset[j]++)&delay.Mask][j] - feedCoeff*input};
+            f[j] = input + feedCoeff*out;
+            samples[i][j] = out;
+        }
+        VectorPartialScatter(delay.Line[(offset++)&delay.Mask], f, xCoeff, yCoeff);
+    }
+}
+
+template<>
+void ReverbFadedAllpass_<CTag>(ALfloat (*RESTRICT samples)[REVERB_LINES],
+    const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets0,
+    const ALsizei *vapOffsets1, const ALfloat feedCoeff, const ALfloat xCoeff,
+    const ALfloat yCoeff, ALfloat fade, const ALfloat fadeStep, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    ALsizei vap_offset0[REVERB_LINES], vap_offset1[REVERB_LINES];
+    std::copy_n(vapOffsets0, REVERB_LINES, std::begin(vap_offset0));
+    std::copy_n(vapOffsets1, REVERB_LINES, std::begin(vap_offset1));
+    for(ALsizei i{0};i < todo;i++)
+    {
+        ALfloat f[REVERB_LINES];
+        for(ALsizei j{0};j < REVERB_LINES;j++)
+        {
+            const ALfloat input{samples[i][j]};
+            const ALfloat out{delay.Line[(vap_offset0[j]++)&delay.Mask][j]*(1.0f-fade) +
+                delay.Line[(vap_offset1[j]++)&delay.Mask][j]*fade - feedCoeff*input};
+            f[j] = input + feedCoeff*out;
+            samples[i][j] = out;
+        }
+        fade += fadeStep;
+        VectorPartialScatter(delay.Line[(offset++)&delay.Mask], f, xCoeff, yCoeff);
+    }
+}
+
+template<>
+void ReverbScatterRevDelayIn_<CTag>(const DelayLineI &delay, ALsizei offset,
+    const ALfloat xCoeff, const ALfloat yCoeff, const ALfloat (*RESTRICT in)[REVERB_LINES],
+    const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    for(ALsizei i{0};i < todo;i++)
+    {
+        ALfloat f[REVERB_LINES];
+        std::reverse_copy(std::begin(in[i]), std::end(in[i]), std::begin(f));
+        VectorPartialScatter(delay.Line[(offset++)&delay.Mask], f, xCoeff, yCoeff);
+    }
+}
+
+template<>
+void ReverbT60Filter_<CTag>(ALfloat (*RESTRICT samples)[REVERB_LINES], T60FilterLanes *filter,
+    const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    auto process_lanes = [samples,todo](BiquadLanes &bq) -> void
+    {
+        for(ALsizei j{0};j < REVERB_LINES;j++)
+        {
+            const ALfloat b0{bq.b0[j]}, b1{bq.b1[j]}, b2{bq.b2[j]};
+            const ALfloat a1{bq.a1[j]}, a2{bq.a2[j]};
+            ALfloat z1{bq.z1[j]}, z2{bq.z2[j]};
+            for(ALsizei i{0};i < todo;i++)
+            {
+                const ALfloat input{samples[i][j]};
+                const ALfloat out{input*b0 + z1};
+                z1 = input*b1 - out*a1 + z2;
+                z2 = input*b2 - out*a2;
+                samples[i][j] = out;
+            }
+            bq.z1[j] = z1;
+            bq.z2[j] = z2;
+        }
+    };
+    process_lanes(filter->HFFilter);
+    process_lanes(filter->LFFilter);
+}
+
+
+template<>
+void DecodeIMA4Lanes_<CTag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], IMA4LaneState *RESTRICT state,
+    const ALsizei count)
+{
+    ASSUME(count > 0);
+
+    for(ALsizei i{0};i < count;i++)
+    {
+        for(ALsizei l{0};l < ADPCM_LANES;l++)
+        {
+            const ALint nibble{nibbles[i][l]};
+            const ALint sample{state->Sample[l] +
+                IMA4Codeword[nibble]*IMAStep_size[state->Index[l]]/8};
+            state->Sample[l] = clampi(sample, -32768, 32767);
+            state->Index[l] = clampi(state->Index[l] + IMA4Index_adjust[nibble], 0, 88);
+            dst[i][l] = static_cast<ALshort>(state->Sample[l]);
+        }
+    }
+}
+
+template<>
+void DecodeMSADPCMLanes_<CTag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], MSADPCMLaneState *RESTRICT state,
+    const ALsizei count)
+{
+    ASSUME(count > 0);
+
+    for(ALsizei i{0};i < count;i++)
+    {
+        for(ALsizei l{0};l < ADPCM_LANES;l++)
+        {
+            const ALint nibble{nibbles[i][l]};
+            ALint pred{(state->Samples[0][l]*state->Coeff[0][l] +
+                state->Samples[1][l]*state->Coeff[1][l]) / 256};
+            pred += ((nibble^0x08) - 0x08) * state->Delta[l];
+            pred  = clampi(pred, -32768, 32767);
+
+            state->Samples[1][l] = state->Samples[0][l];
+            state->Samples[0][l] = pred;
+
+            state->Delta[l] = maxi(16, MSADPCMAdaption[nibble]*state->Delta[l] / 256);
+
+            dst[i][l] = static_cast<ALshort>(pred);
+        }
+    }
+}
+
+
+template<>
+void LoadHalfs_<CTag>(ALfloat *RESTRICT dst, const ALushort *RESTRICT src, const ALint srcstep,
+    const ALsizei samples)
+{
+    ASSUME(srcstep > 0);
+    ASSUME(samples > 0);
+
+    for(ALsizei i{0};i < samples;i++)
+        dst[i] += HalfToFloat(src[i*srcstep]);
+}
@@ -308,3 +308,330 @@ void MixRow_<NEONTag>(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*
             OutBuffer[pos] += src[pos]*gain;
     }
 }
+
+
+/* Mixers for a fixed number of channels. Steady gains are applied to four
+ * output channels at a time, so each group of input samples is loaded once per
+ * channel group, and rows are summed over sixteen samples at once using
+ * separate accumulators. The generic mixers handle gain fading, left over
+ * channels, and mostly-silent inputs.
+ */
+template<ALsizei OutChans>
+static void MixChans(const ALfloat *data, const ALsizei UNUSED(numchans),
+    ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains,
+    const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    if(!GainsSteadyAndAudible(CurrentGains, TargetGains, OutChans))
+        return Mix_<NEONTag>(data, OutChans, OutBuffer, CurrentGains, TargetGains, Counter, OutPos,
+            BufferSize);
+
+    ALsizei c{0};
+    for(;OutChans-c > 3;c += 4)
+    {
+        ALfloat *RESTRICT dst0{al::assume_aligned<16>(&OutBuffer[c  ][OutPos])};
+        ALfloat *RESTRICT dst1{al::assume_aligned<16>(&OutBuffer[c+1][OutPos])};
+        ALfloat *RESTRICT dst2{al::assume_aligned<16>(&OutBuffer[c+2][OutPos])};
+        ALfloat *RESTRICT dst3{al::assume_aligned<16>(&OutBuffer[c+3][OutPos])};
+        ALsizei pos{0};
+        if(LIKELY(BufferSize > 3))
+        {
+            const float32x4_t gain0{vdupq_n_f32(CurrentGains[c  ])};
+            const float32x4_t gain1{vdupq_n_f32(CurrentGains[c+1])};
+            const float32x4_t gain2{vdupq_n_f32(CurrentGains[c+2])};
+            const float32x4_t gain3{vdupq_n_f32(CurrentGains[c+3])};
+            ALsizei todo{BufferSize >> 2};
+            do {
+                const float32x4_t val4{vld1q_f32(&data[pos])};
+                /* Load all outputs before storing any, since the channels are
+                 * a multiple of 4KB apart and a store would stall the
+                 * following loads.
+                 */
+                const float32x4_t dry0{vld1q_f32(&dst0[pos])};
+                const float32x4_t dry1{vld1q_f32(&dst1[pos])};
+                const float32x4_t dry2{vld1q_f32(&dst2[pos])};
+                const float32x4_t dry3{vld1q_f32(&dst3[pos])};
+                vst1q_f32(&dst0[pos], vmlaq_f32(dry0, val4, gain0));
+                vst1q_f32(&dst1[pos], vmlaq_f32(dry1, val4, gain1));
+                vst1q_f32(&dst2[pos], vmlaq_f32(dry2, val4, gain2));
+                vst1q_f32(&dst3[pos], vmlaq_f32(dry3, val4, gain3));
+                pos += 4;
+            } while(--todo);
+        }
+        for(;pos < BufferSize;pos++)
+        {
+            const ALfloat smp{data[pos]};
+            dst0[pos] += smp * CurrentGains[c  ];
+            dst1[pos] += smp * CurrentGains[c+1];
+            dst2[pos] += smp * CurrentGains[c+2];
+            dst3[pos] += smp * CurrentGains[c+3];
+        }
+    }
+    if(c < OutChans)
+        Mix_<NEONTag>(data, OutChans-c, OutBuffer+c, CurrentGains+c, TargetGains+c, Counter,
+            OutPos, BufferSize);
+}
+
+template<ALsizei InChans>
+static void MixRowChans(ALfloat *OutBuffer, const ALfloat *Gains,
+    const ALfloat (*data)[BUFFERSIZE], const ALsizei UNUSED(inchans), const ALsizei InPos,
+    const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    ALsizei chans[InChans];
+    const ALsizei numchans{GetAudibleChans(Gains, InChans, chans)};
+    if(numchans < InChans/2)
+        return MixRow_<NEONTag>(OutBuffer, Gains, data, InChans, InPos, BufferSize);
+
+    float32x4_t gains4[InChans];
+    for(ALsizei i{0};i < numchans;i++)
+        gains4[i] = vdupq_n_f32(Gains[chans[i]]);
+
+    ALsizei pos{0};
+    for(;BufferSize-pos > 15;pos += 16)
+    {
+        float32x4_t dry0{vld1q_f32(&OutBuffer[pos   ])};
+        float32x4_t dry1{vld1q_f32(&OutBuffer[pos+ 4])};
+        float32x4_t dry2{vld1q_f32(&OutBuffer[pos+ 8])};
+        float32x4_t dry3{vld1q_f32(&OutBuffer[pos+12])};
+        for(ALsizei i{0};i < numchans;i++)
+        {
+            const ALfloat *RESTRICT src{al::assume_aligned<16>(&data[chans[i]][InPos+pos])};
+            dry0 = vmlaq_f32(dry0, vld1q_f32(&src[ 0]), gains4[i]);
+            dry1 = vmlaq_f32(dry1, vld1q_f32(&src[ 4]), gains4[i]);
+            dry2 = vmlaq_f32(dry2, vld1q_f32(&src[ 8]), gains4[i]);
+            dry3 = vmlaq_f32(dry3, vld1q_f32(&src[12]), gains4[i]);
+        }
+        vst1q_f32(&OutBuffer[pos   ], dry0);
+        vst1q_f32(&OutBuffer[pos+ 4], dry1);
+        vst1q_f32(&OutBuffer[pos+ 8], dry2);
+        vst1q_f32(&OutBuffer[pos+12], dry3);
+    }
+    for(;pos < BufferSize;pos++)
+    {
+        ALfloat out{OutBuffer[pos]};
+        for(ALsizei i{0};i < numchans;i++)
+            out += data[chans[i]][InPos+pos] * Gains[chans[i]];
+        OutBuffer[pos] = out;
+    }
+}
+
+template<>
+MixerFunc SelectChanMixer_<NEONTag>(const ALsizei OutChans)
+{
+    switch(OutChans)
+    {
+        case 4: return MixChans<4>;
+        case 6: return MixChans<6>;
+        case 8: return MixChans<8>;
+        case 9: return MixChans<9>;
+        case 16: return MixChans<16>;
+    }
+    return Mix_<NEONTag>;
+}
+
+template<>
+RowMixerFunc SelectChanRowMixer_<NEONTag>(const ALsizei InChans)
+{
+    switch(InChans)
+    {
+        case 2: return MixRowChans<2>;
+        case 4: return MixRowChans<4>;
+        case 9: return MixRowChans<9>;
+        case 16: return MixRowChans<16>;
+    }
+    return MixRow_<NEONTag>;
+}
+
+template<>
+void PolyphaseUpsample_<NEONTag>(const ALfloat (*RESTRICT coeffs)[POLYPHASE_FACTOR],
+    const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei srclen)
+{
+    static_assert(POLYPHASE_FACTOR == 4, "Neon upsampler requires 4 phases");
+    ASSUME(srclen > 0);
+
+    for(ALsizei i{0};i < srclen;i++)
+    {
+        float32x4_t r4{vdupq_n_f32(0.0f)};
+        for(ALsizei j{0};j < POLYPHASE_TAPS;j++)
+            r4 = vmlaq_f32(r4, vld1q_f32(coeffs[j]), vdupq_n_f32(src[i-j]));
+        vst1q_f32(&dst[i*4], r4);
+    }
+}
+
+template<>
+void PolyphaseDownsample_<NEONTag>(const ALfloat *RESTRICT coeffs, const ALfloat *RESTRICT src,
+    ALfloat *RESTRICT dst, const ALsizei dstlen)
+{
+    ASSUME(dstlen > 0);
+
+    for(ALsizei i{0};i < dstlen;i++)
+    {
+        float32x4_t r4{vdupq_n_f32(0.0f)};
+        for(ALsizei j{0};j < POLYPHASE_LENGTH;j+=4)
+            r4 = vmlaq_f32(r4, vld1q_f32(&coeffs[j]), vld1q_f32(&src[j]));
+        r4 = vaddq_f32(r4, vcombine_f32(vrev64_f32(vget_high_f32(r4)),
+                                        vrev64_f32(vget_low_f32(r4))));
+        dst[i] = vget_lane_f32(vadd_f32(vget_low_f32(r4), vget_high_f32(r4)), 0);
+
+        src += POLYPHASE_FACTOR;
+    }
+}
+
+
+namespace {
+
+/* Signed division by 1<<shift, rounding toward zero like integer division. */
+template<int shift>
+inline int32x4_t div_pow2(const int32x4_t x) noexcept
+{
+    const int32x4_t bias{vandq_s32(vshrq_n_s32(x, 31), vdupq_n_s32((1<<shift) - 1))};
+    return vshrq_n_s32(vaddq_s32(x, bias), shift);
+}
+
+inline int32x4_t load_nibbles(const ALubyte *nibble) noexcept
+{
+    alignas(16) const ALint vals[4]{nibble[0], nibble[1], nibble[2], nibble[3]};
+    return vld1q_s32(vals);
+}
+
+} // namespace
+
+template<>
+void DecodeIMA4Lanes_<NEONTag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], IMA4LaneState *RESTRICT state,
+    const ALsizei count)
+{
+    static_assert(ADPCM_LANES == 4, "Unexpected ADPCM lane count");
+    const int32x4_t one4{vdupq_n_s32(1)};
+    const int32x4_t four4{vdupq_n_s32(4)};
+    const int32x4_t six4{vdupq_n_s32(6)};
+    const int32x4_t seven4{vdupq_n_s32(7)};
+    const int32x4_t minusone4{vdupq_n_s32(-1)};
+    const int32x4_t maxidx4{vdupq_n_s32(88)};
+    const int32x4_t zero4{vdupq_n_s32(0)};
+
+    ASSUME(count > 0);
+
+    int32x4_t sample4{vld1q_s32(state->Sample)};
+    int32x4_t index4{vld1q_s32(state->Index)};
+    alignas(16) ALint index[4];
+    for(ALsizei i{0};i < count;i++)
+    {
+        const int32x4_t nibble4{load_nibbles(nibbles[i])};
+        vst1q_s32(index, index4);
+        alignas(16) const ALint step[4]{IMAStep_size[index[0]], IMAStep_size[index[1]],
+            IMAStep_size[index[2]], IMAStep_size[index[3]]};
+
+        /* The codeword's magnitude is mag*2 + 1, with the sign taken from the
+         * nibble's top bit.
+         */
+        const int32x4_t mag4{vandq_s32(nibble4, seven4)};
+        const int32x4_t sign4{vnegq_s32(vshrq_n_s32(nibble4, 3))};
+        int32x4_t diff4{vmulq_s32(vaddq_s32(vaddq_s32(mag4, mag4), one4), vld1q_s32(step))};
+        diff4 = vshrq_n_s32(diff4, 3);
+        diff4 = vsubq_s32(veorq_s32(diff4, sign4), sign4);
+
+        const int16x4_t packed{vqmovn_s32(vaddq_s32(sample4, diff4))};
+        sample4 = vmovl_s16(packed);
+        vst1_s16(dst[i], packed);
+
+        /* The index goes down by 1 for magnitudes under 4, else up by
+         * (mag-3)*2.
+         */
+        const int32x4_t adjust4{vbslq_s32(vcltq_s32(mag4, four4), minusone4,
+            vsubq_s32(vaddq_s32(mag4, mag4), six4))};
+        index4 = vminq_s32(vmaxq_s32(vaddq_s32(index4, adjust4), zero4), maxidx4);
+    }
+    vst1q_s32(state->Sample, sample4);
+    vst1q_s32(state->Index, index4);
+}
+
+template<>
+void DecodeMSADPCMLanes_<NEONTag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], MSADPCMLaneState *RESTRICT state,
+    const ALsizei count)
+{
+    static_assert(ADPCM_LANES == 4, "Unexpected ADPCM lane count");
+    const int32x4_t eight4{vdupq_n_s32(8)};
+    const int32x4_t sixteen4{vdupq_n_s32(16)};
+
+    ASSUME(count > 0);
+
+    const int32x4_t coeff0_4{vld1q_s32(state->Coeff[0])};
+    const int32x4_t coeff1_4{vld1q_s32(state->Coeff[1])};
+    int32x4_t sample4{vld1q_s32(state->Samples[0])};
+    int32x4_t prev4{vld1q_s32(state->Samples[1])};
+    int32x4_t delta4{vld1q_s32(state->Delta)};
+    for(ALsizei i{0};i < count;i++)
+    {
+        const ALubyte *nibble{nibbles[i]};
+        const int32x4_t nibble4{load_nibbles(nibble)};
+
+        int32x4_t pred4{vmlaq_s32(vmulq_s32(sample4, coeff0_4), prev4, coeff1_4)};
+        pred4 = div_pow2<8>(pred4);
+        const int32x4_t snibble4{vsubq_s32(veorq_s32(nibble4, eight4), eight4)};
+        pred4 = vmlaq_s32(pred4, snibble4, delta4);
+
+        const int16x4_t packed{vqmovn_s32(pred4)};
+        prev4 = sample4;
+        sample4 = vmovl_s16(packed);
+        vst1_s16(dst[i], packed);
+
+        alignas(16) const ALint adapt[4]{MSADPCMAdaption[nibble[0]],
+            MSADPCMAdaption[nibble[1]], MSADPCMAdaption[nibble[2]], MSADPCMAdaption[nibble[3]]};
+        delta4 = div_pow2<8>(vmulq_s32(vld1q_s32(adapt), delta4));
+        delta4 = vmaxq_s32(delta4, sixteen4);
+    }
+    vst1q_s32(state->Samples[0], sample4);
+    vst1q_s32(state->Samples[1], prev4);
+    vst1q_s32(state->Delta, delta4);
+}
+
+
+template<>
+void LoadHalfs_<NEONTag>(ALfloat *RESTRICT dst, const ALushort *RESTRICT src,
+    const ALint srcstep, const ALsizei samples)
+{
+    const uint32x4_t absmask4{vdupq_n_u32(0x7fff)};
+    const uint32x4_t signmask4{vdupq_n_u32(0x8000)};
+    const uint32x4_t shifted_exp4{vdupq_n_u32(0x7c00<<13)};
+    const uint32x4_t rebias4{vdupq_n_u32((127-15)<<23)};
+    const uint32x4_t infbias4{vdupq_n_u32((128-16)<<23)};
+    const uint32x4_t expone4{vdupq_n_u32(1<<23)};
+    const float32x4_t magic4{vreinterpretq_f32_u32(vdupq_n_u32(113<<23))};
+
+    ASSUME(srcstep > 0);
+    ASSUME(samples > 0);
+
+    /* Same as HalfToFloat, with the special cases handled by masking. */
+    const ALsizei todo{samples & ~3};
+    for(ALsizei i{0};i < todo;i += 4)
+    {
+        alignas(16) const ALuint h[4]{src[0], src[srcstep], src[srcstep*2], src[srcstep*3]};
+        const uint32x4_t h4{vld1q_u32(h)};
+        src += srcstep*4;
+
+        uint32x4_t o4{vshlq_n_u32(vandq_u32(h4, absmask4), 13)};
+        const uint32x4_t exp4{vandq_u32(o4, shifted_exp4)};
+        o4 = vaddq_u32(o4, rebias4);
+        /* Inf/NaN */
+        o4 = vaddq_u32(o4, vandq_u32(vceqq_u32(exp4, shifted_exp4), infbias4));
+        /* Zero/Denormal */
+        const uint32x4_t isdenorm4{vceqq_u32(exp4, vdupq_n_u32(0))};
+        const float32x4_t denorm4{vsubq_f32(vreinterpretq_f32_u32(vaddq_u32(o4, expone4)),
+            magic4)};
+        o4 = vbslq_u32(isdenorm4, vreinterpretq_u32_f32(denorm4), o4);
+        /* Sign */
+        o4 = vorrq_u32(o4, vshlq_n_u32(vandq_u32(h4, signmask4), 16));
+
+        vst1q_f32(&dst[i], vaddq_f32(vld1q_f32(&dst[i]), vreinterpretq_f32_u32(o4)));
+    }
+    for(ALsizei i{todo};i < samples;i++)
+    {
+        dst[i] += HalfToFloat(*src);
+        src += srcstep;
+    }
+}
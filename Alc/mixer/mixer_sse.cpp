@@ -75,6 +75,73 @@ const ALfloat *Resample_<BSincTag,SSETag>(const InterpState *state, const ALfloa
     return dst;
 }
 
+template<>
+void ResampleMulti_<BSincTag,SSETag>(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{
+    const ALfloat *const filter{state->bsinc.filter};
+    const __m128 sf4{_mm_set1_ps(state->bsinc.sf)};
+    const ALsizei m{state->bsinc.m};
+
+    ASSUME(m > 0);
+    ASSUME(numchans > 0);
+    ASSUME(dstlen > 0);
+    ASSUME(increment > 0);
+    ASSUME(frac >= 0);
+
+    /* Space for the largest interpolated filter. */
+    __m128 f4[MAX_RESAMPLE_PADDING*2 / 4];
+
+    srcpos -= state->bsinc.l;
+    for(ALsizei i{0};i < dstlen;i++)
+    {
+        // Calculate the phase index and factor.
+#define FRAC_PHASE_BITDIFF (FRACTIONBITS-BSINC_PHASE_BITS)
+        const ALsizei pi{frac >> FRAC_PHASE_BITDIFF};
+        const ALfloat pf{(frac & ((1<<FRAC_PHASE_BITDIFF)-1)) * (1.0f/(1<<FRAC_PHASE_BITDIFF))};
+#undef FRAC_PHASE_BITDIFF
+
+        ALsizei offset{m*pi*4};
+        const __m128 *fil{reinterpret_cast<const __m128*>(filter + offset)}; offset += m;
+        const __m128 *scd{reinterpret_cast<const __m128*>(filter + offset)}; offset += m;
+        const __m128 *phd{reinterpret_cast<const __m128*>(filter + offset)}; offset += m;
+        const __m128 *spd{reinterpret_cast<const __m128*>(filter + offset)};
+
+        const ALsizei count{m >> 2};
+        ASSUME(count > 0);
+
+#define MLA4(x, y, z) _mm_add_ps(x, _mm_mul_ps(y, z))
+        // Calculate the scale and phase interpolated filter once.
+        const __m128 pf4{_mm_set1_ps(pf)};
+        for(ALsizei j{0};j < count;j++)
+        {
+            /* f = ((fil + sf*scd) + pf*(phd + sf*spd)) */
+            f4[j] = MLA4(
+                MLA4(fil[j], sf4, scd[j]),
+                pf4, MLA4(phd[j], sf4, spd[j])
+            );
+        }
+
+        // Then apply it to each channel.
+        for(ALsizei c{0};c < numchans;c++)
+        {
+            const ALfloat *RESTRICT in{&src[c][srcpos]};
+            __m128 r4{_mm_setzero_ps()};
+            for(ALsizei j{0};j < count;j++)
+                r4 = MLA4(r4, f4[j], _mm_loadu_ps(&in[j*4]));
+            r4 = _mm_add_ps(r4, _mm_shuffle_ps(r4, r4, _MM_SHUFFLE(0, 1, 2, 3)));
+            r4 = _mm_add_ps(r4, _mm_movehl_ps(r4, r4));
+            dst[c][i] = _mm_cvtss_f32(r4);
+        }
+#undef MLA4
+
+        frac += increment;
+        srcpos += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+}
+
 
 static inline void ApplyCoeffs(ALsizei Offset, HrirArray<ALfloat> &Values, const ALsizei IrSize,
     const HrirArray<ALfloat> &Coeffs, const ALfloat left, const ALfloat right)
@@ -283,3 +350,342 @@ void MixRow_<SSETag>(ALfloat *OutBuffer, const ALfloat *Gains, const ALfloat (*d
             OutBuffer[pos] += src[pos]*gain;
     }
 }
+
+
+/* Mixers for a fixed number of channels. Steady gains are applied to four
+ * output channels at a time, so each group of input samples is loaded once per
+ * channel group, and rows are summed over sixteen samples at once using
+ * separate accumulators. The generic mixers handle gain fading, left over
+ * channels, and mostly-silent inputs.
+ */
+template<ALsizei OutChans>
+static void MixChans(const ALfloat *data, const ALsizei UNUSED(numchans),
+    ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains,
+    const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    if(!GainsSteadyAndAudible(CurrentGains, TargetGains, OutChans))
+        return Mix_<SSETag>(data, OutChans, OutBuffer, CurrentGains, TargetGains, Counter, OutPos,
+            BufferSize);
+
+    ALsizei c{0};
+    for(;OutChans-c > 3;c += 4)
+    {
+        ALfloat *RESTRICT dst0{al::assume_aligned<16>(&OutBuffer[c  ][OutPos])};
+        ALfloat *RESTRICT dst1{al::assume_aligned<16>(&OutBuffer[c+1][OutPos])};
+        ALfloat *RESTRICT dst2{al::assume_aligned<16>(&OutBuffer[c+2][OutPos])};
+        ALfloat *RESTRICT dst3{al::assume_aligned<16>(&OutBuffer[c+3][OutPos])};
+        ALsizei pos{0};
+        if(LIKELY(BufferSize > 3))
+        {
+            const __m128 gain0{_mm_set1_ps(CurrentGains[c  ])};
+            const __m128 gain1{_mm_set1_ps(CurrentGains[c+1])};
+            const __m128 gain2{_mm_set1_ps(CurrentGains[c+2])};
+            const __m128 gain3{_mm_set1_ps(CurrentGains[c+3])};
+            ALsizei todo{BufferSize >> 2};
+            do {
+                const __m128 val4{_mm_load_ps(&data[pos])};
+                /* Load all outputs before storing any, since the channels are
+                 * a multiple of 4KB apart and a store would stall the
+                 * following loads.
+                 */
+                const __m128 dry0{_mm_load_ps(&dst0[pos])};
+                const __m128 dry1{_mm_load_ps(&dst1[pos])};
+                const __m128 dry2{_mm_load_ps(&dst2[pos])};
+                const __m128 dry3{_mm_load_ps(&dst3[pos])};
+                _mm_store_ps(&dst0[pos], _mm_add_ps(dry0, _mm_mul_ps(val4, gain0)));
+                _mm_store_ps(&dst1[pos], _mm_add_ps(dry1, _mm_mul_ps(val4, gain1)));
+                _mm_store_ps(&dst2[pos], _mm_add_ps(dry2, _mm_mul_ps(val4, gain2)));
+                _mm_store_ps(&dst3[pos], _mm_add_ps(dry3, _mm_mul_ps(val4, gain3)));
+                pos += 4;
+            } while(--todo);
+        }
+        for(;pos < BufferSize;pos++)
+        {
+            const ALfloat smp{data[pos]};
+            dst0[pos] += smp * CurrentGains[c  ];
+            dst1[pos] += smp * CurrentGains[c+1];
+            dst2[pos] += smp * CurrentGains[c+2];
+            dst3[pos] += smp * CurrentGains[c+3];
+        }
+    }
+    if(c < OutChans)
+        Mix_<SSETag>(data, OutChans-c, OutBuffer+c, CurrentGains+c, TargetGains+c, Counter,
+            OutPos, BufferSize);
+}
+
+template<ALsizei InChans>
+static void MixRowChans(ALfloat *OutBuffer, const ALfloat *Gains,
+    const ALfloat (*data)[BUFFERSIZE], const ALsizei UNUSED(inchans), const ALsizei InPos,
+    const ALsizei BufferSize)
+{
+    ASSUME(BufferSize > 0);
+
+    ALsizei chans[InChans];
+    const ALsizei numchans{GetAudibleChans(Gains, InChans, chans)};
+    if(numchans < InChans/2)
+        return MixRow_<SSETag>(OutBuffer, Gains, data, InChans, InPos, BufferSize);
+
+    __m128 gains4[InChans];
+    for(ALsizei i{0};i < numchans;i++)
+        gains4[i] = _mm_set1_ps(Gains[chans[i]]);
+
+    ALsizei pos{0};
+    for(;BufferSize-pos > 15;pos += 16)
+    {
+        __m128 dry0{_mm_load_ps(&OutBuffer[pos   ])};
+        __m128 dry1{_mm_load_ps(&OutBuffer[pos+ 4])};
+        __m128 dry2{_mm_load_ps(&OutBuffer[pos+ 8])};
+        __m128 dry3{_mm_load_ps(&OutBuffer[pos+12])};
+        for(ALsizei i{0};i < numchans;i++)
+        {
+            const ALfloat *RESTRICT src{al::assume_aligned<16>(&data[chans[i]][InPos+pos])};
+            dry0 = _mm_add_ps(dry0, _mm_mul_ps(_mm_load_ps(&src[ 0]), gains4[i]));
+            dry1 = _mm_add_ps(dry1, _mm_mul_ps(_mm_load_ps(&src[ 4]), gains4[i]));
+            dry2 = _mm_add_ps(dry2, _mm_mul_ps(_mm_load_ps(&src[ 8]), gains4[i]));
+            dry3 = _mm_add_ps(dry3, _mm_mul_ps(_mm_load_ps(&src[12]), gains4[i]));
+        }
+        _mm_store_ps(&OutBuffer[pos   ], dry0);
+        _mm_store_ps(&OutBuffer[pos+ 4], dry1);
+        _mm_store_ps(&OutBuffer[pos+ 8], dry2);
+        _mm_store_ps(&OutBuffer[pos+12], dry3);
+    }
+    for(;pos < BufferSize;pos++)
+    {
+        ALfloat out{OutBuffer[pos]};
+        for(ALsizei i{0};i < numchans;i++)
+            out += data[chans[i]][InPos+pos] * Gains[chans[i]];
+        OutBuffer[pos] = out;
+    }
+}
+
+template<>
+MixerFunc SelectChanMixer_<SSETag>(const ALsizei OutChans)
+{
+    switch(OutChans)
+    {
+        case 4: return MixChans<4>;
+        case 6: return MixChans<6>;
+        case 8: return MixChans<8>;
+        case 9: return MixChans<9>;
+        case 16: return MixChans<16>;
+    }
+    return Mix_<SSETag>;
+}
+
+template<>
+RowMixerFunc SelectChanRowMixer_<SSETag>(const ALsizei InChans)
+{
+    switch(InChans)
+    {
+        case 2: return MixRowChans<2>;
+        case 4: return MixRowChans<4>;
+        case 9: return MixRowChans<9>;
+        case 16: return MixRowChans<16>;
+    }
+    return MixRow_<SSETag>;
+}
+
+template<>
+void PolyphaseUpsample_<SSETag>(const ALfloat (*RESTRICT coeffs)[POLYPHASE_FACTOR],
+    const ALfloat *RESTRICT src, ALfloat *RESTRICT dst, const ALsizei srclen)
+{
+    static_assert(POLYPHASE_FACTOR == 4, "SSE upsampler requires 4 phases");
+    ASSUME(srclen > 0);
+
+    /* Each tap holds the coefficients for all four phases, so one input sample
+     * contributes to four output samples with a single multiply-add.
+     */
+    for(ALsizei i{0};i < srclen;i++)
+    {
+        __m128 r4{_mm_setzero_ps()};
+        for(ALsizei j{0};j < POLYPHASE_TAPS;j++)
+        {
+            const __m128 coeffs4{_mm_load_ps(coeffs[j])};
+            r4 = _mm_add_ps(r4, _mm_mul_ps(coeffs4, _mm_set1_ps(src[i-j])));
+        }
+        _mm_storeu_ps(&dst[i*4], r4);
+    }
+}
+
+template<>
+void PolyphaseDownsample_<SSETag>(const ALfloat *RESTRICT coeffs, const ALfloat *RESTRICT src,
+    ALfloat *RESTRICT dst, const ALsizei dstlen)
+{
+    ASSUME(dstlen > 0);
+
+    const __m128 *coeffs4{reinterpret_cast<const __m128*>(coeffs)};
+    for(ALsizei i{0};i < dstlen;i++)
+    {
+        __m128 r4{_mm_setzero_ps()};
+        for(ALsizei j{0};j < POLYPHASE_LENGTH/4;j++)
+            r4 = _mm_add_ps(r4, _mm_mul_ps(coeffs4[j], _mm_loadu_ps(&src[j*4])));
+        r4 = _mm_add_ps(r4, _mm_shuffle_ps(r4, r4, _MM_SHUFFLE(0, 1, 2, 3)));
+        r4 = _mm_add_ps(r4, _mm_movehl_ps(r4, r4));
+        dst[i] = _mm_cvtss_f32(r4);
+
+        src += POLYPHASE_FACTOR;
+    }
+}
+
+
+namespace {
+
+/* Applies the reverb's 4-line scattering matrix. Each row mixes the other
+ * three lines, which are gathered by swapping lanes in pairs, in halves, and
+ * end-to-end, with the matching signs folded into the y coefficients.
+ */
+struct ScatterCoeffs {
+    __m128 x, y1, y2, y3;
+
+    ScatterCoeffs(const ALfloat xCoeff, const ALfloat yCoeff) noexcept
+      : x{_mm_set1_ps(xCoeff)}, y1{_mm_setr_ps(yCoeff, -yCoeff, yCoeff, -yCoeff)},
+        y2{_mm_setr_ps(-yCoeff, yCoeff, yCoeff, -yCoeff)},
+        y3{_mm_setr_ps(yCoeff, yCoeff, -yCoeff, -yCoeff)}
+    { }
+
+    __m128 apply(const __m128 f) const noexcept
+    {
+        __m128 r{_mm_mul_ps(x, f)};
+        r = _mm_add_ps(r, _mm_mul_ps(y1, _mm_shuffle_ps(f, f, _MM_SHUFFLE(2, 3, 0, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(y2, _mm_shuffle_ps(f, f, _MM_SHUFFLE(1, 0, 3, 2))));
+        r = _mm_add_ps(r, _mm_mul_ps(y3, _mm_shuffle_ps(f, f, _MM_SHUFFLE(0, 1, 2, 3))));
+        return r;
+    }
+};
+
+/* Reads one sample from each line, with each line at its own offset. */
+inline __m128 GatherLines(const DelayLineI &delay, const ALsizei *offsets, const ALsizei i)
+{
+    return _mm_setr_ps(delay.Line[(offsets[0]+i)&delay.Mask][0],
+        delay.Line[(offsets[1]+i)&delay.Mask][1], delay.Line[(offsets[2]+i)&delay.Mask][2],
+        delay.Line[(offsets[3]+i)&delay.Mask][3]);
+}
+
+} // namespace
+
+template<>
+void ReverbDelayMix_<SSETag>(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay,
+    const ALsizei *offsets, const ALfloat *gains, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    const __m128 gain4{_mm_loadu_ps(gains)};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        const __m128 dly4{GatherLines(delay, offsets, i)};
+        _mm_store_ps(dst[i], _mm_add_ps(_mm_load_ps(dst[i]), _mm_mul_ps(dly4, gain4)));
+    }
+}
+
+template<>
+void ReverbFadedDelayMix_<SSETag>(ALfloat (*RESTRICT dst)[REVERB_LINES], const DelayLineI &delay,
+    const ALsizei *offsets0, const ALsizei *offsets1, const ALfloat *gains0,
+    const ALfloat *gains1, ALfloat fade, const ALfloat fadeStep, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    const __m128 gain0{_mm_loadu_ps(gains0)};
+    const __m128 gain1{_mm_loadu_ps(gains1)};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        const __m128 fade4{_mm_set1_ps(fade)};
+        const __m128 g0{_mm_sub_ps(gain0, _mm_mul_ps(gain0, fade4))};
+        const __m128 g1{_mm_mul_ps(gain1, fade4)};
+        const __m128 dly4{_mm_add_ps(_mm_mul_ps(GatherLines(delay, offsets0, i), g0),
+            _mm_mul_ps(GatherLines(delay, offsets1, i), g1))};
+        _mm_store_ps(dst[i], _mm_add_ps(_mm_load_ps(dst[i]), dly4));
+        fade += fadeStep;
+    }
+}
+
+template<>
+void ReverbAllpass_<SSETag>(ALfloat (*RESTRICT samples)[REVERB_LINES], const DelayLineI &delay,
+    ALsizei offset, const ALsizei *vapOffsets, const ALfloat feedCoeff, const ALfloat xCoeff,
+    const ALfloat yCoeff, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    const ScatterCoeffs scatter{xCoeff, yCoeff};
+    const __m128 feed4{_mm_set1_ps(feedCoeff)};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        const __m128 input{_mm_load_ps(samples[i])};
+        const __m128 out{_mm_sub_ps(GatherLines(delay, vapOffsets, i), _mm_mul_ps(feed4, input))};
+        const __m128 f{_mm_add_ps(input, _mm_mul_ps(feed4, out))};
+        _mm_store_ps(samples[i], out);
+        _mm_store_ps(delay.Line[(offset++)&delay.Mask], scatter.apply(f));
+    }
+}
+
+template<>
+void ReverbFadedAllpass_<SSETag>(ALfloat (*RESTRICT samples)[REVERB_LINES],
+    const DelayLineI &delay, ALsizei offset, const ALsizei *vapOffsets0,
+    const ALsizei *vapOffsets1, const ALfloat feedCoeff, const ALfloat xCoeff,
+    const ALfloat yCoeff, ALfloat fade, const ALfloat fadeStep, const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    const ScatterCoeffs scatter{xCoeff, yCoeff};
+    const __m128 feed4{_mm_set1_ps(feedCoeff)};
+    const __m128 one4{_mm_set1_ps(1.0f)};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        const __m128 fade4{_mm_set1_ps(fade)};
+        const __m128 input{_mm_load_ps(samples[i])};
+        __m128 dly4{_mm_mul_ps(GatherLines(delay, vapOffsets0, i), _mm_sub_ps(one4, fade4))};
+        dly4 = _mm_add_ps(dly4, _mm_mul_ps(GatherLines(delay, vapOffsets1, i), fade4));
+        const __m128 out{_mm_sub_ps(dly4, _mm_mul_ps(feed4, input))};
+        const __m128 f{_mm_add_ps(input, _mm_mul_ps(feed4, out))};
+        _mm_store_ps(samples[i], out);
+        fade += fadeStep;
+        _mm_store_ps(delay.Line[(offset++)&delay.Mask], scatter.apply(f));
+    }
+}
+
+template<>
+void ReverbScatterRevDelayIn_<SSETag>(const DelayLineI &delay, ALsizei offset,
+    const ALfloat xCoeff, const ALfloat yCoeff, const ALfloat (*RESTRICT in)[REVERB_LINES],
+    const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    const ScatterCoeffs scatter{xCoeff, yCoeff};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        __m128 f{_mm_load_ps(in[i])};
+        f = _mm_shuffle_ps(f, f, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_store_ps(delay.Line[(offset++)&delay.Mask], scatter.apply(f));
+    }
+}
+
+template<>
+void ReverbT60Filter_<SSETag>(ALfloat (*RESTRICT samples)[REVERB_LINES], T60FilterLanes *filter,
+    const ALsizei todo)
+{
+    ASSUME(todo > 0);
+
+    BiquadLanes &hf = filter->HFFilter;
+    BiquadLanes &lf = filter->LFFilter;
+    const __m128 hb0{_mm_load_ps(hf.b0)}, hb1{_mm_load_ps(hf.b1)}, hb2{_mm_load_ps(hf.b2)};
+    const __m128 ha1{_mm_load_ps(hf.a1)}, ha2{_mm_load_ps(hf.a2)};
+    const __m128 lb0{_mm_load_ps(lf.b0)}, lb1{_mm_load_ps(lf.b1)}, lb2{_mm_load_ps(lf.b2)};
+    const __m128 la1{_mm_load_ps(lf.a1)}, la2{_mm_load_ps(lf.a2)};
+    __m128 hz1{_mm_load_ps(hf.z1)}, hz2{_mm_load_ps(hf.z2)};
+    __m128 lz1{_mm_load_ps(lf.z1)}, lz2{_mm_load_ps(lf.z2)};
+    for(ALsizei i{0};i < todo;i++)
+    {
+        const __m128 input{_mm_load_ps(samples[i])};
+        const __m128 mid{_mm_add_ps(_mm_mul_ps(input, hb0), hz1)};
+        hz1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(input, hb1), _mm_mul_ps(mid, ha1)), hz2);
+        hz2 = _mm_sub_ps(_mm_mul_ps(input, hb2), _mm_mul_ps(mid, ha2));
+
+        const __m128 out{_mm_add_ps(_mm_mul_ps(mid, lb0), lz1)};
+        lz1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(mid, lb1), _mm_mul_ps(out, la1)), lz2);
+        lz2 = _mm_sub_ps(_mm_mul_ps(mid, lb2), _mm_mul_ps(out, la2));
+        _mm_store_ps(samples[i], out);
+    }
+    _mm_store_ps(hf.z1, hz1); _mm_store_ps(hf.z2, hz2);
+    _mm_store_ps(lf.z1, lz1); _mm_store_ps(lf.z2, lz2);
+}
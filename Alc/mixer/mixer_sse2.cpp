@@ -83,3 +83,240 @@ const ALfloat *Resample_<LerpTag,SSE2Tag>(const InterpState* UNUSED(state),
     }
     return dst;
 }
+
+template<>
+void ResampleMulti_<LerpTag,SSE2Tag>(const InterpState* UNUSED(state),
+  const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+  ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen)
+{
+    const __m128i increment4{_mm_set1_epi32(increment*4)};
+    const __m128 fracOne4{_mm_set1_ps(1.0f/FRACTIONONE)};
+    const __m128i fracMask4{_mm_set1_epi32(FRACTIONMASK)};
+
+    ASSUME(frac >= 0);
+    ASSUME(increment > 0);
+    ASSUME(numchans > 0);
+    ASSUME(dstlen >= 0);
+
+    alignas(16) ALsizei pos_[4], frac_[4];
+    InitiatePositionArrays(frac, increment, frac_, pos_, 4);
+    __m128i frac4{_mm_setr_epi32(frac_[0], frac_[1], frac_[2], frac_[3])};
+    __m128i pos4{_mm_setr_epi32(pos_[0], pos_[1], pos_[2], pos_[3])};
+
+    const ALsizei todo{dstlen & ~3};
+    for(ALsizei i{0};i < todo;i += 4)
+    {
+        const int pos0{srcpos + _mm_cvtsi128_si32(_mm_shuffle_epi32(pos4, _MM_SHUFFLE(0, 0, 0, 0)))};
+        const int pos1{srcpos + _mm_cvtsi128_si32(_mm_shuffle_epi32(pos4, _MM_SHUFFLE(1, 1, 1, 1)))};
+        const int pos2{srcpos + _mm_cvtsi128_si32(_mm_shuffle_epi32(pos4, _MM_SHUFFLE(2, 2, 2, 2)))};
+        const int pos3{srcpos + _mm_cvtsi128_si32(_mm_shuffle_epi32(pos4, _MM_SHUFFLE(3, 3, 3, 3)))};
+        const __m128 mu{_mm_mul_ps(_mm_cvtepi32_ps(frac4), fracOne4)};
+
+        /* The positions and fractions are shared by all channels. */
+        for(ALsizei c{0};c < numchans;c++)
+        {
+            const ALfloat *RESTRICT in{src[c]};
+            const __m128 val1{_mm_setr_ps(in[pos0  ], in[pos1  ], in[pos2  ], in[pos3  ])};
+            const __m128 val2{_mm_setr_ps(in[pos0+1], in[pos1+1], in[pos2+1], in[pos3+1])};
+
+            /* val1 + (val2-val1)*mu */
+            const __m128 r0{_mm_sub_ps(val2, val1)};
+            _mm_store_ps(&dst[c][i], _mm_add_ps(val1, _mm_mul_ps(mu, r0)));
+        }
+
+        frac4 = _mm_add_epi32(frac4, increment4);
+        pos4 = _mm_add_epi32(pos4, _mm_srli_epi32(frac4, FRACTIONBITS));
+        frac4 = _mm_and_si128(frac4, fracMask4);
+    }
+
+    ALsizei pos{srcpos + _mm_cvtsi128_si32(pos4)};
+    frac = _mm_cvtsi128_si32(frac4);
+
+    for(ALsizei i{todo};i < dstlen;++i)
+    {
+        const ALfloat mu{frac * (1.0f/FRACTIONONE)};
+        for(ALsizei c{0};c < numchans;c++)
+            dst[c][i] = lerp(src[c][pos], src[c][pos+1], mu);
+
+        frac += increment;
+        pos  += frac>>FRACTIONBITS;
+        frac &= FRACTIONMASK;
+    }
+}
+
+
+namespace {
+
+/* SSE2 has no 32-bit multiply that keeps the low half of each product, so
+ * multiply the even and odd elements separately and recombine them.
+ */
+inline __m128i mullo_epi32(const __m128i a, const __m128i b) noexcept
+{
+    const __m128i even{_mm_mul_epu32(a, b)};
+    const __m128i odd{_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32))};
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+        _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* Signed division by 1<<shift, rounding toward zero like integer division. */
+template<int shift>
+inline __m128i div_pow2(const __m128i x) noexcept
+{
+    const __m128i bias{_mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32((1<<shift) - 1))};
+    return _mm_srai_epi32(_mm_add_epi32(x, bias), shift);
+}
+
+/* Clamps to the 16-bit sample range, storing the packed result in packed. */
+inline __m128i clamp_sample(const __m128i x, __m128i &packed) noexcept
+{
+    packed = _mm_packs_epi32(x, x);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+}
+
+} // namespace
+
+template<>
+void DecodeIMA4Lanes_<SSE2Tag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], IMA4LaneState *RESTRICT state,
+    const ALsizei count)
+{
+    static_assert(ADPCM_LANES == 4, "Unexpected ADPCM lane count");
+    const __m128i one4{_mm_set1_epi32(1)};
+    const __m128i four4{_mm_set1_epi32(4)};
+    const __m128i six4{_mm_set1_epi32(6)};
+    const __m128i seven4{_mm_set1_epi32(7)};
+    const __m128i maxidx4{_mm_set1_epi32(88)};
+    const __m128i zero4{_mm_setzero_si128()};
+
+    ASSUME(count > 0);
+
+    __m128i sample4{_mm_load_si128(reinterpret_cast<const __m128i*>(state->Sample))};
+    __m128i index4{_mm_load_si128(reinterpret_cast<const __m128i*>(state->Index))};
+    alignas(16) ALint index[4];
+    for(ALsizei i{0};i < count;i++)
+    {
+        const ALubyte *nibble{nibbles[i]};
+        const __m128i nibble4{_mm_setr_epi32(nibble[0], nibble[1], nibble[2], nibble[3])};
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), index4);
+        const __m128i step4{_mm_setr_epi32(IMAStep_size[index[0]], IMAStep_size[index[1]],
+            IMAStep_size[index[2]], IMAStep_size[index[3]])};
+
+        /* The codeword's magnitude is mag*2 + 1, with the sign taken from the
+         * nibble's top bit. The step size and codeword both fit in the low 16
+         * bits, so a multiply-add gives the full product.
+         */
+        const __m128i mag4{_mm_and_si128(nibble4, seven4)};
+        const __m128i sign4{_mm_sub_epi32(zero4, _mm_srli_epi32(nibble4, 3))};
+        __m128i diff4{_mm_madd_epi16(_mm_add_epi32(_mm_add_epi32(mag4, mag4), one4), step4)};
+        diff4 = _mm_srai_epi32(diff4, 3);
+        diff4 = _mm_sub_epi32(_mm_xor_si128(diff4, sign4), sign4);
+
+        __m128i packed;
+        sample4 = clamp_sample(_mm_add_epi32(sample4, diff4), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst[i]), packed);
+
+        /* The index goes down by 1 for magnitudes under 4, else up by
+         * (mag-3)*2. The index stays small enough to clamp as 16-bit values.
+         */
+        const __m128i small4{_mm_cmplt_epi32(mag4, four4)};
+        const __m128i adjust4{_mm_or_si128(small4,
+            _mm_andnot_si128(small4, _mm_sub_epi32(_mm_add_epi32(mag4, mag4), six4)))};
+        index4 = _mm_add_epi32(index4, adjust4);
+        index4 = _mm_min_epi16(_mm_max_epi16(index4, zero4), maxidx4);
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(state->Sample), sample4);
+    _mm_store_si128(reinterpret_cast<__m128i*>(state->Index), index4);
+}
+
+template<>
+void DecodeMSADPCMLanes_<SSE2Tag>(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], MSADPCMLaneState *RESTRICT state,
+    const ALsizei count)
+{
+    static_assert(ADPCM_LANES == 4, "Unexpected ADPCM lane count");
+    const __m128i eight4{_mm_set1_epi32(8)};
+    const __m128i sixteen4{_mm_set1_epi32(16)};
+    const __m128i lomask4{_mm_set1_epi32(0xffff)};
+
+    ASSUME(count > 0);
+
+    /* The coefficients and last two samples are all 16-bit, so they can be
+     * paired up in each element for a multiply-add.
+     */
+    const __m128i coeffs4{_mm_or_si128(
+        _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(state->Coeff[0])), lomask4),
+        _mm_slli_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(state->Coeff[1])), 16))};
+    __m128i sample4{_mm_load_si128(reinterpret_cast<const __m128i*>(state->Samples[0]))};
+    __m128i prev4{_mm_load_si128(reinterpret_cast<const __m128i*>(state->Samples[1]))};
+    __m128i delta4{_mm_load_si128(reinterpret_cast<const __m128i*>(state->Delta))};
+    for(ALsizei i{0};i < count;i++)
+    {
+        const ALubyte *nibble{nibbles[i]};
+        const __m128i nibble4{_mm_setr_epi32(nibble[0], nibble[1], nibble[2], nibble[3])};
+
+        const __m128i pairs4{_mm_or_si128(_mm_and_si128(sample4, lomask4),
+            _mm_slli_epi32(prev4, 16))};
+        __m128i pred4{div_pow2<8>(_mm_madd_epi16(pairs4, coeffs4))};
+        const __m128i snibble4{_mm_sub_epi32(_mm_xor_si128(nibble4, eight4), eight4)};
+        pred4 = _mm_add_epi32(pred4, mullo_epi32(snibble4, delta4));
+
+        __m128i packed;
+        prev4 = sample4;
+        sample4 = clamp_sample(pred4, packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst[i]), packed);
+
+        const __m128i adapt4{_mm_setr_epi32(MSADPCMAdaption[nibble[0]],
+            MSADPCMAdaption[nibble[1]], MSADPCMAdaption[nibble[2]], MSADPCMAdaption[nibble[3]])};
+        delta4 = div_pow2<8>(mullo_epi32(adapt4, delta4));
+        const __m128i big4{_mm_cmpgt_epi32(delta4, sixteen4)};
+        delta4 = _mm_or_si128(_mm_and_si128(big4, delta4), _mm_andnot_si128(big4, sixteen4));
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(state->Samples[0]), sample4);
+    _mm_store_si128(reinterpret_cast<__m128i*>(state->Samples[1]), prev4);
+    _mm_store_si128(reinterpret_cast<__m128i*>(state->Delta), delta4);
+}
+
+
+template<>
+void LoadHalfs_<SSE2Tag>(ALfloat *RESTRICT dst, const ALushort *RESTRICT src,
+    const ALint srcstep, const ALsizei samples)
+{
+    const __m128i absmask4{_mm_set1_epi32(0x7fff)};
+    const __m128i signmask4{_mm_set1_epi32(0x8000)};
+    const __m128i shifted_exp4{_mm_set1_epi32(0x7c00<<13)};
+    const __m128i rebias4{_mm_set1_epi32((127-15)<<23)};
+    const __m128i infbias4{_mm_set1_epi32((128-16)<<23)};
+    const __m128i expone4{_mm_set1_epi32(1<<23)};
+    const __m128 magic4{_mm_castsi128_ps(_mm_set1_epi32(113<<23))};
+
+    ASSUME(srcstep > 0);
+    ASSUME(samples > 0);
+
+    /* Same as HalfToFloat, with the special cases handled by masking. */
+    const ALsizei todo{samples & ~3};
+    for(ALsizei i{0};i < todo;i += 4)
+    {
+        const __m128i h4{_mm_setr_epi32(src[0], src[srcstep], src[srcstep*2], src[srcstep*3])};
+        src += srcstep*4;
+
+        __m128i o4{_mm_slli_epi32(_mm_and_si128(h4, absmask4), 13)};
+        const __m128i exp4{_mm_and_si128(o4, shifted_exp4)};
+        o4 = _mm_add_epi32(o4, rebias4);
+        /* Inf/NaN */
+        o4 = _mm_add_epi32(o4, _mm_and_si128(_mm_cmpeq_epi32(exp4, shifted_exp4), infbias4));
+        /* Zero/Denormal */
+        const __m128 isdenorm4{_mm_castsi128_ps(_mm_cmpeq_epi32(exp4, _mm_setzero_si128()))};
+        const __m128 denorm4{_mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o4, expone4)), magic4)};
+        __m128 f4{_mm_or_ps(_mm_and_ps(isdenorm4, denorm4),
+            _mm_andnot_ps(isdenorm4, _mm_castsi128_ps(o4)))};
+        /* Sign */
+        f4 = _mm_or_ps(f4, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h4, signmask4), 16)));
+
+        _mm_storeu_ps(&dst[i], _mm_add_ps(_mm_loadu_ps(&dst[i]), f4));
+    }
+    for(ALsizei i{todo};i < samples;i++)
+    {
+        dst[i] += HalfToFloat(*src);
+        src += srcstep;
+    }
+}
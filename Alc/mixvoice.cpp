@@ -38,6 +38,7 @@
 #include "alBuffer.h"
 #include "alListener.h"
 #include "alAuxEffectSlot.h"
+#include "alSubmixBus.h"
 #include "sample_cvt.h"
 #include "alu.h"
 #include "alconfig.h"
@@ -49,42 +50,63 @@
 
 static_assert((INT_MAX>>FRACTIONBITS)/MAX_PITCH > BUFFERSIZE,
               "MAX_PITCH and/or BUFFERSIZE are too large for FRACTIONBITS!");
+/* Each pass needs room for at least one source sample past the padding,
+ * which at MAX_PITCH mixes at least one output sample, or the mixer can't make
+ * progress.
+ */
+static_assert(BUFFERSIZE - MAX_RESAMPLE_PADDING*2 >= 1,
+              "BUFFERSIZE is too small for MAX_RESAMPLE_PADDING!");
 
-/* BSinc24 requires up to 23 extra samples before the current position, and 24 after. */
-static_assert(MAX_RESAMPLE_PADDING >= 24, "MAX_RESAMPLE_PADDING must be at least 24!");
+/* BSinc48 requires up to 47 extra samples before the current position, and 48
+ * after.
+ */
+static_assert(MAX_RESAMPLE_PADDING >= 48, "MAX_RESAMPLE_PADDING must be at least 48!");
 
 
-Resampler ResamplerDefault = LinearResampler;
+std::atomic<Resampler> ResamplerDefault{LinearResampler};
 
-MixerFunc MixSamples = Mix_<CTag>;
-RowMixerFunc MixRowSamples = MixRow_<CTag>;
+/* Start with the generic C mixers, so the tables are usable before
+ * aluInitMixer selects the specialized ones.
+ */
+static_assert(MAX_OUTPUT_CHANNELS == 16, "Mixer tables need updating");
+MixerFunc ChanMixers[MAX_OUTPUT_CHANNELS+1]{
+    Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>,
+    Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>,
+    Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>, Mix_<CTag>
+};
+RowMixerFunc ChanRowMixers[MAX_OUTPUT_CHANNELS+1]{
+    MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>,
+    MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>,
+    MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>, MixRow_<CTag>,
+    MixRow_<CTag>, MixRow_<CTag>
+};
 static HrtfMixerFunc MixHrtfSamples = MixHrtf_<CTag>;
 static HrtfMixerBlendFunc MixHrtfBlendSamples = MixHrtfBlend_<CTag>;
 
-static MixerFunc SelectMixer()
+static MixerFunc SelectMixer(const ALsizei OutChans)
 {
 #ifdef HAVE_NEON
     if((CPUCapFlags&CPU_CAP_NEON))
-        return Mix_<NEONTag>;
+        return SelectChanMixer_<NEONTag>(OutChans);
 #endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
-        return Mix_<SSETag>;
+        return SelectChanMixer_<SSETag>(OutChans);
 #endif
-    return Mix_<CTag>;
+    return SelectChanMixer_<CTag>(OutChans);
 }
 
-static RowMixerFunc SelectRowMixer()
+static RowMixerFunc SelectRowMixer(const ALsizei InChans)
 {
 #ifdef HAVE_NEON
     if((CPUCapFlags&CPU_CAP_NEON))
-        return MixRow_<NEONTag>;
+        return SelectChanRowMixer_<NEONTag>(InChans);
 #endif
 #ifdef HAVE_SSE
     if((CPUCapFlags&CPU_CAP_SSE))
-        return MixRow_<SSETag>;
+        return SelectChanRowMixer_<SSETag>(InChans);
 #endif
-    return MixRow_<CTag>;
+    return SelectChanRowMixer_<CTag>(InChans);
 }
 
 static inline HrtfMixerFunc SelectHrtfMixer()
@@ -113,6 +135,125 @@ static inline HrtfMixerBlendFunc SelectHrtfBlendMixer()
     return MixHrtfBlend_<CTag>;
 }
 
+static inline PolyphaseUpsampleFunc SelectPolyphaseUpsampler()
+{
+#ifdef HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return PolyphaseUpsample_<NEONTag>;
+#endif
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return PolyphaseUpsample_<SSETag>;
+#endif
+    return PolyphaseUpsample_<CTag>;
+}
+
+static inline PolyphaseDownsampleFunc SelectPolyphaseDownsampler()
+{
+#ifdef HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return PolyphaseDownsample_<NEONTag>;
+#endif
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return PolyphaseDownsample_<SSETag>;
+#endif
+    return PolyphaseDownsample_<CTag>;
+}
+
+static inline ReverbDelayMixFunc SelectReverbDelayMix()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbDelayMix_<SSETag>;
+#endif
+    return ReverbDelayMix_<CTag>;
+}
+
+static inline ReverbFadedDelayMixFunc SelectReverbFadedDelayMix()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbFadedDelayMix_<SSETag>;
+#endif
+    return ReverbFadedDelayMix_<CTag>;
+}
+
+static inline ReverbAllpassFunc SelectReverbAllpass()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbAllpass_<SSETag>;
+#endif
+    return ReverbAllpass_<CTag>;
+}
+
+static inline ReverbFadedAllpassFunc SelectReverbFadedAllpass()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbFadedAllpass_<SSETag>;
+#endif
+    return ReverbFadedAllpass_<CTag>;
+}
+
+static inline ReverbScatterRevDelayInFunc SelectReverbScatterRevDelayIn()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbScatterRevDelayIn_<SSETag>;
+#endif
+    return ReverbScatterRevDelayIn_<CTag>;
+}
+
+static inline ReverbT60FilterFunc SelectReverbT60Filter()
+{
+#ifdef HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return ReverbT60Filter_<SSETag>;
+#endif
+    return ReverbT60Filter_<CTag>;
+}
+
+static inline IMA4DecodeLanesFunc SelectIMA4Decoder()
+{
+#ifdef HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return DecodeIMA4Lanes_<NEONTag>;
+#endif
+#ifdef HAVE_SSE2
+    if((CPUCapFlags&CPU_CAP_SSE2))
+        return DecodeIMA4Lanes_<SSE2Tag>;
+#endif
+    return DecodeIMA4Lanes_<CTag>;
+}
+
+static inline HalfLoadFunc SelectHalfLoader()
+{
+#ifdef HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return LoadHalfs_<NEONTag>;
+#endif
+#ifdef HAVE_SSE2
+    if((CPUCapFlags&CPU_CAP_SSE2))
+        return LoadHalfs_<SSE2Tag>;
+#endif
+    return LoadHalfs_<CTag>;
+}
+
+static inline MSADPCMDecodeLanesFunc SelectMSADPCMDecoder()
+{
+#ifdef HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return DecodeMSADPCMLanes_<NEONTag>;
+#endif
+#ifdef HAVE_SSE2
+    if((CPUCapFlags&CPU_CAP_SSE2))
+        return DecodeMSADPCMLanes_<SSE2Tag>;
+#endif
+    return DecodeMSADPCMLanes_<CTag>;
+}
+
 ResamplerFunc SelectResampler(Resampler resampler)
 {
     switch(resampler)
@@ -135,8 +276,10 @@ ResamplerFunc SelectResampler(Resampler resampler)
             return Resample_<LerpTag,CTag>;
         case FIR4Resampler:
             return Resample_<CubicTag,CTag>;
+        case BSinc8Resampler:
         case BSinc12Resampler:
         case BSinc24Resampler:
+        case BSinc48Resampler:
 #ifdef HAVE_NEON
             if((CPUCapFlags&CPU_CAP_NEON))
                 return Resample_<BSincTag,NEONTag>;
@@ -151,48 +294,100 @@ ResamplerFunc SelectResampler(Resampler resampler)
     return Resample_<PointTag,CTag>;
 }
 
+ResamplerMultiFunc SelectResamplerMulti(Resampler resampler)
+{
+    switch(resampler)
+    {
+        case PointResampler:
+            return ResampleMulti_<PointTag,CTag>;
+        case LinearResampler:
+#ifdef HAVE_SSE2
+            if((CPUCapFlags&CPU_CAP_SSE2))
+                return ResampleMulti_<LerpTag,SSE2Tag>;
+#endif
+            return ResampleMulti_<LerpTag,CTag>;
+        case FIR4Resampler:
+            return ResampleMulti_<CubicTag,CTag>;
+        case BSinc8Resampler:
+        case BSinc12Resampler:
+        case BSinc24Resampler:
+        case BSinc48Resampler:
+#ifdef HAVE_SSE
+            if((CPUCapFlags&CPU_CAP_SSE))
+                return ResampleMulti_<BSincTag,SSETag>;
+#endif
+            return ResampleMulti_<BSincTag,CTag>;
+    }
 
-void aluInitMixer()
+    return ResampleMulti_<PointTag,CTag>;
+}
+
+
+void aluInitResampler()
 {
+    Resampler resampler{LinearResampler};
     const char *str;
-
     if(ConfigValueStr(nullptr, nullptr, "resampler", &str))
     {
         if(strcasecmp(str, "point") == 0 || strcasecmp(str, "none") == 0)
-            ResamplerDefault = PointResampler;
+            resampler = PointResampler;
         else if(strcasecmp(str, "linear") == 0)
-            ResamplerDefault = LinearResampler;
+            resampler = LinearResampler;
         else if(strcasecmp(str, "cubic") == 0)
-            ResamplerDefault = FIR4Resampler;
+            resampler = FIR4Resampler;
+        else if(strcasecmp(str, "bsinc8") == 0)
+            resampler = BSinc8Resampler;
         else if(strcasecmp(str, "bsinc12") == 0)
-            ResamplerDefault = BSinc12Resampler;
+            resampler = BSinc12Resampler;
         else if(strcasecmp(str, "bsinc24") == 0)
-            ResamplerDefault = BSinc24Resampler;
+            resampler = BSinc24Resampler;
+        else if(strcasecmp(str, "bsinc48") == 0)
+            resampler = BSinc48Resampler;
         else if(strcasecmp(str, "bsinc") == 0)
         {
             WARN("Resampler option \"%s\" is deprecated, using bsinc12\n", str);
-            ResamplerDefault = BSinc12Resampler;
+            resampler = BSinc12Resampler;
         }
         else if(strcasecmp(str, "sinc4") == 0 || strcasecmp(str, "sinc8") == 0)
         {
             WARN("Resampler option \"%s\" is deprecated, using cubic\n", str);
-            ResamplerDefault = FIR4Resampler;
+            resampler = FIR4Resampler;
         }
         else
         {
             char *end;
             long n = strtol(str, &end, 0);
             if(*end == '\0' && (n == PointResampler || n == LinearResampler || n == FIR4Resampler))
-                ResamplerDefault = static_cast<Resampler>(n);
+                resampler = static_cast<Resampler>(n);
             else
                 WARN("Invalid resampler: %s\n", str);
         }
     }
+    ResamplerDefault = resampler;
+}
+
+void aluInitMixer()
+{
+    aluInitResampler();
 
     MixHrtfBlendSamples = SelectHrtfBlendMixer();
     MixHrtfSamples = SelectHrtfMixer();
-    MixSamples = SelectMixer();
-    MixRowSamples = SelectRowMixer();
+    for(ALsizei i{0};i <= MAX_OUTPUT_CHANNELS;i++)
+    {
+        ChanMixers[i] = SelectMixer(i);
+        ChanRowMixers[i] = SelectRowMixer(i);
+    }
+    PolyphaseUpsampleSamples = SelectPolyphaseUpsampler();
+    PolyphaseDownsampleSamples = SelectPolyphaseDownsampler();
+    ReverbDelayMix = SelectReverbDelayMix();
+    ReverbFadedDelayMix = SelectReverbFadedDelayMix();
+    ReverbAllpass = SelectReverbAllpass();
+    ReverbFadedAllpass = SelectReverbFadedAllpass();
+    ReverbScatterRevDelayIn = SelectReverbScatterRevDelayIn();
+    ReverbT60Filter = SelectReverbT60Filter();
+    DecodeIMA4Lanes = SelectIMA4Decoder();
+    DecodeMSADPCMLanes = SelectMSADPCMDecoder();
+    LoadHalfSamples = SelectHalfLoader();
 }
 
 
@@ -216,6 +411,13 @@ template<> inline ALfloat LoadSample<FmtMulaw>(FmtTypeTraits<FmtMulaw>::Type val
 { return muLawDecompressionTable[val] * (1.0f/32768.0f); }
 template<> inline ALfloat LoadSample<FmtAlaw>(FmtTypeTraits<FmtAlaw>::Type val)
 { return aLawDecompressionTable[val] * (1.0f/32768.0f); }
+template<> inline ALfloat LoadSample<FmtPacked24>(FmtTypeTraits<FmtPacked24>::Type val)
+{
+    /* Place the sample in the top 24 bits to sign-extend it. */
+    const auto ival = static_cast<ALint>(static_cast<ALuint>(val.b[0])<<8 |
+        static_cast<ALuint>(val.b[1])<<16 | static_cast<ALuint>(val.b[2])<<24);
+    return ival * (1.0f/2147483648.0f);
+}
 
 template<FmtType T>
 inline void LoadSampleArray(ALfloat *RESTRICT dst, const void *src, ALint srcstep, ALsizei samples)
@@ -240,10 +442,69 @@ void LoadSamples(ALfloat *RESTRICT dst, const ALvoid *RESTRICT src, ALint srcste
         HANDLE_FMT(FmtDouble);
         HANDLE_FMT(FmtMulaw);
         HANDLE_FMT(FmtAlaw);
+        HANDLE_FMT(FmtPacked24);
+    case FmtHalf:
+        LoadHalfSamples(dst, static_cast<const ALushort*>(src), srcstep, samples);
+        break;
     }
 #undef HANDLE_FMT
 }
 
+void SendResidencyMissEvent(ALCcontext *context, ALuint id, const ALbuffer *buffer, ALsizei pos)
+{
+    ALbitfieldSOFT enabledevt{context->EnabledEvts.load(std::memory_order_acquire)};
+    if(!(enabledevt&EventType_Performance)) return;
+
+    RingBuffer *ring{context->AsyncEvents.get()};
+    auto evt_vec = ring->getWriteVector();
+    if(evt_vec.first.len < 1) return;
+
+    AsyncEvent *evt{new (evt_vec.first.buf) AsyncEvent{EventType_Performance}};
+    evt->u.user.type = AL_EVENT_TYPE_PERFORMANCE_SOFT;
+    evt->u.user.id = id;
+    evt->u.user.param = buffer->id;
+    snprintf(evt->u.user.msg, sizeof(evt->u.user.msg),
+        "Buffer %u sample data not resident at offset %d", buffer->id, pos);
+
+    ring->writeAdvance(1);
+    context->EventSem.post();
+}
+
+/* Loads samples for the given channel of the buffer, starting at the given
+ * sample frame. File-backed buffers are read a page at a time, with pages that
+ * aren't resident being left silent.
+ */
+void LoadBufferSamples(ALfloat *RESTRICT dst, const ALbuffer *buffer, ALsizei pos, ALsizei chan,
+    ALsizei NumChannels, ALsizei SampleSize, ALsizei samples, ALCcontext *context, ALuint SourceID)
+{
+    BufferResidency *residency{buffer->mResidency.get()};
+    if(LIKELY(!residency))
+    {
+        const ALbyte *Data{buffer->mData.data()};
+        LoadSamples(dst, &Data[(pos*NumChannels + chan)*SampleSize], NumChannels,
+            buffer->mFmtType, samples);
+        return;
+    }
+
+    while(samples > 0)
+    {
+        const ALsizei page{pos / BufferResidency::PageFrames};
+        const ALsizei pagepos{pos % BufferResidency::PageFrames};
+        const ALsizei todo{mini(samples, BufferResidency::PageFrames - pagepos)};
+
+        const ALbyte *Data{residency->getPage(page, pos)};
+        if(LIKELY(Data))
+            LoadSamples(dst, &Data[(pagepos*NumChannels + chan)*SampleSize], NumChannels,
+                buffer->mFmtType, todo);
+        else if(!residency->mPages[page].MissReported.exchange(true, std::memory_order_relaxed))
+            SendResidencyMissEvent(context, SourceID, buffer, pos);
+
+        dst += todo;
+        pos += todo;
+        samples -= todo;
+    }
+}
+
 
 const ALfloat *DoFilters(BiquadFilter *lpfilter, BiquadFilter *hpfilter,
                          ALfloat *RESTRICT dst, const ALfloat *RESTRICT src,
@@ -281,13 +542,74 @@ const ALfloat *DoFilters(BiquadFilter *lpfilter, BiquadFilter *hpfilter,
     return src;
 }
 
+/* Returns the number of IR samples to apply for the given HRTF parameters.
+ * Parameters that haven't been given a level of detail (e.g. the silent LFE
+ * channel) apply the full IR.
+ */
+inline ALsizei HrtfApplySize(const HrtfParams &params, const ALsizei irsize)
+{ return (params.IrSize > 0) ? mini(params.IrSize, irsize) : irsize; }
+
+/* The number of samples processed with each step of interpolated HRTF
+ * coefficients.
+ */
+constexpr ALsizei HRTF_INTERP_STEP{16};
+
+/* An alternative to MixHrtfBlendSamples, which fades from the old to the new
+ * HRIR by interpolating the coefficients, delays, and gain in small steps.
+ * This only needs one convolution per sample, rather than convolving with both
+ * the old and new HRIRs to cross-fade the results.
+ */
+void MixHrtfInterpSamples(ALfloat *RESTRICT LeftOut, ALfloat *RESTRICT RightOut,
+    const ALfloat *data, ALsizei Offset, const ALsizei OutPos, const ALsizei IrSize,
+    const HrtfParams *oldparams, MixHrtfParams *newparams, HrtfState *hrtfstate,
+    const ALsizei BufferSize)
+{
+    ASSUME(IrSize >= 4);
+    ASSUME(BufferSize > 0);
+
+    const ALfloat *oldcoeffs{al::assume_aligned<16>(&oldparams->Coeffs[0][0])};
+    const ALfloat *newcoeffs{al::assume_aligned<16>(&(*newparams->Coeffs)[0][0])};
+    const ALfloat oldGain{oldparams->Gain};
+    const ALfloat newGain{newparams->Gain + newparams->GainStep*static_cast<ALfloat>(BufferSize)};
+    const ALsizei numsteps{(BufferSize+HRTF_INTERP_STEP-1) / HRTF_INTERP_STEP};
+
+    alignas(16) HrirArray<ALfloat> coeffs;
+    MixHrtfParams hrtfparams;
+    hrtfparams.Coeffs = &coeffs;
+    hrtfparams.Gain = oldGain;
+    hrtfparams.IrSize = newparams->IrSize;
+
+    ALsizei pos{0};
+    for(ALsizei step{1};step <= numsteps;step++)
+    {
+        const ALsizei todo{mini(BufferSize-pos, HRTF_INTERP_STEP)};
+        const ALfloat mu{static_cast<ALfloat>(step) / static_cast<ALfloat>(numsteps)};
+
+        ALfloat *coeffout{al::assume_aligned<16>(&coeffs[0][0])};
+        for(ALsizei i{0};i < hrtfparams.IrSize*2;i++)
+            coeffout[i] = lerp(oldcoeffs[i], newcoeffs[i], mu);
+        hrtfparams.Delay[0] = fastf2i(lerp(static_cast<ALfloat>(oldparams->Delay[0]),
+            static_cast<ALfloat>(newparams->Delay[0]), mu));
+        hrtfparams.Delay[1] = fastf2i(lerp(static_cast<ALfloat>(oldparams->Delay[1]),
+            static_cast<ALfloat>(newparams->Delay[1]), mu));
+
+        const ALfloat gain{lerp(oldGain, newGain, static_cast<ALfloat>(pos+todo) /
+            static_cast<ALfloat>(BufferSize))};
+        hrtfparams.GainStep = (gain - hrtfparams.Gain) / static_cast<ALfloat>(todo);
+
+        MixHrtfSamples(LeftOut, RightOut, data+pos, Offset+pos, OutPos+pos, IrSize, &hrtfparams,
+            hrtfstate, todo);
+        hrtfparams.Gain = gain;
+        pos += todo;
+    }
+    newparams->Gain = newGain;
+}
+
 } // namespace
 
 /* This function uses these device temp buffers. */
-#define SOURCE_DATA_BUF 0
-#define RESAMPLED_BUF 1
-#define FILTERED_BUF 2
-#define NFC_DATA_BUF 3
+#define FILTERED_BUF 0
+#define NFC_DATA_BUF 1
 ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context, const ALsizei SamplesToDo)
 {
     ASSUME(SamplesToDo > 0);
@@ -311,26 +633,41 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
 
     ALCdevice *Device{Context->Device};
     const ALsizei IrSize{Device->mHrtf ? Device->mHrtf->irSize : 0};
+    const HrtfMixerBlendFunc MixHrtfFade{Device->mHrtfInterp ? MixHrtfInterpSamples :
+        MixHrtfBlendSamples};
     const int OutLIdx{GetChannelIdxByName(Device->RealOut, FrontLeft)};
     const int OutRIdx{GetChannelIdxByName(Device->RealOut, FrontRight)};
 
     ASSUME(IrSize >= 0);
 
-    ResamplerFunc Resample{(increment == FRACTIONONE && DataPosFrac == 0) ?
-                           Resample_<CopyTag,CTag> : voice->Resampler};
+    /* Multichannel voices resample all channels together, unless the samples
+     * can be passed through as-is.
+     */
+    const bool copying{increment == FRACTIONONE && DataPosFrac == 0};
+    ResamplerFunc Resample{copying ? Resample_<CopyTag,CTag> : voice->Resampler};
+    ResamplerMultiFunc ResampleMulti{(copying || NumChannels < 2) ? nullptr :
+                                     voice->ResamplerMulti};
 
     ALsizei Counter{(voice->Flags&VOICE_IS_FADING) ? SamplesToDo : 0};
     if(!Counter)
     {
         /* No fading, just overwrite the old/current params. */
-        for(ALsizei chan{0};chan < NumChannels;chan++)
+        auto set_direct_current = [](DirectParams &parms, const ALuint flags) -> void
         {
-            DirectParams &parms = voice->Direct.Params[chan];
-            if(!(voice->Flags&VOICE_HAS_HRTF))
+            if(!(flags&VOICE_HAS_HRTF))
                 std::copy(std::begin(parms.Gains.Target), std::end(parms.Gains.Target),
                     std::begin(parms.Gains.Current));
             else
                 parms.Hrtf.Old = parms.Hrtf.Target;
+        };
+        for(ALsizei chan{0};chan < NumChannels;chan++)
+        {
+            set_direct_current(voice->Direct.Params[chan], voice->Flags);
+            for(ALsizei i{1};i < Context->NumListeners;i++)
+            {
+                ALvoice::ListenerData &path = voice->Listeners[i-1];
+                set_direct_current(path.Direct.Params[chan], path.Flags);
+            }
             auto set_current = [chan](ALvoice::SendData &send) -> void
             {
                 if(!send.Buffer)
@@ -343,21 +680,29 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
             std::for_each(voice->Send.begin(), voice->Send.end(), set_current);
         }
     }
-    else if((voice->Flags&VOICE_HAS_HRTF))
+    else
     {
-        for(ALsizei chan{0};chan < NumChannels;chan++)
+        auto reset_silent_hrtf = [NumChannels](ALvoice::DirectData &direct, const ALuint flags) -> void
         {
-            DirectParams &parms = voice->Direct.Params[chan];
-            if(!(parms.Hrtf.Old.Gain > GAIN_SILENCE_THRESHOLD))
+            if(!(flags&VOICE_HAS_HRTF))
+                return;
+            for(ALsizei chan{0};chan < NumChannels;chan++)
             {
-                /* The old HRTF params are silent, so overwrite the old
-                 * coefficients with the new, and reset the old gain to 0. The
-                 * future mix will then fade from silence.
-                 */
-                parms.Hrtf.Old = parms.Hrtf.Target;
-                parms.Hrtf.Old.Gain = 0.0f;
+                DirectParams &parms = direct.Params[chan];
+                if(!(parms.Hrtf.Old.Gain > GAIN_SILENCE_THRESHOLD))
+                {
+                    /* The old HRTF params are silent, so overwrite the old
+                     * coefficients with the new, and reset the old gain to 0.
+                     * The future mix will then fade from silence.
+                     */
+                    parms.Hrtf.Old = parms.Hrtf.Target;
+                    parms.Hrtf.Old.Gain = 0.0f;
+                }
             }
-        }
+        };
+        reset_silent_hrtf(voice->Direct, voice->Flags);
+        for(ALsizei i{1};i < Context->NumListeners;i++)
+            reset_silent_hrtf(voice->Listeners[i-1].Direct, voice->Listeners[i-1].Flags);
     }
 
     ALsizei buffers_done{0};
@@ -386,18 +731,25 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
             DstBufferSize = static_cast<ALsizei>(mini64(DataSize64, DstBufferSize));
 
             /* Some mixers like having a multiple of 4, so try to give that
-             * unless this is the last update.
+             * unless this is the last update. At high pitches with a small
+             * BUFFERSIZE this may be fewer than 4 samples, which can't be
+             * rounded down without stalling.
              */
-            if(DstBufferSize < SamplesToDo-OutPos)
+            if(DstBufferSize < SamplesToDo-OutPos && DstBufferSize > 3)
                 DstBufferSize &= ~3;
         }
 
         /* It's impossible to have a buffer list item with no entries. */
         assert(BufferListItem->num_buffers > 0);
 
+        /* Load each channel's source samples, resampling them individually if
+         * they can't be done together.
+         */
+        const ALfloat *ResampledPtrs[MAX_INPUT_CHANNELS];
+
         for(ALsizei chan{0};chan < NumChannels;chan++)
         {
-            ALfloat (&SrcData)[BUFFERSIZE] = Device->TempBuffer[SOURCE_DATA_BUF];
+            ALfloat (&SrcData)[BUFFERSIZE] = Device->SourceData[chan];
 
             /* Load the previous samples into the source data first, and clear the rest. */
             auto srciter = std::copy(std::begin(voice->PrevSamples[chan]),
@@ -424,7 +776,7 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
 
                     BufferLoopItem = nullptr;
 
-                    auto load_buffer = [DataPosInt,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
+                    auto load_buffer = [DataPosInt,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo,Context,SourceID](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
                     {
                         if(DataPosInt >= buffer->SampleLen)
                             return CompLen;
@@ -433,11 +785,8 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                         const ALsizei DataSize{mini(SizeToDo, buffer->SampleLen - DataPosInt)};
                         CompLen = maxi(CompLen, DataSize);
 
-                        const ALbyte *Data{buffer->mData.data()};
-                        LoadSamples(&SrcData[FilledAmt],
-                            &Data[(DataPosInt*NumChannels + chan)*SampleSize],
-                            NumChannels, buffer->mFmtType, DataSize
-                        );
+                        LoadBufferSamples(&SrcData[FilledAmt], buffer, DataPosInt, chan,
+                            NumChannels, SampleSize, DataSize, Context, SourceID);
                         return CompLen;
                     };
                     auto buffers_end = BufferListItem->buffers + BufferListItem->num_buffers;
@@ -448,7 +797,7 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                 {
                     const ALsizei SizeToDo{mini(SrcBufferSize - FilledAmt, LoopEnd - DataPosInt)};
 
-                    auto load_buffer = [DataPosInt,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
+                    auto load_buffer = [DataPosInt,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo,Context,SourceID](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
                     {
                         if(DataPosInt >= buffer->SampleLen)
                             return CompLen;
@@ -457,11 +806,8 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                         const ALsizei DataSize{mini(SizeToDo, buffer->SampleLen - DataPosInt)};
                         CompLen = maxi(CompLen, DataSize);
 
-                        const ALbyte *Data{buffer->mData.data()};
-                        LoadSamples(&SrcData[FilledAmt],
-                            &Data[(DataPosInt*NumChannels + chan)*SampleSize],
-                            NumChannels, buffer->mFmtType, DataSize
-                        );
+                        LoadBufferSamples(&SrcData[FilledAmt], buffer, DataPosInt, chan,
+                            NumChannels, SampleSize, DataSize, Context, SourceID);
                         return CompLen;
                     };
                     auto buffers_end = BufferListItem->buffers + BufferListItem->num_buffers;
@@ -472,7 +818,7 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                     {
                         const ALsizei SizeToDo{mini(SrcBufferSize - FilledAmt, LoopSize)};
 
-                        auto load_buffer_loop = [LoopStart,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
+                        auto load_buffer_loop = [LoopStart,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo,Context,SourceID](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
                         {
                             if(LoopStart >= buffer->SampleLen)
                                 return CompLen;
@@ -480,11 +826,8 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                             const ALsizei DataSize{mini(SizeToDo, buffer->SampleLen - LoopStart)};
                             CompLen = maxi(CompLen, DataSize);
 
-                            const ALbyte *Data{buffer->mData.data()};
-                            LoadSamples(&SrcData[FilledAmt],
-                                &Data[(LoopStart*NumChannels + chan)*SampleSize],
-                                NumChannels, buffer->mFmtType, DataSize
-                            );
+                            LoadBufferSamples(&SrcData[FilledAmt], buffer, LoopStart, chan,
+                                NumChannels, SampleSize, DataSize, Context, SourceID);
                             return CompLen;
                         };
                         FilledAmt += std::accumulate(BufferListItem->buffers, buffers_end,
@@ -509,7 +852,7 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                     }
 
                     const ALsizei SizeToDo{SrcBufferSize - FilledAmt};
-                    auto load_buffer = [pos,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
+                    auto load_buffer = [pos,&SrcData,NumChannels,SampleSize,chan,FilledAmt,SizeToDo,Context,SourceID](ALsizei CompLen, const ALbuffer *buffer) -> ALsizei
                     {
                         if(!buffer) return CompLen;
                         ALsizei DataSize{buffer->SampleLen};
@@ -518,11 +861,8 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                         DataSize = mini(SizeToDo, DataSize - pos);
                         CompLen = maxi(CompLen, DataSize);
 
-                        const ALbyte *Data{buffer->mData.data()};
-                        Data += (pos*NumChannels + chan)*SampleSize;
-
-                        LoadSamples(&SrcData[FilledAmt], Data, NumChannels,
-                                    buffer->mFmtType, DataSize);
+                        LoadBufferSamples(&SrcData[FilledAmt], buffer, pos, chan, NumChannels,
+                            SampleSize, DataSize, Context, SourceID);
                         return CompLen;
                     };
                     auto buffers_end = tmpiter->buffers + tmpiter->num_buffers;
@@ -541,43 +881,60 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
             std::copy_n(&SrcData[(increment*DstBufferSize + DataPosFrac)>>FRACTIONBITS],
                         voice->PrevSamples[chan].size(), std::begin(voice->PrevSamples[chan]));
 
-            /* Now resample, then filter and mix to the appropriate outputs. */
-            const ALfloat *ResampledData{Resample(&voice->ResampleState,
-                &SrcData[MAX_RESAMPLE_PADDING], DataPosFrac, increment,
-                Device->TempBuffer[RESAMPLED_BUF], DstBufferSize
-            )};
+            if(!ResampleMulti)
+                ResampledPtrs[chan] = Resample(&voice->ResampleState,
+                    &SrcData[MAX_RESAMPLE_PADDING], DataPosFrac, increment,
+                    Device->ResampledData[chan], DstBufferSize);
+        }
+        if(ResampleMulti)
+        {
+            ResampleMulti(&voice->ResampleState, Device->SourceData, MAX_RESAMPLE_PADDING,
+                NumChannels, DataPosFrac, increment, Device->ResampledData, DstBufferSize);
+            for(ALsizei chan{0};chan < NumChannels;chan++)
+                ResampledPtrs[chan] = Device->ResampledData[chan];
+        }
+
+        /* Now filter and mix each channel to the appropriate outputs. */
+        for(ALsizei chan{0};chan < NumChannels;chan++)
+        {
+            const ALfloat *ResampledData{ResampledPtrs[chan]};
+
+            /* Filters and mixes a listener's direct path, returning the
+             * filtered samples.
+             */
+            auto mix_direct = [Device,voice,chan,ResampledData,Counter,OutPos,DstBufferSize,IrSize,MixHrtfFade,OutLIdx,OutRIdx](ALvoice::DirectData &direct, const ALuint flags) -> const ALfloat*
             {
-                DirectParams &parms = voice->Direct.Params[chan];
+                DirectParams &parms = direct.Params[chan];
                 const ALfloat *samples{DoFilters(&parms.LowPass, &parms.HighPass,
                     Device->TempBuffer[FILTERED_BUF], ResampledData, DstBufferSize,
-                    voice->Direct.FilterType
+                    direct.FilterType
                 )};
 
-                if(!(voice->Flags&VOICE_HAS_HRTF))
+                if(!(flags&VOICE_HAS_HRTF))
                 {
-                    if(!(voice->Flags&VOICE_HAS_NFC))
-                        MixSamples(samples, voice->Direct.Channels, voice->Direct.Buffer,
+                    if(!(flags&VOICE_HAS_NFC))
+                        MixSamples(samples, direct.Channels, direct.Buffer,
                             parms.Gains.Current, parms.Gains.Target, Counter, OutPos,
                             DstBufferSize);
                     else
                     {
                         MixSamples(samples,
-                            voice->Direct.ChannelsPerOrder[0], voice->Direct.Buffer,
+                            direct.ChannelsPerOrder[0], direct.Buffer,
                             parms.Gains.Current, parms.Gains.Target, Counter, OutPos,
                             DstBufferSize);
 
                         ALfloat *nfcsamples{Device->TempBuffer[NFC_DATA_BUF]};
-                        ALsizei chanoffset{voice->Direct.ChannelsPerOrder[0]};
+                        ALsizei chanoffset{direct.ChannelsPerOrder[0]};
                         using FilterProc = void (NfcFilter::*)(float*,const float*,int);
-                        auto apply_nfc = [voice,&parms,samples,DstBufferSize,Counter,OutPos,&chanoffset,nfcsamples](FilterProc process, ALsizei order) -> void
+                        auto apply_nfc = [&direct,&parms,samples,DstBufferSize,Counter,OutPos,&chanoffset,nfcsamples](FilterProc process, ALsizei order) -> void
                         {
-                            if(voice->Direct.ChannelsPerOrder[order] < 1)
+                            if(direct.ChannelsPerOrder[order] < 1)
                                 return;
                             (parms.NFCtrlFilter.*process)(nfcsamples, samples, DstBufferSize);
-                            MixSamples(nfcsamples, voice->Direct.ChannelsPerOrder[order],
-                                voice->Direct.Buffer+chanoffset, parms.Gains.Current+chanoffset,
+                            MixSamples(nfcsamples, direct.ChannelsPerOrder[order],
+                                direct.Buffer+chanoffset, parms.Gains.Current+chanoffset,
                                 parms.Gains.Target+chanoffset, Counter, OutPos, DstBufferSize);
-                            chanoffset += voice->Direct.ChannelsPerOrder[order];
+                            chanoffset += direct.ChannelsPerOrder[order];
                         };
                         apply_nfc(&NfcFilter::process1, 1);
                         apply_nfc(&NfcFilter::process2, 2);
@@ -608,9 +965,14 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                         hrtfparams.Delay[1] = parms.Hrtf.Target.Delay[1];
                         hrtfparams.Gain = 0.0f;
                         hrtfparams.GainStep = gain / static_cast<ALfloat>(fademix);
+                        /* Apply enough of the IRs to cover both the old and
+                         * new levels of detail.
+                         */
+                        hrtfparams.IrSize = maxi(HrtfApplySize(parms.Hrtf.Old, IrSize),
+                            HrtfApplySize(parms.Hrtf.Target, IrSize));
 
-                        MixHrtfBlendSamples(
-                            voice->Direct.Buffer[OutLIdx], voice->Direct.Buffer[OutRIdx],
+                        MixHrtfFade(
+                            direct.Buffer[OutLIdx], direct.Buffer[OutRIdx],
                             samples, voice->Offset, OutPos, IrSize, &parms.Hrtf.Old,
                             &hrtfparams, &parms.Hrtf.State, fademix);
                         /* Update the old parameters with the result. */
@@ -637,8 +999,9 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                         hrtfparams.Delay[1] = parms.Hrtf.Target.Delay[1];
                         hrtfparams.Gain = parms.Hrtf.Old.Gain;
                         hrtfparams.GainStep = (gain - parms.Hrtf.Old.Gain) / static_cast<ALfloat>(todo);
+                        hrtfparams.IrSize = HrtfApplySize(parms.Hrtf.Target, IrSize);
                         MixHrtfSamples(
-                            voice->Direct.Buffer[OutLIdx], voice->Direct.Buffer[OutRIdx],
+                            direct.Buffer[OutLIdx], direct.Buffer[OutRIdx],
                             samples+fademix, voice->Offset+fademix, OutPos+fademix, IrSize,
                             &hrtfparams, &parms.Hrtf.State, todo);
                         /* Store the interpolated gain or the final target gain
@@ -650,6 +1013,23 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
                             parms.Hrtf.Old.Gain = parms.Hrtf.Target.Gain;
                     }
                 }
+
+                return samples;
+            };
+
+            const ALfloat *samples{mix_direct(voice->Direct, voice->Flags)};
+            if(voice->PrevClusterIdx >= 0)
+            {
+                static constexpr ALfloat silence[1]{0.0f};
+                VoiceCluster &cluster = Context->VoiceClusters[voice->PrevClusterIdx];
+                MixSamples(samples, 1, cluster.Buffer, &voice->PrevClusterGain, silence,
+                    Counter, OutPos, DstBufferSize);
+            }
+            for(ALsizei i{1};i < Context->NumListeners;i++)
+            {
+                ALvoice::ListenerData &path = voice->Listeners[i-1];
+                if(path.Direct.Buffer)
+                    mix_direct(path.Direct, path.Flags);
             }
 
             ALfloat (&FilterBuf)[BUFFERSIZE] = Device->TempBuffer[FILTERED_BUF];
@@ -724,6 +1104,7 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
     } while(isplaying && OutPos < SamplesToDo);
 
     voice->Flags |= VOICE_IS_FADING;
+    voice->PrevClusterIdx = -1;
 
     /* Update source info */
     voice->position.store(DataPosInt, std::memory_order_relaxed);
@@ -748,3 +1129,79 @@ ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context,
 
     return isplaying;
 }
+
+
+void MixVoiceCluster(VoiceCluster *cluster, ALCdevice *Device, const ALsizei SamplesToDo)
+{
+    ASSUME(SamplesToDo > 0);
+
+    const ALfloat *samples{cluster->Buffer[0]};
+    if(Device->mRenderMode != HrtfRender)
+    {
+        MixSamples(samples, Device->Dry.NumChannels, Device->Dry.Buffer, cluster->Gains.Current,
+            cluster->Gains.Target, SamplesToDo, 0, SamplesToDo);
+        return;
+    }
+
+    const ALsizei IrSize{Device->mHrtf->irSize};
+    const HrtfMixerBlendFunc MixHrtfFade{Device->mHrtfInterp ? MixHrtfInterpSamples :
+        MixHrtfBlendSamples};
+    const int OutLIdx{GetChannelIdxByName(Device->RealOut, FrontLeft)};
+    const int OutRIdx{GetChannelIdxByName(Device->RealOut, FrontRight)};
+    ALfloat *LeftOut{Device->RealOut.Buffer[OutLIdx]};
+    ALfloat *RightOut{Device->RealOut.Buffer[OutRIdx]};
+
+    MixHrtfParams hrtfparams;
+    hrtfparams.Coeffs = &cluster->Hrtf.Target.Coeffs;
+    hrtfparams.Delay[0] = cluster->Hrtf.Target.Delay[0];
+    hrtfparams.Delay[1] = cluster->Hrtf.Target.Delay[1];
+
+    /* Cross-fade to the new IRs if the cluster moved, unless it's just
+     * starting from silence.
+     */
+    ALsizei fademix{0};
+    if(cluster->Moved && cluster->Hrtf.Old.Gain > GAIN_SILENCE_THRESHOLD)
+    {
+        fademix = mini(SamplesToDo, 128);
+
+        hrtfparams.Gain = 0.0f;
+        hrtfparams.GainStep = cluster->Hrtf.Target.Gain / static_cast<ALfloat>(fademix);
+        hrtfparams.IrSize = maxi(HrtfApplySize(cluster->Hrtf.Old, IrSize),
+            HrtfApplySize(cluster->Hrtf.Target, IrSize));
+        MixHrtfFade(LeftOut, RightOut, samples, cluster->Offset, 0, IrSize,
+            &cluster->Hrtf.Old, &hrtfparams, &cluster->Hrtf.State, fademix);
+    }
+    if(fademix < SamplesToDo)
+    {
+        hrtfparams.Gain = cluster->Hrtf.Target.Gain;
+        hrtfparams.GainStep = 0.0f;
+        hrtfparams.IrSize = HrtfApplySize(cluster->Hrtf.Target, IrSize);
+        MixHrtfSamples(LeftOut, RightOut, samples+fademix, cluster->Offset+fademix, fademix,
+            IrSize, &hrtfparams, &cluster->Hrtf.State, SamplesToDo-fademix);
+    }
+
+    cluster->Hrtf.Old = cluster->Hrtf.Target;
+    cluster->Moved = false;
+    cluster->Offset += static_cast<ALuint>(SamplesToDo);
+}
+
+void MixSubmixBus(ALsubmixbus *bus, ALCdevice *Device, const ALsizei SamplesToDo)
+{
+    ASSUME(SamplesToDo > 0);
+
+    ALeffectslot *slot{bus->Params.Slot};
+    for(ALsizei c{0};c < bus->Mix.NumChannels;c++)
+    {
+        const ALfloat *samples{DoFilters(&bus->Params.LowPass[c], &bus->Params.HighPass[c],
+            Device->TempBuffer[FILTERED_BUF], bus->Buffer[c], SamplesToDo,
+            bus->Params.FilterType)};
+
+        MixSamples(samples, Device->FOAOut.NumChannels, Device->FOAOut.Buffer,
+            bus->Params.Gains[c].Current, bus->Params.Gains[c].Target, SamplesToDo, 0,
+            SamplesToDo);
+        if(slot)
+            MixSamples(samples, slot->NumChannels, slot->WetBuffer,
+                bus->Params.SendGains[c].Current, bus->Params.SendGains[c].Target,
+                SamplesToDo, 0, SamplesToDo);
+    }
+}
@@ -872,6 +872,8 @@ void aluInitRenderer(ALCdevice *device, ALint hrtf_id, HrtfRequestMode hrtf_appr
     device->mHrtfState = nullptr;
     device->mHrtf = nullptr;
     device->HrtfName.clear();
+    device->mHrtfLod = false;
+    device->mHrtfInterp = false;
     device->mRenderMode = NormalRender;
 
     device->Dry.AmbiMap.fill(BFChannelConfig{});
@@ -1066,6 +1068,9 @@ void aluInitRenderer(ALCdevice *device, ALint hrtf_id, HrtfRequestMode hrtf_appr
             else
                 ERR("Unexpected hrtf-mode: %s\n", mode);
         }
+        device->mHrtfLod = GetConfigValueBool(device->DeviceName.c_str(), nullptr, "hrtf-lod", 0);
+        device->mHrtfInterp = GetConfigValueBool(device->DeviceName.c_str(), nullptr,
+            "hrtf-interpolate", 0);
 
         TRACE("%s HRTF rendering enabled, using \"%s\"\n",
             ((device->mRenderMode == HrtfRender) ? "Full" : "Basic"), device->HrtfName.c_str()
@@ -1118,6 +1123,49 @@ no_hrtf:
     InitPanning(device);
 }
 
+void aluInitListenerOutput(const ALCdevice *device, ListenerOutput *output)
+{
+    output->MixBuffer.clear();
+    output->MixBuffer.resize(device->MixBuffer.size());
+
+    /* Copy the device's post-process configuration, starting with a clean
+     * filter history.
+     */
+    output->mHrtfState = nullptr;
+    if(const DirectHrtfState *hrtfstate{device->mHrtfState.get()})
+    {
+        output->mHrtfState = DirectHrtfState::Create(hrtfstate->Chan.size());
+        output->mHrtfState->IrSize = hrtfstate->IrSize;
+        for(size_t i{0};i < hrtfstate->Chan.size();i++)
+            output->mHrtfState->Chan[i].Coeffs = hrtfstate->Chan[i].Coeffs;
+    }
+
+    output->Uhj_Encoder = nullptr;
+    if(device->Uhj_Encoder)
+        output->Uhj_Encoder = al::make_unique<Uhj2Encoder>();
+
+    output->AmbiDecoder = nullptr;
+    if(device->AmbiDecoder)
+    {
+        output->AmbiDecoder = al::make_unique<BFormatDec>();
+        output->AmbiDecoder->reset(*device->AmbiDecoder);
+    }
+
+    output->Bs2b = nullptr;
+    if(device->Bs2b)
+    {
+        output->Bs2b = al::make_unique<bs2b>();
+        bs2b_set_params(output->Bs2b.get(), device->Bs2b->level, device->Bs2b->srate);
+    }
+
+    output->AmbiUp = nullptr;
+    if(device->AmbiUp)
+    {
+        output->AmbiUp = al::make_unique<AmbiUpsampler>();
+        output->AmbiUp->reset(*device->AmbiUp);
+    }
+}
+
 
 void aluInitEffectPanning(ALeffectslot *slot)
 {
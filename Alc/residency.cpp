@@ -0,0 +1,344 @@
+
+#include "config.h"
+
+#include "residency.h"
+
+#include <cstring>
+#include <functional>
+
+#include "alMain.h"
+#include "logging.h"
+
+
+namespace {
+
+/* Reads the given page of sample data from the buffer's file. Any data that
+ * couldn't be read is zeroed.
+ */
+ALbyte *ReadPage(BufferResidency *buffer, ALsizei page)
+{
+    const size_t bytes{buffer->pageBytes(page)};
+    auto data = static_cast<ALbyte*>(al_large_malloc(16, bytes));
+    if(!data) return nullptr;
+
+    buffer->mFile.clear();
+    buffer->mFile.seekg(buffer->mFileOffset +
+        static_cast<std::streamoff>(page)*BufferResidency::PageFrames*buffer->mFrameSize);
+    buffer->mFile.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(bytes));
+
+    const auto got = static_cast<size_t>(buffer->mFile.gcount());
+    if(UNLIKELY(got < bytes))
+    {
+        WARN("Short read of page %d from %s (" SZFMT " of " SZFMT " bytes)\n", page,
+            buffer->mFilename.c_str(), got, bytes);
+        std::memset(data+got, 0, bytes-got);
+    }
+    return data;
+}
+
+} // namespace
+
+
+BufferResidency::BufferResidency(ResidencyManager *manager, std::string filename,
+    std::streamoff offset, ALsizei framesize, ALsizei numframes, ALsizei prefetch)
+  : mManager{manager}, mFilename{std::move(filename)}, mFileOffset{offset},
+    mFrameSize{framesize}, mNumFrames{numframes}, mPrefetchFrames{prefetch}
+{ }
+
+BufferResidency::~BufferResidency()
+{
+    if(!mPages) return;
+    mManager->remove(this);
+}
+
+bool BufferResidency::init()
+{
+    mFile.open(mFilename.c_str(), std::ios::binary);
+    if(!mFile.is_open())
+    {
+        WARN("Could not open %s\n", mFilename.c_str());
+        return false;
+    }
+
+    /* Make sure the file holds all the sample data up front, so reads later
+     * on don't fail.
+     */
+    mFile.seekg(0, std::ios::end);
+    const std::streamoff filesize{mFile.tellg()};
+    if(filesize < mFileOffset + static_cast<std::streamoff>(mNumFrames)*mFrameSize)
+    {
+        WARN("%s is too small (%lld bytes, expected %lld)\n", mFilename.c_str(),
+            static_cast<long long>(filesize),
+            static_cast<long long>(mFileOffset + static_cast<std::streamoff>(mNumFrames)*mFrameSize));
+        return false;
+    }
+
+    mNumPages = (mNumFrames+PageFrames-1) / PageFrames;
+    mPages = std::unique_ptr<Page[]>{new Page[mNumPages]};
+
+    const ALsizei topin{std::min(std::max((mPrefetchFrames+PageFrames-1) / PageFrames, 1),
+        mNumPages)};
+    for(;mNumPinned < topin;mNumPinned++)
+    {
+        bool pinned{true};
+        if(!mManager->loadPinned(this, mNumPinned, &pinned))
+        {
+            mManager->remove(this);
+            mPages = nullptr;
+            return false;
+        }
+        if(!pinned) break;
+    }
+    if(mNumPinned < topin)
+        WARN("Pinned %d of %d leading pages of %s\n", mNumPinned, topin, mFilename.c_str());
+    mManager->add(this);
+
+    return true;
+}
+
+const ALbyte *BufferResidency::getPage(ALsizei page, ALsizei frame) noexcept
+{
+    /* Mark the pages being played, and those coming up within the prefetch
+     * distance, as in use. Any that aren't resident are queued for the
+     * manager's thread.
+     */
+    const ALuint now{mManager->now()};
+    const ALsizei last{std::min((frame+mPrefetchFrames) / PageFrames, mNumPages-1)};
+    for(ALsizei i{std::max(page, mNumPinned)};i <= last;i++)
+    {
+        Page &cur = mPages[i];
+        cur.LastUse.store(now, std::memory_order_relaxed);
+        if(cur.Data.load(std::memory_order_relaxed))
+            continue;
+        /* If the queue is full, try again with the next update. */
+        if(!cur.Wanted.exchange(true, std::memory_order_acq_rel) && !mManager->request(this, i))
+            cur.Wanted.store(false, std::memory_order_release);
+    }
+
+    return mPages[page].Data.load(std::memory_order_acquire);
+}
+
+
+ResidencyManager::ResidencyManager(ALCdevice *device, size_t budget, ALuint prefetch_ms)
+  : mDevice{device}, mBudget{budget}, mPrefetchMs{prefetch_ms},
+    mEpoch{std::chrono::steady_clock::now()}
+{
+    mRequests = CreateRingBuffer(1024, sizeof(PageRequest), false);
+    mThread = std::thread{std::mem_fn(&ResidencyManager::ioThread), this};
+}
+
+ResidencyManager::~ResidencyManager()
+{
+    mQuit.store(true, std::memory_order_release);
+    mSem.post();
+    if(mThread.joinable())
+        mThread.join();
+
+    if(!mBuffers.empty())
+        WARN(SZFMT " file-backed buffer%s still registered\n", mBuffers.size(),
+            (mBuffers.size()==1) ? "" : "s");
+}
+
+bool ResidencyManager::loadPinned(BufferResidency *buffer, ALsizei page, bool *pinned)
+{
+    /* The buffer isn't registered yet, so the I/O thread won't read its file
+     * while it's read here without the lock.
+     */
+    const size_t bytes{buffer->pageBytes(page)};
+    {
+        std::lock_guard<std::mutex> _{mLock};
+        if(mPinnedBytes+bytes > mBudget/2)
+        {
+            *pinned = false;
+            return true;
+        }
+        mPinnedBytes += bytes;
+        mResidentBytes += bytes;
+    }
+
+    ALbyte *data{ReadPage(buffer, page)};
+
+    std::lock_guard<std::mutex> _{mLock};
+    if(!data)
+    {
+        mPinnedBytes -= bytes;
+        mResidentBytes -= bytes;
+        return false;
+    }
+    buffer->mPages[page].Data.store(data, std::memory_order_release);
+    if(mResidentBytes > mBudget && !mWarnedBudget)
+    {
+        WARN("Resident pages exceed the residency budget (" SZFMT " > " SZFMT " bytes)\n",
+            mResidentBytes, mBudget);
+        mWarnedBudget = true;
+    }
+    *pinned = true;
+    return true;
+}
+
+void ResidencyManager::add(BufferResidency *buffer)
+{
+    std::lock_guard<std::mutex> _{mLock};
+    /* Skip 0, which unregistered buffers have. */
+    if(++mNextId == 0) ++mNextId;
+    buffer->mId = mNextId;
+    mBuffers.emplace_back(buffer);
+}
+
+void ResidencyManager::remove(BufferResidency *buffer)
+{
+    std::unique_lock<std::mutex> lock{mLock};
+    auto iter = std::find(mBuffers.begin(), mBuffers.end(), buffer);
+    if(iter != mBuffers.end())
+        mBuffers.erase(iter);
+    /* Wait for any page the I/O thread is reading from the buffer. */
+    mLoadDone.wait(lock, [this,buffer]() noexcept -> bool { return mLoading != buffer; });
+
+    /* The buffer isn't in use by any source, so its pages can be freed right
+     * away.
+     */
+    for(ALsizei i{0};i < buffer->mNumPages;i++)
+    {
+        BufferResidency::Page &cur = buffer->mPages[i];
+        ALbyte *data{cur.Data.exchange(nullptr, std::memory_order_relaxed)};
+        if(!data) continue;
+        al_large_free(data, buffer->pageBytes(i));
+        mResidentBytes -= buffer->pageBytes(i);
+        if(i < buffer->mNumPinned)
+            mPinnedBytes -= buffer->pageBytes(i);
+        else
+            mEvictList.erase(cur.EvictPos);
+    }
+}
+
+bool ResidencyManager::request(BufferResidency *buffer, ALsizei page) noexcept
+{
+    const PageRequest req{buffer, buffer->mId, page};
+    if(mRequests->write(&req, 1) == 0)
+        return false;
+    mSem.post();
+    return true;
+}
+
+ALbyte *ResidencyManager::evictPage(const ALuint now, const size_t needed, size_t *bytes)
+{
+    /* Evict the oldest page that hasn't been used within the prefetch time
+     * (which would mean it's needed soon). Recently used pages move to the
+     * back of the list, so each page is checked at most once.
+     */
+    for(size_t count{mEvictList.size()};count > 0;--count)
+    {
+        const ResidentPage oldest{mEvictList.front()};
+        BufferResidency::Page &cur = oldest.buffer->mPages[oldest.page];
+        if(now - cur.LastUse.load(std::memory_order_relaxed) <= mPrefetchMs)
+        {
+            mEvictList.splice(mEvictList.end(), mEvictList, mEvictList.begin());
+            continue;
+        }
+
+        mEvictList.pop_front();
+        *bytes = oldest.buffer->pageBytes(oldest.page);
+        mResidentBytes -= *bytes;
+        return cur.Data.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    if(!mWarnedBudget)
+    {
+        WARN("Residency budget exhausted (" SZFMT " of " SZFMT " bytes resident, " SZFMT
+            " needed)\n", mResidentBytes, mBudget, needed);
+        mWarnedBudget = true;
+    }
+    return nullptr;
+}
+
+void ResidencyManager::loadPage(const PageRequest &req)
+{
+    BufferResidency *buffer{req.buffer};
+    const ALsizei page{req.page};
+
+    std::unique_lock<std::mutex> lock{mLock};
+    /* The buffer may have been deleted since the request was made, and a new
+     * one may have been registered at the same address.
+     */
+    if(std::find(mBuffers.begin(), mBuffers.end(), buffer) == mBuffers.end()
+        || buffer->mId != req.id || page >= buffer->mNumPages)
+        return;
+
+    BufferResidency::Page &cur = buffer->mPages[page];
+    if(cur.Data.load(std::memory_order_relaxed))
+    {
+        cur.Wanted.store(false, std::memory_order_release);
+        return;
+    }
+
+    /* Make room for the page, and reserve its space, before reading it. */
+    const size_t bytes{buffer->pageBytes(page)};
+    const ALuint now{this->now()};
+    al::vector<std::pair<ALbyte*,size_t>> evicted;
+    while(mResidentBytes+bytes > mBudget)
+    {
+        size_t oldbytes{0u};
+        ALbyte *olddata{evictPage(now, bytes, &oldbytes)};
+        if(!olddata) break;
+        evicted.emplace_back(olddata, oldbytes);
+    }
+    const bool fits{mResidentBytes+bytes <= mBudget};
+    if(fits)
+    {
+        mResidentBytes += bytes;
+        mLoading = buffer;
+    }
+    else
+        cur.Wanted.store(false, std::memory_order_release);
+    lock.unlock();
+
+    /* Wait for the mixer to finish any update that may still be reading the
+     * evicted pages before freeing them.
+     */
+    if(!evicted.empty())
+    {
+        /* Make sure the mixer either sees the cleared pointers, or is seen
+         * mixing an update that may have loaded them.
+         */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while((mDevice->MixCount.load(std::memory_order_acquire)&1))
+            std::this_thread::yield();
+        for(auto &olddata : evicted)
+            al_large_free(olddata.first, olddata.second);
+    }
+    if(!fits) return;
+
+    ALbyte *data{ReadPage(buffer, page)};
+
+    lock.lock();
+    mLoading = nullptr;
+    if(!data)
+        mResidentBytes -= bytes;
+    else
+    {
+        cur.MissReported.store(false, std::memory_order_relaxed);
+        cur.EvictPos = mEvictList.emplace(mEvictList.end(), ResidentPage{buffer, page});
+        cur.Data.store(data, std::memory_order_release);
+    }
+    cur.Wanted.store(false, std::memory_order_release);
+    lock.unlock();
+    mLoadDone.notify_all();
+}
+
+int ResidencyManager::ioThread()
+{
+    althrd_setname(RESIDENCY_THREAD_NAME);
+
+    while(1)
+    {
+        mSem.wait();
+        if(mQuit.load(std::memory_order_acquire))
+            break;
+
+        PageRequest req;
+        while(mRequests->read(&req, 1) > 0)
+            loadPage(req);
+    }
+
+    return 0;
+}
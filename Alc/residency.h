@@ -0,0 +1,188 @@
+#ifndef ALC_RESIDENCY_H
+#define ALC_RESIDENCY_H
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "AL/al.h"
+
+#include "almalloc.h"
+#include "compat.h"
+#include "ringbuffer.h"
+#include "threads.h"
+#include "vector.h"
+
+
+struct ALCdevice;
+struct BufferResidency;
+class ResidencyManager;
+
+struct ResidentPage {
+    BufferResidency *buffer;
+    ALsizei page;
+};
+using ResidentPageList = std::list<ResidentPage>;
+
+/* A page the mixer wants loaded. The buffer's ID guards against a deleted
+ * buffer's address being reused by a new one before the request is handled.
+ */
+struct PageRequest {
+    BufferResidency *buffer;
+    ALuint id;
+    ALsizei page;
+};
+
+/* Sample data for a buffer that's read from a file on demand. The data is
+ * split into pages, which a background thread loads ahead of the playback
+ * position and evicts when unused, keeping the device's total resident data
+ * within a fixed budget.
+ */
+struct BufferResidency {
+    /* The number of sample frames in each page. */
+    static constexpr ALsizei PageFrames{16384};
+
+    struct Page {
+        /* The page's samples, or null if not resident. */
+        std::atomic<ALbyte*> Data{nullptr};
+        /* When the page was last read or wanted, in milliseconds of the
+         * manager's clock.
+         */
+        std::atomic<ALuint> LastUse{0u};
+        /* Set when the mixer needs the page loaded. */
+        std::atomic<bool> Wanted{false};
+        /* Set once a read of the non-resident page has been reported, so the
+         * mixer reports each miss once.
+         */
+        std::atomic<bool> MissReported{false};
+        /* The page's place in the manager's eviction list while resident and
+         * not pinned. Only used by the manager, with its lock held.
+         */
+        ResidentPageList::iterator EvictPos{};
+    };
+
+    ResidencyManager *const mManager;
+    /* Set by the manager when the buffer is registered. */
+    ALuint mId{0u};
+
+    const std::string mFilename;
+    const std::streamoff mFileOffset;
+    const ALsizei mFrameSize;
+    const ALsizei mNumFrames;
+    /* How far ahead of the playback position pages are requested. */
+    const ALsizei mPrefetchFrames;
+
+    /* The file is only read by the manager's thread, after creation. */
+    al::ifstream mFile;
+
+    /* The leading pages, which are loaded on creation and never evicted, so
+     * playback can start without missing data. Fewer pages are pinned when
+     * the device's pinned data would grow past its limit.
+     */
+    ALsizei mNumPinned{0};
+    ALsizei mNumPages{0};
+    std::unique_ptr<Page[]> mPages;
+
+    BufferResidency(ResidencyManager *manager, std::string filename, std::streamoff offset,
+        ALsizei framesize, ALsizei numframes, ALsizei prefetch);
+    BufferResidency(const BufferResidency&) = delete;
+    BufferResidency& operator=(const BufferResidency&) = delete;
+    ~BufferResidency();
+
+    /* Loads the pinned pages and registers with the manager. Returns false if
+     * the file couldn't be read.
+     */
+    bool init();
+
+    size_t pageBytes(ALsizei page) const noexcept
+    {
+        return static_cast<size_t>(std::min(PageFrames, mNumFrames - page*PageFrames)) *
+            static_cast<size_t>(mFrameSize);
+    }
+
+    /* Called by the mixer to get the data for the given page, or null if it
+     * isn't resident. The pages from the given frame to the prefetch distance
+     * ahead of it are requested as needed.
+     */
+    const ALbyte *getPage(ALsizei page, ALsizei frame) noexcept;
+
+    DEF_NEWDEL(BufferResidency)
+};
+
+
+/* Manages the resident pages of a device's file-backed buffers. */
+class ResidencyManager {
+    ALCdevice *const mDevice;
+    const size_t mBudget;
+    const ALuint mPrefetchMs;
+
+    std::mutex mLock;
+    al::vector<BufferResidency*> mBuffers;
+    ALuint mNextId{0u};
+    size_t mResidentBytes{0u};
+    size_t mPinnedBytes{0u};
+    bool mWarnedBudget{false};
+    /* Resident pages that can be evicted, oldest first. Pages passed over for
+     * being recently used move to the back, approximating LRU order without
+     * the mixer having to touch the list.
+     */
+    ResidentPageList mEvictList;
+    /* The buffer the I/O thread is reading from, without the lock held. */
+    BufferResidency *mLoading{nullptr};
+    std::condition_variable mLoadDone;
+
+    /* Pages the mixer wants loaded, written by the mixer and read by the I/O
+     * thread.
+     */
+    RingBufferPtr mRequests;
+
+    std::atomic<bool> mQuit{false};
+    al::semaphore mSem;
+    std::thread mThread;
+
+    const std::chrono::steady_clock::time_point mEpoch;
+
+    void loadPage(const PageRequest &req);
+    ALbyte *evictPage(const ALuint now, const size_t needed, size_t *bytes);
+    int ioThread();
+
+public:
+    ResidencyManager(ALCdevice *device, size_t budget, ALuint prefetch_ms);
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+    ~ResidencyManager();
+
+    ALuint prefetchMs() const noexcept { return mPrefetchMs; }
+
+    /* The current time in milliseconds, for tracking page use. */
+    ALuint now() const noexcept
+    {
+        return static_cast<ALuint>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - mEpoch).count());
+    }
+
+    /* Reads the given page from the buffer's file and makes it resident
+     * without being evictable. Sets *pinned to false without loading if that
+     * would put more than half the budget in pinned pages. Returns false if
+     * the page couldn't be read.
+     */
+    bool loadPinned(BufferResidency *buffer, ALsizei page, bool *pinned);
+
+    void add(BufferResidency *buffer);
+    void remove(BufferResidency *buffer);
+
+    /* Queues the page to be loaded and wakes the I/O thread. Only called by
+     * the mixer. Returns false if the queue is full.
+     */
+    bool request(BufferResidency *buffer, ALsizei page) noexcept;
+
+    DEF_NEWDEL(ResidencyManager)
+};
+
+#endif /* ALC_RESIDENCY_H */
@@ -10,6 +10,10 @@ namespace al {
 template<typename T, size_t alignment=DEF_ALIGN>
 using vector = std::vector<T, al::allocator<T, alignment>>;
 
+/* A vector for large audio storage, using the large allocation flags. */
+template<typename T, size_t alignment=DEF_ALIGN>
+using large_vector = std::vector<T, al::large_allocator<T, alignment>>;
+
 } // namespace al
 
 #endif /* AL_VECTOR_H */
@@ -94,8 +94,21 @@ struct ALeffectslot {
         ALfloat DecayHFRatio{0.0f};
         ALboolean DecayHFLimit{AL_FALSE};
         ALfloat AirAbsorptionGainHF{1.0f};
+
+        /* Effects that only route their input to a single real output channel
+         * (i.e. the dedicated effects) set the channel index and gain here,
+         * otherwise the index is -1.
+         */
+        ALsizei DirectOutChannel{-1};
+        ALfloat DirectOutGain{0.0f};
     } Params;
 
+    /* Set by the mixer when voices can mix directly to the DirectOutChannel,
+     * skipping the wet buffer and effect processing. This is only done when
+     * no other effect slot outputs to this one.
+     */
+    bool DirectOut{false};
+
     /* Self ID */
     ALuint id{};
 
@@ -8,6 +8,7 @@
 #include "inprogext.h"
 #include "atomic.h"
 #include "vector.h"
+#include "residency.h"
 
 
 /* User formats */
@@ -18,6 +19,8 @@ enum UserFmtType {
     UserFmtDouble,
     UserFmtMulaw,
     UserFmtAlaw,
+    UserFmtHalf,
+    UserFmtPacked24,
     UserFmtIMA4,
     UserFmtMSADPCM,
 };
@@ -47,6 +50,8 @@ enum FmtType {
     FmtDouble = UserFmtDouble,
     FmtMulaw  = UserFmtMulaw,
     FmtAlaw   = UserFmtAlaw,
+    FmtHalf   = UserFmtHalf,
+    FmtPacked24 = UserFmtPacked24,
 };
 enum FmtChannels {
     FmtMono   = UserFmtMono,
@@ -59,7 +64,12 @@ enum FmtChannels {
     FmtBFormat2D = UserFmtBFormat2D,
     FmtBFormat3D = UserFmtBFormat3D,
 };
-#define MAX_INPUT_CHANNELS  (8)
+
+/* A signed 24-bit little-endian sample, stored in 3 bytes. */
+struct ALpacked24 {
+    ALubyte b[3];
+};
+static_assert(sizeof(ALpacked24) == 3, "ALpacked24 is not 3 bytes");
 
 /* DevFmtType traits, providing the type, etc given a DevFmtType. */
 template<FmtType T>
@@ -77,6 +87,10 @@ template<>
 struct FmtTypeTraits<FmtMulaw> { using Type = ALubyte; };
 template<>
 struct FmtTypeTraits<FmtAlaw> { using Type = ALubyte; };
+template<>
+struct FmtTypeTraits<FmtHalf> { using Type = ALushort; };
+template<>
+struct FmtTypeTraits<FmtPacked24> { using Type = ALpacked24; };
 
 
 ALsizei BytesFromFmt(FmtType type);
@@ -86,7 +100,7 @@ inline ALsizei FrameSizeFromFmt(FmtChannels chans, FmtType type)
 
 
 struct ALbuffer {
-    al::vector<ALbyte,16> mData;
+    al::large_vector<ALbyte,16> mData;
 
     ALsizei Frequency{0};
     ALbitfieldSOFT Access{0u};
@@ -106,6 +120,11 @@ struct ALbuffer {
     std::atomic<ALsizei> UnpackAlign{0};
     std::atomic<ALsizei> PackAlign{0};
 
+    /* Set for buffers whose sample data is read from a file as needed, in
+     * which case mData is unused.
+     */
+    std::unique_ptr<BufferResidency> mResidency;
+
     ALbitfieldSOFT MappedAccess{0u};
     ALsizei MappedOffset{0};
     ALsizei MappedSize{0};
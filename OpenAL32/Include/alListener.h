@@ -54,6 +54,7 @@ struct ALlistener {
     ALlistener() { PropsClean.test_and_set(std::memory_order_relaxed); }
 };
 
-void UpdateListenerProps(ALCcontext *context);
+void UpdateListenerProps(ALlistener *listener, ALCcontext *context);
+void UpdateAllListenerProps(ALCcontext *context);
 
 #endif
@@ -182,6 +182,7 @@ struct EffectState;
 struct Uhj2Encoder;
 class BFormatDec;
 class AmbiUpsampler;
+class ResidencyManager;
 struct bs2b;
 
 
@@ -392,6 +393,7 @@ enum DevFmtChannels {
     DevFmtChannelsDefault = DevFmtStereo
 };
 #define MAX_OUTPUT_CHANNELS  (16)
+#define MAX_INPUT_CHANNELS  (8)
 
 /* DevFmtType traits, providing the type, etc given a DevFmtType. */
 template<DevFmtType T>
@@ -447,6 +449,18 @@ enum RenderMode {
     HrtfRender
 };
 
+/* Output fade state used while the renderer of a running device is replaced.
+ * The mixer advances FadeOut to Silent, and FadeIn to None, after the update
+ * that completes the fade. Updates mixed while Silent output silence without
+ * processing any contexts, so voices don't advance until the fade in.
+ */
+enum class RenderFade {
+    None,
+    FadeOut,
+    Silent,
+    FadeIn
+};
+
 
 struct BufferSubList {
     uint64_t FreeMask{~0_u64};
@@ -546,8 +560,14 @@ struct BFChannelConfig {
  * more memory, while smaller values may need more iterations. The value needs
  * to be a sensible size, however, as it constrains the max stepping value used
  * for mixing, as well as the maximum number of samples per mixing iteration.
+ * It's set at build time with ALSOFT_BUFFER_SIZE, and is the same for every
+ * device. Mixing functions take channel buffers as ALfloat (*)[BUFFERSIZE],
+ * so it's the stride between channels, and the buffers can't be sized from
+ * a device's own period. Builds that only use small periods (e.g. hosts
+ * running many loopback devices) can lower it to cut the memory held by each
+ * device, effect slot, and limiter.
  */
-#define BUFFERSIZE 2048
+#define BUFFERSIZE ALSOFT_BUFFERSIZE
 
 struct MixParams {
     /* Coefficient channel mapping for mixing to the buffer. */
@@ -566,6 +586,27 @@ struct RealMixParams {
 
 using POSTPROCESS = void(*)(ALCdevice *device, const ALsizei SamplesToDo);
 
+/* Output for an additional listener of the device's contexts. It has its own
+ * copy of the device's mixing buffers, with the same channel layout, and of
+ * the post-process state, so it renders separately in the device format.
+ */
+struct ListenerOutput {
+    al::vector<std::array<ALfloat,BUFFERSIZE>, 16> MixBuffer;
+
+    std::unique_ptr<DirectHrtfState> mHrtfState;
+    std::unique_ptr<Uhj2Encoder> Uhj_Encoder;
+    std::unique_ptr<BFormatDec> AmbiDecoder;
+    std::unique_ptr<bs2b> Bs2b;
+    std::unique_ptr<AmbiUpsampler> AmbiUp;
+
+    ListenerOutput();
+    ListenerOutput(const ListenerOutput&) = delete;
+    ListenerOutput& operator=(const ListenerOutput&) = delete;
+    ~ListenerOutput();
+
+    DEF_NEWDEL(ListenerOutput)
+};
+
 struct ALCdevice {
     RefCount ref{1u};
 
@@ -607,6 +648,11 @@ struct ALCdevice {
     ALCuint NumStereoSources{};
     ALsizei NumAuxSends{};
 
+    /* Loads and evicts the sample data of file-backed buffers. Created on
+     * first use, and destroyed after the buffers.
+     */
+    std::unique_ptr<ResidencyManager> mResidency;
+
     // Map of Buffers for this device
     std::mutex BufferLock;
     al::vector<BufferSubList> BufferList;
@@ -632,7 +678,12 @@ struct ALCdevice {
     std::chrono::nanoseconds FixedLatency{0};
 
     /* Temp storage used for mixer processing. */
-    alignas(16) ALfloat TempBuffer[4][BUFFERSIZE];
+    alignas(16) ALfloat TempBuffer[2][BUFFERSIZE];
+    /* Each channel's source samples and resampled output for the voice being
+     * mixed, so multichannel voices can be resampled all at once.
+     */
+    alignas(16) ALfloat SourceData[MAX_INPUT_CHANNELS][BUFFERSIZE];
+    alignas(16) ALfloat ResampledData[MAX_INPUT_CHANNELS][BUFFERSIZE];
 
     /* Mixing buffer used by the Dry mix, FOAOut, and Real out. */
     al::vector<std::array<ALfloat,BUFFERSIZE>, 16> MixBuffer;
@@ -652,6 +703,12 @@ struct ALCdevice {
     /* HRTF state and info */
     std::unique_ptr<DirectHrtfState> mHrtfState;
     HrtfEntry *mHrtf{nullptr};
+    /* Reduce the IR length of quieter HRTF voices. */
+    bool mHrtfLod{false};
+    /* Fade between HRIRs by interpolating coefficients instead of
+     * cross-fading two convolutions.
+     */
+    bool mHrtfInterp{false};
 
     /* UHJ encoder state */
     std::unique_ptr<Uhj2Encoder> Uhj_Encoder;
@@ -667,6 +724,13 @@ struct ALCdevice {
 
     POSTPROCESS PostProcess{};
 
+    /* Outputs for the additional listeners of contexts created with
+     * ALC_MAX_LISTENERS_SOFT (loopback devices only). Listener N of each
+     * context mixes to ListenerOuts[N-1]. They don't get the stablizer,
+     * limiter, distance compensation, or dither below.
+     */
+    al::vector<std::unique_ptr<ListenerOutput>> ListenerOuts;
+
     std::unique_ptr<FrontStablizer> Stablizer;
 
     std::unique_ptr<Compressor> Limiter;
@@ -678,6 +742,9 @@ struct ALCdevice {
     ALfloat DitherDepth{0.0f};
     ALuint DitherSeed{0u};
 
+    /* Fades the output out and back in around a renderer swap. */
+    std::atomic<RenderFade> mRenderFade{RenderFade::None};
+
     /* Running count of the mixer invocations, in 31.1 fixed point. This
      * actually increments *twice* when mixing, first at the start and then at
      * the end, so the bottom bit indicates if the device is currently mixing
@@ -694,6 +761,10 @@ struct ALCdevice {
      */
     std::mutex StateLock;
     std::unique_ptr<BackendBase> Backend;
+    /* Held with the StateLock while alcReopenDeviceSOFT replaces the backend,
+     * so it can be locked without the StateLock (see DeviceBackendLock).
+     */
+    std::mutex BackendSwapLock;
 
     std::atomic<ALCdevice*> next{nullptr};
 
@@ -731,6 +802,8 @@ struct ALCdevice {
 
 #define RECORD_THREAD_NAME "alsoft-record"
 
+#define RESIDENCY_THREAD_NAME "alsoft-residency"
+
 
 enum {
     /* End event thread processing. */
@@ -14,6 +14,7 @@
 struct ALbuffer;
 struct ALsource;
 struct ALeffectslot;
+struct ALsubmixbus;
 
 
 struct ALbufferlistitem {
@@ -51,6 +52,10 @@ struct ALsource {
     ALboolean Looping;
     DistanceModel mDistanceModel;
     Resampler mResampler;
+    /* Set when the app specifies a resampler, otherwise the source follows
+     * the config's default when it's reloaded.
+     */
+    bool mResamplerSet;
     ALboolean DirectChannels;
     SpatializeMode mSpatialize;
 
@@ -70,6 +75,9 @@ struct ALsource {
 
     ALfloat Radius;
 
+    /* Submix bus the source mixes to instead of the device output. */
+    ALsubmixbus *Bus;
+
     /** Direct filter and auxiliary send info. */
     struct {
         ALfloat Gain;
@@ -0,0 +1,107 @@
+#ifndef _AL_SUBMIXBUS_H_
+#define _AL_SUBMIXBUS_H_
+
+#include <array>
+
+#include "alMain.h"
+#include "alu.h"
+#include "alAuxEffectSlot.h"
+#include "alFilter.h"
+#include "filters/biquad.h"
+
+#include "almalloc.h"
+#include "atomic.h"
+
+
+struct ALsubmixbus;
+
+using ALsubmixbusArray = al::FlexArray<ALsubmixbus*>;
+
+
+struct ALsubmixbusProps {
+    ALfloat Gain;
+    std::array<ALfloat,3> Position;
+    ALboolean Spatialize;
+
+    struct {
+        ALfloat Gain;
+        ALfloat GainHF;
+        ALfloat HFReference;
+        ALfloat GainLF;
+        ALfloat LFReference;
+    } Filter;
+
+    ALeffectslot *Slot;
+    ALfloat SendGain;
+
+    std::atomic<ALsubmixbusProps*> next;
+};
+
+
+struct ALsubmixbus {
+    ALfloat Gain{1.0f};
+    std::array<ALfloat,3> Position{{0.0f, 0.0f, 0.0f}};
+    ALboolean Spatialize{AL_FALSE};
+
+    struct {
+        ALfloat Gain{1.0f};
+        ALfloat GainHF{1.0f};
+        ALfloat HFReference{LOWPASSFREQREF};
+        ALfloat GainLF{1.0f};
+        ALfloat LFReference{HIGHPASSFREQREF};
+    } Filter;
+
+    ALeffectslot *Slot{nullptr};
+    ALfloat SendGain{1.0f};
+
+    std::atomic_flag PropsClean;
+
+    RefCount ref{0u};
+
+    std::atomic<ALsubmixbusProps*> Update{nullptr};
+
+    struct {
+        ALfloat Gain{1.0f};
+        std::array<ALfloat,3> Position{{0.0f, 0.0f, 0.0f}};
+        ALboolean Spatialize{AL_FALSE};
+        ALeffectslot *Slot{nullptr};
+        ALfloat SendGain{1.0f};
+
+        int FilterType{AF_None};
+        BiquadFilter LowPass[MAX_EFFECT_CHANNELS];
+        BiquadFilter HighPass[MAX_EFFECT_CHANNELS];
+
+        /* Gains for each input channel to the device's first-order output, and
+         * to the effect slot.
+         */
+        struct {
+            ALfloat Current[MAX_OUTPUT_CHANNELS];
+            ALfloat Target[MAX_OUTPUT_CHANNELS];
+        } Gains[MAX_EFFECT_CHANNELS], SendGains[MAX_EFFECT_CHANNELS];
+    } Params;
+
+    /* Self ID */
+    ALuint id{};
+
+    /* Sources mix to the bus as first-order B-Format, using the same ACN
+     * channel order and N3D scaling as an effect slot's wet buffer. So the bus
+     * can be panned as a whole like a B-Format source, or passed on to an
+     * effect slot as-is.
+     */
+    MixParams Mix;
+    alignas(16) ALfloat Buffer[MAX_EFFECT_CHANNELS][BUFFERSIZE];
+
+    ALsubmixbus();
+    ALsubmixbus(const ALsubmixbus&) = delete;
+    ALsubmixbus& operator=(const ALsubmixbus&) = delete;
+    ~ALsubmixbus();
+
+    static ALsubmixbusArray *CreatePtrArray(size_t count) noexcept;
+
+    DEF_NEWDEL(ALsubmixbus)
+};
+
+void UpdateSubmixBusProps(ALsubmixbus *bus, ALCcontext *context);
+void UpdateAllSubmixBusProps(ALCcontext *context);
+
+#endif
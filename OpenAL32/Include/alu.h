@@ -29,11 +29,12 @@ enum class DistanceModel;
 
 #define MAX_PITCH  255
 #define MAX_SENDS  16
+#define MAX_LISTENERS  4
 
 /* Maximum number of samples to pad on either end of a buffer for resampling.
  * Note that both the beginning and end need padding!
  */
-#define MAX_RESAMPLE_PADDING 24
+#define MAX_RESAMPLE_PADDING 48
 
 
 struct BSincTable;
@@ -41,6 +42,7 @@ struct ALsource;
 struct ALbufferlistitem;
 struct ALvoice;
 struct ALeffectslot;
+struct ALsubmixbus;
 
 
 #define DITHER_RNG_SEED 22222
@@ -58,10 +60,13 @@ enum Resampler {
     FIR4Resampler,
     BSinc12Resampler,
     BSinc24Resampler,
+    BSinc8Resampler,
+    BSinc48Resampler,
 
-    ResamplerMax = BSinc24Resampler
+    ResamplerMax = BSinc48Resampler
 };
-extern Resampler ResamplerDefault;
+/* May be changed by a config reload, so it's atomic. */
+extern std::atomic<Resampler> ResamplerDefault;
 
 /* The number of distinct scale and phase intervals within the bsinc filter
  * table.
@@ -93,11 +98,19 @@ union InterpState {
 using ResamplerFunc = const ALfloat*(*)(const InterpState *state,
     const ALfloat *RESTRICT src, ALsizei frac, ALint increment,
     ALfloat *RESTRICT dst, ALsizei dstlen);
+/* Resamples the first numchans lines of src together, starting at srcpos in
+ * each, so the sample positions and filter coefficients are only calculated
+ * once per output sample.
+ */
+using ResamplerMultiFunc = void(*)(const InterpState *state,
+    const ALfloat (*RESTRICT src)[BUFFERSIZE], const ALsizei srcpos, const ALsizei numchans,
+    ALsizei frac, ALint increment, ALfloat (*RESTRICT dst)[BUFFERSIZE], ALsizei dstlen);
 
 void BsincPrepare(const ALuint increment, BsincState *state, const BSincTable *table);
-
-extern const BSincTable bsinc12;
-extern const BSincTable bsinc24;
+/* Returns the bsinc table used by the given resampler, or null if it doesn't
+ * use one.
+ */
+const BSincTable *GetBSincTable(Resampler resampler);
 
 
 enum {
@@ -113,6 +126,10 @@ struct MixHrtfParams {
     ALsizei Delay[2];
     ALfloat Gain;
     ALfloat GainStep;
+    /* The number of IR samples to apply, which may be less than the state's
+     * IR size when using a reduced level of detail.
+     */
+    ALsizei IrSize;
 };
 
 
@@ -180,6 +197,8 @@ struct ALvoicePropsBase {
 
     ALfloat Radius;
 
+    ALsubmixbus *Bus;
+
     /** Direct filter and auxiliary send info. */
     struct {
         ALfloat Gain;
@@ -208,6 +227,8 @@ struct ALvoiceProps : public ALvoicePropsBase {
 #define VOICE_IS_FADING (1<<1) /* Fading sources use gain stepping for smooth transitions. */
 #define VOICE_HAS_HRTF  (1<<2)
 #define VOICE_HAS_NFC   (1<<3)
+#define VOICE_IS_CLUSTERED (1<<4) /* Direct path is premixed into a VoiceCluster. */
+#define VOICE_IS_BUSSED (1<<5) /* Direct path mixes to a submix bus. */
 
 struct ALvoice {
     std::atomic<ALvoiceProps*> Update{nullptr};
@@ -244,23 +265,48 @@ struct ALvoice {
     ALint Step;
 
     ResamplerFunc Resampler;
+    ResamplerMultiFunc ResamplerMulti;
 
     ALuint Flags;
 
     ALuint Offset; /* Number of output samples mixed since starting. */
 
+    /* For clustered voices, the index of the direction cluster and the
+     * listener-relative direction (+X right, +Y up, +Z front) contributed to
+     * its average.
+     */
+    ALsizei ClusterIdx;
+    std::array<ALfloat,3> ClusterDir;
+    /* The cluster the voice just left, if any, which its direct path fades
+     * out of over the next mix.
+     */
+    ALsizei PrevClusterIdx;
+    ALfloat PrevClusterGain;
+
     alignas(16) std::array<std::array<ALfloat,MAX_RESAMPLE_PADDING>,MAX_INPUT_CHANNELS> PrevSamples;
 
     InterpState ResampleState;
 
-    struct {
+    struct DirectData {
         int FilterType;
         DirectParams Params[MAX_INPUT_CHANNELS];
 
         ALfloat (*Buffer)[BUFFERSIZE];
         ALsizei Channels;
         ALsizei ChannelsPerOrder[MAX_AMBI_ORDER+1];
-    } Direct;
+    };
+    DirectData Direct;
+
+    /* Direct paths to the context's additional listeners, which mix the same
+     * resampled samples from their own viewpoint. Each has its own HRTF and
+     * NFC flags, and a null buffer if the voice isn't heard by it. Stored
+     * after the voice, following the sends.
+     */
+    struct ListenerData {
+        ALuint Flags;
+        DirectData Direct;
+    };
+    ListenerData *Listeners{nullptr};
 
     struct SendData {
         int FilterType;
@@ -285,6 +331,42 @@ struct ALvoice {
 void DeinitVoice(ALvoice *voice) noexcept;
 
 
+/* Distant voices arriving from around the same direction are premixed in mono
+ * and spatialized once as a group. The sphere is split into a fixed set of
+ * direction bins, one cluster each, so a cluster's panning and HRTF state
+ * carry over between updates while its members come and go.
+ */
+struct VoiceCluster {
+    alignas(16) ALfloat Buffer[1][BUFFERSIZE];
+
+    /* Gain-weighted sum of the member directions, and the number of members,
+     * for the current update.
+     */
+    std::array<ALfloat,3> Dir;
+    ALsizei NumVoices{0};
+
+    /* Set while the cluster is being mixed. It stays set for one update after
+     * the last member leaves, so the panning and HRTF response can finish.
+     */
+    bool Active{false};
+    /* Set when the HRTF target changed and needs to be blended in. */
+    bool Moved{false};
+
+    ALuint Offset{0u}; /* Number of output samples mixed since activating. */
+
+    struct {
+        HrtfParams Old;
+        HrtfParams Target;
+        HrtfState State;
+    } Hrtf;
+
+    struct {
+        ALfloat Current[MAX_OUTPUT_CHANNELS];
+        ALfloat Target[MAX_OUTPUT_CHANNELS];
+    } Gains;
+};
+
+
 using MixerFunc = void(*)(const ALfloat *data, const ALsizei OutChans,
     ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains,
     const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize);
@@ -340,8 +422,11 @@ enum HrtfRequestMode {
 void aluInit(void);
 
 void aluInitMixer(void);
+/* Reads the default resampler from the config. */
+void aluInitResampler(void);
 
 ResamplerFunc SelectResampler(Resampler resampler);
+ResamplerMultiFunc SelectResamplerMulti(Resampler resampler);
 
 /* aluInitRenderer
  *
@@ -350,6 +435,13 @@ ResamplerFunc SelectResampler(Resampler resampler);
  */
 void aluInitRenderer(ALCdevice *device, ALint hrtf_id, HrtfRequestMode hrtf_appreq, HrtfRequestMode hrtf_userreq);
 
+/* aluInitListenerOutput
+ *
+ * Sets up an additional listener's output to match the device's renderer,
+ * after it's been initialized.
+ */
+void aluInitListenerOutput(const ALCdevice *device, ListenerOutput *output);
+
 void aluInitEffectPanning(ALeffectslot *slot);
 
 void aluSelectPostProcess(ALCdevice *device);
@@ -434,13 +526,38 @@ void ComputePanGains(const ALeffectslot *slot, const ALfloat*RESTRICT coeffs, AL
 
 
 ALboolean MixSource(ALvoice *voice, const ALuint SourceID, ALCcontext *Context, const ALsizei SamplesToDo);
+/* Spatializes a cluster's premixed mono input to the device output. */
+void MixVoiceCluster(VoiceCluster *cluster, ALCdevice *Device, const ALsizei SamplesToDo);
+/* Filters a submix bus and mixes it to the device output and its effect slot. */
+void MixSubmixBus(ALsubmixbus *bus, ALCdevice *Device, const ALsizei SamplesToDo);
 
 void aluMixData(ALCdevice *device, ALvoid *OutBuffer, ALsizei NumSamples);
+/* Mixes like aluMixData, with a buffer for each listener's output. The first
+ * buffer is for the main listener, and the rest are for the additional
+ * listeners. Null buffers are skipped.
+ */
+void aluMixListenerData(ALCdevice *device, ALvoid *const *OutBuffers, ALsizei NumBuffers,
+    ALsizei NumSamples);
 /* Caller must lock the device state, and the mixer must not be running. */
 void aluHandleDisconnect(ALCdevice *device, const char *msg, ...) DECL_FORMAT(printf, 2, 3);
 
-extern MixerFunc MixSamples;
-extern RowMixerFunc MixRowSamples;
+/* Mixers indexed by channel count. Common channel counts get kernels
+ * specialized for that count, set up with the rest of the mixer functions.
+ */
+extern MixerFunc ChanMixers[MAX_OUTPUT_CHANNELS+1];
+extern RowMixerFunc ChanRowMixers[MAX_OUTPUT_CHANNELS+1];
+
+inline void MixSamples(const ALfloat *data, const ALsizei OutChans,
+    ALfloat (*OutBuffer)[BUFFERSIZE], ALfloat *CurrentGains, const ALfloat *TargetGains,
+    const ALsizei Counter, const ALsizei OutPos, const ALsizei BufferSize)
+{
+    ChanMixers[OutChans](data, OutChans, OutBuffer, CurrentGains, TargetGains, Counter, OutPos,
+        BufferSize);
+}
+inline void MixRowSamples(ALfloat *OutBuffer, const ALfloat *gains,
+    const ALfloat (*data)[BUFFERSIZE], const ALsizei InChans, const ALsizei InPos,
+    const ALsizei BufferSize)
+{ ChanRowMixers[InChans](OutBuffer, gains, data, InChans, InPos, BufferSize); }
 
 extern const ALfloat ConeScale;
 extern const ALfloat ZScale;
@@ -16,8 +16,100 @@ void Convert_ALshort_ALima4(ALshort *dst, const ALubyte *src, ALsizei numchans,
 void Convert_ALshort_ALmsadpcm(ALshort *dst, const ALubyte *src, ALsizei numchans, ALsizei len,
                                ALsizei align);
 
+/* Decodes count blocks of ADPCM data, starting with block first, to
+ * interleaved 16-bit samples. src is the start of the encoded data and dst
+ * receives count*align sample frames. Lets a caller decode just the range of
+ * blocks it needs (e.g. when streaming or decoding on the fly).
+ */
+void Decode_ALshort_ALima4(ALshort *dst, const ALubyte *src, ALsizei numchans, ALsizei align,
+                           ALsizei first, ALsizei count);
+void Decode_ALshort_ALmsadpcm(ALshort *dst, const ALubyte *src, ALsizei numchans,
+                              ALsizei align, ALsizei first, ALsizei count);
+
+/* Size in bytes of one block of encoded data, given the number of channels
+ * and the number of sample frames per block.
+ */
+inline ALsizei IMA4BlockSize(ALsizei numchans, ALsizei align)
+{ return ((align-1)/2 + 4) * numchans; }
+inline ALsizei MSADPCMBlockSize(ALsizei numchans, ALsizei align)
+{ return ((align-2)/2 + 7) * numchans; }
+
 #ifdef __cplusplus
 } // extern "C"
+
+/* Number of independent ADPCM streams (one channel of one block) decoded in
+ * parallel by the lane decoders.
+ */
+#define ADPCM_LANES 4
+
+extern const ALint IMAStep_size[89];
+extern const ALint IMA4Codeword[16];
+extern const ALint IMA4Index_adjust[16];
+extern const ALint MSADPCMAdaption[16];
+extern const ALint MSADPCMAdaptionCoeff[7][2];
+
+struct IMA4LaneState {
+    alignas(16) ALint Sample[ADPCM_LANES];
+    alignas(16) ALint Index[ADPCM_LANES];
+};
+
+struct MSADPCMLaneState {
+    alignas(16) ALint Coeff[2][ADPCM_LANES];
+    alignas(16) ALint Delta[ADPCM_LANES];
+    /* The last two decoded samples, most recent first. */
+    alignas(16) ALint Samples[2][ADPCM_LANES];
+};
+
+/* Decodes count nibbles for each lane, continuing from the given state. The
+ * nibbles and output samples are arranged with each lane's value for a given
+ * sample next to each other.
+ */
+using IMA4DecodeLanesFunc = void(*)(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], IMA4LaneState *RESTRICT state,
+    const ALsizei count);
+using MSADPCMDecodeLanesFunc = void(*)(ALshort (*RESTRICT dst)[ADPCM_LANES],
+    const ALubyte (*RESTRICT nibbles)[ADPCM_LANES], MSADPCMLaneState *RESTRICT state,
+    const ALsizei count);
+
+extern IMA4DecodeLanesFunc DecodeIMA4Lanes;
+extern MSADPCMDecodeLanesFunc DecodeMSADPCMLanes;
+
+
+/* Converts an IEEE half-precision float to single precision. The exponent is
+ * rebiased with integer math and denormals are renormalized with a float
+ * subtraction, so this stays exact even when denormals are flushed to zero.
+ */
+inline ALfloat HalfToFloat(const ALushort val) noexcept
+{
+    constexpr ALuint shifted_exp{0x7c00u << 13};
+    union {
+        ALuint u;
+        ALfloat f;
+    } ret, magic;
+    magic.u = 113u << 23;
+
+    ret.u = static_cast<ALuint>(val&0x7fffu) << 13;
+    const ALuint exp{ret.u & shifted_exp};
+    ret.u += (127u-15u) << 23;
+    if(exp == shifted_exp) /* Inf/NaN */
+        ret.u += (128u-16u) << 23;
+    else if(exp == 0) /* Zero/Denormal */
+    {
+        ret.u += 1u << 23;
+        ret.f -= magic.f;
+    }
+    ret.u |= static_cast<ALuint>(val&0x8000u) << 16;
+    return ret.f;
+}
+
+/* Converts half-float samples, read srcstep values apart, and adds them to
+ * dst.
+ */
+using HalfLoadFunc = void(*)(ALfloat *RESTRICT dst, const ALushort *RESTRICT src,
+    const ALint srcstep, const ALsizei samples);
+
+extern HalfLoadFunc LoadHalfSamples;
+
 #endif
 
 #endif /* SAMPLE_CVT_H */
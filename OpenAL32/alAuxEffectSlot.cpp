@@ -204,6 +204,9 @@ AL_API ALvoid AL_APIENTRY alGenAuxiliaryEffectSlots(ALsizei n, ALuint *effectslo
         SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Generating %d effect slots", n);
     if(n == 0) return;
 
+    /* The mixer releases replaced effect states through the event thread. */
+    StartEventThrd(context.get());
+
     std::unique_lock<std::mutex> slotlock{context->EffectSlotLock};
     ALCdevice *device{context->Device};
     for(ALsizei cur{0};cur < n;cur++)
@@ -38,7 +38,9 @@
 #include "alu.h"
 #include "alError.h"
 #include "alBuffer.h"
+#include "alconfig.h"
 #include "sample_cvt.h"
+#include "residency.h"
 
 
 namespace {
@@ -173,6 +175,8 @@ const ALchar *NameFromUserFmtType(UserFmtType type)
     case UserFmtDouble: return "Float64";
     case UserFmtMulaw: return "muLaw";
     case UserFmtAlaw: return "aLaw";
+    case UserFmtHalf: return "Float16";
+    case UserFmtPacked24: return "Packed 24-bit";
     case UserFmtIMA4: return "IMA4 ADPCM";
     case UserFmtMSADPCM: return "MSADPCM";
     }
@@ -218,6 +222,8 @@ void LoadData(ALCcontext *context, ALbuffer *ALBuf, ALuint freq, ALsizei size, U
     case UserFmtDouble: DstType = FmtDouble; break;
     case UserFmtAlaw: DstType = FmtAlaw; break;
     case UserFmtMulaw: DstType = FmtMulaw; break;
+    case UserFmtHalf: DstType = FmtHalf; break;
+    case UserFmtPacked24: DstType = FmtPacked24; break;
     case UserFmtIMA4: DstType = FmtShort; break;
     case UserFmtMSADPCM: DstType = FmtShort; break;
     }
@@ -285,9 +291,10 @@ void LoadData(ALCcontext *context, ALbuffer *ALBuf, ALuint freq, ALsizei size, U
      */
     if(LIKELY(newsize <= std::numeric_limits<ALsizei>::max()-15))
         newsize = (newsize+15) & ~0xf;
+    ALBuf->mResidency = nullptr;
     if(newsize != ALBuf->BytesAlloc)
     {
-        al::vector<ALbyte,16> newdata(newsize);
+        al::large_vector<ALbyte,16> newdata(newsize);
         if((access&AL_PRESERVE_DATA_BIT_SOFT))
         {
             ALsizei tocopy{std::min(newsize, ALBuf->BytesAlloc)};
@@ -333,6 +340,77 @@ void LoadData(ALCcontext *context, ALbuffer *ALBuf, ALuint freq, ALsizei size, U
     ALBuf->LoopEnd = ALBuf->SampleLen;
 }
 
+/*
+ * LoadFileData
+ *
+ * Sets the buffer to read samples of the specified format from a file as
+ * needed, instead of holding them all in memory.
+ */
+void LoadFileData(ALCcontext *context, ALbuffer *ALBuf, ALuint freq, const ALchar *filename, ALsizei offset, ALsizei size, UserFmtChannels SrcChannels, UserFmtType SrcType)
+{
+    if(UNLIKELY(ReadRef(&ALBuf->ref) != 0 || ALBuf->MappedAccess != 0))
+        SETERR_RETURN(context, AL_INVALID_OPERATION,, "Modifying storage for in-use buffer %u",
+                      ALBuf->id);
+
+    /* The samples are read directly into the pages the mixer uses, so they
+     * can't be compressed formats that need converting.
+     */
+    if(UNLIKELY(SrcType == UserFmtIMA4 || SrcType == UserFmtMSADPCM))
+        SETERR_RETURN(context, AL_INVALID_VALUE,, "%s samples cannot be read from a file",
+                      NameFromUserFmtType(SrcType));
+    const auto DstChannels = static_cast<FmtChannels>(SrcChannels);
+    const auto DstType = static_cast<FmtType>(SrcType);
+
+    const ALsizei FrameSize{FrameSizeFromUserFmt(SrcChannels, SrcType)};
+    if(UNLIKELY((size%FrameSize) != 0))
+        SETERR_RETURN(context, AL_INVALID_VALUE,,
+            "Data size %d is not a multiple of frame size %d", size, FrameSize);
+    const ALsizei frames{size / FrameSize};
+
+    ALCdevice *device{context->Device};
+    if(!device->mResidency)
+    {
+        ALuint budget{256u};
+        ALuint prefetch{500u};
+        ConfigValueUInt(device->DeviceName.c_str(), nullptr, "residency-budget", &budget);
+        ConfigValueUInt(device->DeviceName.c_str(), nullptr, "residency-prefetch", &prefetch);
+        try {
+            device->mResidency.reset(new ResidencyManager{device, size_t{budget}<<20, prefetch});
+        }
+        catch(std::exception &e) {
+            SETERR_RETURN(context, AL_OUT_OF_MEMORY,, "Failed to start residency thread: %s",
+                          e.what());
+        }
+        TRACE("Residency budget %uMB, prefetching %ums\n", budget, prefetch);
+    }
+    ResidencyManager *manager{device->mResidency.get()};
+
+    const auto prefetch = static_cast<ALsizei>(std::min<uint64_t>(
+        uint64_t{manager->prefetchMs()} * freq / 1000, std::numeric_limits<ALsizei>::max()/2));
+    std::unique_ptr<BufferResidency> residency{new BufferResidency{manager, filename, offset,
+        FrameSize, frames, prefetch}};
+    if(UNLIKELY(!residency->init()))
+        SETERR_RETURN(context, AL_INVALID_VALUE,, "Failed to read %d bytes at offset %d from %s",
+                      size, offset, filename);
+
+    ALBuf->mData = al::large_vector<ALbyte,16>{};
+    ALBuf->BytesAlloc = 0;
+    ALBuf->mResidency = std::move(residency);
+
+    ALBuf->OriginalSize = size;
+    ALBuf->OriginalType = SrcType;
+    ALBuf->OriginalAlign = 1;
+
+    ALBuf->Frequency = freq;
+    ALBuf->mFmtChannels = DstChannels;
+    ALBuf->mFmtType = DstType;
+    ALBuf->Access = 0;
+
+    ALBuf->SampleLen = frames;
+    ALBuf->LoopStart = 0;
+    ALBuf->LoopEnd = ALBuf->SampleLen;
+}
+
 using DecompResult = std::tuple<bool, UserFmtChannels, UserFmtType>;
 DecompResult DecomposeUserFormat(ALenum format)
 {
@@ -341,7 +419,7 @@ DecompResult DecomposeUserFormat(ALenum format)
         UserFmtChannels channels;
         UserFmtType type;
     };
-    static constexpr std::array<FormatMap,46> UserFmtList{{
+    static constexpr std::array<FormatMap,58> UserFmtList{{
         { AL_FORMAT_MONO8,             UserFmtMono, UserFmtUByte   },
         { AL_FORMAT_MONO16,            UserFmtMono, UserFmtShort   },
         { AL_FORMAT_MONO_FLOAT32,      UserFmtMono, UserFmtFloat   },
@@ -350,6 +428,8 @@ DecompResult DecomposeUserFormat(ALenum format)
         { AL_FORMAT_MONO_MSADPCM_SOFT, UserFmtMono, UserFmtMSADPCM },
         { AL_FORMAT_MONO_MULAW,        UserFmtMono, UserFmtMulaw   },
         { AL_FORMAT_MONO_ALAW_EXT,     UserFmtMono, UserFmtAlaw    },
+        { AL_FORMAT_MONO_HALF_SOFT,    UserFmtMono, UserFmtHalf    },
+        { AL_FORMAT_MONO24_SOFT,       UserFmtMono, UserFmtPacked24 },
 
         { AL_FORMAT_STEREO8,             UserFmtStereo, UserFmtUByte   },
         { AL_FORMAT_STEREO16,            UserFmtStereo, UserFmtShort   },
@@ -359,6 +439,8 @@ DecompResult DecomposeUserFormat(ALenum format)
         { AL_FORMAT_STEREO_MSADPCM_SOFT, UserFmtStereo, UserFmtMSADPCM },
         { AL_FORMAT_STEREO_MULAW,        UserFmtStereo, UserFmtMulaw   },
         { AL_FORMAT_STEREO_ALAW_EXT,     UserFmtStereo, UserFmtAlaw    },
+        { AL_FORMAT_STEREO_HALF_SOFT,    UserFmtStereo, UserFmtHalf    },
+        { AL_FORMAT_STEREO24_SOFT,       UserFmtStereo, UserFmtPacked24 },
 
         { AL_FORMAT_REAR8,      UserFmtRear, UserFmtUByte },
         { AL_FORMAT_REAR16,     UserFmtRear, UserFmtShort },
@@ -377,6 +459,8 @@ DecompResult DecomposeUserFormat(ALenum format)
         { AL_FORMAT_51CHN16,     UserFmtX51, UserFmtShort },
         { AL_FORMAT_51CHN32,     UserFmtX51, UserFmtFloat },
         { AL_FORMAT_51CHN_MULAW, UserFmtX51, UserFmtMulaw },
+        { AL_FORMAT_51CHN_HALF_SOFT, UserFmtX51, UserFmtHalf },
+        { AL_FORMAT_51CHN24_SOFT,    UserFmtX51, UserFmtPacked24 },
 
         { AL_FORMAT_61CHN8,      UserFmtX61, UserFmtUByte },
         { AL_FORMAT_61CHN16,     UserFmtX61, UserFmtShort },
@@ -387,16 +471,22 @@ DecompResult DecomposeUserFormat(ALenum format)
         { AL_FORMAT_71CHN16,     UserFmtX71, UserFmtShort },
         { AL_FORMAT_71CHN32,     UserFmtX71, UserFmtFloat },
         { AL_FORMAT_71CHN_MULAW, UserFmtX71, UserFmtMulaw },
+        { AL_FORMAT_71CHN_HALF_SOFT, UserFmtX71, UserFmtHalf },
+        { AL_FORMAT_71CHN24_SOFT,    UserFmtX71, UserFmtPacked24 },
 
         { AL_FORMAT_BFORMAT2D_8,       UserFmtBFormat2D, UserFmtUByte },
         { AL_FORMAT_BFORMAT2D_16,      UserFmtBFormat2D, UserFmtShort },
         { AL_FORMAT_BFORMAT2D_FLOAT32, UserFmtBFormat2D, UserFmtFloat },
         { AL_FORMAT_BFORMAT2D_MULAW,   UserFmtBFormat2D, UserFmtMulaw },
+        { AL_FORMAT_BFORMAT2D_HALF_SOFT, UserFmtBFormat2D, UserFmtHalf },
+        { AL_FORMAT_BFORMAT2D_24_SOFT,   UserFmtBFormat2D, UserFmtPacked24 },
 
         { AL_FORMAT_BFORMAT3D_8,       UserFmtBFormat3D, UserFmtUByte },
         { AL_FORMAT_BFORMAT3D_16,      UserFmtBFormat3D, UserFmtShort },
         { AL_FORMAT_BFORMAT3D_FLOAT32, UserFmtBFormat3D, UserFmtFloat },
         { AL_FORMAT_BFORMAT3D_MULAW,   UserFmtBFormat3D, UserFmtMulaw },
+        { AL_FORMAT_BFORMAT3D_HALF_SOFT, UserFmtBFormat3D, UserFmtHalf },
+        { AL_FORMAT_BFORMAT3D_24_SOFT,   UserFmtBFormat3D, UserFmtPacked24 },
     }};
 
     DecompResult ret{};
@@ -555,6 +645,40 @@ AL_API void AL_APIENTRY alBufferStorageSOFT(ALuint buffer, ALenum format, const
     }
 }
 
+AL_API void AL_APIENTRY alBufferFileSOFT(ALuint buffer, ALenum format, const ALchar *filename, ALsizei offset, ALsizei size, ALsizei freq)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    ALCdevice *device = context->Device;
+    std::lock_guard<std::mutex> _{device->BufferLock};
+
+    ALbuffer *albuf = LookupBuffer(device, buffer);
+    if(UNLIKELY(!albuf))
+        alSetError(context.get(), AL_INVALID_NAME, "Invalid buffer ID %u", buffer);
+    else if(UNLIKELY(!filename))
+        alSetError(context.get(), AL_INVALID_VALUE, "NULL filename");
+    else if(UNLIKELY(offset < 0))
+        alSetError(context.get(), AL_INVALID_VALUE, "Negative file offset %d", offset);
+    else if(UNLIKELY(size < 1))
+        alSetError(context.get(), AL_INVALID_VALUE, "Invalid data size %d", size);
+    else if(UNLIKELY(freq < 1))
+        alSetError(context.get(), AL_INVALID_VALUE, "Invalid sample rate %d", freq);
+    else
+    {
+        UserFmtType srctype{UserFmtUByte};
+        UserFmtChannels srcchannels{UserFmtMono};
+        bool success;
+
+        std::tie(success, srcchannels, srctype) = DecomposeUserFormat(format);
+        if(UNLIKELY(!success))
+            alSetError(context.get(), AL_INVALID_ENUM, "Invalid format 0x%04x", format);
+        else
+            LoadFileData(context.get(), albuf, freq, filename, offset, size, srcchannels,
+                srctype);
+    }
+}
+
 AL_API void* AL_APIENTRY alMapBufferSOFT(ALuint buffer, ALsizei offset, ALsizei length, ALbitfieldSOFT access)
 {
     ContextRef context{GetContextRef()};
@@ -697,6 +821,9 @@ AL_API ALvoid AL_APIENTRY alBufferSubDataSOFT(ALuint buffer, ALenum format, cons
     else if(UNLIKELY(albuf->MappedAccess != 0))
         alSetError(context.get(), AL_INVALID_OPERATION, "Unpacking data into mapped buffer %u",
                 buffer);
+    else if(UNLIKELY(albuf->mResidency != nullptr))
+        alSetError(context.get(), AL_INVALID_OPERATION,
+                "Unpacking data into file-backed buffer %u", buffer);
     else
     {
         ALsizei num_chans{ChannelsFromFmt(albuf->mFmtChannels)};
@@ -1119,6 +1246,8 @@ ALsizei BytesFromUserFmt(UserFmtType type)
     case UserFmtDouble: return sizeof(ALdouble);
     case UserFmtMulaw: return sizeof(ALubyte);
     case UserFmtAlaw: return sizeof(ALubyte);
+    case UserFmtHalf: return sizeof(ALushort);
+    case UserFmtPacked24: return sizeof(ALpacked24);
     case UserFmtIMA4: break; /* not handled here */
     case UserFmtMSADPCM: break; /* not handled here */
     }
@@ -1151,6 +1280,8 @@ ALsizei BytesFromFmt(FmtType type)
     case FmtDouble: return sizeof(ALdouble);
     case FmtMulaw: return sizeof(ALubyte);
     case FmtAlaw: return sizeof(ALubyte);
+    case FmtHalf: return sizeof(ALushort);
+    case FmtPacked24: return sizeof(ALpacked24);
     }
     return 0;
 }
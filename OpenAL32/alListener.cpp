@@ -31,7 +31,7 @@
 
 #define DO_UPDATEPROPS() do {                                                 \
     if(!context->DeferUpdates.load(std::memory_order_acquire))                \
-        UpdateListenerProps(context.get());                                   \
+        UpdateListenerProps(&listener, context.get());                        \
     else                                                                      \
         listener.PropsClean.clear(std::memory_order_release);                 \
 } while(0)
@@ -42,8 +42,8 @@ AL_API ALvoid AL_APIENTRY alListenerf(ALenum param, ALfloat value)
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     switch(param)
     {
     case AL_GAIN:
@@ -75,8 +75,8 @@ AL_API ALvoid AL_APIENTRY alListener3f(ALenum param, ALfloat value1, ALfloat val
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     switch(param)
     {
     case AL_POSITION:
@@ -124,8 +124,8 @@ AL_API ALvoid AL_APIENTRY alListenerfv(ALenum param, const ALfloat *values)
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!values) SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "NULL pointer");
     switch(param)
     {
@@ -228,8 +228,8 @@ AL_API ALvoid AL_APIENTRY alGetListenerf(ALenum param, ALfloat *value)
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!value)
         alSetError(context.get(), AL_INVALID_VALUE, "NULL pointer");
     else switch(param)
@@ -253,8 +253,8 @@ AL_API ALvoid AL_APIENTRY alGetListener3f(ALenum param, ALfloat *value1, ALfloat
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!value1 || !value2 || !value3)
         alSetError(context.get(), AL_INVALID_VALUE, "NULL pointer");
     else switch(param)
@@ -295,8 +295,8 @@ AL_API ALvoid AL_APIENTRY alGetListenerfv(ALenum param, ALfloat *values)
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!values)
         alSetError(context.get(), AL_INVALID_VALUE, "NULL pointer");
     else switch(param)
@@ -338,8 +338,8 @@ AL_API void AL_APIENTRY alGetListener3i(ALenum param, ALint *value1, ALint *valu
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!value1 || !value2 || !value3)
         alSetError(context.get(), AL_INVALID_VALUE, "NULL pointer");
     else switch(param)
@@ -375,8 +375,8 @@ AL_API void AL_APIENTRY alGetListeneriv(ALenum param, ALint* values)
     ContextRef context{GetContextRef()};
     if(UNLIKELY(!context)) return;
 
-    ALlistener &listener = context->Listener;
     std::lock_guard<std::mutex> _{context->PropLock};
+    ALlistener &listener = context->getListener(context->SelectedListener);
     if(!values)
         alSetError(context.get(), AL_INVALID_VALUE, "NULL pointer");
     else switch(param)
@@ -397,7 +397,20 @@ AL_API void AL_APIENTRY alGetListeneriv(ALenum param, ALint* values)
 }
 
 
-void UpdateListenerProps(ALCcontext *context)
+AL_API void AL_APIENTRY alSelectListenerSOFT(ALsizei index)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->PropLock};
+    if(!(index >= 0 && index < context->NumListeners))
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Listener index %d out of range",
+            index);
+    context->SelectedListener = index;
+}
+
+
+void UpdateListenerProps(ALlistener *listener, ALCcontext *context)
 {
     /* Get an unused proprty container, or allocate a new one as needed. */
     ALlistenerProps *props{context->FreeListenerProps.load(std::memory_order_acquire)};
@@ -413,15 +426,14 @@ void UpdateListenerProps(ALCcontext *context)
     }
 
     /* Copy in current property values. */
-    ALlistener &listener = context->Listener;
-    props->Position = listener.Position;
-    props->Velocity = listener.Velocity;
-    props->OrientAt = listener.OrientAt;
-    props->OrientUp = listener.OrientUp;
-    props->Gain = listener.Gain;
+    props->Position = listener->Position;
+    props->Velocity = listener->Velocity;
+    props->OrientAt = listener->OrientAt;
+    props->OrientUp = listener->OrientUp;
+    props->Gain = listener->Gain;
 
     /* Set the new container for updating internal parameters. */
-    props = listener.Update.exchange(props, std::memory_order_acq_rel);
+    props = listener->Update.exchange(props, std::memory_order_acq_rel);
     if(props)
     {
         /* If there was an unused update container, put it back in the
@@ -430,3 +442,13 @@ void UpdateListenerProps(ALCcontext *context)
         AtomicReplaceHead(context->FreeListenerProps, props);
     }
 }
+
+void UpdateAllListenerProps(ALCcontext *context)
+{
+    for(ALsizei i{0};i < context->NumListeners;i++)
+    {
+        ALlistener &listener = context->getListener(i);
+        if(!listener.PropsClean.test_and_set(std::memory_order_acq_rel))
+            UpdateListenerProps(&listener, context);
+    }
+}
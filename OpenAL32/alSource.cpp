@@ -40,6 +40,7 @@
 #include "alBuffer.h"
 #include "alFilter.h"
 #include "alAuxEffectSlot.h"
+#include "alSubmixBus.h"
 #include "ringbuffer.h"
 
 #include "backends/base.h"
@@ -116,6 +117,8 @@ void UpdateSourceProps(const ALsource *source, ALvoice *voice, ALCcontext *conte
 
     props->Radius = source->Radius;
 
+    props->Bus = source->Bus;
+
     props->Direct.Gain = source->Direct.Gain;
     props->Direct.GainHF = source->Direct.GainHF;
     props->Direct.HFReference = source->Direct.HFReference;
@@ -526,7 +529,7 @@ void FreeSource(ALCcontext *context, ALsource *source)
     ALsizei slidx = id & 0x3f;
 
     ALCdevice *device{context->Device};
-    BackendUniqueLock backlock{*device->Backend};
+    DeviceBackendLock backlock{device};
     if(ALvoice *voice{GetSourceVoice(source, context)})
     {
         voice->SourceID.store(0u, std::memory_order_relaxed);
@@ -588,6 +591,14 @@ inline ALeffectslot *LookupEffectSlot(ALCcontext *context, ALuint id) noexcept
     return context->EffectSlotList[id].get();
 }
 
+inline ALsubmixbus *LookupSubmixBus(ALCcontext *context, ALuint id) noexcept
+{
+    --id;
+    if(UNLIKELY(id >= context->SubmixBusList.size()))
+        return nullptr;
+    return context->SubmixBusList[id].get();
+}
+
 
 enum SourceProp : ALenum {
     srcPitch = AL_PITCH,
@@ -655,6 +666,9 @@ enum SourceProp : ALenum {
     /* ALC_SOFT_device_clock */
     srcSampleOffsetClockSOFT = AL_SAMPLE_OFFSET_CLOCK_SOFT,
     srcSecOffsetClockSOFT = AL_SEC_OFFSET_CLOCK_SOFT,
+
+    /* AL_SOFT_submix_bus */
+    srcSubmixBus = AL_SUBMIX_BUS_SOFT,
 };
 
 /**
@@ -761,6 +775,7 @@ ALint FloatValsByProp(ALenum prop)
             break; /* Double only */
 
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
         case AL_AUXILIARY_SEND_FILTER:
             break; /* i/i64 only */
@@ -821,6 +836,7 @@ ALint DoubleValsByProp(ALenum prop)
             return 6;
 
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
         case AL_AUXILIARY_SEND_FILTER:
             break; /* i/i64 only */
@@ -860,6 +876,7 @@ ALint IntValsByProp(ALenum prop)
         case AL_SOURCE_RELATIVE:
         case AL_LOOPING:
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_SOURCE_STATE:
         case AL_BUFFERS_QUEUED:
         case AL_BUFFERS_PROCESSED:
@@ -919,6 +936,7 @@ ALint Int64ValsByProp(ALenum prop)
         case AL_SOURCE_RELATIVE:
         case AL_LOOPING:
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_SOURCE_STATE:
         case AL_BUFFERS_QUEUED:
         case AL_BUFFERS_PROCESSED:
@@ -1094,7 +1112,7 @@ ALboolean SetSourcefv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
             if(IsPlayingOrPaused(Source))
             {
                 ALCdevice *device{Context->Device};
-                BackendLockGuard _{*device->Backend};
+                DeviceBackendLock _{device};
                 /* Double-check that the source is still playing while we have
                  * the lock.
                  */
@@ -1183,6 +1201,7 @@ ALboolean SetSourcefv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
             return SetSourceiv(Source, Context, prop, &ival);
 
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
         case AL_AUXILIARY_SEND_FILTER:
         case AL_SAMPLE_OFFSET_LATENCY_SOFT:
@@ -1200,8 +1219,10 @@ ALboolean SetSourceiv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
     ALbuffer *buffer{nullptr};
     ALfilter *filter{nullptr};
     ALeffectslot *slot{nullptr};
+    ALsubmixbus *bus{nullptr};
     ALbufferlistitem *oldlist{nullptr};
     std::unique_lock<std::mutex> slotlock;
+    std::unique_lock<std::mutex> buslock;
     std::unique_lock<std::mutex> filtlock;
     std::unique_lock<std::mutex> buflock;
     ALfloat fvals[6];
@@ -1315,7 +1336,7 @@ ALboolean SetSourceiv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
             if(IsPlayingOrPaused(Source))
             {
                 ALCdevice *device{Context->Device};
-                BackendLockGuard _{*device->Backend};
+                DeviceBackendLock _{device};
                 if(ALvoice *voice{GetSourceVoice(Source, Context)})
                 {
                     if(ApplyOffset(Source, voice) == AL_FALSE)
@@ -1397,6 +1418,7 @@ ALboolean SetSourceiv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
             CHECKVAL(*values >= 0 && *values <= ResamplerMax);
 
             Source->mResampler = static_cast<Resampler>(*values);
+            Source->mResamplerSet = true;
             DO_UPDATEPROPS();
             return AL_TRUE;
 
@@ -1466,6 +1488,33 @@ ALboolean SetSourceiv(ALsource *Source, ALCcontext *Context, SourceProp prop, co
 
             return AL_TRUE;
 
+        case AL_SUBMIX_BUS_SOFT:
+            buslock = std::unique_lock<std::mutex>{Context->SubmixBusLock};
+            if(!(*values == 0 || (bus=LookupSubmixBus(Context, *values)) != nullptr))
+                SETERR_RETURN(Context, AL_INVALID_VALUE, AL_FALSE, "Invalid submix bus ID %u",
+                              *values);
+
+            if(bus) IncrementRef(&bus->ref);
+            if(Source->Bus)
+                DecrementRef(&Source->Bus->ref);
+            if(bus != Source->Bus && IsPlayingOrPaused(Source))
+            {
+                Source->Bus = bus;
+
+                /* We must force an update if the bus changed on an active
+                 * source, in case the old bus is about to be deleted.
+                 */
+                ALvoice *voice{GetSourceVoice(Source, Context)};
+                if(voice) UpdateSourceProps(Source, voice, Context);
+                else Source->PropsClean.clear(std::memory_order_release);
+            }
+            else
+            {
+                Source->Bus = bus;
+                DO_UPDATEPROPS();
+            }
+            return AL_TRUE;
+
 
         /* 1x float */
         case AL_CONE_INNER_ANGLE:
@@ -1555,6 +1604,7 @@ ALboolean SetSourcei64v(ALsource *Source, ALCcontext *Context, SourceProp prop,
 
         /* 1x uint */
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
             CHECKVAL(*values <= UINT_MAX && *values >= 0);
 
@@ -1782,6 +1832,7 @@ ALboolean GetSourcedv(ALsource *Source, ALCcontext *Context, SourceProp prop, AL
             return err;
 
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
         case AL_AUXILIARY_SEND_FILTER:
         case AL_SAMPLE_OFFSET_LATENCY_SOFT:
@@ -1816,6 +1867,10 @@ ALboolean GetSourceiv(ALsource *Source, ALCcontext *Context, SourceProp prop, AL
                       BufferList->buffers[0]->id : 0;
             return AL_TRUE;
 
+        case AL_SUBMIX_BUS_SOFT:
+            *values = Source->Bus ? static_cast<ALint>(Source->Bus->id) : 0;
+            return AL_TRUE;
+
         case AL_SOURCE_STATE:
             *values = GetSourceState(Source, GetSourceVoice(Source, Context));
             return AL_TRUE;
@@ -2066,6 +2121,7 @@ ALboolean GetSourcei64v(ALsource *Source, ALCcontext *Context, SourceProp prop,
 
         /* 1x uint */
         case AL_BUFFER:
+        case AL_SUBMIX_BUS_SOFT:
         case AL_DIRECT_FILTER:
             if((err=GetSourceiv(Source, Context, prop, ivals)) != AL_FALSE)
                 *values = static_cast<ALuint>(ivals[0]);
@@ -2667,6 +2723,113 @@ AL_API void AL_APIENTRY alGetSourcei64vSOFT(ALuint source, ALenum param, ALint64
         GetSourcei64v(Source, context.get(), static_cast<SourceProp>(param), values);
 }
 
+AL_API void AL_APIENTRY alGetSourceStatusvSOFT(ALsizei n, const ALuint *sources, ALint *states, ALint *processed, ALint64SOFT *offsets, ALint64SOFT *latency)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    if(n < 0)
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Getting status of %d sources", n);
+    if(n > 0 && !sources)
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "NULL pointer");
+
+    std::lock_guard<std::mutex> _{context->SourceLock};
+    auto sources_end = sources+n;
+    auto bad_sid = std::find_if_not(sources, sources_end,
+        [&context](ALuint sid) -> bool
+        {
+            ALsource *source{LookupSource(context.get(), sid)};
+            return LIKELY(source != nullptr);
+        }
+    );
+    if(UNLIKELY(bad_sid != sources_end))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid source ID %u", *bad_sid);
+
+    /* Get the status of all the sources from the same mix, so they're
+     * consistent with each other and share one clock time. This only touches
+     * the voices and the sources' own queues, so it's repeated in full if a
+     * mix happened in the middle.
+     */
+    ALCdevice *device{context->Device};
+    std::chrono::nanoseconds srcclock;
+    ALuint refcount;
+    do {
+        while(((refcount=device->MixCount.load(std::memory_order_acquire))&1))
+            std::this_thread::yield();
+        srcclock = GetDeviceClockTime(device);
+
+        for(ALsizei i{0};i < n;i++)
+        {
+            ALsource *Source{LookupSource(context.get(), sources[i])};
+            ALvoice *voice{GetSourceVoice(Source, context.get())};
+
+            const ALbufferlistitem *Current{nullptr};
+            uint64_t readPos{0};
+            if(voice)
+            {
+                Current = voice->current_buffer.load(std::memory_order_relaxed);
+
+                readPos  = uint64_t{voice->position.load(std::memory_order_relaxed)} << 32;
+                readPos |= int64_t{voice->position_fraction.load(std::memory_order_relaxed)} <<
+                           (32-FRACTIONBITS);
+            }
+            else if(Source->state == AL_INITIAL)
+                Current = Source->queue;
+
+            if(states)
+                states[i] = GetSourceState(Source, voice);
+
+            if(processed)
+            {
+                /* Buffers on a looping source are in a perpetual state of
+                 * PENDING, so don't report any as PROCESSED.
+                 */
+                ALsizei played{0};
+                if(!Source->Looping && Source->SourceType == AL_STREAMING)
+                {
+                    const ALbufferlistitem *BufferList{Source->queue};
+                    while(BufferList && BufferList != Current)
+                    {
+                        played += BufferList->num_buffers;
+                        BufferList = BufferList->next.load(std::memory_order_relaxed);
+                    }
+                }
+                processed[i] = played;
+            }
+
+            if(offsets)
+            {
+                if(voice)
+                {
+                    const ALbufferlistitem *BufferList{Source->queue};
+                    while(BufferList && BufferList != Current)
+                    {
+                        readPos += int64_t{BufferList->max_samples} << 32;
+                        BufferList = BufferList->next.load(std::memory_order_relaxed);
+                    }
+                    readPos = minu64(readPos, 0x7fffffffffffffff_u64);
+                }
+                offsets[i] = static_cast<ALint64SOFT>(readPos);
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while(refcount != device->MixCount.load(std::memory_order_relaxed));
+
+    if(latency)
+    {
+        ClockLatency clocktime;
+        { std::lock_guard<std::mutex> __{device->StateLock};
+            clocktime = GetClockLatency(device);
+        }
+        /* As with AL_SAMPLE_OFFSET_LATENCY_SOFT, if the clock time
+         * incremented, reduce the latency by that much since it's that much
+         * closer to the offsets.
+         */
+        auto diff = clocktime.ClockTime - srcclock;
+        *latency = (clocktime.Latency - std::min(clocktime.Latency, diff)).count();
+    }
+}
+
 
 AL_API ALvoid AL_APIENTRY alSourcePlay(ALuint source)
 {
@@ -2694,7 +2857,7 @@ AL_API ALvoid AL_APIENTRY alSourcePlayv(ALsizei n, const ALuint *sources)
         SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid source ID %u", *bad_sid);
 
     ALCdevice *device{context->Device};
-    BackendLockGuard __{*device->Backend};
+    DeviceBackendLock __{device};
     /* If the device is disconnected, go right to stopped. */
     if(UNLIKELY(!device->Connected.load(std::memory_order_acquire)))
     {
@@ -2711,12 +2874,15 @@ AL_API ALvoid AL_APIENTRY alSourcePlayv(ALsizei n, const ALuint *sources)
         return;
     }
 
+    /* Contexts start without voices, so the first play allocates a modest
+     * amount that's doubled as needed.
+     */
     while(n > context->MaxVoices-context->VoiceCount.load(std::memory_order_relaxed))
     {
         if(UNLIKELY(context->MaxVoices > std::numeric_limits<ALsizei>::max()>>1))
             SETERR_RETURN(context.get(), AL_OUT_OF_MEMORY,,
                 "Overflow increasing voice count from %d", context->MaxVoices);
-        ALsizei newcount = context->MaxVoices << 1;
+        ALsizei newcount = context->MaxVoices ? context->MaxVoices<<1 : 64;
         AllocateVoices(context.get(), newcount, device->NumAuxSends);
     }
 
@@ -2822,20 +2988,35 @@ AL_API ALvoid AL_APIENTRY alSourcePlayv(ALsizei n, const ALuint *sources)
 
         voice->Flags = start_fading ? VOICE_IS_FADING : 0;
         if(source->SourceType == AL_STATIC) voice->Flags |= VOICE_IS_STATIC;
+        voice->PrevClusterIdx = -1;
 
         std::fill_n(std::begin(voice->Direct.Params), voice->NumChannels, DirectParams{});
         std::for_each(voice->Send.begin(), voice->Send.end(),
             [voice](ALvoice::SendData &send) -> void
             { std::fill_n(std::begin(send.Params), voice->NumChannels, SendParams{}); }
         );
+        std::for_each(voice->Listeners, voice->Listeners+context->NumListeners-1,
+            [voice](ALvoice::ListenerData &path) -> void
+            {
+                path.Direct.Buffer = nullptr;
+                std::fill_n(std::begin(path.Direct.Params), voice->NumChannels, DirectParams{});
+            }
+        );
 
         if(device->AvgSpeakerDist > 0.0f)
         {
             ALfloat w1 = SPEEDOFSOUNDMETRESPERSEC /
                          (device->AvgSpeakerDist * device->Frequency);
+            auto init_nfc = [w1](DirectParams &parms) noexcept -> void
+            { parms.NFCtrlFilter.init(w1); };
             std::for_each(voice->Direct.Params+0, voice->Direct.Params+voice->NumChannels,
-                [w1](DirectParams &parms) noexcept -> void
-                { parms.NFCtrlFilter.init(w1); }
+                init_nfc);
+            std::for_each(voice->Listeners, voice->Listeners+context->NumListeners-1,
+                [voice,init_nfc](ALvoice::ListenerData &path) -> void
+                {
+                    std::for_each(path.Direct.Params+0,
+                        path.Direct.Params+voice->NumChannels, init_nfc);
+                }
             );
         }
 
@@ -2870,7 +3051,7 @@ AL_API ALvoid AL_APIENTRY alSourcePausev(ALsizei n, const ALuint *sources)
     }
 
     ALCdevice *device{context->Device};
-    BackendLockGuard __{*device->Backend};
+    DeviceBackendLock __{device};
     for(ALsizei i{0};i < n;i++)
     {
         ALsource *source{LookupSource(context.get(), sources[i])};
@@ -2905,7 +3086,7 @@ AL_API ALvoid AL_APIENTRY alSourceStopv(ALsizei n, const ALuint *sources)
     }
 
     ALCdevice *device{context->Device};
-    BackendLockGuard __{*device->Backend};
+    DeviceBackendLock __{device};
     for(ALsizei i{0};i < n;i++)
     {
         ALsource *source{LookupSource(context.get(), sources[i])};
@@ -2948,7 +3129,7 @@ AL_API ALvoid AL_APIENTRY alSourceRewindv(ALsizei n, const ALuint *sources)
     }
 
     ALCdevice *device{context->Device};
-    BackendLockGuard __{*device->Backend};
+    DeviceBackendLock __{device};
     for(ALsizei i{0};i < n;i++)
     {
         ALsource *source{LookupSource(context.get(), sources[i])};
@@ -3321,6 +3502,7 @@ ALsource::ALsource(ALsizei num_sends)
     Looping = AL_FALSE;
     mDistanceModel = DistanceModel::Default;
     mResampler = ResamplerDefault;
+    mResamplerSet = false;
     DirectChannels = AL_FALSE;
     mSpatialize = SpatializeAuto;
 
@@ -3329,6 +3511,8 @@ ALsource::ALsource(ALsizei num_sends)
 
     Radius = 0.0f;
 
+    Bus = nullptr;
+
     Direct.Gain = 1.0f;
     Direct.GainHF = 1.0f;
     Direct.HFReference = LOWPASSFREQREF;
@@ -3381,6 +3565,10 @@ ALsource::~ALsource()
             send.Slot = nullptr;
         }
     );
+
+    if(Bus)
+        DecrementRef(&Bus->ref);
+    Bus = nullptr;
 }
 
 void UpdateAllSourceProps(ALCcontext *context)
@@ -53,6 +53,8 @@ constexpr ALchar alLinearResampler[] = "Linear";
 constexpr ALchar alCubicResampler[] = "Cubic";
 constexpr ALchar alBSinc12Resampler[] = "11th order Sinc";
 constexpr ALchar alBSinc24Resampler[] = "23rd order Sinc";
+constexpr ALchar alBSinc8Resampler[] = "7th order Sinc";
+constexpr ALchar alBSinc48Resampler[] = "47th order Sinc";
 
 } // namespace
 
@@ -178,6 +180,21 @@ AL_API ALboolean AL_APIENTRY alGetBoolean(ALenum pname)
         value = ResamplerDefault ? AL_TRUE : AL_FALSE;
         break;
 
+    case AL_VOICE_CLUSTERS_SOFT:
+        if(context->ActiveClusters.load(std::memory_order_relaxed) != 0)
+            value = AL_TRUE;
+        break;
+
+    case AL_CLUSTERED_VOICES_SOFT:
+        if(context->ClusteredVoices.load(std::memory_order_relaxed) != 0)
+            value = AL_TRUE;
+        break;
+
+    case AL_NUM_LISTENERS_SOFT:
+        /* Always non-0. */
+        value = AL_TRUE;
+        break;
+
     default:
         alSetError(context.get(), AL_INVALID_VALUE, "Invalid boolean property 0x%04x", pname);
     }
@@ -227,6 +244,18 @@ AL_API ALdouble AL_APIENTRY alGetDouble(ALenum pname)
         value = static_cast<ALdouble>(ResamplerDefault);
         break;
 
+    case AL_VOICE_CLUSTERS_SOFT:
+        value = static_cast<ALdouble>(context->ActiveClusters.load(std::memory_order_relaxed));
+        break;
+
+    case AL_CLUSTERED_VOICES_SOFT:
+        value = static_cast<ALdouble>(context->ClusteredVoices.load(std::memory_order_relaxed));
+        break;
+
+    case AL_NUM_LISTENERS_SOFT:
+        value = static_cast<ALdouble>(context->NumListeners);
+        break;
+
     default:
         alSetError(context.get(), AL_INVALID_VALUE, "Invalid double property 0x%04x", pname);
     }
@@ -276,6 +305,18 @@ AL_API ALfloat AL_APIENTRY alGetFloat(ALenum pname)
         value = static_cast<ALfloat>(ResamplerDefault);
         break;
 
+    case AL_VOICE_CLUSTERS_SOFT:
+        value = static_cast<ALfloat>(context->ActiveClusters.load(std::memory_order_relaxed));
+        break;
+
+    case AL_CLUSTERED_VOICES_SOFT:
+        value = static_cast<ALfloat>(context->ClusteredVoices.load(std::memory_order_relaxed));
+        break;
+
+    case AL_NUM_LISTENERS_SOFT:
+        value = static_cast<ALfloat>(context->NumListeners);
+        break;
+
     default:
         alSetError(context.get(), AL_INVALID_VALUE, "Invalid float property 0x%04x", pname);
     }
@@ -325,6 +366,18 @@ AL_API ALint AL_APIENTRY alGetInteger(ALenum pname)
         value = ResamplerDefault;
         break;
 
+    case AL_VOICE_CLUSTERS_SOFT:
+        value = static_cast<ALint>(context->ActiveClusters.load(std::memory_order_relaxed));
+        break;
+
+    case AL_CLUSTERED_VOICES_SOFT:
+        value = static_cast<ALint>(context->ClusteredVoices.load(std::memory_order_relaxed));
+        break;
+
+    case AL_NUM_LISTENERS_SOFT:
+        value = static_cast<ALint>(context->NumListeners);
+        break;
+
     default:
         alSetError(context.get(), AL_INVALID_VALUE, "Invalid integer property 0x%04x", pname);
     }
@@ -374,6 +427,18 @@ extern "C" AL_API ALint64SOFT AL_APIENTRY alGetInteger64SOFT(ALenum pname)
         value = (ALint64SOFT)ResamplerDefault;
         break;
 
+    case AL_VOICE_CLUSTERS_SOFT:
+        value = (ALint64SOFT)context->ActiveClusters.load(std::memory_order_relaxed);
+        break;
+
+    case AL_CLUSTERED_VOICES_SOFT:
+        value = (ALint64SOFT)context->ClusteredVoices.load(std::memory_order_relaxed);
+        break;
+
+    case AL_NUM_LISTENERS_SOFT:
+        value = (ALint64SOFT)context->NumListeners;
+        break;
+
     default:
         alSetError(context.get(), AL_INVALID_VALUE, "Invalid integer64 property 0x%04x", pname);
     }
@@ -419,6 +484,9 @@ AL_API ALvoid AL_APIENTRY alGetBooleanv(ALenum pname, ALboolean *values)
             case AL_GAIN_LIMIT_SOFT:
             case AL_NUM_RESAMPLERS_SOFT:
             case AL_DEFAULT_RESAMPLER_SOFT:
+            case AL_VOICE_CLUSTERS_SOFT:
+            case AL_CLUSTERED_VOICES_SOFT:
+            case AL_NUM_LISTENERS_SOFT:
                 values[0] = alGetBoolean(pname);
                 return;
         }
@@ -450,6 +518,9 @@ AL_API ALvoid AL_APIENTRY alGetDoublev(ALenum pname, ALdouble *values)
             case AL_GAIN_LIMIT_SOFT:
             case AL_NUM_RESAMPLERS_SOFT:
             case AL_DEFAULT_RESAMPLER_SOFT:
+            case AL_VOICE_CLUSTERS_SOFT:
+            case AL_CLUSTERED_VOICES_SOFT:
+            case AL_NUM_LISTENERS_SOFT:
                 values[0] = alGetDouble(pname);
                 return;
         }
@@ -481,6 +552,9 @@ AL_API ALvoid AL_APIENTRY alGetFloatv(ALenum pname, ALfloat *values)
             case AL_GAIN_LIMIT_SOFT:
             case AL_NUM_RESAMPLERS_SOFT:
             case AL_DEFAULT_RESAMPLER_SOFT:
+            case AL_VOICE_CLUSTERS_SOFT:
+            case AL_CLUSTERED_VOICES_SOFT:
+            case AL_NUM_LISTENERS_SOFT:
                 values[0] = alGetFloat(pname);
                 return;
         }
@@ -512,6 +586,9 @@ AL_API ALvoid AL_APIENTRY alGetIntegerv(ALenum pname, ALint *values)
             case AL_GAIN_LIMIT_SOFT:
             case AL_NUM_RESAMPLERS_SOFT:
             case AL_DEFAULT_RESAMPLER_SOFT:
+            case AL_VOICE_CLUSTERS_SOFT:
+            case AL_CLUSTERED_VOICES_SOFT:
+            case AL_NUM_LISTENERS_SOFT:
                 values[0] = alGetInteger(pname);
                 return;
         }
@@ -543,6 +620,9 @@ extern "C" AL_API void AL_APIENTRY alGetInteger64vSOFT(ALenum pname, ALint64SOFT
             case AL_GAIN_LIMIT_SOFT:
             case AL_NUM_RESAMPLERS_SOFT:
             case AL_DEFAULT_RESAMPLER_SOFT:
+            case AL_VOICE_CLUSTERS_SOFT:
+            case AL_CLUSTERED_VOICES_SOFT:
+            case AL_NUM_LISTENERS_SOFT:
                 values[0] = alGetInteger64SOFT(pname);
                 return;
         }
@@ -738,7 +818,8 @@ AL_API const ALchar* AL_APIENTRY alGetStringiSOFT(ALenum pname, ALsizei index)
     const char *ResamplerNames[] = {
         alPointResampler, alLinearResampler,
         alCubicResampler, alBSinc12Resampler,
-        alBSinc24Resampler,
+        alBSinc24Resampler, alBSinc8Resampler,
+        alBSinc48Resampler,
     };
     static_assert(COUNTOF(ResamplerNames) == ResamplerMax+1, "Incorrect ResamplerNames list");
 
@@ -0,0 +1,564 @@
+/**
+ * OpenAL cross platform audio library
+ * Copyright (C) 2019 by authors.
+ * This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Library General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ *  License along with this library; if not, write to the
+ *  Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ * Or go to http://www.gnu.org/copyleft/lgpl.html
+ */
+
+#include "config.h"
+
+#include <cmath>
+
+#include <thread>
+#include <algorithm>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+
+#include "alMain.h"
+#include "alcontext.h"
+#include "alSubmixBus.h"
+#include "alAuxEffectSlot.h"
+#include "alFilter.h"
+#include "alError.h"
+
+#include "almalloc.h"
+
+
+namespace {
+
+inline ALsubmixbus *LookupSubmixBus(ALCcontext *context, ALuint id) noexcept
+{
+    --id;
+    if(UNLIKELY(id >= context->SubmixBusList.size()))
+        return nullptr;
+    return context->SubmixBusList[id].get();
+}
+
+inline ALeffectslot *LookupEffectSlot(ALCcontext *context, ALuint id) noexcept
+{
+    --id;
+    if(UNLIKELY(id >= context->EffectSlotList.size()))
+        return nullptr;
+    return context->EffectSlotList[id].get();
+}
+
+inline ALfilter *LookupFilter(ALCdevice *device, ALuint id) noexcept
+{
+    ALuint lidx = (id-1) >> 6;
+    ALsizei slidx = (id-1) & 0x3f;
+
+    if(UNLIKELY(lidx >= device->FilterList.size()))
+        return nullptr;
+    FilterSubList &sublist = device->FilterList[lidx];
+    if(UNLIKELY(sublist.FreeMask & (1_u64 << slidx)))
+        return nullptr;
+    return sublist.Filters + slidx;
+}
+
+
+/* Replaces the mixer's list of buses with the ones currently allocated. Must
+ * be called with the context's SubmixBusLock held.
+ */
+void UpdateActiveSubmixBuses(ALCcontext *context)
+{
+    auto count = static_cast<size_t>(std::count_if(context->SubmixBusList.cbegin(),
+        context->SubmixBusList.cend(),
+        [](const ALsubmixbusPtr &entry) noexcept -> bool { return entry != nullptr; }
+    ));
+
+    ALsubmixbusArray *newarray{ALsubmixbus::CreatePtrArray(count)};
+    auto busiter = newarray->begin();
+    for(const ALsubmixbusPtr &entry : context->SubmixBusList)
+    {
+        if(entry) *(busiter++) = entry.get();
+    }
+
+    ALsubmixbusArray *curarray{context->ActiveSubmixBuses.exchange(newarray,
+        std::memory_order_acq_rel)};
+    ALCdevice *device{context->Device};
+    while((device->MixCount.load(std::memory_order_acquire)&1))
+        std::this_thread::yield();
+    delete curarray;
+}
+
+
+#define DO_UPDATEPROPS() do {                                                 \
+    if(!context->DeferUpdates.load(std::memory_order_acquire))                \
+        UpdateSubmixBusProps(bus, context.get());                             \
+    else                                                                      \
+        bus->PropsClean.clear(std::memory_order_release);                     \
+} while(0)
+
+} // namespace
+
+ALsubmixbusArray *ALsubmixbus::CreatePtrArray(size_t count) noexcept
+{
+    void *ptr{al_calloc(DEF_ALIGN, ALsubmixbusArray::Sizeof(count))};
+    return new (ptr) ALsubmixbusArray{count};
+}
+
+
+AL_API ALvoid AL_APIENTRY alGenSubmixBusesSOFT(ALsizei n, ALuint *buses)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    if(n < 0)
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Generating %d submix buses", n);
+    if(n == 0) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    for(ALsizei cur{0};cur < n;cur++)
+    {
+        auto iter = std::find_if(context->SubmixBusList.begin(), context->SubmixBusList.end(),
+            [](const ALsubmixbusPtr &entry) noexcept -> bool
+            { return !entry; }
+        );
+        if(iter == context->SubmixBusList.end())
+        {
+            context->SubmixBusList.emplace_back(nullptr);
+            iter = context->SubmixBusList.end() - 1;
+        }
+
+        *iter = al::make_unique<ALsubmixbus>();
+
+        auto id = static_cast<ALuint>(std::distance(context->SubmixBusList.begin(), iter) + 1);
+        (*iter)->id = id;
+        buses[cur] = id;
+    }
+    UpdateActiveSubmixBuses(context.get());
+}
+
+AL_API ALvoid AL_APIENTRY alDeleteSubmixBusesSOFT(ALsizei n, const ALuint *buses)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    if(n < 0)
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Deleting %d submix buses", n);
+    if(n == 0) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    auto buses_end = buses + n;
+    auto bad_bus = std::find_if(buses, buses_end,
+        [&context](ALuint id) -> bool
+        {
+            ALsubmixbus *bus{LookupSubmixBus(context.get(), id)};
+            if(!bus)
+            {
+                alSetError(context.get(), AL_INVALID_NAME, "Invalid submix bus ID %u", id);
+                return true;
+            }
+            if(ReadRef(&bus->ref) != 0)
+            {
+                alSetError(context.get(), AL_INVALID_OPERATION, "Deleting in-use submix bus %u",
+                    id);
+                return true;
+            }
+            return false;
+        }
+    );
+    if(bad_bus != buses_end)
+        return;
+
+    /* Take the buses out of the list and stop the mixer from using them before
+     * deleting them.
+     */
+    al::vector<ALsubmixbusPtr> deleted;
+    deleted.reserve(static_cast<size_t>(n));
+    std::for_each(buses, buses_end,
+        [&context,&deleted](ALuint id) -> void
+        {
+            if(context->SubmixBusList[id-1])
+                deleted.emplace_back(std::move(context->SubmixBusList[id-1]));
+        }
+    );
+    UpdateActiveSubmixBuses(context.get());
+}
+
+AL_API ALboolean AL_APIENTRY alIsSubmixBusSOFT(ALuint bus)
+{
+    ContextRef context{GetContextRef()};
+    if(LIKELY(context))
+    {
+        std::lock_guard<std::mutex> _{context->SubmixBusLock};
+        if(LookupSubmixBus(context.get(), bus) != nullptr)
+            return AL_TRUE;
+    }
+    return AL_FALSE;
+}
+
+
+AL_API ALvoid AL_APIENTRY alSubmixBusiSOFT(ALuint busid, ALenum param, ALint value)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->PropLock};
+    std::lock_guard<std::mutex> __{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    ALCdevice *device{context->Device};
+    ALeffectslot *slot{};
+    ALfilter *filter{};
+    switch(param)
+    {
+    case AL_SUBMIX_BUS_SPATIALIZE_SOFT:
+        if(!(value == AL_TRUE || value == AL_FALSE))
+            SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Submix bus spatialize out of range");
+        bus->Spatialize = value;
+        break;
+
+    case AL_DIRECT_FILTER:
+        { std::lock_guard<std::mutex> ___{device->FilterLock};
+            if(!(value == 0 || (filter=LookupFilter(device, value)) != nullptr))
+                SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Invalid filter ID %u", value);
+
+            if(!filter)
+            {
+                bus->Filter.Gain = 1.0f;
+                bus->Filter.GainHF = 1.0f;
+                bus->Filter.HFReference = LOWPASSFREQREF;
+                bus->Filter.GainLF = 1.0f;
+                bus->Filter.LFReference = HIGHPASSFREQREF;
+            }
+            else
+            {
+                bus->Filter.Gain = filter->Gain;
+                bus->Filter.GainHF = filter->GainHF;
+                bus->Filter.HFReference = filter->HFReference;
+                bus->Filter.GainLF = filter->GainLF;
+                bus->Filter.LFReference = filter->LFReference;
+            }
+        }
+        break;
+
+    case AL_SUBMIX_BUS_EFFECTSLOT_SOFT:
+        { std::lock_guard<std::mutex> ___{context->EffectSlotLock};
+            slot = (value ? LookupEffectSlot(context.get(), value) : nullptr);
+            if(value && !slot)
+                SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Invalid effect slot ID %u",
+                    value);
+
+            if(ALeffectslot *oldslot{bus->Slot})
+            {
+                /* We must force an update if there was an existing effect
+                 * slot, in case it's about to be deleted.
+                 */
+                if(slot) IncrementRef(&slot->ref);
+                DecrementRef(&oldslot->ref);
+                bus->Slot = slot;
+                UpdateSubmixBusProps(bus, context.get());
+                return;
+            }
+
+            if(slot) IncrementRef(&slot->ref);
+            bus->Slot = slot;
+        }
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,, "Invalid submix bus integer property 0x%04x",
+            param);
+    }
+    DO_UPDATEPROPS();
+}
+
+AL_API ALvoid AL_APIENTRY alSubmixBusivSOFT(ALuint busid, ALenum param, const ALint *values)
+{
+    switch(param)
+    {
+    case AL_SUBMIX_BUS_SPATIALIZE_SOFT:
+    case AL_DIRECT_FILTER:
+    case AL_SUBMIX_BUS_EFFECTSLOT_SOFT:
+        alSubmixBusiSOFT(busid, param, values[0]);
+        return;
+    }
+
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,,
+            "Invalid submix bus integer-vector property 0x%04x", param);
+    }
+}
+
+AL_API ALvoid AL_APIENTRY alSubmixBusfSOFT(ALuint busid, ALenum param, ALfloat value)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->PropLock};
+    std::lock_guard<std::mutex> __{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    case AL_GAIN:
+        if(!(value >= 0.0f && std::isfinite(value)))
+            SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Submix bus gain out of range");
+        bus->Gain = value;
+        break;
+
+    case AL_SUBMIX_BUS_SEND_GAIN_SOFT:
+        if(!(value >= 0.0f && value <= 1.0f))
+            SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Submix bus send gain out of range");
+        bus->SendGain = value;
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,, "Invalid submix bus float property 0x%04x",
+            param);
+    }
+    DO_UPDATEPROPS();
+}
+
+AL_API ALvoid AL_APIENTRY alSubmixBusfvSOFT(ALuint busid, ALenum param, const ALfloat *values)
+{
+    switch(param)
+    {
+    case AL_GAIN:
+    case AL_SUBMIX_BUS_SEND_GAIN_SOFT:
+        alSubmixBusfSOFT(busid, param, values[0]);
+        return;
+    }
+
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->PropLock};
+    std::lock_guard<std::mutex> __{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+    if(UNLIKELY(!values))
+        SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "NULL pointer");
+
+    switch(param)
+    {
+    case AL_POSITION:
+        if(!(std::isfinite(values[0]) && std::isfinite(values[1]) && std::isfinite(values[2])))
+            SETERR_RETURN(context.get(), AL_INVALID_VALUE,, "Submix bus position out of range");
+        bus->Position[0] = values[0];
+        bus->Position[1] = values[1];
+        bus->Position[2] = values[2];
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,,
+            "Invalid submix bus float-vector property 0x%04x", param);
+    }
+    DO_UPDATEPROPS();
+}
+
+AL_API ALvoid AL_APIENTRY alGetSubmixBusiSOFT(ALuint busid, ALenum param, ALint *value)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    case AL_SUBMIX_BUS_SPATIALIZE_SOFT:
+        *value = bus->Spatialize;
+        break;
+
+    case AL_SUBMIX_BUS_EFFECTSLOT_SOFT:
+        *value = bus->Slot ? static_cast<ALint>(bus->Slot->id) : 0;
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,, "Invalid submix bus integer property 0x%04x",
+            param);
+    }
+}
+
+AL_API ALvoid AL_APIENTRY alGetSubmixBusivSOFT(ALuint busid, ALenum param, ALint *values)
+{
+    switch(param)
+    {
+    case AL_SUBMIX_BUS_SPATIALIZE_SOFT:
+    case AL_SUBMIX_BUS_EFFECTSLOT_SOFT:
+        alGetSubmixBusiSOFT(busid, param, values);
+        return;
+    }
+
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,,
+            "Invalid submix bus integer-vector property 0x%04x", param);
+    }
+}
+
+AL_API ALvoid AL_APIENTRY alGetSubmixBusfSOFT(ALuint busid, ALenum param, ALfloat *value)
+{
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    case AL_GAIN:
+        *value = bus->Gain;
+        break;
+
+    case AL_SUBMIX_BUS_SEND_GAIN_SOFT:
+        *value = bus->SendGain;
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,, "Invalid submix bus float property 0x%04x",
+            param);
+    }
+}
+
+AL_API ALvoid AL_APIENTRY alGetSubmixBusfvSOFT(ALuint busid, ALenum param, ALfloat *values)
+{
+    switch(param)
+    {
+    case AL_GAIN:
+    case AL_SUBMIX_BUS_SEND_GAIN_SOFT:
+        alGetSubmixBusfSOFT(busid, param, values);
+        return;
+    }
+
+    ContextRef context{GetContextRef()};
+    if(UNLIKELY(!context)) return;
+
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    ALsubmixbus *bus{LookupSubmixBus(context.get(), busid)};
+    if(UNLIKELY(!bus))
+        SETERR_RETURN(context.get(), AL_INVALID_NAME,, "Invalid submix bus ID %u", busid);
+
+    switch(param)
+    {
+    case AL_POSITION:
+        values[0] = bus->Position[0];
+        values[1] = bus->Position[1];
+        values[2] = bus->Position[2];
+        break;
+
+    default:
+        SETERR_RETURN(context.get(), AL_INVALID_ENUM,,
+            "Invalid submix bus float-vector property 0x%04x", param);
+    }
+}
+
+
+ALsubmixbus::ALsubmixbus()
+{
+    PropsClean.test_and_set(std::memory_order_relaxed);
+
+    for(ALsizei c{0};c < MAX_EFFECT_CHANNELS;c++)
+    {
+        Mix.AmbiMap[c].Scale = 1.0f;
+        Mix.AmbiMap[c].Index = c;
+    }
+    Mix.Buffer = Buffer;
+    Mix.NumChannels = MAX_EFFECT_CHANNELS;
+}
+
+ALsubmixbus::~ALsubmixbus()
+{
+    if(Slot)
+        DecrementRef(&Slot->ref);
+    Slot = nullptr;
+
+    ALsubmixbusProps *props{Update.exchange(nullptr, std::memory_order_relaxed)};
+    if(props)
+    {
+        TRACE("Freed unapplied submix bus update %p\n", props);
+        al_free(props);
+    }
+}
+
+void UpdateSubmixBusProps(ALsubmixbus *bus, ALCcontext *context)
+{
+    /* Get an unused property container, or allocate a new one as needed. */
+    ALsubmixbusProps *props{context->FreeSubmixBusProps.load(std::memory_order_relaxed)};
+    if(!props)
+        props = static_cast<ALsubmixbusProps*>(al_calloc(16, sizeof(*props)));
+    else
+    {
+        ALsubmixbusProps *next;
+        do {
+            next = props->next.load(std::memory_order_relaxed);
+        } while(context->FreeSubmixBusProps.compare_exchange_weak(props, next,
+                std::memory_order_seq_cst, std::memory_order_acquire) == 0);
+    }
+
+    /* Copy in current property values. */
+    props->Gain = bus->Gain;
+    props->Position = bus->Position;
+    props->Spatialize = bus->Spatialize;
+    props->Filter.Gain = bus->Filter.Gain;
+    props->Filter.GainHF = bus->Filter.GainHF;
+    props->Filter.HFReference = bus->Filter.HFReference;
+    props->Filter.GainLF = bus->Filter.GainLF;
+    props->Filter.LFReference = bus->Filter.LFReference;
+    props->Slot = bus->Slot;
+    props->SendGain = bus->SendGain;
+
+    /* Set the new container for updating internal parameters. */
+    props = bus->Update.exchange(props, std::memory_order_acq_rel);
+    if(props)
+    {
+        /* If there was an unused update container, put it back in the
+         * freelist.
+         */
+        AtomicReplaceHead(context->FreeSubmixBusProps, props);
+    }
+}
+
+void UpdateAllSubmixBusProps(ALCcontext *context)
+{
+    std::lock_guard<std::mutex> _{context->SubmixBusLock};
+    for(ALsubmixbusPtr &bus : context->SubmixBusList)
+    {
+        if(bus && !bus->PropsClean.test_and_set(std::memory_order_acq_rel))
+            UpdateSubmixBusProps(bus.get(), context);
+    }
+}
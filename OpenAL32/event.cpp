@@ -97,6 +97,14 @@ static int EventThread(ALCcontext *context)
 
 void StartEventThrd(ALCcontext *ctx)
 {
+    /* The event queue and thread are created on first use, so contexts that
+     * never use events or effects don't pay for them.
+     */
+    std::lock_guard<std::mutex> _{ctx->EventThrdLock};
+    if(ctx->AsyncEvents)
+        return;
+
+    ctx->AsyncEvents = CreateRingBuffer(511, sizeof(AsyncEvent), false);
     try {
         ctx->EventThread = std::thread(EventThread, ctx);
     }
@@ -111,7 +119,10 @@ void StartEventThrd(ALCcontext *ctx)
 void StopEventThrd(ALCcontext *ctx)
 {
     static constexpr AsyncEvent kill_evt{EventType_KillThread};
+    std::lock_guard<std::mutex> _{ctx->EventThrdLock};
     RingBuffer *ring{ctx->AsyncEvents.get()};
+    if(!ring) return;
+
     auto evt_data = ring->getWriteVector().first;
     if(evt_data.len == 0)
     {
@@ -164,6 +175,7 @@ AL_API void AL_APIENTRY alEventControlSOFT(ALsizei count, const ALenum *types, A
 
     if(enable)
     {
+        StartEventThrd(context.get());
         ALbitfieldSOFT enabledevts{context->EnabledEvts.load(std::memory_order_relaxed)};
         while(context->EnabledEvts.compare_exchange_weak(enabledevts, enabledevts|flags,
             std::memory_order_acq_rel, std::memory_order_acquire) == 0)
@@ -3,9 +3,17 @@
 
 #include "sample_cvt.h"
 
+#include <algorithm>
+
 #include "AL/al.h"
 #include "alu.h"
 #include "alBuffer.h"
+#include "mixer/defs.h"
+
+
+IMA4DecodeLanesFunc DecodeIMA4Lanes = DecodeIMA4Lanes_<CTag>;
+MSADPCMDecodeLanesFunc DecodeMSADPCMLanes = DecodeMSADPCMLanes_<CTag>;
+HalfLoadFunc LoadHalfSamples = LoadHalfs_<CTag>;
 
 
 /* A quick'n'dirty lookup table to decode a muLaw-encoded byte sample into a
@@ -82,10 +90,8 @@ const ALshort aLawDecompressionTable[256] = {
        944,   912,  1008,   976,   816,   784,   880,   848
 };
 
-namespace {
-
 /* IMA ADPCM Stepsize table */
-constexpr int IMAStep_size[89] = {
+const ALint IMAStep_size[89] = {
        7,    8,    9,   10,   11,   12,   13,   14,   16,   17,   19,
       21,   23,   25,   28,   31,   34,   37,   41,   45,   50,   55,
       60,   66,   73,   80,   88,   97,  107,  118,  130,  143,  157,
@@ -98,26 +104,26 @@ constexpr int IMAStep_size[89] = {
 };
 
 /* IMA4 ADPCM Codeword decode table */
-constexpr int IMA4Codeword[16] = {
+const ALint IMA4Codeword[16] = {
     1, 3, 5, 7, 9, 11, 13, 15,
    -1,-3,-5,-7,-9,-11,-13,-15,
 };
 
 /* IMA4 ADPCM Step index adjust decode table */
-constexpr int IMA4Index_adjust[16] = {
+const ALint IMA4Index_adjust[16] = {
    -1,-1,-1,-1, 2, 4, 6, 8,
    -1,-1,-1,-1, 2, 4, 6, 8
 };
 
 
 /* MSADPCM Adaption table */
-constexpr int MSADPCMAdaption[16] = {
+const ALint MSADPCMAdaption[16] = {
     230, 230, 230, 230, 307, 409, 512, 614,
     768, 614, 512, 409, 307, 230, 230, 230
 };
 
 /* MSADPCM Adaption Coefficient tables */
-constexpr int MSADPCMAdaptionCoeff[7][2] = {
+const ALint MSADPCMAdaptionCoeff[7][2] = {
     { 256,    0 },
     { 512, -256 },
     {   0,    0 },
@@ -127,148 +133,177 @@ constexpr int MSADPCMAdaptionCoeff[7][2] = {
     { 392, -232 }
 };
 
-void DecodeIMA4Block(ALshort *dst, const ALubyte *src, ALint numchans, ALsizei align)
+
+namespace {
+
+/* Number of samples decoded per lane with each call to the lane decoder. */
+constexpr ALsizei ADPCM_CHUNK_SIZE{64};
+
+inline ALint read_le16s(const ALubyte *src) noexcept
 {
-    ALint sample[MAX_INPUT_CHANNELS]{};
-    ALint index[MAX_INPUT_CHANNELS]{};
-    ALuint code[MAX_INPUT_CHANNELS]{};
+    const ALint val{src[0] | (src[1]<<8)};
+    return (val^0x8000) - 32768;
+}
 
-    for(int c{0};c < numchans;c++)
-    {
-        sample[c]  = *(src++);
-        sample[c] |= *(src++) << 8;
-        sample[c]  = (sample[c]^0x8000) - 32768;
-        index[c]  = *(src++);
-        index[c] |= *(src++) << 8;
-        index[c]  = (index[c]^0x8000) - 32768;
+} // namespace
 
-        index[c] = clampi(index[c], 0, 88);
+/* The blocks are decoded by splitting them into streams, one per channel of
+ * each block, and handing groups of ADPCM_LANES streams to the lane decoder.
+ * Each stream is independent so they can all be decoded in parallel, with the
+ * results written back interleaved. Lanes without a stream are given silence
+ * and their output is ignored.
+ */
+void Decode_ALshort_ALima4(ALshort *dst, const ALubyte *src, ALsizei numchans, ALsizei align,
+                           ALsizei first, ALsizei count)
+{
+    ASSUME(numchans > 0);
+    ASSUME(align > 0);
 
-        dst[c] = sample[c];
-    }
+    const ALsizei byte_align{IMA4BlockSize(numchans, align)};
+    const ALsizei numstreams{count * numchans};
+    src += first*byte_align;
 
-    for(int i{1};i < align;i++)
+    alignas(16) ALubyte nibbles[ADPCM_CHUNK_SIZE][ADPCM_LANES];
+    alignas(16) ALshort samples[ADPCM_CHUNK_SIZE][ADPCM_LANES];
+    for(ALsizei stream{0};stream < numstreams;stream += ADPCM_LANES)
     {
-        if((i&7) == 1)
+        const ALsizei numlanes{mini(numstreams-stream, ADPCM_LANES)};
+        const ALubyte *code[ADPCM_LANES]{};
+        ALshort *out[ADPCM_LANES]{};
+        IMA4LaneState state{};
+
+        for(ALsizei l{0};l < numlanes;l++)
         {
-            for(int c{0};c < numchans;c++)
-            {
-                code[c]  = *(src++);
-                code[c] |= *(src++) << 8;
-                code[c] |= *(src++) << 16;
-                code[c] |= *(src++) << 24;
-            }
+            const ALsizei block{(stream+l) / numchans};
+            const ALsizei chan{(stream+l) % numchans};
+            const ALubyte *blocksrc{src + block*byte_align};
+
+            state.Sample[l] = read_le16s(blocksrc + chan*4);
+            state.Index[l] = clampi(read_le16s(blocksrc + chan*4 + 2), 0, 88);
+
+            /* Each channel's nibbles come in 32-bit groups of 8 samples,
+             * following the block header.
+             */
+            code[l] = blocksrc + numchans*4 + chan*4;
+            out[l] = dst + block*align*numchans + chan;
+            *out[l] = static_cast<ALshort>(state.Sample[l]);
+            out[l] += numchans;
         }
 
-        for(int c{0};c < numchans;c++)
+        for(ALsizei base{1};base < align;)
         {
-            int nibble = code[c]&0xf;
-            code[c] >>= 4;
-
-            sample[c] += IMA4Codeword[nibble] * IMAStep_size[index[c]] / 8;
-            sample[c] = clampi(sample[c], -32768, 32767);
+            const ALsizei todo{mini(align-base, ADPCM_CHUNK_SIZE)};
+            for(ALsizei i{0};i < todo;i++)
+            {
+                const ALsizei n{base+i - 1};
+                const ALsizei offset{(n>>3)*4*numchans + ((n&7)>>1)};
+                const ALsizei shift{(n&1) * 4};
+                for(ALsizei l{0};l < numlanes;l++)
+                    nibbles[i][l] = (code[l][offset]>>shift) & 0x0f;
+                std::fill(std::begin(nibbles[i])+numlanes, std::end(nibbles[i]), 0);
+            }
 
-            index[c] += IMA4Index_adjust[nibble];
-            index[c] = clampi(index[c], 0, 88);
+            DecodeIMA4Lanes(samples, nibbles, &state, todo);
 
-            *(dst++) = sample[c];
+            for(ALsizei l{0};l < numlanes;l++)
+            {
+                ALshort *RESTRICT lanedst{out[l]};
+                for(ALsizei i{0};i < todo;i++)
+                    lanedst[i*numchans] = samples[i][l];
+                out[l] += todo*numchans;
+            }
+            base += todo;
         }
     }
 }
 
-void DecodeMSADPCMBlock(ALshort *dst, const ALubyte *src, ALint numchans, ALsizei align)
+void Decode_ALshort_ALmsadpcm(ALshort *dst, const ALubyte *src, ALsizei numchans,
+                              ALsizei align, ALsizei first, ALsizei count)
 {
-    ALubyte blockpred[MAX_INPUT_CHANNELS]{};
-    ALint delta[MAX_INPUT_CHANNELS]{};
-    ALshort samples[MAX_INPUT_CHANNELS][2]{};
+    ASSUME(numchans > 0);
+    ASSUME(align > 1);
 
-    for(int c{0};c < numchans;c++)
-    {
-        blockpred[c] = *(src++);
-        blockpred[c] = minu(blockpred[c], 6);
-    }
-    for(int c{0};c < numchans;c++)
-    {
-        delta[c]  = *(src++);
-        delta[c] |= *(src++) << 8;
-        delta[c]  = (delta[c]^0x8000) - 32768;
-    }
-    for(int c{0};c < numchans;c++)
-    {
-        samples[c][0]  = *(src++);
-        samples[c][0] |= *(src++) << 8;
-        samples[c][0]  = (samples[c][0]^0x8000) - 32768;
-    }
-    for(int c{0};c < numchans;c++)
-    {
-        samples[c][1]  = *(src++);
-        samples[c][1] |= *(src++) << 8;
-        samples[c][1]  = (samples[c][1]^0x8000) - 0x8000;
-    }
+    const ALsizei byte_align{MSADPCMBlockSize(numchans, align)};
+    const ALsizei numstreams{count * numchans};
+    src += first*byte_align;
 
-    /* Second sample is written first. */
-    for(int c{0};c < numchans;c++)
-        *(dst++) = samples[c][1];
-    for(int c{0};c < numchans;c++)
-        *(dst++) = samples[c][0];
-
-    for(int i{2};i < align;i++)
+    alignas(16) ALubyte nibbles[ADPCM_CHUNK_SIZE][ADPCM_LANES];
+    alignas(16) ALshort samples[ADPCM_CHUNK_SIZE][ADPCM_LANES];
+    for(ALsizei stream{0};stream < numstreams;stream += ADPCM_LANES)
     {
-        for(int c{0};c < numchans;c++)
-        {
-            const ALint num = (i*numchans) + c;
-            ALint nibble, pred;
-
-            /* Read the nibble (first is in the upper bits). */
-            if(!(num&1))
-                nibble = (*src>>4)&0x0f;
-            else
-                nibble = (*(src++))&0x0f;
+        const ALsizei numlanes{mini(numstreams-stream, ADPCM_LANES)};
+        const ALubyte *code[ADPCM_LANES]{};
+        ALshort *out[ADPCM_LANES]{};
+        ALsizei chans[ADPCM_LANES]{};
+        MSADPCMLaneState state{};
 
-            pred  = (samples[c][0]*MSADPCMAdaptionCoeff[blockpred[c]][0] +
-                     samples[c][1]*MSADPCMAdaptionCoeff[blockpred[c]][1]) / 256;
-            pred += ((nibble^0x08) - 0x08) * delta[c];
-            pred  = clampi(pred, -32768, 32767);
+        for(ALsizei l{0};l < numlanes;l++)
+        {
+            const ALsizei block{(stream+l) / numchans};
+            const ALsizei chan{(stream+l) % numchans};
+            const ALubyte *blocksrc{src + block*byte_align};
+            chans[l] = chan;
+
+            /* The header holds each channel's predictor index, followed by
+             * each channel's initial delta, then the two initial samples for
+             * each channel (the most recent first).
+             */
+            const ALuint blockpred{minu(blocksrc[chan], 6)};
+            state.Coeff[0][l] = MSADPCMAdaptionCoeff[blockpred][0];
+            state.Coeff[1][l] = MSADPCMAdaptionCoeff[blockpred][1];
+            state.Delta[l] = read_le16s(blocksrc + numchans + chan*2);
+            state.Samples[0][l] = read_le16s(blocksrc + numchans*3 + chan*2);
+            state.Samples[1][l] = read_le16s(blocksrc + numchans*5 + chan*2);
+
+            code[l] = blocksrc + numchans*7;
+            out[l] = dst + block*align*numchans + chan;
+            /* Second sample is written first. */
+            out[l][0] = static_cast<ALshort>(state.Samples[1][l]);
+            out[l][numchans] = static_cast<ALshort>(state.Samples[0][l]);
+            out[l] += numchans*2;
+        }
 
-            samples[c][1] = samples[c][0];
-            samples[c][0] = pred;
+        for(ALsizei base{2};base < align;)
+        {
+            const ALsizei todo{mini(align-base, ADPCM_CHUNK_SIZE)};
+            for(ALsizei i{0};i < todo;i++)
+            {
+                /* The nibbles are interleaved by channel, and the first of
+                 * each byte is in the upper bits.
+                 */
+                for(ALsizei l{0};l < numlanes;l++)
+                {
+                    const ALsizei num{(base+i - 2)*numchans + chans[l]};
+                    nibbles[i][l] = (code[l][num>>1] >> ((~num&1)*4)) & 0x0f;
+                }
+                std::fill(std::begin(nibbles[i])+numlanes, std::end(nibbles[i]), 0);
+            }
 
-            delta[c] = (MSADPCMAdaption[nibble] * delta[c]) / 256;
-            delta[c] = maxi(16, delta[c]);
+            DecodeMSADPCMLanes(samples, nibbles, &state, todo);
 
-            *(dst++) = pred;
+            for(ALsizei l{0};l < numlanes;l++)
+            {
+                ALshort *RESTRICT lanedst{out[l]};
+                for(ALsizei i{0};i < todo;i++)
+                    lanedst[i*numchans] = samples[i][l];
+                out[l] += todo*numchans;
+            }
+            base += todo;
         }
     }
 }
 
-} // namespace
 
 void Convert_ALshort_ALima4(ALshort *dst, const ALubyte *src, ALsizei numchans, ALsizei len,
                             ALsizei align)
 {
-    ALsizei byte_align = ((align-1)/2 + 4) * numchans;
-
     assert(align > 0 && (len%align) == 0);
-    len /= align;
-    while(len--)
-    {
-        DecodeIMA4Block(dst, src, numchans, align);
-        src += byte_align;
-        dst += align*numchans;
-    }
+    Decode_ALshort_ALima4(dst, src, numchans, align, 0, len/align);
 }
 
 void Convert_ALshort_ALmsadpcm(ALshort *dst, const ALubyte *src, ALsizei numchans, ALsizei len,
                                ALsizei align)
 {
-    const ALsizei byte_align = ((align-2)/2 + 7) * numchans;
-
     assert(align > 1 && (len%align) == 0);
-    len /= align;
-    while(len--)
-    {
-        DecodeMSADPCMBlock(dst, src, numchans, align);
-        src += byte_align;
-        dst += align*numchans;
-    }
+    Decode_ALshort_ALmsadpcm(dst, src, numchans, align, 0, len/align);
 }
@@ -5,6 +5,8 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <cstdint>
+#include <atomic>
 #ifdef HAVE_MALLOC_H
 #include <malloc.h>
 #endif
@@ -13,6 +15,9 @@
 #else
 #include <unistd.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 
 
 #ifdef __GNUC__
@@ -24,6 +29,40 @@
 #endif
 
 
+namespace {
+
+std::atomic<unsigned int> LargeAllocFlags{0u};
+
+#ifdef HAVE_SYS_MMAN_H
+/* Large allocations smaller than this aren't worth mapping separately, and are
+ * made with al_malloc instead.
+ */
+constexpr size_t MinMappedSize{64u << 10};
+
+/* The huge page size for large allocations. Allocations smaller than this use
+ * normal pages.
+ */
+constexpr size_t HugePageSize{2u << 20};
+
+inline size_t RoundUpSize(size_t value, size_t r) noexcept
+{ return (value+r-1) / r * r; }
+
+/* Returns the size of the mapping used for a large allocation, or 0 if it
+ * isn't mapped.
+ */
+size_t GetMappedSize(size_t size, unsigned int flags) noexcept
+{
+    if(flags == 0 || size < MinMappedSize)
+        return 0;
+    if((flags&AL_LARGE_ALLOC_HUGEPAGES) && size >= HugePageSize)
+        return RoundUpSize(size, HugePageSize);
+    return RoundUpSize(size, al_get_page_size());
+}
+#endif
+
+} // namespace
+
+
 void *al_malloc(size_t alignment, size_t size)
 {
 #if defined(HAVE_ALIGNED_ALLOC)
@@ -73,6 +112,82 @@ void al_free(void *ptr) noexcept
 #endif
 }
 
+void al_set_large_alloc_flags(unsigned int flags) noexcept
+{ LargeAllocFlags.store(flags, std::memory_order_relaxed); }
+
+void *al_large_malloc(size_t alignment, size_t size)
+{
+#ifdef HAVE_SYS_MMAN_H
+    /* Mapped pages are always aligned well beyond what's needed for audio
+     * data.
+     */
+    const unsigned int flags{LargeAllocFlags.load(std::memory_order_relaxed)};
+    const size_t mapsize{GetMappedSize(size, flags)};
+    if(mapsize > 0)
+    {
+        const bool huge{(flags&AL_LARGE_ALLOC_HUGEPAGES) && mapsize >= HugePageSize};
+        void *ret{MAP_FAILED};
+#ifdef MAP_HUGETLB
+        /* Try to use the reserved huge page pool first. This fails if none
+         * are available.
+         */
+        if(huge)
+            ret = mmap(nullptr, mapsize, PROT_READ|PROT_WRITE,
+                MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+#endif
+        if(ret == MAP_FAILED)
+        {
+            /* Otherwise, map normal pages aligned to the huge page size so
+             * the kernel can back them with transparent huge pages.
+             */
+            const size_t extra{huge ? HugePageSize : 0};
+            void *base{mmap(nullptr, mapsize+extra, PROT_READ|PROT_WRITE,
+                MAP_PRIVATE|MAP_ANONYMOUS, -1, 0)};
+            if(base == MAP_FAILED)
+                return nullptr;
+
+            auto start = reinterpret_cast<uintptr_t>(base);
+            ret = base;
+            if(extra > 0)
+            {
+                const uintptr_t aligned{RoundUpSize(start, HugePageSize)};
+                if(aligned > start)
+                    munmap(base, aligned-start);
+                if(start+extra > aligned)
+                    munmap(reinterpret_cast<void*>(aligned+mapsize), start+extra-aligned);
+                ret = reinterpret_cast<void*>(aligned);
+            }
+#ifdef MADV_HUGEPAGE
+            if(huge)
+                madvise(ret, mapsize, MADV_HUGEPAGE);
+#endif
+        }
+
+        /* Locking may fail if it exceeds the process's limit, in which case
+         * the memory is left pageable.
+         */
+        if((flags&AL_LARGE_ALLOC_LOCKED))
+            mlock(ret, mapsize);
+        return ret;
+    }
+#endif
+    return al_malloc(alignment, size);
+}
+
+void al_large_free(void *ptr, size_t size) noexcept
+{
+    if(!ptr) return;
+#ifdef HAVE_SYS_MMAN_H
+    const size_t mapsize{GetMappedSize(size, LargeAllocFlags.load(std::memory_order_relaxed))};
+    if(mapsize > 0)
+    {
+        munmap(ptr, mapsize);
+        return;
+    }
+#endif
+    al_free(ptr);
+}
+
 size_t al_get_page_size() noexcept
 {
     static size_t psize = 0;
@@ -16,6 +16,33 @@ void al_free(void *ptr) noexcept;
 
 size_t al_get_page_size(void) noexcept;
 
+/* Flags for how large audio storage, such as sample data and effect delay
+ * lines, is allocated.
+ */
+enum : unsigned int {
+    /* Back large allocations with huge pages where available, reducing TLB
+     * misses when many voices read from them.
+     */
+    AL_LARGE_ALLOC_HUGEPAGES = 1u<<0,
+    /* Lock large allocations into memory, preventing them from being paged
+     * out.
+     */
+    AL_LARGE_ALLOC_LOCKED = 1u<<1,
+};
+
+/**
+ * Sets the flags used for large allocations. This must be set before any
+ * large allocations are made, as the flags also determine how they're freed.
+ */
+void al_set_large_alloc_flags(unsigned int flags) noexcept;
+
+/**
+ * Allocates storage for large audio data. Allocations made with this must be
+ * freed with al_large_free, given the same size.
+ */
+void *al_large_malloc(size_t alignment, size_t size);
+void al_large_free(void *ptr, size_t size) noexcept;
+
 /**
  * Returns non-0 if the allocation function has direct alignment handling.
  * Otherwise, the standard malloc is used with an over-allocation and pointer
@@ -70,6 +97,40 @@ struct allocator : public std::allocator<T> {
     { }
 };
 
+/* An allocator for large audio storage, which may be backed by huge pages and
+ * locked into memory depending on the large allocation flags.
+ */
+template<typename T, size_t alignment=DEF_ALIGN>
+struct large_allocator : public std::allocator<T> {
+    using size_type = size_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    template<typename U>
+    struct rebind {
+        using other = large_allocator<U, alignment>;
+    };
+
+    pointer allocate(size_type n, const void* = nullptr)
+    {
+        if(n > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        void *ret{al_large_malloc(alignment, n*sizeof(T))};
+        if(!ret) throw std::bad_alloc();
+        return static_cast<pointer>(ret);
+    }
+
+    void deallocate(pointer p, size_type n)
+    { al_large_free(p, n*sizeof(T)); }
+
+    large_allocator() : std::allocator<T>() { }
+    large_allocator(const large_allocator &a) : std::allocator<T>(a) { }
+    template<class U>
+    large_allocator(const large_allocator<U,alignment> &a) : std::allocator<T>(a)
+    { }
+};
+
 template<size_t alignment, typename T>
 inline T* assume_aligned(T *ptr) noexcept
 {
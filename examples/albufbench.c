@@ -0,0 +1,214 @@
+/*
+ * OpenAL Large Buffer Benchmark
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* This file contains a test program for timing the mixer with many sources
+ * playing from different parts of large buffers. It renders to a loopback
+ * device and reports the time taken, so runs with different settings (e.g.
+ * with the huge-pages config option enabled or disabled) can be compared.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+
+#define SAMPLE_RATE 48000
+#define UPDATE_SIZE 1024
+
+
+static LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+static LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+
+
+static int RunBenchmark(int megabytes, int numbuffers, int numsources, double seconds)
+{
+    ALCint attrs[16];
+    ALCdevice *device;
+    ALCcontext *context;
+    ALuint *buffers, *sources;
+    ALsizei frames, total, done;
+    ALshort *data;
+    ALfloat *out;
+    clock_t start, end;
+    int i;
+
+    device = alcLoopbackOpenDeviceSOFT(NULL);
+    if(!device)
+    {
+        fprintf(stderr, "Could not open loopback device\n");
+        return 1;
+    }
+
+    i = 0;
+    attrs[i++] = ALC_FORMAT_CHANNELS_SOFT;
+    attrs[i++] = ALC_STEREO_SOFT;
+    attrs[i++] = ALC_FORMAT_TYPE_SOFT;
+    attrs[i++] = ALC_FLOAT_SOFT;
+    attrs[i++] = ALC_FREQUENCY;
+    attrs[i++] = SAMPLE_RATE;
+    attrs[i++] = ALC_MONO_SOURCES;
+    attrs[i++] = numsources;
+    attrs[i] = 0;
+
+    context = alcCreateContext(device, attrs);
+    if(!context || alcMakeContextCurrent(context) == ALC_FALSE)
+    {
+        fprintf(stderr, "Could not create context\n");
+        if(context)
+            alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+
+    /* Fill each buffer with noise, using a fixed seed so each run gets the
+     * same data.
+     */
+    frames = (ALsizei)((size_t)megabytes * 1024 * 1024 / sizeof(ALshort));
+    data = malloc((size_t)frames * sizeof(*data));
+    if(!data)
+    {
+        fprintf(stderr, "Out of memory\n");
+        alcMakeContextCurrent(NULL);
+        alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+    srand(1);
+    buffers = calloc(numbuffers, sizeof(*buffers));
+    alGenBuffers(numbuffers, buffers);
+    for(i = 0;i < numbuffers;i++)
+    {
+        ALsizei j;
+        for(j = 0;j < frames;j++)
+            data[j] = (ALshort)((rand()%32767) - 16383);
+        alBufferData(buffers[i], AL_FORMAT_MONO16, data, frames*(ALsizei)sizeof(*data),
+            SAMPLE_RATE);
+    }
+    free(data);
+    if(alGetError() != AL_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to load buffers\n");
+        alDeleteBuffers(numbuffers, buffers);
+        free(buffers);
+        alcMakeContextCurrent(NULL);
+        alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+
+    /* Start each source at a random offset, with a slightly different pitch,
+     * so the sources read from scattered parts of the buffers.
+     */
+    sources = calloc(numsources, sizeof(*sources));
+    alGenSources(numsources, sources);
+    for(i = 0;i < numsources;i++)
+    {
+        alSourcei(sources[i], AL_BUFFER, (ALint)buffers[i%numbuffers]);
+        alSourcei(sources[i], AL_LOOPING, AL_TRUE);
+        alSourcef(sources[i], AL_GAIN, 1.0f / (ALfloat)numsources);
+        alSourcef(sources[i], AL_PITCH, 0.75f + (ALfloat)(rand()%1000) / 2000.0f);
+        alSourcei(sources[i], AL_SAMPLE_OFFSET, rand()%frames);
+    }
+    alSourcePlayv(numsources, sources);
+
+    total = (ALsizei)(seconds * SAMPLE_RATE);
+    out = malloc(UPDATE_SIZE * 2 * sizeof(*out));
+
+    start = clock();
+    for(done = 0;done < total;done += UPDATE_SIZE)
+    {
+        ALsizei todo = (total-done < UPDATE_SIZE) ? (total-done) : UPDATE_SIZE;
+        alcRenderSamplesSOFT(device, out, todo);
+    }
+    end = clock();
+
+    printf("Rendered %.2fs with %d sources over %d x %dMB buffers in %.1fms\n",
+        (double)total/SAMPLE_RATE, numsources, numbuffers, megabytes,
+        (double)(end-start) * 1000.0 / CLOCKS_PER_SEC);
+
+    free(out);
+    alDeleteSources(numsources, sources);
+    free(sources);
+    alDeleteBuffers(numbuffers, buffers);
+    free(buffers);
+
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(context);
+    alcCloseDevice(device);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int megabytes = 64;
+    int numbuffers = 4;
+    int numsources = 256;
+    double seconds = 10.0;
+    int i;
+
+    for(i = 1;i < argc;i++)
+    {
+        if(strcmp(argv[i], "-m") == 0 && i+1 < argc)
+            megabytes = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-b") == 0 && i+1 < argc)
+            numbuffers = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-n") == 0 && i+1 < argc)
+            numsources = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0 && i+1 < argc)
+            seconds = atof(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [options]\n\n"
+                "Options:\n"
+                "  -m <megabytes>  Size of each buffer (default: 64)\n"
+                "  -b <count>      Number of buffers (default: 4)\n"
+                "  -n <count>      Number of sources (default: 256)\n"
+                "  -t <seconds>    Length of the render (default: 10)\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    if(megabytes < 1 || megabytes > 1024 || numbuffers < 1 || numsources < 1 ||
+       !(seconds > 0.0))
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    if(!alcIsExtensionPresent(NULL, "ALC_SOFT_loopback"))
+    {
+        fprintf(stderr, "Error: ALC_SOFT_loopback not supported!\n");
+        return 1;
+    }
+    alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(NULL,
+        "alcLoopbackOpenDeviceSOFT");
+    alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(NULL,
+        "alcRenderSamplesSOFT");
+
+    return RunBenchmark(megabytes, numbuffers, numsources, seconds);
+}
@@ -0,0 +1,174 @@
+/*
+ * OpenAL Context Creation Benchmark
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* This file contains a test program for timing how quickly contexts can be
+ * created and destroyed, as a server creating a context per session would.
+ * Each cycle creates a context, makes it current, plays a source on it, and
+ * destroys it. Cycles run on a loopback device by default, or on a playback
+ * device, optionally with another context kept alive on it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+
+#define SAMPLE_RATE 48000
+
+
+static LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+
+
+static int RunBenchmark(const char *devname, int loopback, int keepalive, int cycles)
+{
+    ALCint attrs[16];
+    ALCint *attrlist = NULL;
+    ALCdevice *device;
+    ALCcontext *other = NULL;
+    clock_t start, end;
+    double us;
+    int i;
+
+    if(loopback)
+    {
+        device = alcLoopbackOpenDeviceSOFT(NULL);
+        i = 0;
+        attrs[i++] = ALC_FORMAT_CHANNELS_SOFT;
+        attrs[i++] = ALC_STEREO_SOFT;
+        attrs[i++] = ALC_FORMAT_TYPE_SOFT;
+        attrs[i++] = ALC_FLOAT_SOFT;
+        attrs[i++] = ALC_FREQUENCY;
+        attrs[i++] = SAMPLE_RATE;
+        attrs[i] = 0;
+        attrlist = attrs;
+    }
+    else
+        device = alcOpenDevice(devname);
+    if(!device)
+    {
+        fprintf(stderr, "Could not open device\n");
+        return 1;
+    }
+
+    if(keepalive)
+    {
+        other = alcCreateContext(device, attrlist);
+        if(!other)
+        {
+            fprintf(stderr, "Could not create context\n");
+            alcCloseDevice(device);
+            return 1;
+        }
+    }
+
+    start = clock();
+    for(i = 0;i < cycles;i++)
+    {
+        ALCcontext *context = alcCreateContext(device, attrlist);
+        ALuint source;
+
+        if(!context || alcMakeContextCurrent(context) == ALC_FALSE)
+        {
+            fprintf(stderr, "Could not create context (cycle %d)\n", i);
+            if(context)
+                alcDestroyContext(context);
+            break;
+        }
+
+        alGenSources(1, &source);
+        alSourcePlay(source);
+        alDeleteSources(1, &source);
+
+        alcMakeContextCurrent(NULL);
+        alcDestroyContext(context);
+    }
+    end = clock();
+
+    us = (double)(end-start) * 1000000.0 / CLOCKS_PER_SEC;
+    printf("%d cycles on %s%s: %.1fms, %.2fus per cycle\n", i,
+        loopback ? "a loopback device" : alcGetString(device, ALC_DEVICE_SPECIFIER),
+        keepalive ? " (with another context)" : "", us/1000.0, us/i);
+
+    if(other)
+        alcDestroyContext(other);
+    alcCloseDevice(device);
+
+    return (i == cycles) ? 0 : 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char *devname = NULL;
+    int loopback = 1;
+    int keepalive = 0;
+    int cycles = 10000;
+    int i;
+
+    for(i = 1;i < argc;i++)
+    {
+        if(strcmp(argv[i], "-n") == 0 && i+1 < argc)
+            cycles = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-p") == 0)
+            loopback = 0;
+        else if(strcmp(argv[i], "-d") == 0 && i+1 < argc)
+        {
+            devname = argv[++i];
+            loopback = 0;
+        }
+        else if(strcmp(argv[i], "-k") == 0)
+            keepalive = 1;
+        else
+        {
+            fprintf(stderr, "Usage: %s [options]\n\n"
+                "Options:\n"
+                "  -n <count>      Number of create/destroy cycles (default: 10000)\n"
+                "  -p              Use the default playback device instead of loopback\n"
+                "  -d <device>     Use the named playback device\n"
+                "  -k              Keep another context alive on the device\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    if(cycles < 1)
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    if(loopback)
+    {
+        if(!alcIsExtensionPresent(NULL, "ALC_SOFT_loopback"))
+        {
+            fprintf(stderr, "Error: ALC_SOFT_loopback not supported!\n");
+            return 1;
+        }
+        alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(NULL,
+            "alcLoopbackOpenDeviceSOFT");
+    }
+
+    return RunBenchmark(devname, loopback, keepalive, cycles);
+}
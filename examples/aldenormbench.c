@@ -0,0 +1,245 @@
+/*
+ * OpenAL Effect Tail Denormal Benchmark
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* This file contains a test program for timing the mixer while effect tails
+ * decay toward silence. A short burst of noise is fed to a reverb and an echo,
+ * then the tails are rendered to a loopback device in small updates, and the
+ * time taken for each stretch of the render is reported. As the tails decay,
+ * the effects' filters and feedback paths reach denormal values, which are
+ * very slow on many CPUs unless the mixer flushes them to zero. The -f option
+ * puts the calling thread into flush-to-zero mode first, like a backend's
+ * mixing thread, to time the mixer when it doesn't need to change the mode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP > 0) || defined(_M_X64)
+#include <xmmintrin.h>
+#define HAVE_FTZ_MODE 1
+#endif
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+#include "AL/efx.h"
+
+#define SAMPLE_RATE 48000
+#define BURST_FRAMES (SAMPLE_RATE/10)
+#define SEGMENT_SECONDS 2
+
+
+static LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+static LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+
+static LPALGENEFFECTS alGenEffects;
+static LPALDELETEEFFECTS alDeleteEffects;
+static LPALEFFECTI alEffecti;
+static LPALEFFECTF alEffectf;
+static LPALGENAUXILIARYEFFECTSLOTS alGenAuxiliaryEffectSlots;
+static LPALDELETEAUXILIARYEFFECTSLOTS alDeleteAuxiliaryEffectSlots;
+static LPALAUXILIARYEFFECTSLOTI alAuxiliaryEffectSloti;
+
+
+static int RunBenchmark(int updatesize, int seconds)
+{
+    ALCint attrs[16];
+    ALCdevice *device;
+    ALCcontext *context;
+    ALuint buffer, source;
+    ALuint effects[2], slots[2];
+    ALshort *data;
+    ALfloat *out;
+    double total_ms;
+    int segment, i;
+
+    device = alcLoopbackOpenDeviceSOFT(NULL);
+    if(!device)
+    {
+        fprintf(stderr, "Could not open loopback device\n");
+        return 1;
+    }
+
+    i = 0;
+    attrs[i++] = ALC_FORMAT_CHANNELS_SOFT;
+    attrs[i++] = ALC_STEREO_SOFT;
+    attrs[i++] = ALC_FORMAT_TYPE_SOFT;
+    attrs[i++] = ALC_FLOAT_SOFT;
+    attrs[i++] = ALC_FREQUENCY;
+    attrs[i++] = SAMPLE_RATE;
+    attrs[i++] = ALC_MAX_AUXILIARY_SENDS;
+    attrs[i++] = 2;
+    attrs[i] = 0;
+
+    context = alcCreateContext(device, attrs);
+    if(!context || alcMakeContextCurrent(context) == ALC_FALSE)
+    {
+        fprintf(stderr, "Could not create context\n");
+        if(context)
+            alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+
+    /* A short reverb decay and a long echo feedback, so both tails reach
+     * denormal levels well within the render.
+     */
+    alGenEffects(2, effects);
+    alEffecti(effects[0], AL_EFFECT_TYPE, AL_EFFECT_REVERB);
+    alEffectf(effects[0], AL_REVERB_DECAY_TIME, 1.0f);
+    alEffectf(effects[0], AL_REVERB_GAIN, 1.0f);
+    alEffecti(effects[1], AL_EFFECT_TYPE, AL_EFFECT_ECHO);
+    alEffectf(effects[1], AL_ECHO_FEEDBACK, 0.7f);
+    alEffectf(effects[1], AL_ECHO_DAMPING, 0.5f);
+
+    alGenAuxiliaryEffectSlots(2, slots);
+    alAuxiliaryEffectSloti(slots[0], AL_EFFECTSLOT_EFFECT, (ALint)effects[0]);
+    alAuxiliaryEffectSloti(slots[1], AL_EFFECTSLOT_EFFECT, (ALint)effects[1]);
+    if(alGetError() != AL_NO_ERROR)
+    {
+        fprintf(stderr, "Failed to set up effects\n");
+        alcMakeContextCurrent(NULL);
+        alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+
+    data = malloc(BURST_FRAMES * sizeof(*data));
+    srand(1);
+    for(i = 0;i < BURST_FRAMES;i++)
+        data[i] = (ALshort)((rand()%32767) - 16383);
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, AL_FORMAT_MONO16, data, BURST_FRAMES*(ALsizei)sizeof(*data),
+        SAMPLE_RATE);
+    free(data);
+
+    alGenSources(1, &source);
+    alSourcei(source, AL_BUFFER, (ALint)buffer);
+    alSource3i(source, AL_AUXILIARY_SEND_FILTER, (ALint)slots[0], 0, AL_FILTER_NULL);
+    alSource3i(source, AL_AUXILIARY_SEND_FILTER, (ALint)slots[1], 1, AL_FILTER_NULL);
+    alSourcePlay(source);
+
+    out = malloc((size_t)updatesize * 2 * sizeof(*out));
+
+    total_ms = 0.0;
+    for(segment = 0;segment < seconds/SEGMENT_SECONDS;segment++)
+    {
+        const int total = SEGMENT_SECONDS * SAMPLE_RATE;
+        clock_t start, end;
+        int done;
+        double ms;
+
+        start = clock();
+        for(done = 0;done < total;done += updatesize)
+        {
+            int todo = (total-done < updatesize) ? (total-done) : updatesize;
+            alcRenderSamplesSOFT(device, out, todo);
+        }
+        end = clock();
+
+        ms = (double)(end-start) * 1000.0 / CLOCKS_PER_SEC;
+        printf("  %2ds-%2ds: %7.1fms\n", segment*SEGMENT_SECONDS, (segment+1)*SEGMENT_SECONDS,
+            ms);
+        total_ms += ms;
+    }
+    printf("Rendered %ds in %d-sample updates in %.1fms\n", seconds, updatesize, total_ms);
+
+    free(out);
+    alDeleteSources(1, &source);
+    alDeleteBuffers(1, &buffer);
+    alDeleteAuxiliaryEffectSlots(2, slots);
+    alDeleteEffects(2, effects);
+
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(context);
+    alcCloseDevice(device);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int updatesize = 64;
+    int seconds = 20;
+    int ftz = 0;
+    int i;
+
+    for(i = 1;i < argc;i++)
+    {
+        if(strcmp(argv[i], "-u") == 0 && i+1 < argc)
+            updatesize = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0 && i+1 < argc)
+            seconds = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-f") == 0)
+            ftz = 1;
+        else
+        {
+            fprintf(stderr, "Usage: %s [options]\n\n"
+                "Options:\n"
+                "  -u <samples>    Samples rendered per update (default: 64)\n"
+                "  -t <seconds>    Length of the render (default: 20)\n"
+                "  -f              Set flush-to-zero mode on this thread first\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    if(updatesize < 1 || seconds < SEGMENT_SECONDS)
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    if(ftz)
+    {
+#ifdef HAVE_FTZ_MODE
+        _mm_setcsr(_mm_getcsr() | 0x8040);
+#else
+        fprintf(stderr, "Flush-to-zero mode is not supported here\n");
+        return 1;
+#endif
+    }
+
+    if(!alcIsExtensionPresent(NULL, "ALC_SOFT_loopback"))
+    {
+        fprintf(stderr, "Error: ALC_SOFT_loopback not supported!\n");
+        return 1;
+    }
+    alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(NULL,
+        "alcLoopbackOpenDeviceSOFT");
+    alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(NULL,
+        "alcRenderSamplesSOFT");
+
+#define LOAD_PROC(T, x)  ((x) = (T)alGetProcAddress(#x))
+    LOAD_PROC(LPALGENEFFECTS, alGenEffects);
+    LOAD_PROC(LPALDELETEEFFECTS, alDeleteEffects);
+    LOAD_PROC(LPALEFFECTI, alEffecti);
+    LOAD_PROC(LPALEFFECTF, alEffectf);
+    LOAD_PROC(LPALGENAUXILIARYEFFECTSLOTS, alGenAuxiliaryEffectSlots);
+    LOAD_PROC(LPALDELETEAUXILIARYEFFECTSLOTS, alDeleteAuxiliaryEffectSlots);
+    LOAD_PROC(LPALAUXILIARYEFFECTSLOTI, alAuxiliaryEffectSloti);
+#undef LOAD_PROC
+
+    return RunBenchmark(updatesize, seconds);
+}
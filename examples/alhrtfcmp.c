@@ -0,0 +1,290 @@
+/*
+ * OpenAL HRTF Fade Comparison
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* This file contains a test program for comparing how HRTF rendering handles
+ * moving sources. It renders noise sources circling the listener to a raw
+ * stereo float file using a loopback device, with the source position updated
+ * at a given interval. Renders made with different settings (e.g. with the
+ * hrtf-interpolate config option enabled or disabled) can then be compared to
+ * a reference, such as one made with very frequent updates.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+
+#ifndef M_PI
+#define M_PI    (3.14159265358979323846)
+#endif
+
+#define SAMPLE_RATE 48000
+
+
+static LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+static LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+
+
+static int RenderFile(const char *fname, double speed, int update, double seconds, int count)
+{
+    ALCint attrs[16];
+    ALCdevice *device;
+    ALCcontext *context;
+    ALCint hrtf_state;
+    ALshort *data;
+    ALfloat *out;
+    ALuint buffer;
+    ALuint *sources;
+    ALsizei total, done;
+    clock_t start, end;
+    FILE *file;
+    int i;
+
+    file = fopen(fname, "wb");
+    if(!file)
+    {
+        fprintf(stderr, "Could not open %s\n", fname);
+        return 1;
+    }
+
+    device = alcLoopbackOpenDeviceSOFT(NULL);
+    if(!device)
+    {
+        fprintf(stderr, "Could not open loopback device\n");
+        fclose(file);
+        return 1;
+    }
+
+    i = 0;
+    attrs[i++] = ALC_FORMAT_CHANNELS_SOFT;
+    attrs[i++] = ALC_STEREO_SOFT;
+    attrs[i++] = ALC_FORMAT_TYPE_SOFT;
+    attrs[i++] = ALC_FLOAT_SOFT;
+    attrs[i++] = ALC_FREQUENCY;
+    attrs[i++] = SAMPLE_RATE;
+    attrs[i++] = ALC_HRTF_SOFT;
+    attrs[i++] = ALC_TRUE;
+    attrs[i] = 0;
+
+    context = alcCreateContext(device, attrs);
+    if(!context || alcMakeContextCurrent(context) == ALC_FALSE)
+    {
+        fprintf(stderr, "Could not create context\n");
+        if(context)
+            alcDestroyContext(context);
+        alcCloseDevice(device);
+        fclose(file);
+        return 1;
+    }
+
+    alcGetIntegerv(device, ALC_HRTF_SOFT, 1, &hrtf_state);
+    if(!hrtf_state)
+        fprintf(stderr, "Warning: HRTF not enabled!\n");
+
+    /* Use a second of white noise, with a fixed seed so each render gets the
+     * same input.
+     */
+    data = malloc(SAMPLE_RATE * sizeof(*data));
+    srand(1);
+    for(i = 0;i < SAMPLE_RATE;i++)
+        data[i] = (ALshort)((rand()%32767) - 16383);
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, AL_FORMAT_MONO16, data, SAMPLE_RATE*sizeof(*data), SAMPLE_RATE);
+    free(data);
+
+    sources = calloc(count, sizeof(*sources));
+    alGenSources(count, sources);
+    for(i = 0;i < count;i++)
+    {
+        alSourcei(sources[i], AL_BUFFER, (ALint)buffer);
+        alSourcei(sources[i], AL_LOOPING, AL_TRUE);
+        alSourcef(sources[i], AL_GAIN, 1.0f / (ALfloat)count);
+    }
+
+    total = (ALsizei)(seconds * SAMPLE_RATE);
+    out = malloc(update * 2 * sizeof(*out));
+
+    start = clock();
+    for(done = 0;done < total;done += update)
+    {
+        ALsizei todo = (total-done < update) ? (total-done) : update;
+
+        /* Each source circles the listener, starting at evenly spaced angles
+         * and moving at the given rate in degrees per second. The position is
+         * set for the middle of the update, so renders with different update
+         * intervals stay aligned.
+         */
+        for(i = 0;i < count;i++)
+        {
+            double angle = (done + todo*0.5)/SAMPLE_RATE * speed * M_PI / 180.0;
+            angle += (double)i * 2.0 * M_PI / (double)count;
+            alSource3f(sources[i], AL_POSITION, (ALfloat)sin(angle), 0.0f,
+                -(ALfloat)cos(angle));
+        }
+        if(done == 0)
+            alSourcePlayv(count, sources);
+
+        alcRenderSamplesSOFT(device, out, todo);
+        fwrite(out, sizeof(*out)*2, (size_t)todo, file);
+    }
+    end = clock();
+
+    printf("Rendered %.2fs with %d source%s in %.1fms\n", (double)total/SAMPLE_RATE, count,
+        (count == 1) ? "" : "s", (double)(end-start) * 1000.0 / CLOCKS_PER_SEC);
+
+    free(out);
+    alDeleteSources(count, sources);
+    free(sources);
+    alDeleteBuffers(1, &buffer);
+
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(context);
+    alcCloseDevice(device);
+    fclose(file);
+
+    return 0;
+}
+
+
+static int CompareFiles(const char *reffname, const char *fname)
+{
+    double refpow = 0.0, errpow = 0.0, peak = 0.0;
+    float ref[2], test[2];
+    long frames = 0;
+    FILE *reffile, *file;
+    int c;
+
+    reffile = fopen(reffname, "rb");
+    file = fopen(fname, "rb");
+    if(!reffile || !file)
+    {
+        fprintf(stderr, "Could not open %s\n", (!reffile) ? reffname : fname);
+        if(reffile) fclose(reffile);
+        if(file) fclose(file);
+        return 1;
+    }
+
+    while(fread(ref, sizeof(ref), 1, reffile) == 1 && fread(test, sizeof(test), 1, file) == 1)
+    {
+        for(c = 0;c < 2;c++)
+        {
+            double err = (double)test[c] - (double)ref[c];
+            refpow += (double)ref[c] * (double)ref[c];
+            errpow += err * err;
+            if(fabs(err) > peak)
+                peak = fabs(err);
+        }
+        frames++;
+    }
+    fclose(reffile);
+    fclose(file);
+
+    if(frames == 0 || !(refpow > 0.0))
+    {
+        fprintf(stderr, "No signal to compare\n");
+        return 1;
+    }
+
+    printf("Compared %ld frames\n", frames);
+    if(errpow > 0.0)
+        printf("  Difference: %.2fdB relative to reference\n", 10.0*log10(errpow/refpow));
+    else
+        printf("  Difference: none\n");
+    printf("  Peak error: %f\n", peak);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    const char *fname = NULL;
+    double speed = 90.0;
+    double seconds = 10.0;
+    int update = 1024;
+    int count = 1;
+    int i;
+
+    if(argc < 2 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0)
+    {
+        fprintf(stderr, "Usage: %s [options] <output.raw>\n"
+            "       %s -c <reference.raw> <test.raw>\n\n"
+            "Options:\n"
+            "  -s <speed>     Source movement in degrees per second (default: 90)\n"
+            "  -u <frames>    Sample frames between position updates (default: 1024)\n"
+            "  -t <seconds>   Length of the render (default: 10)\n"
+            "  -n <count>     Number of circling sources (default: 1)\n",
+            argv[0], argv[0]);
+        return 1;
+    }
+
+    if(strcmp(argv[1], "-c") == 0)
+    {
+        if(argc != 4)
+        {
+            fprintf(stderr, "Expected two files to compare\n");
+            return 1;
+        }
+        return CompareFiles(argv[2], argv[3]);
+    }
+
+    for(i = 1;i < argc;i++)
+    {
+        if(strcmp(argv[i], "-s") == 0 && i+1 < argc)
+            speed = atof(argv[++i]);
+        else if(strcmp(argv[i], "-u") == 0 && i+1 < argc)
+            update = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0 && i+1 < argc)
+            seconds = atof(argv[++i]);
+        else if(strcmp(argv[i], "-n") == 0 && i+1 < argc)
+            count = atoi(argv[++i]);
+        else if(!fname)
+            fname = argv[i];
+        else
+        {
+            fprintf(stderr, "Unexpected argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if(!fname || update < 1 || !(seconds > 0.0) || count < 1)
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    if(!alcIsExtensionPresent(NULL, "ALC_SOFT_loopback"))
+    {
+        fprintf(stderr, "Error: ALC_SOFT_loopback not supported!\n");
+        return 1;
+    }
+    alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(NULL,
+        "alcLoopbackOpenDeviceSOFT");
+    alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(NULL,
+        "alcRenderSamplesSOFT");
+
+    return RenderFile(fname, speed, update, seconds, count);
+}
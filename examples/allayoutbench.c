@@ -0,0 +1,246 @@
+/*
+ * OpenAL Output Layout Mixing Benchmark
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/* This file contains a test program for timing the mixer with each output
+ * channel layout. Many sources play noise at fixed positions and gains, which
+ * is rendered to a loopback device for each layout, and the time taken is
+ * reported. Comparing runs with different builds shows how much each layout
+ * gains from a mixer change.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+
+#ifndef M_PI
+#define M_PI    (3.14159265358979323846)
+#endif
+
+/* From the in-progress ALC_SOFT_loopback_bformat extension. */
+#ifndef ALC_SOFT_loopback_bformat
+#define ALC_SOFT_loopback_bformat 1
+#define ALC_AMBISONIC_LAYOUT_SOFT                0x1997
+#define ALC_AMBISONIC_SCALING_SOFT               0x1998
+#define ALC_AMBISONIC_ORDER_SOFT                 0x1999
+#define ALC_BFORMAT3D_SOFT                       0x1508
+#define ALC_ACN_SOFT                             0x0001
+#define ALC_SN3D_SOFT                            0x0001
+#endif
+
+#define SAMPLE_RATE 48000
+#define UPDATE_SIZE 1024
+#define BUFFER_FRAMES SAMPLE_RATE
+
+
+static LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+static LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+
+static const struct {
+    const char name[16];
+    ALCint channels;
+    ALCint order;
+    ALsizei count;
+} Layouts[] = {
+    { "Stereo", ALC_STEREO_SOFT, 0, 2 },
+    { "Quad", ALC_QUAD_SOFT, 0, 4 },
+    { "5.1", ALC_5POINT1_SOFT, 0, 6 },
+    { "6.1", ALC_6POINT1_SOFT, 0, 7 },
+    { "7.1", ALC_7POINT1_SOFT, 0, 8 },
+    { "B-Format 1st", ALC_BFORMAT3D_SOFT, 1, 4 },
+    { "B-Format 2nd", ALC_BFORMAT3D_SOFT, 2, 9 },
+    { "B-Format 3rd", ALC_BFORMAT3D_SOFT, 3, 16 },
+};
+
+
+static int RunLayout(size_t layout, int numsources, double seconds, const ALshort *data)
+{
+    ALCint attrs[20];
+    ALCdevice *device;
+    ALCcontext *context;
+    ALuint buffer, *sources;
+    ALsizei total, done;
+    ALfloat *out;
+    clock_t start, end;
+    int i;
+
+    device = alcLoopbackOpenDeviceSOFT(NULL);
+    if(!device)
+    {
+        fprintf(stderr, "Could not open loopback device\n");
+        return 1;
+    }
+
+    i = 0;
+    attrs[i++] = ALC_FORMAT_CHANNELS_SOFT;
+    attrs[i++] = Layouts[layout].channels;
+    attrs[i++] = ALC_FORMAT_TYPE_SOFT;
+    attrs[i++] = ALC_FLOAT_SOFT;
+    attrs[i++] = ALC_FREQUENCY;
+    attrs[i++] = SAMPLE_RATE;
+    attrs[i++] = ALC_MONO_SOURCES;
+    attrs[i++] = numsources;
+    if(Layouts[layout].order > 0)
+    {
+        attrs[i++] = ALC_AMBISONIC_LAYOUT_SOFT;
+        attrs[i++] = ALC_ACN_SOFT;
+        attrs[i++] = ALC_AMBISONIC_SCALING_SOFT;
+        attrs[i++] = ALC_SN3D_SOFT;
+        attrs[i++] = ALC_AMBISONIC_ORDER_SOFT;
+        attrs[i++] = Layouts[layout].order;
+    }
+    attrs[i] = 0;
+
+    context = alcCreateContext(device, attrs);
+    if(!context || alcMakeContextCurrent(context) == ALC_FALSE)
+    {
+        fprintf(stderr, "Could not create context for %s\n", Layouts[layout].name);
+        if(context)
+            alcDestroyContext(context);
+        alcCloseDevice(device);
+        return 1;
+    }
+
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, AL_FORMAT_MONO16, data, BUFFER_FRAMES*(ALsizei)sizeof(*data),
+        SAMPLE_RATE);
+
+    /* Spread the sources around the listener, so each gets its own set of
+     * steady, audible output gains.
+     */
+    sources = calloc(numsources, sizeof(*sources));
+    alGenSources(numsources, sources);
+    for(i = 0;i < numsources;i++)
+    {
+        const double angle = 2.0 * M_PI * i / numsources;
+        alSourcei(sources[i], AL_BUFFER, (ALint)buffer);
+        alSourcei(sources[i], AL_LOOPING, AL_TRUE);
+        alSourcef(sources[i], AL_GAIN, 1.0f / (ALfloat)numsources);
+        alSource3f(sources[i], AL_POSITION, (ALfloat)sin(angle), (ALfloat)((i%3)-1)*0.5f,
+            -(ALfloat)cos(angle));
+        alSourcei(sources[i], AL_SAMPLE_OFFSET, (i*997)%BUFFER_FRAMES);
+    }
+    alSourcePlayv(numsources, sources);
+    if(alGetError() != AL_NO_ERROR)
+        fprintf(stderr, "Failed to set up sources for %s\n", Layouts[layout].name);
+
+    total = (ALsizei)(seconds * SAMPLE_RATE);
+    out = malloc(UPDATE_SIZE * (size_t)Layouts[layout].count * sizeof(*out));
+
+    /* Render one update first, so the gains have settled before timing. */
+    alcRenderSamplesSOFT(device, out, UPDATE_SIZE);
+
+    start = clock();
+    for(done = 0;done < total;done += UPDATE_SIZE)
+    {
+        ALsizei todo = (total-done < UPDATE_SIZE) ? (total-done) : UPDATE_SIZE;
+        alcRenderSamplesSOFT(device, out, todo);
+    }
+    end = clock();
+
+    printf("%-13s %2d channels: %8.1fms\n", Layouts[layout].name, Layouts[layout].count,
+        (double)(end-start) * 1000.0 / CLOCKS_PER_SEC);
+
+    free(out);
+    alDeleteSources(numsources, sources);
+    free(sources);
+    alDeleteBuffers(1, &buffer);
+
+    alcMakeContextCurrent(NULL);
+    alcDestroyContext(context);
+    alcCloseDevice(device);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int numsources = 256;
+    double seconds = 10.0;
+    const char *only = NULL;
+    ALshort *data;
+    size_t l;
+    int ret = 0;
+    int i;
+
+    for(i = 1;i < argc;i++)
+    {
+        if(strcmp(argv[i], "-n") == 0 && i+1 < argc)
+            numsources = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0 && i+1 < argc)
+            seconds = atof(argv[++i]);
+        else if(strcmp(argv[i], "-l") == 0 && i+1 < argc)
+            only = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [options]\n\n"
+                "Options:\n"
+                "  -n <count>      Number of sources (default: 256)\n"
+                "  -t <seconds>    Length of each render (default: 10)\n"
+                "  -l <layout>     Only time the named layout\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    if(numsources < 1 || !(seconds > 0.0))
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    if(!alcIsExtensionPresent(NULL, "ALC_SOFT_loopback"))
+    {
+        fprintf(stderr, "Error: ALC_SOFT_loopback not supported!\n");
+        return 1;
+    }
+    alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(NULL,
+        "alcLoopbackOpenDeviceSOFT");
+    alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(NULL,
+        "alcRenderSamplesSOFT");
+
+    /* Use the same noise for every layout and run. */
+    data = malloc(BUFFER_FRAMES * sizeof(*data));
+    if(!data)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    srand(1);
+    for(i = 0;i < BUFFER_FRAMES;i++)
+        data[i] = (ALshort)((rand()%32767) - 16383);
+
+    for(l = 0;l < sizeof(Layouts)/sizeof(Layouts[0]);l++)
+    {
+        if(only && strcmp(only, Layouts[l].name) != 0)
+            continue;
+        ret |= RunLayout(l, numsources, seconds, data);
+    }
+    free(data);
+
+    return ret;
+}
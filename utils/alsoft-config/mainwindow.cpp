@@ -101,8 +101,10 @@ static const struct NameValuePair {
     { "Linear", "linear" },
     { "Default (Linear)", "" },
     { "Cubic Spline", "cubic" },
+    { "7th order Sinc", "bsinc8" },
     { "11th order Sinc", "bsinc12" },
     { "23rd order Sinc", "bsinc24" },
+    { "47th order Sinc", "bsinc48" },
 
     { "", "" }
 }, stereoModeList[] = {